@@ -0,0 +1,212 @@
+#include "Benchmark.hpp"
+#include "DockLayout.h"
+#include "GridLayout.h"
+#include "StackLayoutH.h"
+#include "StackLayoutV.h"
+#include "UniformGridLayout.h"
+#include "WrapLayoutH.h"
+#include "WrapLayoutV.h"
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief 模拟的子元素，Measure时返回固定的尺寸，不做任何额外工作
+ */
+class FakeChild : public sw::ILayout
+{
+public:
+    uint64_t layoutTag = 0;
+    sw::Size size{};
+    sw::Size desireSize{};
+    sw::Rect arrangeRect{};
+
+    virtual uint64_t GetLayoutTag() override { return this->layoutTag; }
+    virtual int GetChildLayoutCount() override { return 0; }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return *this; }
+    virtual sw::Size GetDesireSize() override { return this->desireSize; }
+    virtual void Measure(const sw::Size &availableSize) override { this->desireSize = this->size; }
+    virtual void Arrange(const sw::Rect &finalPosition) override { this->arrangeRect = finalPosition; }
+};
+
+/**
+ * @brief 模拟的父元素，持有所有子元素
+ */
+class FakeHost : public sw::ILayout
+{
+public:
+    std::vector<FakeChild> children;
+
+    virtual uint64_t GetLayoutTag() override { return 0; }
+    virtual int GetChildLayoutCount() override { return (int)this->children.size(); }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return this->children[index]; }
+    virtual sw::Size GetDesireSize() override { return sw::Size(); }
+    virtual void Measure(const sw::Size &availableSize) override {}
+    virtual void Arrange(const sw::Rect &finalPosition) override {}
+};
+
+/**
+ * @brief 一个测量场景
+ */
+struct Scenario {
+    const char *name;
+    sw::Size availableSize;
+    std::function<sw::LayoutHost *(FakeHost &host, int count)> setup;
+};
+
+/**
+ * @brief 生成确定的伪随机尺寸，保证每次运行的结果可比较
+ */
+static sw::Size MakeChildSize(int index)
+{
+    return sw::Size(20 + (index * 37) % 80, 16 + (index * 13) % 24);
+}
+
+/**
+ * @brief 创建count个子元素，tagFunc用于计算每个子元素的布局标记
+ */
+static void FillChildren(FakeHost &host, int count, const std::function<uint64_t(int)> &tagFunc)
+{
+    host.children.assign(count, FakeChild());
+    for (int i = 0; i < count; ++i) {
+        host.children[i].size      = MakeChildSize(i);
+        host.children[i].layoutTag = tagFunc ? tagFunc(i) : 0;
+    }
+}
+
+/**
+ * @brief 执行一个场景并输出结果
+ */
+static void Run(const Scenario &scenario, int childCount)
+{
+    FakeHost host;
+    sw::LayoutHost *layout = scenario.setup(host, childCount);
+    layout->Associate(&host);
+
+    bench::Sample measure, arrange;
+
+    // 预热一次，排除首次执行时建立内部缓存的开销
+    layout->ArrangeOverride(layout->MeasureOverride(scenario.availableSize));
+
+    while (bench::NeedMorePasses(measure)) {
+        sw::Size desireSize;
+        {
+            bench::Probe probe;
+            desireSize = layout->MeasureOverride(scenario.availableSize);
+            probe.AddTo(measure);
+        }
+        sw::Size finalSize(
+            std::isinf(scenario.availableSize.width) ? desireSize.width : scenario.availableSize.width,
+            std::isinf(scenario.availableSize.height) ? desireSize.height : scenario.availableSize.height);
+        {
+            bench::Probe probe;
+            layout->ArrangeOverride(finalSize);
+            probe.AddTo(arrange);
+        }
+    }
+
+    bench::PrintRow(scenario.name, childCount, measure, arrange);
+    delete layout;
+}
+
+/**
+ * @brief 创建包含rowCount行colCount列的GridLayout，列类型按照colTypes循环
+ */
+static sw::GridLayout *MakeGrid(int rowCount, int colCount, const std::vector<sw::GridRCType> &colTypes, sw::GridRCType rowType)
+{
+    auto grid = new sw::GridLayout;
+    for (int i = 0; i < rowCount; ++i) {
+        switch (rowType) {
+            case sw::GridRCType::FixSize: grid->rows.Append(sw::FixSizeGridRow(24)); break;
+            case sw::GridRCType::AutoSize: grid->rows.Append(sw::AutoSizeGridRow()); break;
+            case sw::GridRCType::FillRemain: grid->rows.Append(sw::FillRemainGridRow()); break;
+        }
+    }
+    for (int j = 0; j < colCount; ++j) {
+        switch (colTypes[j % colTypes.size()]) {
+            case sw::GridRCType::FixSize: grid->columns.Append(sw::FixSizeGridColumn(60)); break;
+            case sw::GridRCType::AutoSize: grid->columns.Append(sw::AutoSizeGridColumn()); break;
+            case sw::GridRCType::FillRemain: grid->columns.Append(sw::FillRemainGridColumn(1 + j % 3)); break;
+        }
+    }
+    return grid;
+}
+
+int main(int argc, char *argv[])
+{
+    // 命令行参数为要测量的子元素数量，默认测量1k、10k和100k
+    std::vector<int> childCounts;
+    for (int i = 1; i < argc; ++i) {
+        int count = std::atoi(argv[i]);
+        if (count > 0) childCounts.push_back(count);
+    }
+    if (childCounts.empty()) {
+        childCounts = {1000, 10000, 100000};
+    }
+
+    const sw::Size windowSize(1920, 1080);
+    const sw::Size sizeToContent(INFINITY, INFINITY);
+    const int gridColumns = 40;
+
+    std::vector<Scenario> scenarios = {
+        {"StackLayoutH", windowSize, [](FakeHost &host, int count) -> sw::LayoutHost * {
+             FillChildren(host, count, nullptr);
+             return new sw::StackLayoutH;
+         }},
+        {"StackLayoutV", windowSize, [](FakeHost &host, int count) -> sw::LayoutHost * {
+             FillChildren(host, count, nullptr);
+             return new sw::StackLayoutV;
+         }},
+        {"WrapLayoutH", windowSize, [](FakeHost &host, int count) -> sw::LayoutHost * {
+             FillChildren(host, count, nullptr);
+             return new sw::WrapLayoutH;
+         }},
+        {"WrapLayoutV", windowSize, [](FakeHost &host, int count) -> sw::LayoutHost * {
+             FillChildren(host, count, nullptr);
+             return new sw::WrapLayoutV;
+         }},
+        {"DockLayout", windowSize, [](FakeHost &host, int count) -> sw::LayoutHost * {
+             FillChildren(host, count, [](int i) -> uint64_t { return (uint64_t)(i % 4); });
+             return new sw::DockLayout;
+         }},
+        {"UniformGridLayout", windowSize, [=](FakeHost &host, int count) -> sw::LayoutHost * {
+             FillChildren(host, count, nullptr);
+             auto layout     = new sw::UniformGridLayout;
+             layout->columns = gridColumns;
+             layout->rows    = (count + gridColumns - 1) / gridColumns;
+             return layout;
+         }},
+        {"GridLayout (FixSize)", windowSize, [=](FakeHost &host, int count) -> sw::LayoutHost * {
+             int rowCount = (count + gridColumns - 1) / gridColumns;
+             FillChildren(host, count, [=](int i) -> uint64_t { return sw::GridLayoutTag(i / gridColumns, i % gridColumns); });
+             return MakeGrid(rowCount, gridColumns, {sw::GridRCType::FixSize}, sw::GridRCType::FixSize);
+         }},
+        {"GridLayout (Fix/Auto/Fill mix)", windowSize, [=](FakeHost &host, int count) -> sw::LayoutHost * {
+             int rowCount = (count + gridColumns - 1) / gridColumns;
+             FillChildren(host, count, [=](int i) -> uint64_t { return sw::GridLayoutTag(i / gridColumns, i % gridColumns); });
+             return MakeGrid(rowCount, gridColumns, {sw::GridRCType::FixSize, sw::GridRCType::AutoSize, sw::GridRCType::FillRemain}, sw::GridRCType::AutoSize);
+         }},
+        {"GridLayout (mix, spans)", windowSize, [=](FakeHost &host, int count) -> sw::LayoutHost * {
+             int rowCount = (count + gridColumns - 1) / gridColumns;
+             FillChildren(host, count, [=](int i) -> uint64_t {
+                 // 每7个元素中有一个跨2列、每11个元素中有一个跨2行
+                 return sw::GridLayoutTag(i / gridColumns, i % gridColumns, i % 11 == 0 ? 2 : 1, i % 7 == 0 ? 2 : 1);
+             });
+             return MakeGrid(rowCount, gridColumns, {sw::GridRCType::AutoSize, sw::GridRCType::FillRemain, sw::GridRCType::FixSize}, sw::GridRCType::AutoSize);
+         }},
+        {"GridLayout (mix, size to content)", sizeToContent, [=](FakeHost &host, int count) -> sw::LayoutHost * {
+             int rowCount = (count + gridColumns - 1) / gridColumns;
+             FillChildren(host, count, [=](int i) -> uint64_t { return sw::GridLayoutTag(i / gridColumns, i % gridColumns); });
+             return MakeGrid(rowCount, gridColumns, {sw::GridRCType::FixSize, sw::GridRCType::AutoSize, sw::GridRCType::FillRemain}, sw::GridRCType::FillRemain);
+         }},
+    };
+
+    bench::PrintHeader("layout");
+    for (const Scenario &scenario : scenarios) {
+        for (int childCount : childCounts) {
+            Run(scenario, childCount);
+        }
+    }
+    return 0;
+}
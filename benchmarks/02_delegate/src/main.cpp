@@ -0,0 +1,129 @@
+#include "Benchmark.hpp"
+#include "Delegate.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 每次执行包含的操作数
+ */
+static constexpr int OpsPerPass = 10000;
+
+/**
+ * @brief 防止编译器将被测代码优化掉
+ */
+static volatile int sink = 0;
+
+/**
+ * @brief 用于测试成员函数绑定的类型
+ */
+class Receiver
+{
+public:
+    int value = 0;
+
+    void OnEvent(int arg) { this->value += arg; }
+};
+
+/**
+ * @brief 执行count次func并输出结果
+ */
+static void Run(const char *name, const std::function<void()> &func)
+{
+    bench::Sample sample;
+
+    // 预热一次
+    func();
+
+    while (bench::NeedMorePasses(sample)) {
+        bench::Probe probe;
+        func();
+        probe.AddTo(sample);
+    }
+
+    bench::PrintOpsRow(name, sample, OpsPerPass);
+}
+
+int main()
+{
+    Receiver receiver;
+    int counter = 0;
+
+    auto smallLambda = [&counter](int arg) { counter += arg; };
+    auto largeLambda = [&counter, text = std::string(64, 'x')](int arg) { counter += arg + (int)text.size(); };
+
+    sw::Action<int> single = smallLambda;
+    sw::Action<int> member(receiver, &Receiver::OnEvent);
+    sw::Action<int> multicast2;
+    multicast2 += smallLambda;
+    multicast2 += sw::Action<int>(receiver, &Receiver::OnEvent);
+    sw::Action<int> multicast8;
+    for (int i = 0; i < 8; ++i) multicast8 += [&counter, i](int arg) { counter += arg + i; };
+
+    bench::PrintOpsHeader("delegate");
+
+    Run("construct (lambda)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) {
+            sw::Action<int> action = smallLambda;
+            sink = sink + (action != nullptr);
+        }
+    });
+
+    Run("construct (member function)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) {
+            sw::Action<int> action(receiver, &Receiver::OnEvent);
+            sink = sink + (action != nullptr);
+        }
+    });
+
+    Run("construct (large lambda)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) {
+            sw::Action<int> action = largeLambda;
+            sink = sink + (action != nullptr);
+        }
+    });
+
+    Run("copy (single)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) {
+            sw::Action<int> copy = single;
+            sink = sink + (copy != nullptr);
+        }
+    });
+
+    Run("copy (multicast x2)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) {
+            sw::Action<int> copy = multicast2;
+            sink = sink + (copy != nullptr);
+        }
+    });
+
+    Run("invoke (single)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) single(i);
+    });
+
+    Run("invoke (member function)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) member(i);
+    });
+
+    Run("invoke (multicast x2)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) multicast2(i);
+    });
+
+    Run("invoke (multicast x8)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) multicast8(i);
+    });
+
+    Run("add/remove handler (x2)", [&]() {
+        for (int i = 0; i < OpsPerPass; ++i) {
+            sw::Action<int> action;
+            action += smallLambda;
+            action.Add(receiver, &Receiver::OnEvent);
+            action.Remove(receiver, &Receiver::OnEvent);
+            action -= smallLambda;
+            sink = sink + (action == nullptr);
+        }
+    });
+
+    sink = sink + counter + receiver.value;
+    return 0;
+}
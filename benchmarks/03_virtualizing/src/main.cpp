@@ -0,0 +1,174 @@
+#include "Benchmark.hpp"
+#include "StackLayoutV.h"
+#include "VirtualizingLayout.h"
+#include "WrapLayoutH.h"
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 模拟的子元素，Measure时返回固定的尺寸
+ */
+class FakeChild : public sw::ILayout
+{
+public:
+    sw::Size size{200, 24};
+    sw::Size desireSize{};
+    sw::Rect arrangeRect{};
+    int item = -1;
+
+    virtual uint64_t GetLayoutTag() override { return 0; }
+    virtual int GetChildLayoutCount() override { return 0; }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return *this; }
+    virtual sw::Size GetDesireSize() override { return this->desireSize; }
+    virtual void Measure(const sw::Size &availableSize) override { this->desireSize = this->size; }
+    virtual void Arrange(const sw::Rect &finalPosition) override { this->arrangeRect = finalPosition; }
+};
+
+/**
+ * @brief 模拟的父元素，子元素按需创建，相当于面板中的容器
+ */
+class FakeHost : public sw::ILayout
+{
+public:
+    std::vector<std::unique_ptr<FakeChild>> children;
+    int prepareCount = 0;
+
+    virtual uint64_t GetLayoutTag() override { return 0; }
+    virtual int GetChildLayoutCount() override { return (int)this->children.size(); }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return *this->children[index]; }
+    virtual sw::Size GetDesireSize() override { return sw::Size(); }
+    virtual void Measure(const sw::Size &availableSize) override {}
+    virtual void Arrange(const sw::Rect &finalPosition) override {}
+
+    /**
+     * @brief 与VirtualizingPanel相同的容器分配方式：第i项使用第i%n个容器
+     */
+    void Realize(int first, int last)
+    {
+        int count = last - first;
+        if (count > (int)this->children.size()) {
+            while ((int)this->children.size() < count) {
+                this->children.emplace_back(new FakeChild);
+            }
+            for (auto &child : this->children) child->item = -1;
+        }
+        int n = (int)this->children.size();
+        for (int i = first; i < last; ++i) {
+            FakeChild &child = *this->children[i % n];
+            if (child.item != i) {
+                child.item = i;
+                ++this->prepareCount;
+            }
+        }
+    }
+};
+
+static const sw::Size viewportSize(1920, 1080);
+
+/**
+ * @brief 不虚拟化的布局，打开时需要创建、测量和安排所有子元素
+ */
+static void RunFull(const std::string &name, sw::LayoutHost &layout, int itemCount)
+{
+    bench::Sample open;
+
+    while (bench::NeedMorePasses(open)) {
+        bench::Probe probe;
+        FakeHost host;
+        for (int i = 0; i < itemCount; ++i) {
+            host.children.emplace_back(new FakeChild);
+        }
+        layout.Associate(&host);
+        layout.MeasureOverride(viewportSize);
+        layout.ArrangeOverride(viewportSize);
+        probe.AddTo(open);
+    }
+
+    bench::PrintOpsRow(name + " open " + std::to_string(itemCount), open, 1);
+    std::printf("%-34s %14d\n", "  containers", itemCount);
+}
+
+/**
+ * @brief 虚拟化的布局，分别测量打开（首次布局并创建容器）和每次滚动3行的耗时
+ */
+static void RunVirtualizing(const std::string &name, bool wrap, int itemCount)
+{
+    bench::Sample open, scroll;
+
+    sw::VirtualizingLayout layout;
+    layout.wrap        = wrap;
+    layout.orientation = wrap ? sw::Orientation::Horizontal : sw::Orientation::Vertical;
+    layout.itemSize    = sw::Size(200, 24);
+    layout.itemCount   = itemCount;
+
+    sw::Point offset;
+    layout.getViewportOffset = [&offset]() -> sw::Point {
+        return offset;
+    };
+
+    while (bench::NeedMorePasses(open)) {
+        bench::Probe probe;
+        FakeHost host;
+        layout.realizeItems = [&host](int first, int last) {
+            host.Realize(first, last);
+        };
+        layout.Associate(&host);
+        layout.MeasureOverride(viewportSize);
+        layout.ArrangeOverride(viewportSize);
+        probe.AddTo(open);
+    }
+
+    FakeHost host;
+    layout.realizeItems = [&host](int first, int last) {
+        host.Realize(first, last);
+    };
+    layout.Associate(&host);
+    layout.MeasureOverride(viewportSize);
+    layout.ArrangeOverride(viewportSize);
+
+    double extent     = layout.GetExtent(viewportSize).height - viewportSize.height;
+    host.prepareCount = 0;
+
+    while (bench::NeedMorePasses(scroll)) {
+        offset.y += 3 * layout.itemSize.height;
+        if (offset.y > extent) offset.y = 0;
+
+        bench::Probe probe;
+        layout.MeasureOverride(viewportSize);
+        layout.ArrangeOverride(viewportSize);
+        probe.AddTo(scroll);
+    }
+
+    bench::PrintOpsRow(name + " open " + std::to_string(itemCount), open, 1);
+    bench::PrintOpsRow(name + " scroll " + std::to_string(itemCount), scroll, 1);
+    std::printf("%-34s %14d\n", "  containers", host.GetChildLayoutCount());
+    std::printf("%-34s %14.1f\n", "  prepares per scroll", (double)host.prepareCount / scroll.passes);
+}
+
+int main(int argc, char *argv[])
+{
+    // 命令行参数为项的数量，默认测量1k、10k和100k
+    std::vector<int> itemCounts;
+    for (int i = 1; i < argc; ++i) {
+        int count = std::atoi(argv[i]);
+        if (count > 0) itemCounts.push_back(count);
+    }
+    if (itemCounts.empty()) {
+        itemCounts = {1000, 10000, 100000};
+    }
+
+    bench::PrintOpsHeader("virtualizing (ns per layout pass)");
+
+    for (int itemCount : itemCounts) {
+        sw::StackLayoutV stackLayout;
+        RunFull("StackLayoutV", stackLayout, itemCount);
+        RunVirtualizing("VirtualizingLayout (stack)", false, itemCount);
+
+        sw::WrapLayoutH wrapLayout;
+        RunFull("WrapLayoutH", wrapLayout, itemCount);
+        RunVirtualizing("VirtualizingLayout (wrap)", true, itemCount);
+    }
+    return 0;
+}
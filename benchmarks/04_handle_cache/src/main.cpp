@@ -0,0 +1,95 @@
+#include "Benchmark.hpp"
+#include "HandleCache.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 每次执行包含的操作数，相当于同时绘制的控件数
+ */
+static constexpr int OpsPerPass = 10000;
+
+/**
+ * @brief 模拟的句柄类型，0表示无效句柄
+ */
+using FakeHandle = uintptr_t;
+
+/**
+ * @brief 模拟的画刷缓存，以颜色为键
+ */
+using FakeBrushCache = sw::HandleCache<uint32_t, FakeHandle>;
+
+/**
+ * @brief 创建与销毁句柄的次数，用于与不使用缓存时的情况比较
+ */
+static uint64_t createCount  = 0;
+static uint64_t destroyCount = 0;
+
+/**
+ * @brief 创建模拟的句柄缓存
+ */
+static FakeBrushCache *MakeCache(size_t maxIdleCount)
+{
+    return new FakeBrushCache(
+        [](const uint32_t &color) -> FakeHandle {
+            ++createCount;
+            return (FakeHandle)color + 1;
+        },
+        [](FakeHandle handle) {
+            ++destroyCount;
+        },
+        maxIdleCount);
+}
+
+/**
+ * @brief 执行一个场景，colorFunc给出第i个控件的颜色，holdAll为true时所有控件同时持有画刷（WM_CTLCOLOR），否则每次绘制后立即释放（OnPaint）
+ */
+static void Run(const std::string &name, size_t maxIdleCount, bool holdAll, const std::function<uint32_t(int)> &colorFunc)
+{
+    FakeBrushCache *cache = MakeCache(maxIdleCount);
+    std::vector<FakeHandle> handles(OpsPerPass);
+    bench::Sample sample;
+
+    createCount = destroyCount = 0;
+
+    while (bench::NeedMorePasses(sample)) {
+        bench::Probe probe;
+        for (int i = 0; i < OpsPerPass; ++i) {
+            FakeHandle handle = cache->Acquire(colorFunc(i));
+            if (holdAll) {
+                handles[i] = handle;
+            } else {
+                cache->Release(handle);
+            }
+        }
+        if (holdAll) {
+            for (FakeHandle handle : handles) cache->Release(handle);
+        }
+        probe.AddTo(sample);
+    }
+
+    sw::HandleCacheStats stats = cache->GetStats();
+    uint64_t total             = stats.hits + stats.misses;
+
+    bench::PrintOpsRow(name, sample, OpsPerPass);
+    std::printf("  hit rate %.4f, creates %llu, destroys %llu, live %zu, idle %zu (without cache: %llu creates)\n",
+                total ? (double)stats.hits / total : 0.0,
+                (unsigned long long)createCount, (unsigned long long)destroyCount,
+                stats.liveHandles, stats.idleHandles, (unsigned long long)total);
+
+    delete cache;
+}
+
+int main()
+{
+    bench::PrintOpsHeader("handle cache (per acquire/release)");
+
+    Run("paint, 1 color", 64, false, [](int i) -> uint32_t { return 0xf0f0f0; });
+    Run("paint, 8 colors", 64, false, [](int i) -> uint32_t { return (uint32_t)(i % 8); });
+    Run("ctlcolor, 8 colors held", 64, true, [](int i) -> uint32_t { return (uint32_t)(i % 8); });
+    Run("paint, 100 colors, idle 64 (LRU)", 64, false, [](int i) -> uint32_t { return (uint32_t)(i % 100); });
+    Run("paint, 100 colors, idle 128", 128, false, [](int i) -> uint32_t { return (uint32_t)(i % 100); });
+    Run("paint, 1 color, idle 0", 0, false, [](int i) -> uint32_t { return 0xf0f0f0; });
+    return 0;
+}
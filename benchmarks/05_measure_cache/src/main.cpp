@@ -0,0 +1,176 @@
+#include "Benchmark.hpp"
+#include "GridLayout.h"
+#include "MeasureCache.h"
+#include "StackLayoutV.h"
+#include "WrapLayoutH.h"
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Measure与MeasureOverride的调用次数
+ */
+static uint64_t measureCount  = 0;
+static uint64_t overrideCount = 0;
+
+/**
+ * @brief 模拟的元素，按照与UIElement::Measure相同的规则使用测量缓存
+ */
+class FakeElement : public sw::ILayout
+{
+public:
+    bool multiEntry = true; // 为true时使用MeasureCache，否则模拟只记录一次结果的旧实现
+    bool invalidated = true;
+    uint64_t layoutTag = 0;
+    sw::Size size{};
+    sw::Size desireSize{};
+    sw::Size lastAvailableSize{};
+    sw::MeasureCache cache{};
+    std::unique_ptr<sw::LayoutHost> layout;
+    std::vector<std::unique_ptr<FakeElement>> children;
+
+    virtual uint64_t GetLayoutTag() override { return this->layoutTag; }
+    virtual int GetChildLayoutCount() override { return (int)this->children.size(); }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return *this->children[index]; }
+    virtual sw::Size GetDesireSize() override { return this->desireSize; }
+
+    virtual void Measure(const sw::Size &availableSize) override
+    {
+        ++measureCount;
+
+        if (this->multiEntry) {
+            if (this->cache.TryGet(availableSize, this->desireSize)) return;
+        } else {
+            if (!this->invalidated && this->lastAvailableSize == availableSize) return;
+        }
+
+        ++overrideCount;
+        this->desireSize        = this->layout ? this->layout->MeasureOverride(availableSize) : this->size;
+        this->lastAvailableSize = availableSize;
+        if (this->multiEntry) this->cache.Add(availableSize, this->desireSize);
+    }
+
+    virtual void Arrange(const sw::Rect &finalPosition) override
+    {
+        this->invalidated = false;
+        if (this->layout) this->layout->ArrangeOverride(finalPosition.GetSize());
+    }
+
+    /**
+     * @brief 使当前元素的布局失效，相当于InvalidateMeasure
+     */
+    void Invalidate()
+    {
+        this->invalidated = true;
+        this->cache.Clear();
+    }
+
+    /**
+     * @brief 添加一个子元素
+     */
+    FakeElement &Add(FakeElement *child)
+    {
+        child->multiEntry = this->multiEntry;
+        this->children.emplace_back(child);
+        return *child;
+    }
+};
+
+/**
+ * @brief 创建一个包含4个叶子元素的StackLayoutV元素，模拟表单中的一个单元格
+ */
+static FakeElement *MakeCell(bool multiEntry, int index)
+{
+    FakeElement *cell = new FakeElement;
+    cell->multiEntry  = multiEntry;
+    cell->layout.reset(new sw::StackLayoutV);
+    cell->layout->Associate(cell);
+    for (int i = 0; i < 4; ++i) {
+        FakeElement &leaf = cell->Add(new FakeElement);
+        leaf.size         = sw::Size(40 + (index * 7 + i * 13) % 60, 18);
+    }
+    return cell;
+}
+
+/**
+ * @brief 一个测量场景，root为根元素，每次执行使根元素失效后重新布局
+ */
+static void Run(const char *name, FakeElement &root, const sw::Size &rootSize)
+{
+    bench::Sample sample;
+
+    // 首次布局，所有元素都需要测量
+    root.Measure(rootSize);
+    root.Arrange(sw::Rect(0, 0, rootSize.width, rootSize.height));
+
+    measureCount = overrideCount = 0;
+
+    while (bench::NeedMorePasses(sample)) {
+        bench::Probe probe;
+        root.Invalidate();
+        root.Measure(rootSize);
+        root.Arrange(sw::Rect(0, 0, rootSize.width, rootSize.height));
+        probe.AddTo(sample);
+    }
+
+    bench::PrintOpsRow(name, sample, 1);
+    std::printf("  measure calls/pass %.0f, MeasureOverride calls/pass %.0f, hit rate %.3f\n",
+                (double)measureCount / sample.passes, (double)overrideCount / sample.passes,
+                measureCount ? 1.0 - (double)overrideCount / measureCount : 0.0);
+}
+
+/**
+ * @brief 创建rowCount行4列AutoSize的Grid，每个单元格为MakeCell创建的元素
+ */
+static FakeElement *MakeGridRoot(bool multiEntry, int rowCount)
+{
+    auto root        = new FakeElement;
+    root->multiEntry = multiEntry;
+
+    auto grid = new sw::GridLayout;
+    for (int i = 0; i < rowCount; ++i) grid->rows.Append(sw::AutoSizeGridRow());
+    for (int j = 0; j < 4; ++j) grid->columns.Append(sw::AutoSizeGridColumn());
+    root->layout.reset(grid);
+    root->layout->Associate(root);
+
+    for (int i = 0; i < rowCount * 4; ++i) {
+        FakeElement &cell = root->Add(MakeCell(multiEntry, i));
+        cell.layoutTag    = sw::GridLayoutTag(i / 4, i % 4);
+    }
+    return root;
+}
+
+/**
+ * @brief 创建count个单元格的WrapLayoutH
+ */
+static FakeElement *MakeWrapRoot(bool multiEntry, int count)
+{
+    auto root        = new FakeElement;
+    root->multiEntry = multiEntry;
+    root->layout.reset(new sw::WrapLayoutH);
+    root->layout->Associate(root);
+
+    for (int i = 0; i < count; ++i) {
+        root->Add(MakeCell(multiEntry, i));
+    }
+    return root;
+}
+
+int main(int argc, char *argv[])
+{
+    int rowCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000;
+
+    bench::PrintOpsHeader("measure cache (per root relayout)");
+
+    for (bool multiEntry : {false, true}) {
+        std::unique_ptr<FakeElement> grid(MakeGridRoot(multiEntry, rowCount));
+        Run(multiEntry ? "Grid AutoSize, MeasureCache" : "Grid AutoSize, single entry", *grid, sw::Size(1920, 1080));
+    }
+
+    for (bool multiEntry : {false, true}) {
+        std::unique_ptr<FakeElement> wrap(MakeWrapRoot(multiEntry, rowCount * 4));
+        Run(multiEntry ? "WrapLayoutH, MeasureCache" : "WrapLayoutH, single entry", *wrap, sw::Size(1920, 1080));
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include "Benchmark.hpp"
+#include "CanvasLayout.h"
+#include "SpatialIndex.h"
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 模拟的Canvas子元素，布局标记中记录其位置
+ */
+class FakeChild : public sw::ILayout
+{
+public:
+    sw::CanvasLayoutTag tag{};
+    sw::Size size{};
+    sw::Size desireSize{};
+
+    virtual uint64_t GetLayoutTag() override { return this->tag; }
+    virtual int GetChildLayoutCount() override { return 0; }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return *this; }
+    virtual sw::Size GetDesireSize() override { return this->desireSize; }
+    virtual void Measure(const sw::Size &availableSize) override { this->desireSize = this->size; }
+    virtual void Arrange(const sw::Rect &finalPosition) override {}
+};
+
+/**
+ * @brief 模拟的Canvas
+ */
+class FakeCanvas : public sw::ILayout
+{
+public:
+    std::vector<std::unique_ptr<FakeChild>> children;
+
+    virtual uint64_t GetLayoutTag() override { return 0; }
+    virtual int GetChildLayoutCount() override { return (int)this->children.size(); }
+    virtual sw::ILayout &GetChildLayoutAt(int index) override { return *this->children[index]; }
+    virtual sw::Size GetDesireSize() override { return sw::Size(); }
+    virtual void Measure(const sw::Size &availableSize) override {}
+    virtual void Arrange(const sw::Rect &finalPosition) override {}
+};
+
+static const sw::Size viewportSize(1920, 1080);
+
+/**
+ * @brief 在边长为extent的正方形区域中随机生成count个矩形，尺寸与常见控件相近
+ */
+static std::vector<sw::Rect> MakeRects(int count, double extent)
+{
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<double> pos(0, extent);
+    std::uniform_real_distribution<double> width(40, 240);
+    std::uniform_real_distribution<double> height(20, 60);
+
+    std::vector<sw::Rect> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        result.emplace_back(pos(random), pos(random), width(random), height(random));
+    }
+    return result;
+}
+
+/**
+ * @brief 生成查询用的随机点
+ */
+static std::vector<sw::Point> MakePoints(int count, double extent)
+{
+    std::mt19937 random(54321);
+    std::uniform_real_distribution<double> pos(0, extent);
+
+    std::vector<sw::Point> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        result.emplace_back(pos(random), pos(random));
+    }
+    return result;
+}
+
+/**
+ * @brief 逐个判断的命中测试，相当于未使用索引时的实现
+ */
+static int LinearHitTest(const std::vector<sw::Rect> &rects, const sw::Point &point)
+{
+    for (int i = (int)rects.size() - 1; i >= 0; --i) {
+        const sw::Rect &rect = rects[i];
+        if (point.x >= rect.left && point.x < rect.left + rect.width &&
+            point.y >= rect.top && point.y < rect.top + rect.height) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 逐个判断的矩形查询
+ */
+static void LinearQueryRect(const std::vector<sw::Rect> &rects, const sw::Rect &query, std::vector<int> &result)
+{
+    result.clear();
+    for (int i = 0; i < (int)rects.size(); ++i) {
+        const sw::Rect &rect = rects[i];
+        if (rect.left < query.left + query.width && query.left < rect.left + rect.width &&
+            rect.top < query.top + query.height && query.top < rect.top + rect.height) {
+            result.push_back(i);
+        }
+    }
+}
+
+/**
+ * @brief  将索引的查询结果与逐个判断的结果对比，不一致时输出错误
+ * @return 结果是否全部一致
+ */
+static bool Verify(const std::string &name, const sw::SpatialIndex &index,
+                   const std::vector<sw::Rect> &rects, const std::vector<sw::Point> &points)
+{
+    std::vector<int> expected, actual;
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const sw::Point &p = points[i];
+
+        if (index.HitTest(p) != LinearHitTest(rects, p)) {
+            std::fprintf(stderr, "%s: HitTest mismatch at (%g, %g)\n", name.c_str(), p.x, p.y);
+            return false;
+        }
+
+        // 以不同大小的矩形查询，覆盖按网格查询与直接遍历两条路径
+        double size = (i % 3 == 0) ? 1.0 : (i % 3 == 1) ? 300.0 : 5000.0;
+        sw::Rect query(p.x, p.y, size, size);
+        LinearQueryRect(rects, query, expected);
+        index.QueryRect(query, actual);
+        if (actual != expected) {
+            std::fprintf(stderr, "%s: QueryRect mismatch at (%g, %g, %g, %g)\n", name.c_str(), query.left, query.top, query.width, query.height);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief  直接测量SpatialIndex的建立、更新与查询
+ * @return 索引的查询结果是否与逐个判断的结果一致
+ */
+static bool RunIndex(int count)
+{
+    const int queryCount = 1000;
+    std::string suffix   = " " + std::to_string(count);
+
+    // 保持元素密度大致不变，区域随元素数量增大
+    double extent                 = 40.0 * std::sqrt((double)count) * 4;
+    std::vector<sw::Rect> rects   = MakeRects(count, extent);
+    std::vector<sw::Point> points = MakePoints(queryCount, extent);
+
+    bench::Sample build, update;
+    sw::SpatialIndex index;
+
+    while (bench::NeedMorePasses(build)) {
+        bench::Probe probe;
+        sw::SpatialIndex temp;
+        for (int i = 0; i < count; ++i) temp.Update(i, rects[i]);
+        probe.AddTo(build);
+    }
+
+    for (int i = 0; i < count; ++i) index.Update(i, rects[i]);
+
+    // 测量前先确认结果正确，包括改变网格尺寸之后
+    bool ok = Verify("SpatialIndex" + suffix, index, rects, points);
+    for (double cellSize : {32.0, 1000.0, index.GetCellSize()}) {
+        index.SetCellSize(cellSize);
+        ok = ok && Verify("SpatialIndex cell " + std::to_string((int)cellSize) + suffix, index, rects, points);
+    }
+
+    while (bench::NeedMorePasses(update)) {
+        bench::Probe probe;
+        for (int i = 0; i < count; ++i) index.Update(i, rects[i]);
+        probe.AddTo(update);
+    }
+
+    bench::Sample linearHit, indexHit;
+    volatile int sink = 0;
+
+    while (bench::NeedMorePasses(linearHit)) {
+        bench::Probe probe;
+        for (const sw::Point &point : points) sink = sink + LinearHitTest(rects, point);
+        probe.AddTo(linearHit);
+    }
+    while (bench::NeedMorePasses(indexHit)) {
+        bench::Probe probe;
+        for (const sw::Point &point : points) sink = sink + index.HitTest(point);
+        probe.AddTo(indexHit);
+    }
+
+    bench::Sample linearQuery, indexQuery;
+    std::vector<int> result;
+    size_t found = 0;
+
+    while (bench::NeedMorePasses(linearQuery)) {
+        bench::Probe probe;
+        for (int i = 0; i < 100; ++i) {
+            const sw::Point &p = points[i];
+            LinearQueryRect(rects, sw::Rect(p.x, p.y, viewportSize.width, viewportSize.height), result);
+        }
+        probe.AddTo(linearQuery);
+    }
+    while (bench::NeedMorePasses(indexQuery)) {
+        bench::Probe probe;
+        found = 0;
+        for (int i = 0; i < 100; ++i) {
+            const sw::Point &p = points[i];
+            index.QueryRect(sw::Rect(p.x, p.y, viewportSize.width, viewportSize.height), result);
+            found += result.size();
+        }
+        probe.AddTo(indexQuery);
+    }
+
+    bench::PrintOpsRow("SpatialIndex build" + suffix, build, 1);
+    bench::PrintOpsRow("SpatialIndex update (unchanged)" + suffix, update, 1);
+    bench::PrintOpsRow("linear HitTest" + suffix, linearHit, queryCount);
+    bench::PrintOpsRow("SpatialIndex HitTest" + suffix, indexHit, queryCount);
+    bench::PrintOpsRow("linear QueryRect viewport" + suffix, linearQuery, 100);
+    bench::PrintOpsRow("SpatialIndex QueryRect viewport" + suffix, indexQuery, 100);
+    std::printf("%-34s %14.1f\n", "  items per viewport", (double)found / 100);
+    return ok;
+}
+
+/**
+ * @brief  测量CanvasLayout安排子元素（同时更新索引）的耗时及命中测试
+ * @return 命中测试的结果是否与逐个判断的结果一致
+ */
+static bool RunCanvas(int count)
+{
+    const int queryCount = 1000;
+    std::string suffix   = " " + std::to_string(count);
+
+    double extent                 = 40.0 * std::sqrt((double)count) * 4;
+    std::vector<sw::Rect> rects   = MakeRects(count, extent);
+    std::vector<sw::Point> points = MakePoints(queryCount, extent);
+
+    FakeCanvas canvas;
+    for (const sw::Rect &rect : rects) {
+        FakeChild *child = new FakeChild;
+        child->tag       = sw::CanvasLayoutTag((float)rect.left, (float)rect.top);
+        child->size      = rect.GetSize();
+        canvas.children.emplace_back(child);
+    }
+
+    sw::CanvasLayout layout;
+    layout.Associate(&canvas);
+    layout.MeasureOverride(viewportSize);
+    layout.ArrangeOverride(viewportSize);
+
+    // 布局标记以float记录位置，对比时使用相同精度的矩形
+    std::vector<sw::Rect> arranged;
+    for (const sw::Rect &rect : rects) {
+        arranged.emplace_back((float)rect.left, (float)rect.top, rect.width, rect.height);
+    }
+
+    bool ok = true;
+    for (const sw::Point &point : points) {
+        if (layout.HitTest(point) != LinearHitTest(arranged, point)) {
+            std::fprintf(stderr, "CanvasLayout%s: HitTest mismatch at (%g, %g)\n", suffix.c_str(), point.x, point.y);
+            ok = false;
+            break;
+        }
+    }
+
+    bench::Sample arrange, hitTest;
+    volatile int sink = 0;
+
+    while (bench::NeedMorePasses(arrange)) {
+        bench::Probe probe;
+        layout.MeasureOverride(viewportSize);
+        layout.ArrangeOverride(viewportSize);
+        probe.AddTo(arrange);
+    }
+    while (bench::NeedMorePasses(hitTest)) {
+        bench::Probe probe;
+        for (const sw::Point &point : points) sink = sink + layout.HitTest(point);
+        probe.AddTo(hitTest);
+    }
+
+    bench::PrintOpsRow("CanvasLayout relayout" + suffix, arrange, 1);
+    bench::PrintOpsRow("CanvasLayout HitTest" + suffix, hitTest, queryCount);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    // 命令行参数为项的数量，默认测量1k、10k和100k
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i) {
+        int count = std::atoi(argv[i]);
+        if (count > 0) counts.push_back(count);
+    }
+    if (counts.empty()) {
+        counts = {1000, 10000, 100000};
+    }
+
+    bench::PrintOpsHeader("spatial index (ns per operation)");
+
+    // 查询结果与逐个判断不一致时以非零值退出
+    bool ok = true;
+    for (int count : counts) {
+        ok = RunIndex(count) && ok;
+        ok = RunCanvas(count) && ok;
+    }
+    return ok ? 0 : 1;
+}
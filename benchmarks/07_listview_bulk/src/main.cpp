@@ -0,0 +1,135 @@
+#include "Benchmark.hpp"
+#include "SimpleWindow.h"
+#include <cstdlib>
+#include <string>
+
+/**
+ * @brief 列数
+ */
+static constexpr int ColumnCount = 4;
+
+/**
+ * @brief 测量插入前预先添加的行数，使插入的行位于已有行之前
+ */
+static constexpr int PrefillCount = 1000;
+
+/**
+ * @brief 处理消息队列中的所有消息，使重绘等延迟的工作计入耗时
+ */
+static void PumpMessages()
+{
+    MSG msg;
+    while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+}
+
+/**
+ * @brief 生成列形式的数据，columns[j][i]为第i行第j列
+ */
+static sw::List<sw::StrList> MakeColumns(int rowCount)
+{
+    sw::List<sw::StrList> columns;
+    for (int j = 0; j < ColumnCount; ++j) {
+        sw::StrList column;
+        for (int i = 0; i < rowCount; ++i) {
+            column.Append(L"R" + std::to_wstring(i) + L"C" + std::to_wstring(j));
+        }
+        columns.Append(column);
+    }
+    return columns;
+}
+
+/**
+ * @brief 清空列表并重新添加预先填充的行
+ */
+static void Reset(sw::ListView &listView, const sw::List<sw::StrList> &prefill)
+{
+    listView.Clear();
+    if (prefill.Count() > 0) {
+        listView.AddItems(prefill);
+    }
+    PumpMessages();
+}
+
+/**
+ * @brief 逐行添加或插入，每行需要先构造一个StrList
+ * @param insert 为true时从索引0开始逐行插入，否则逐行添加到末尾
+ */
+static void MeasurePerRow(bench::Sample &sample, sw::ListView &listView, const sw::List<sw::StrList> &columns,
+                          const sw::List<sw::StrList> &prefill, int rowCount, bool insert)
+{
+    while (bench::NeedMorePasses(sample, 3, 0)) {
+        Reset(listView, prefill);
+
+        bench::Probe probe;
+        for (int i = 0; i < rowCount; ++i) {
+            sw::StrList row;
+            for (int j = 0; j < ColumnCount; ++j) row.Append(columns[j][i]);
+            if (insert) {
+                listView.InsertItem(i, row);
+            } else {
+                listView.AddItem(row);
+            }
+        }
+        PumpMessages();
+        probe.AddTo(sample);
+    }
+}
+
+/**
+ * @brief 通过AddItems或InsertItems一次添加或插入所有行
+ * @param insert 为true时插入到索引0处，否则添加到末尾
+ */
+static void MeasureBulk(bench::Sample &sample, sw::ListView &listView, const sw::List<sw::StrList> &columns,
+                        const sw::List<sw::StrList> &prefill, bool insert)
+{
+    while (bench::NeedMorePasses(sample, 3, 0)) {
+        Reset(listView, prefill);
+
+        bench::Probe probe;
+        if (insert) {
+            listView.InsertItems(0, columns);
+        } else {
+            listView.AddItems(columns);
+        }
+        PumpMessages();
+        probe.AddTo(sample);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int rowCount = argc > 1 ? sw::Utils::Max(1, std::atoi(argv[1])) : 100000;
+
+    sw::Window window;
+    sw::ListView listView;
+    listView.HorizontalAlignment = sw::HorizontalAlignment::Stretch;
+    listView.VerticalAlignment   = sw::VerticalAlignment::Stretch;
+    for (int j = 0; j < ColumnCount; ++j) {
+        listView.AddColumn(L"Column " + std::to_wstring(j));
+    }
+    window.AddChild(listView);
+    window.Show();
+    PumpMessages();
+
+    sw::List<sw::StrList> columns = MakeColumns(rowCount);
+    sw::List<sw::StrList> prefill = MakeColumns(PrefillCount);
+    sw::List<sw::StrList> empty;
+
+    bench::Sample perRowAdd, bulkAdd, perRowInsert, bulkInsert;
+    MeasurePerRow(perRowAdd, listView, columns, empty, rowCount, false);
+    MeasureBulk(bulkAdd, listView, columns, empty, false);
+    MeasurePerRow(perRowInsert, listView, columns, prefill, rowCount, true);
+    MeasureBulk(bulkInsert, listView, columns, prefill, true);
+
+    std::string rows = std::to_string(rowCount);
+
+    bench::PrintOpsHeader("ListView population (ns per row)");
+    bench::PrintOpsRow("AddItem per row " + rows, perRowAdd, rowCount);
+    bench::PrintOpsRow("AddItems " + rows, bulkAdd, rowCount);
+    bench::PrintOpsRow("InsertItem per row " + rows, perRowInsert, rowCount);
+    bench::PrintOpsRow("InsertItems " + rows, bulkInsert, rowCount);
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include "Benchmark.hpp"
+#include "DispatchQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 模拟界面线程的唤醒消息，Wake相当于PostMessage，Wait相当于GetMessage
+ */
+class FakeMessageQueue
+{
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    uint64_t _pending = 0;
+
+public:
+    std::atomic<uint64_t> posted{0};
+
+    void Wake()
+    {
+        ++this->posted;
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            ++this->_pending;
+        }
+        this->_cv.notify_one();
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        this->_cv.wait(lock, [this] { return this->_pending != 0; });
+        --this->_pending;
+    }
+};
+
+/**
+ * @brief 消费者记录的执行情况，只在消费者线程中访问
+ */
+struct ConsumerState {
+    std::vector<int> lastSeq; // 每个生产者每个优先级最近执行的序号
+    uint64_t executed   = 0;
+    uint64_t outOfOrder = 0;
+};
+
+/**
+ * @brief 生产者添加的回调的优先级，大部分为Render，少量为Input和Background
+ */
+static sw::DispatchPriority GetPriority(int seq)
+{
+    if (seq % 7 == 0) return sw::DispatchPriority::Input;
+    if (seq % 5 == 0) return sw::DispatchPriority::Background;
+    return sw::DispatchPriority::Render;
+}
+
+/**
+ * @brief 多个生产者同时向DispatchQueue添加回调，消费者在收到唤醒后分批执行，并检查每个生产者的回调是否按顺序执行
+ */
+static bool RunDispatchQueue(const std::string &name, size_t capacity, int producerCount, int perProducer)
+{
+    bench::Sample sample;
+    uint64_t posted = 0, outOfOrder = 0, missing = 0;
+
+    while (bench::NeedMorePasses(sample)) {
+        sw::DispatchQueue queue(capacity);
+        FakeMessageQueue messages;
+        ConsumerState state;
+        state.lastSeq.assign(producerCount * sw::DispatchQueue::PriorityCount, -1);
+
+        uint64_t total = (uint64_t)producerCount * perProducer;
+
+        bench::Probe probe;
+
+        std::thread consumer([&] {
+            while (state.executed < total) {
+                messages.Wait();
+                for (;;) {
+                    queue.Run(1.0);
+                    if (queue.HasPending()) {
+                        // 超出时间预算，相当于重新投递唤醒消息
+                        continue;
+                    }
+                    if (queue.EndRun()) messages.Wake();
+                    break;
+                }
+            }
+        });
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < perProducer; ++i) {
+                    sw::DispatchPriority priority = GetPriority(i);
+                    ConsumerState *s             = &state;
+                    int slot                     = p * sw::DispatchQueue::PriorityCount + (int)priority;
+                    bool wake                    = queue.Enqueue(
+                        [s, slot, i] {
+                            if (s->lastSeq[slot] >= i) ++s->outOfOrder;
+                            s->lastSeq[slot] = i;
+                            ++s->executed;
+                        },
+                        priority);
+                    if (wake) messages.Wake();
+                }
+            });
+        }
+
+        for (std::thread &t : producers) t.join();
+        consumer.join();
+
+        probe.AddTo(sample);
+
+        posted += messages.posted;
+        outOfOrder += state.outOfOrder;
+        missing += total - state.executed;
+    }
+
+    int ops = producerCount * perProducer;
+    bench::PrintOpsRow(name, sample, ops);
+    std::printf("  wake-ups/op %.4f, out of order %llu, missing %llu\n",
+                (double)posted / sample.passes / ops,
+                (unsigned long long)outOfOrder, (unsigned long long)missing);
+    return outOfOrder == 0 && missing == 0;
+}
+
+/**
+ * @brief 对照组：加锁的std::deque<std::function>，每添加一个回调唤醒一次，相当于每次调用都PostMessage
+ */
+static void RunMutexQueue(const std::string &name, int producerCount, int perProducer)
+{
+    bench::Sample sample;
+
+    while (bench::NeedMorePasses(sample)) {
+        std::mutex mutex;
+        std::deque<std::function<void()>> queue;
+        FakeMessageQueue messages;
+        uint64_t executed = 0;
+        uint64_t total    = (uint64_t)producerCount * perProducer;
+
+        bench::Probe probe;
+
+        std::thread consumer([&] {
+            while (executed < total) {
+                messages.Wait();
+                std::function<void()> f;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (queue.empty()) continue;
+                    f = std::move(queue.front());
+                    queue.pop_front();
+                }
+                f();
+            }
+        });
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; ++p) {
+            producers.emplace_back([&] {
+                for (int i = 0; i < perProducer; ++i) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        queue.emplace_back([&executed] { ++executed; });
+                    }
+                    messages.Wake();
+                }
+            });
+        }
+
+        for (std::thread &t : producers) t.join();
+        consumer.join();
+
+        probe.AddTo(sample);
+    }
+
+    bench::PrintOpsRow(name, sample, producerCount * perProducer);
+}
+
+int main(int argc, char *argv[])
+{
+    // 命令行参数为每个生产者添加的回调数
+    int perProducer = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (perProducer <= 0) perProducer = 100000;
+
+    bench::PrintOpsHeader("dispatch queue (ns per callback)");
+
+    // 有回调乱序或丢失时以非零值退出
+    bool ok = true;
+    for (int producerCount : {1, 4, 8}) {
+        std::string suffix = " x" + std::to_string(producerCount);
+        RunMutexQueue("mutex + deque, wake per call" + suffix, producerCount, perProducer);
+        ok = RunDispatchQueue("DispatchQueue" + suffix, sw::DispatchQueue::DefaultCapacity, producerCount, perProducer) && ok;
+        ok = RunDispatchQueue("DispatchQueue, capacity 1M" + suffix, 1 << 20, producerCount, perProducer) && ok;
+        // 容量很小时大部分回调进入溢出队列，用于检查溢出路径的顺序
+        ok = RunDispatchQueue("DispatchQueue, capacity 16" + suffix, 16, producerCount, perProducer) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+#include "Benchmark.hpp"
+#include "TimerWheel.h"
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 压力测试中每个定时器的期望状态
+ */
+struct ModelTimer {
+    sw::TimerWheel::TimerId id = 0;
+    bool active                = false;
+    uint64_t due               = 0; // 名义上的下一次到期时间
+    uint64_t period            = 0;
+    uint64_t tolerance         = 0;
+    uint64_t fired             = 0;
+};
+
+/**
+ * @brief 压力测试的状态，回调中随机启动、停止、销毁和创建定时器，并与期望状态比较
+ */
+class Stress
+{
+public:
+    sw::TimerWheel wheel;
+    std::vector<ModelTimer> timers;
+    std::mt19937_64 random{20240601};
+    uint64_t fired  = 0;
+    uint64_t early  = 0; // 早于名义到期时间触发的次数
+    uint64_t late   = 0; // 晚于名义到期时间加容差触发的次数
+    uint64_t stray  = 0; // 已停止的定时器触发的次数
+    uint64_t missed = 0; // 到期后未触发的次数
+
+    explicit Stress(int count)
+    {
+        this->timers.resize(count);
+        for (int i = 0; i < count; ++i) {
+            this->Create(i);
+            this->RandomStart(i);
+        }
+    }
+
+    void Create(int index)
+    {
+        this->timers[index].id = this->wheel.Create([this, index] { this->OnFire(index); });
+    }
+
+    void RandomStart(int index)
+    {
+        ModelTimer &t = this->timers[index];
+        uint64_t now  = this->wheel.GetNow();
+        uint64_t r    = this->random() % 100;
+
+        // 大部分为几毫秒到几秒的定时器，少量跨越多层甚至超出时间轮范围
+        uint64_t delay = r < 60 ? this->random() % 200 : (r < 95 ? this->random() % 20000 : this->random() % (uint64_t(3) << 30));
+        t.period       = this->random() % 3 == 0 ? 0 : 1 + this->random() % 1000;
+        t.tolerance    = this->random() % 2 == 0 ? 0 : this->random() % 64;
+        t.due          = now + delay;
+        t.active       = true;
+        this->wheel.Start(t.id, t.due, t.period, t.tolerance);
+    }
+
+    void OnFire(int index)
+    {
+        ModelTimer &t = this->timers[index];
+        uint64_t now  = this->wheel.GetNow();
+
+        ++this->fired;
+        ++t.fired;
+        if (!t.active) {
+            ++this->stray;
+            return;
+        }
+        if (now < t.due) ++this->early;
+        if (now > t.due + t.tolerance) ++this->late;
+
+        if (t.period == 0) {
+            t.active = false;
+        } else {
+            t.due += t.period;
+            if (t.due <= now) t.due = now + t.period;
+        }
+
+        // 回调中修改定时器
+        switch (this->random() % 16) {
+            case 0: { // 停止其他定时器
+                int other = (int)(this->random() % this->timers.size());
+                this->wheel.Stop(this->timers[other].id);
+                this->timers[other].active = false;
+                break;
+            }
+            case 1: { // 重新启动其他定时器
+                this->RandomStart((int)(this->random() % this->timers.size()));
+                break;
+            }
+            case 2: { // 销毁自身并创建新的定时器，回调执行完毕后才析构
+                this->wheel.Destroy(t.id);
+                t.active = false;
+                this->Create(index);
+                this->RandomStart(index);
+                break;
+            }
+            case 3: { // 重新启动自身
+                this->RandomStart(index);
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief 检查已启动的定时器是否都尚未超过最晚到期时间
+     */
+    void CheckMissed()
+    {
+        uint64_t now = this->wheel.GetNow();
+        for (ModelTimer &t : this->timers) {
+            if (t.active && t.due + t.tolerance < now) {
+                ++this->missed;
+                t.active = false;
+                this->wheel.Stop(t.id);
+            }
+        }
+    }
+};
+
+/**
+ * @brief  以模拟的时钟运行压力测试，时钟每次前进随机的步长
+ * @return 是否所有定时器都在到期时间与到期时间加容差之间触发
+ */
+static bool RunStress(int count, uint64_t duration)
+{
+    Stress stress(count);
+    std::mt19937 random(7);
+
+    uint64_t now = 0;
+    int checks   = 0;
+    while (now < duration) {
+        now += random() % 40;
+        stress.wheel.Advance(now);
+        if (++checks % 64 == 0) stress.CheckMissed();
+    }
+    // 跳过很长的时间，检查跨越多层的定时器
+    stress.wheel.Advance(now + (uint64_t(4) << 30));
+    stress.CheckMissed();
+
+    std::printf("stress %d timers, %llu ms simulated: fired %llu, early %llu, late %llu, stray %llu, missed %llu\n",
+                count, (unsigned long long)duration,
+                (unsigned long long)stress.fired, (unsigned long long)stress.early, (unsigned long long)stress.late,
+                (unsigned long long)stress.stray, (unsigned long long)stress.missed);
+
+    bool ok = stress.early == 0 && stress.late == 0 && stress.stray == 0 && stress.missed == 0;
+    if (!ok) {
+        std::fprintf(stderr, "stress %d timers: timers fired outside [due, due + tolerance]\n", count);
+    }
+    return ok;
+}
+
+/**
+ * @brief 启动后立即停止定时器的开销
+ */
+static void RunStartStop(int count)
+{
+    std::mt19937 random(1);
+    std::vector<uint64_t> delays(count);
+    for (uint64_t &d : delays) d = 1 + random() % 60000;
+
+    {
+        sw::TimerWheel wheel;
+        std::vector<sw::TimerWheel::TimerId> ids(count);
+        for (auto &id : ids) id = wheel.Create([] {});
+
+        bench::Sample sample;
+        while (bench::NeedMorePasses(sample)) {
+            bench::Probe probe;
+            for (int i = 0; i < count; ++i) wheel.Start(ids[i], delays[i]);
+            for (int i = 0; i < count; ++i) wheel.Stop(ids[i]);
+            probe.AddTo(sample);
+        }
+        bench::PrintOpsRow("TimerWheel start + stop", sample, count);
+    }
+
+    {
+        // 对照组：以到期时间为键的std::multimap，停止时通过保存的迭代器删除
+        std::multimap<uint64_t, int> queue;
+        std::vector<std::multimap<uint64_t, int>::iterator> its(count);
+
+        bench::Sample sample;
+        while (bench::NeedMorePasses(sample)) {
+            bench::Probe probe;
+            for (int i = 0; i < count; ++i) its[i] = queue.emplace(delays[i], i);
+            for (int i = 0; i < count; ++i) queue.erase(its[i]);
+            probe.AddTo(sample);
+        }
+        bench::PrintOpsRow("std::multimap insert + erase", sample, count);
+    }
+}
+
+/**
+ * @brief 模拟定时器服务：每次唤醒时将时钟设为GetNextExpiry返回的时间并执行到期的定时器，统计唤醒次数
+ */
+static void RunService(int count, uint64_t tolerance)
+{
+    static const uint64_t periods[] = {100, 250, 500, 1000};
+
+    uint64_t duration = 10000;
+    uint64_t fired    = 0;
+    uint64_t wakes    = 0;
+
+    bench::Sample sample;
+    while (bench::NeedMorePasses(sample)) {
+        sw::TimerWheel wheel;
+        std::mt19937 random(3);
+        for (int i = 0; i < count; ++i) {
+            auto id = wheel.Create([&fired] { ++fired; });
+            // 常见的刷新周期，起始相位随机
+            uint64_t period = periods[random() % 4];
+            wheel.Start(id, 1 + random() % period, period, tolerance);
+        }
+
+        fired = 0;
+        wakes = 0;
+
+        bench::Probe probe;
+        uint64_t next;
+        while (wheel.GetNextExpiry(next) && next <= duration) {
+            wheel.Advance(next);
+            ++wakes;
+        }
+        probe.AddTo(sample);
+    }
+
+    std::string name = std::to_string(count) + " timers, tolerance " + std::to_string(tolerance);
+    bench::PrintOpsRow(name, sample, (int)fired);
+    std::printf("  callbacks %llu, native wake-ups per second %.1f\n",
+                (unsigned long long)fired, wakes * 1000.0 / duration);
+}
+
+int main(int argc, char *argv[])
+{
+    // 命令行参数为压力测试的定时器数
+    int count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (count <= 0) count = 2000;
+
+    // 压力测试中有定时器未按时触发时以非零值退出
+    bool ok = RunStress(count, 120000);
+
+    bench::PrintOpsHeader("start/stop (ns per timer)");
+    RunStartStop(100000);
+
+    bench::PrintOpsHeader("service loop (ns per callback)");
+    for (int n : {100, 1000, 10000}) {
+        RunService(n, 0);
+        RunService(n, 15);
+        RunService(n, 50);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+#include "Benchmark.hpp"
+#include "MsgMonitor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+/**
+ * @brief 模拟处理消息的窗口类型，用于检查卡顿记录中的类型名
+ */
+class FakeWindow
+{
+public:
+    virtual ~FakeWindow() = default;
+};
+
+class SlowWindow : public FakeWindow
+{
+};
+
+/**
+ * @brief 看门狗回调收到的卡顿记录
+ */
+struct HandlerLog {
+    std::mutex mutex;
+    std::vector<sw::HangReport> reports;
+
+    void Add(const sw::HangReport &report)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->reports.push_back(report);
+    }
+};
+
+static void SleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief  检查直方图的百分位数与精确值的相对误差
+ * @return 误差是否在一个子桶的宽度以内且所有值都落在对应的桶中
+ */
+static bool CheckHistogram()
+{
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> values;
+    sw::LatencyHistogram histogram;
+
+    // 对数分布的样本，跨越从几纳秒到几秒的范围
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t v = (uint64_t)std::exp2((double)(random() % 3200) / 100);
+        values.push_back(v);
+        histogram.Record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    double worst    = 0;
+    int boundErrors = 0;
+    for (double p : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        uint64_t rank  = std::max<uint64_t>(1, (uint64_t)(p / 100 * values.size() + 0.5));
+        uint64_t exact = values[rank - 1];
+        uint64_t got   = histogram.GetPercentile(p);
+        if (got < exact) ++boundErrors; // 百分位数为桶的上界，不应小于精确值
+        worst = std::max(worst, exact == 0 ? 0 : (double)(got - std::min(got, exact)) / exact);
+    }
+
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t v = random() >> (random() % 64);
+        int index  = sw::LatencyHistogram::GetBucketIndex(v);
+        if (v < sw::LatencyHistogram::GetBucketLowerBound(index) || v > sw::LatencyHistogram::GetBucketUpperBound(index)) {
+            ++boundErrors;
+        }
+    }
+
+    double limit = 1.0 / sw::LatencyHistogram::SubBucketCount;
+    std::printf("histogram %llu samples: worst percentile error %.2f%% (limit %.2f%%), bound errors %d\n",
+                (unsigned long long)histogram.GetCount(), worst * 100, limit * 100, boundErrors);
+    return boundErrors == 0 && worst <= limit;
+}
+
+/**
+ * @brief  模拟界面线程：短消息、嵌套的消息循环中的等待以及一次长时间的消息，检查看门狗只报告长时间的消息
+ * @return 是否只报告了一次卡顿且记录中为长时间的消息
+ */
+static bool CheckWatchdog()
+{
+    HandlerLog log;
+    sw::HangWatchdog &watchdog = sw::MsgMonitor::StartWatchdog(50, [&log](const sw::HangReport &report) { log.Add(report); });
+    sw::MsgMonitor::Clear();
+
+    FakeWindow fast;
+    SlowWindow slow;
+
+    // 大量短消息，总时间远超阈值
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < end) {
+        sw::MsgMonitor::DispatchScope scope(0x0200, typeid(fast).name(), 1);
+        SleepMs(1);
+    }
+
+    // 处理消息时进入嵌套的消息循环，循环中长时间等待消息，期间处理短消息
+    {
+        sw::MsgMonitor::DispatchScope outer(0x0201, typeid(fast).name(), 1);
+        for (int i = 0; i < 4; ++i) {
+            sw::MsgMonitor::NotifyIdle();
+            SleepMs(60);
+            sw::MsgMonitor::NotifyResume();
+            sw::MsgMonitor::DispatchScope inner(0x000F, typeid(fast).name(), 2);
+        }
+    }
+    size_t falseReports = log.reports.size();
+
+    // 一次长时间的消息，嵌套在另一条消息的处理中
+    {
+        sw::MsgMonitor::DispatchScope outer(0x0111, typeid(fast).name(), 1);
+        sw::MsgMonitor::DispatchScope scope(0x0113, typeid(slow).name(), 3);
+        SleepMs(200);
+    }
+    SleepMs(50);
+
+    std::vector<sw::HangReport> reports = watchdog.GetReports();
+    std::printf("watchdog: false reports %zu, hangs %zu, handler calls %zu\n", falseReports, reports.size(), log.reports.size());
+
+    bool ok = falseReports == 0 && reports.size() == 1;
+    for (const sw::HangReport &report : reports) {
+        bool matched = report.activity.message == 0x0113 && report.activity.className == typeid(slow).name() && report.activity.handle == 3;
+        ok           = ok && matched;
+        std::printf("  hang #%llu %ls handle %llu: %.1f ms, finished %s, activity %s\n",
+                    (unsigned long long)report.id, sw::MsgMonitor::GetMessageName(report.activity.message).c_str(),
+                    (unsigned long long)report.activity.handle, report.durationMs,
+                    report.finished ? "yes" : "no", matched ? "matched" : "MISMATCHED");
+    }
+    return ok;
+}
+
+/**
+ * @brief  模拟其他线程投递回调，检查排队时间的记录并输出JSON
+ * @return 是否所有回调都已执行并记录了排队时间，且JSON已保存
+ */
+static bool CheckQueueWait(const char *path)
+{
+    using Call = sw::MsgMonitor::QueuedCall<std::function<void()>>;
+
+    std::mutex mutex;
+    std::vector<Call> queue;
+    int executed = 0;
+
+    // 其他线程投递回调，相当于Dispatcher::InvokeAsync
+    std::thread producer([&] {
+        for (int i = 0; i < 100; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(sw::MsgMonitor::MakeQueuedCall(0x3404, std::function<void()>([&executed] { ++executed; })));
+        }
+    });
+    producer.join();
+
+    // 界面线程稍后取出并执行
+    SleepMs(5);
+    std::vector<Call> calls;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        calls.swap(queue);
+    }
+    for (Call &call : calls) {
+        sw::MsgMonitor::DispatchScope scope(0x3404, "sw::Dispatcher", 4);
+        call();
+    }
+
+    const sw::LatencyHistogram *wait = sw::MsgMonitor::GetQueueWaitHistogram(0x3404);
+    std::printf("queue wait %ls: executed %d, recorded %llu, min %.3f ms, p99 %.3f ms\n",
+                sw::MsgMonitor::GetMessageName(0x3404).c_str(), executed,
+                (unsigned long long)(wait ? wait->GetCount() : 0),
+                wait ? wait->GetMinimum() / 1e6 : 0, wait ? wait->GetPercentile(99) / 1e6 : 0);
+
+    std::wstring json = sw::MsgMonitor::ToJson();
+    bool saved       = sw::MsgMonitor::SaveJson(path);
+    std::printf("json: %zu chars, dispatch messages %zu, saved to %s: %s\n",
+                json.size(), sw::MsgMonitor::GetDispatchMessages().size(), path, saved ? "yes" : "no");
+    return executed == 100 && wait != nullptr && wait->GetCount() == 100 && saved;
+}
+
+/**
+ * @brief 各记录点的开销
+ */
+static void RunCost()
+{
+    const int count = 100000;
+
+    {
+        std::mt19937_64 random(5);
+        std::vector<uint64_t> values(count);
+        for (uint64_t &v : values) v = random() >> (random() % 64);
+
+        sw::LatencyHistogram histogram;
+        bench::Sample sample;
+        while (bench::NeedMorePasses(sample)) {
+            bench::Probe probe;
+            for (uint64_t v : values) histogram.Record(v);
+            probe.AddTo(sample);
+        }
+        bench::PrintOpsRow("LatencyHistogram::Record", sample, count);
+    }
+
+    {
+        sw::HangWatchdog watchdog(1000);
+        bench::Sample sample;
+        while (bench::NeedMorePasses(sample)) {
+            bench::Probe probe;
+            for (int i = 0; i < count; ++i) {
+                sw::HangActivity previous = watchdog.Enter({(uint32_t)i, "FakeWindow", 1});
+                watchdog.Leave(previous);
+            }
+            probe.AddTo(sample);
+        }
+        bench::PrintOpsRow("HangWatchdog Enter + Leave", sample, count);
+    }
+
+    struct Case {
+        const char *name;
+        bool enabled;
+        bool watchdog;
+    };
+    for (const Case &c : {Case{"DispatchScope disabled", false, false},
+                          Case{"DispatchScope enabled", true, false},
+                          Case{"DispatchScope enabled + watchdog", true, true}}) {
+        if (c.watchdog) {
+            sw::MsgMonitor::StartWatchdog(1000);
+        } else {
+            sw::MsgMonitor::StopWatchdog();
+        }
+        sw::MsgMonitor::SetEnabled(c.enabled);
+        sw::MsgMonitor::Clear();
+
+        bench::Sample sample;
+        while (bench::NeedMorePasses(sample)) {
+            bench::Probe probe;
+            for (int i = 0; i < count; ++i) {
+                sw::MsgMonitor::DispatchScope scope((uint32_t)(i & 0xFF), "FakeWindow", 1);
+            }
+            probe.AddTo(sample);
+        }
+        bench::PrintOpsRow(c.name, sample, count);
+    }
+
+    sw::MsgMonitor::StopWatchdog();
+    sw::MsgMonitor::SetEnabled(false);
+}
+
+int main(int argc, char *argv[])
+{
+    // 命令行参数为JSON的输出路径
+    const char *path = argc > 1 ? argv[1] : "msg_monitor.json";
+
+    // 检查失败时以非零值退出
+    bool ok = CheckHistogram();
+    ok      = CheckWatchdog() && ok;
+    ok      = CheckQueueWait(path) && ok;
+
+    bench::PrintOpsHeader("record cost (ns per call)");
+    RunCost();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+#include "Benchmark.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    /**
+     * @brief 记录operator new的调用次数
+     */
+    std::atomic<uint64_t> _allocCount{0};
+}
+
+uint64_t bench::GetAllocCount()
+{
+    return _allocCount.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size)
+{
+    _allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
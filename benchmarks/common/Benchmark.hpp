@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace bench
+{
+    /**
+     * @brief 获取进程启动以来调用operator new的总次数
+     */
+    uint64_t GetAllocCount();
+
+    /**
+     * @brief 单项测量结果
+     */
+    struct Sample {
+        double nanoseconds = 0; // 累计耗时
+        uint64_t allocs    = 0; // 累计内存分配次数
+        int passes         = 0; // 累计执行次数
+    };
+
+    /**
+     * @brief 用于测量一段代码的耗时与内存分配次数
+     */
+    class Probe
+    {
+    private:
+        std::chrono::steady_clock::time_point _start;
+        uint64_t _allocs;
+
+    public:
+        Probe()
+            : _start(std::chrono::steady_clock::now()), _allocs(GetAllocCount())
+        {
+        }
+
+        /**
+         * @brief 将从构造到现在的耗时与分配次数累加到sample中
+         */
+        void AddTo(Sample &sample) const
+        {
+            auto end = std::chrono::steady_clock::now();
+            sample.nanoseconds += std::chrono::duration<double, std::nano>(end - this->_start).count();
+            sample.allocs += GetAllocCount() - this->_allocs;
+            sample.passes += 1;
+        }
+    };
+
+    /**
+     * @brief 判断是否需要继续执行，保证至少执行minPasses次且总耗时不少于minMilliseconds
+     */
+    inline bool NeedMorePasses(const Sample &sample, int minPasses = 3, double minMilliseconds = 200)
+    {
+        return sample.passes < minPasses || sample.nanoseconds < minMilliseconds * 1e6;
+    }
+
+    /**
+     * @brief 输出表头
+     */
+    inline void PrintHeader(const char *title)
+    {
+        std::printf("%-34s %10s %14s %14s %14s %14s\n", title, "children", "measure ns/ch", "arrange ns/ch", "measure alloc", "arrange alloc");
+    }
+
+    /**
+     * @brief 输出一行结果，耗时以每个子元素的纳秒数表示，分配次数以每次执行的次数表示
+     */
+    inline void PrintRow(const std::string &name, int childCount, const Sample &measure, const Sample &arrange)
+    {
+        std::printf("%-34s %10d %14.2f %14.2f %14.1f %14.1f\n",
+                    name.c_str(), childCount,
+                    measure.nanoseconds / measure.passes / childCount,
+                    arrange.nanoseconds / arrange.passes / childCount,
+                    (double)measure.allocs / measure.passes,
+                    (double)arrange.allocs / arrange.passes);
+    }
+
+    /**
+     * @brief 输出按单次操作统计的表头
+     */
+    inline void PrintOpsHeader(const char *title)
+    {
+        std::printf("%-34s %14s %14s\n", title, "ns/op", "alloc/op");
+    }
+
+    /**
+     * @brief 输出一行按单次操作统计的结果，opsPerPass为每次执行包含的操作数
+     */
+    inline void PrintOpsRow(const std::string &name, const Sample &sample, int opsPerPass)
+    {
+        std::printf("%-34s %14.2f %14.2f\n",
+                    name.c_str(),
+                    sample.nanoseconds / sample.passes / opsPerPass,
+                    (double)sample.allocs / sample.passes / opsPerPass);
+    }
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Delegate.h"
+#include "IdleQueue.h"
+#include "MsgLoopStatistics.h"
 #include "Property.h"
 #include <Windows.h>
 #include <memory>
@@ -58,7 +60,61 @@ namespace sw
         static thread_local Action<MSG &> NullHwndMsgHandler;
 
         /**
-         * @brief  消息循环
+         * @brief 当前线程每轮执行空闲回调的时间预算（毫秒），默认为4，超出预算后先处理新到达的消息
+         * @note  该属性是线程局部的，每个线程有各自独立的值
+         */
+        static const Property<double> IdleTimeBudget;
+
+        /**
+         * @brief 当前线程消息循环的目标帧间隔（毫秒），默认为0，大于0时消息循环进入帧节奏模式，
+         *        每隔FrameInterval毫秒调用一次FrameHandler，处理不及时的帧会被跳过而不会连续补帧
+         * @note  该属性是线程局部的，每个线程有各自独立的值，可在消息循环运行期间修改
+         */
+        static const Property<double> FrameInterval;
+
+        /**
+         * @brief 帧节奏模式下每帧调用的回调函数，可在其中更新动画并重绘窗口
+         * @note  该委托是线程局部的，每个线程有各自独立的值
+         */
+        static thread_local Action<const MsgLoopFrame &> FrameHandler;
+
+        /**
+         * @brief 消息循环每轮结束、等待新的消息之前调用的回调函数，参数为本轮的计时信息
+         * @note  该委托是线程局部的，每个线程有各自独立的值，不为空时消息循环会读取时钟以记录计时信息
+         */
+        static thread_local Action<const MsgLoopTurn &> MsgLoopTurnHandler;
+
+        /**
+         * @brief 是否统计当前线程消息循环的计时信息，默认为false，为false时消息循环不更新GetMsgLoopStatistics的结果
+         * @note  该属性是线程局部的，每个线程有各自独立的值，统计时每轮需要额外读取几次时钟
+         */
+        static const Property<bool> MsgLoopStatisticsEnabled;
+
+        /**
+         * @brief         注册当前线程的空闲回调，消息队列为空时消息循环在IdleTimeBudget内轮流执行空闲回调
+         * @param handler 空闲回调，返回false时被移除
+         * @return        回调的标识，可用于RemoveIdleHandler
+         */
+        static uint64_t AddIdleHandler(const IdleHandler &handler);
+
+        /**
+         * @brief  移除当前线程的空闲回调
+         * @return 回调是否存在
+         */
+        static bool RemoveIdleHandler(uint64_t id);
+
+        /**
+         * @brief 获取当前线程消息循环的累计统计信息，仅统计MsgLoopStatisticsEnabled为true期间的轮次
+         */
+        static const MsgLoopStatistics &GetMsgLoopStatistics();
+
+        /**
+         * @brief 清除当前线程消息循环的累计统计信息
+         */
+        static void ResetMsgLoopStatistics();
+
+        /**
+         * @brief  消息循环，依次分发已到达的消息、按FrameInterval渲染帧、执行空闲回调，没有工作时等待新的消息
          * @return 退出代码
          */
         static int MsgLoop();
@@ -0,0 +1,449 @@
+#pragma once
+
+#include "DispatchQueue.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 是否支持C++20协程，支持时AsyncResult、Dispatcher与WndBase提供可co_await的等待体
+ */
+#ifndef SW_HAS_COROUTINE
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define SW_HAS_COROUTINE 1
+#else
+#define SW_HAS_COROUTINE 0
+#endif
+#endif
+
+#if SW_HAS_COROUTINE
+#include <coroutine>
+#endif
+
+namespace sw
+{
+    template <typename T>
+    class AsyncResult;
+
+    /**
+     * @brief 异步结果共享状态中与结果类型无关的部分
+     */
+    class _AsyncStateBase
+    {
+    protected:
+        /**
+         * @brief 保护共享状态
+         */
+        mutable std::mutex _mutex;
+
+        /**
+         * @brief 等待结果的线程
+         */
+        mutable std::condition_variable _cv;
+
+        /**
+         * @brief 是否已经设置了结果或异常
+         */
+        bool _ready = false;
+
+        /**
+         * @brief 回调抛出的异常
+         */
+        std::exception_ptr _exception;
+
+        /**
+         * @brief 完成时执行的后续操作
+         */
+        std::vector<DispatchCallable> _continuations;
+
+    public:
+        _AsyncStateBase() = default;
+
+        _AsyncStateBase(const _AsyncStateBase &)            = delete;
+        _AsyncStateBase &operator=(const _AsyncStateBase &) = delete;
+
+        /**
+         * @brief 判断是否已经完成
+         */
+        bool IsReady() const
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            return this->_ready;
+        }
+
+        /**
+         * @brief 阻塞当前线程直到完成
+         */
+        void Wait() const
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_cv.wait(lock, [this] { return this->_ready; });
+        }
+
+        /**
+         * @brief  阻塞当前线程直到完成或超时
+         * @return 是否已经完成
+         */
+        bool WaitFor(double milliseconds) const
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            return this->_cv.wait_for(lock, std::chrono::duration<double, std::milli>(milliseconds),
+                                      [this] { return this->_ready; });
+        }
+
+        /**
+         * @brief  设置异常，已经完成时不做任何操作
+         * @return 是否设置成功
+         */
+        bool SetException(std::exception_ptr exception)
+        {
+            return this->_Complete([this, &exception] { this->_exception = std::move(exception); });
+        }
+
+        /**
+         * @brief 添加完成时执行的后续操作，已经完成时在当前线程上立即执行
+         */
+        void AddContinuation(DispatchCallable &&continuation)
+        {
+            if (!this->TryAddContinuation(continuation)) {
+                continuation();
+            }
+        }
+
+        /**
+         * @brief  添加完成时执行的后续操作
+         * @return 是否添加成功，已经完成时返回false且continuation不变
+         */
+        bool TryAddContinuation(DispatchCallable &continuation)
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            if (this->_ready) {
+                return false;
+            }
+            this->_continuations.push_back(std::move(continuation));
+            return true;
+        }
+
+    protected:
+        /**
+         * @brief       在加锁的状态下通过store保存结果并标记为完成，然后唤醒等待的线程并执行后续操作
+         * @param store 保存结果的函数，抛出异常时状态保持未完成
+         * @return      是否设置成功，已经完成时返回false
+         */
+        template <typename Store>
+        bool _Complete(Store &&store)
+        {
+            std::vector<DispatchCallable> continuations;
+            {
+                std::lock_guard<std::mutex> lock(this->_mutex);
+                if (this->_ready) {
+                    return false;
+                }
+                store();
+                this->_ready = true;
+                continuations.swap(this->_continuations);
+            }
+            this->_cv.notify_all();
+
+            // 在锁外执行后续操作，后续操作中可以访问结果或添加新的后续操作
+            for (DispatchCallable &continuation : continuations) {
+                continuation();
+            }
+            return true;
+        }
+
+        /**
+         * @brief 等待完成，有异常时重新抛出
+         */
+        void _WaitAndRethrow() const
+        {
+            this->Wait();
+            if (this->_exception) {
+                std::rethrow_exception(this->_exception);
+            }
+        }
+    };
+
+    /**
+     * @brief 异步结果的共享状态
+     */
+    template <typename T>
+    class _AsyncState : public _AsyncStateBase
+    {
+    private:
+        /**
+         * @brief 结果的存储空间，完成且没有异常时保存结果
+         */
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+
+    public:
+        /**
+         * @brief 析构保存的结果
+         */
+        ~_AsyncState()
+        {
+            if (this->_ready && !this->_exception) {
+                reinterpret_cast<T *>(&this->_storage)->~T();
+            }
+        }
+
+        /**
+         * @brief  设置结果，已经完成时不做任何操作
+         * @return 是否设置成功
+         */
+        template <typename U>
+        bool SetValue(U &&value)
+        {
+            return this->_Complete([this, &value] { new (&this->_storage) T(std::forward<U>(value)); });
+        }
+
+        /**
+         * @brief 执行可调用对象并将其返回值或抛出的异常设置为结果
+         */
+        template <typename F, typename... Args>
+        void Run(F &f, Args &&...args)
+        {
+            try {
+                this->SetValue(f(std::forward<Args>(args)...));
+            } catch (...) {
+                this->SetException(std::current_exception());
+            }
+        }
+
+        /**
+         * @brief 等待完成并获取结果，有异常时重新抛出
+         */
+        const T &Get() const
+        {
+            this->_WaitAndRethrow();
+            return *reinterpret_cast<const T *>(&this->_storage);
+        }
+    };
+
+    /**
+     * @brief 没有返回值的异步操作的共享状态
+     */
+    template <>
+    class _AsyncState<void> : public _AsyncStateBase
+    {
+    public:
+        /**
+         * @brief  标记为完成，已经完成时不做任何操作
+         * @return 是否设置成功
+         */
+        bool SetValue()
+        {
+            return this->_Complete([] {});
+        }
+
+        /**
+         * @brief 执行可调用对象，将其抛出的异常设置为结果
+         */
+        template <typename F, typename... Args>
+        void Run(F &f, Args &&...args)
+        {
+            try {
+                f(std::forward<Args>(args)...);
+                this->SetValue();
+            } catch (...) {
+                this->SetException(std::current_exception());
+            }
+        }
+
+        /**
+         * @brief 等待完成，有异常时重新抛出
+         */
+        void Get() const
+        {
+            this->_WaitAndRethrow();
+        }
+    };
+
+    /**
+     * @brief 执行后将结果设置到共享状态中的回调
+     * @note  回调未执行就被销毁时（如调度器已销毁）结果被设置为std::future_errc::broken_promise异常，等待的线程不会一直阻塞
+     */
+    template <typename T, typename F>
+    class _AsyncInvoker
+    {
+    private:
+        std::shared_ptr<_AsyncState<T>> _state;
+        F _f;
+
+    public:
+        template <typename U>
+        _AsyncInvoker(std::shared_ptr<_AsyncState<T>> state, U &&f)
+            : _state(std::move(state)), _f(std::forward<U>(f))
+        {
+        }
+
+        _AsyncInvoker(_AsyncInvoker &&) = default;
+
+        ~_AsyncInvoker()
+        {
+            if (this->_state != nullptr) {
+                this->_state->SetException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            }
+        }
+
+        void operator()()
+        {
+            this->_state->Run(this->_f);
+            this->_state.reset();
+        }
+    };
+
+    /**
+     * @brief 异步操作的结果，可以阻塞等待、轮询或添加完成后执行的后续操作
+     * @note  AsyncResult可以复制，所有副本共享同一个结果；结果可以多次获取
+     * @note  在执行回调的线程上调用Get或Wait等待该回调的结果会导致死锁，例如在窗口线程上等待窗口InvokeAsync的结果，
+     *        此时应使用Then或co_await
+     */
+    template <typename T>
+    class AsyncResult
+    {
+    private:
+        /**
+         * @brief 共享状态
+         */
+        std::shared_ptr<_AsyncState<T>> _state;
+
+    public:
+        /**
+         * @brief 初始化无效的AsyncResult
+         */
+        AsyncResult() = default;
+
+        /**
+         * @brief 通过共享状态初始化AsyncResult
+         */
+        explicit AsyncResult(std::shared_ptr<_AsyncState<T>> state)
+            : _state(std::move(state))
+        {
+        }
+
+        /**
+         * @brief 判断是否关联了异步操作
+         */
+        bool IsValid() const noexcept
+        {
+            return this->_state != nullptr;
+        }
+
+        /**
+         * @brief 判断异步操作是否已经完成
+         */
+        bool IsReady() const
+        {
+            return this->_state->IsReady();
+        }
+
+        /**
+         * @brief 阻塞当前线程直到异步操作完成
+         */
+        void Wait() const
+        {
+            this->_state->Wait();
+        }
+
+        /**
+         * @brief              阻塞当前线程直到异步操作完成或超时
+         * @param milliseconds 超时时间（毫秒）
+         * @return             异步操作是否已经完成
+         */
+        bool WaitFor(double milliseconds) const
+        {
+            return this->_state->WaitFor(milliseconds);
+        }
+
+        /**
+         * @brief 等待异步操作完成并获取结果，异步操作抛出异常时重新抛出该异常
+         */
+        auto Get() const -> decltype(std::declval<const _AsyncState<T> &>().Get())
+        {
+            return this->_state->Get();
+        }
+
+        /**
+         * @brief   添加异步操作完成后执行的后续操作
+         * @param f 后续操作，参数为当前AsyncResult，可通过其Get获取结果或异常
+         * @return  后续操作的结果
+         * @note    后续操作在完成异步操作的线程上执行（对于InvokeAsync即窗口线程），若此时已经完成则在当前线程上立即执行
+         */
+        template <typename F>
+        auto Then(F &&f) const -> AsyncResult<decltype(std::declval<typename std::decay<F>::type &>()(std::declval<const AsyncResult &>()))>
+        {
+            using TResult = decltype(std::declval<typename std::decay<F>::type &>()(std::declval<const AsyncResult &>()));
+
+            auto state = std::make_shared<_AsyncState<TResult>>();
+            this->_state->AddContinuation(
+                _AsyncInvoker<TResult, _Continuation<typename std::decay<F>::type>>(
+                    state, _Continuation<typename std::decay<F>::type>{*this, std::forward<F>(f)}));
+            return AsyncResult<TResult>(std::move(state));
+        }
+
+#if SW_HAS_COROUTINE
+        /**
+         * @brief 协程等待时判断是否已经完成
+         */
+        bool await_ready() const
+        {
+            return this->_state->IsReady();
+        }
+
+        /**
+         * @brief  异步操作完成后在完成它的线程上恢复协程
+         * @return 是否挂起，在此期间已经完成时返回false，协程在当前线程上继续执行
+         */
+        bool await_suspend(std::coroutine_handle<> handle) const
+        {
+            DispatchCallable continuation([handle] { handle.resume(); });
+            return this->_state->TryAddContinuation(continuation);
+        }
+
+        /**
+         * @brief 协程恢复后获取结果，异步操作抛出异常时重新抛出该异常
+         */
+        auto await_resume() const -> decltype(std::declval<const _AsyncState<T> &>().Get())
+        {
+            return this->_state->Get();
+        }
+#endif
+
+    private:
+        /**
+         * @brief Then添加的后续操作，以前一个AsyncResult为参数调用f
+         */
+        template <typename F>
+        struct _Continuation {
+            AsyncResult result;
+            F f;
+
+            auto operator()() -> decltype(std::declval<F &>()(std::declval<const AsyncResult &>()))
+            {
+                return this->f(static_cast<const AsyncResult &>(this->result));
+            }
+        };
+    };
+
+    /**
+     * @brief        创建与异步结果关联的回调，回调执行后设置结果
+     * @param f      要执行的可调用对象，返回值需可转换为T
+     * @param result 与回调关联的异步结果
+     * @return       回调，可交给调度器或其他线程执行
+     */
+    template <typename T, typename F>
+    _AsyncInvoker<T, typename std::decay<F>::type> MakeAsyncInvoker(F &&f, AsyncResult<T> &result)
+    {
+        auto state = std::make_shared<_AsyncState<T>>();
+        result     = AsyncResult<T>(state);
+        return _AsyncInvoker<T, typename std::decay<F>::type>(std::move(state), std::forward<F>(f));
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Color.h"
+#include "HandleCache.h"
+
+namespace sw
+{
+    /**
+     * @brief 纯色画刷缓存，颜色相同的画刷共享同一个HBRUSH
+     * @note  缓存是进程范围的，可在任意线程获取和释放，内部使用互斥锁同步
+     */
+    class BrushCache
+    {
+    private:
+        BrushCache() = delete;
+
+    public:
+        /**
+         * @brief       获取与颜色对应的纯色画刷并增加其引用计数
+         * @param color 颜色
+         * @return      画刷句柄，使用完毕后需调用Release释放，创建失败时返回NULL
+         */
+        static HBRUSH Acquire(const Color &color);
+
+        /**
+         * @brief        释放由Acquire获取的画刷句柄
+         * @param hbrush 画刷句柄
+         * @return       句柄是否由缓存管理
+         */
+        static bool Release(HBRUSH hbrush);
+
+        /**
+         * @brief 销毁当前未被使用的画刷
+         */
+        static void Trim();
+
+        /**
+         * @brief       设置最多保留的未被使用的画刷数
+         * @param count 画刷数，为0时画刷在不被使用后立即销毁
+         */
+        static void SetMaxIdleCount(size_t count);
+
+        /**
+         * @brief 获取画刷缓存的统计信息
+         */
+        static HandleCacheStats GetStats();
+
+        /**
+         * @brief 清零画刷缓存的命中、未命中与淘汰次数
+         */
+        static void ResetStats();
+    };
+}
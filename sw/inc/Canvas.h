@@ -2,6 +2,7 @@
 
 #include "CanvasLayout.h"
 #include "Panel.h"
+#include <vector>
 
 namespace sw
 {
@@ -32,6 +33,20 @@ namespace sw
          */
         static void SetCanvasLayoutTag(UIElement &element, const CanvasLayoutTag &tag);
 
+        /**
+         * @brief       获取指定位置处最上层的子元素
+         * @param point 用户区中的位置
+         * @return      按最近一次布局时子元素的区域（包括边距）查找，未找到时返回nullptr
+         */
+        UIElement *HitTest(const Point &point);
+
+        /**
+         * @brief      获取与指定区域相交的所有子元素，可用于拖放及只处理可见区域内的子元素
+         * @param rect 用户区中的矩形
+         * @return     按添加顺序排列的子元素
+         */
+        std::vector<UIElement *> QueryRect(const sw::Rect &rect);
+
     protected:
         /**
          * @brief 获取默认布局对象
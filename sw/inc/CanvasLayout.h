@@ -1,6 +1,8 @@
 #pragma once
 
 #include "LayoutHost.h"
+#include "SpatialIndex.h"
+#include <vector>
 
 namespace sw
 {
@@ -44,6 +46,12 @@ namespace sw
      */
     class CanvasLayout : public LayoutHost
     {
+    private:
+        /**
+         * @brief 子元素安排位置的空间索引，在ArrangeOverride中更新
+         */
+        SpatialIndex _spatialIndex{};
+
     public:
         /**
          * @brief               测量元素所需尺寸，无需考虑边框和边距
@@ -57,5 +65,26 @@ namespace sw
          * @param finalSize 可用于排列子元素的最终尺寸
          */
         virtual void ArrangeOverride(const Size &finalSize) override;
+
+        /**
+         * @brief       查找包含指定点的最上层子元素
+         * @param point 相对于内容区域的位置
+         * @return      子元素在GetChildLayoutAt中的索引，未找到时返回-1
+         * @note        按最近一次安排时各子元素的区域（包括边距）查找
+         */
+        int HitTest(const Point &point) const;
+
+        /**
+         * @brief        查找与指定区域相交的所有子元素
+         * @param rect   相对于内容区域的矩形
+         * @param result 按索引从小到大保存子元素在GetChildLayoutAt中的索引
+         * @note         按最近一次安排时各子元素的区域（包括边距）查找
+         */
+        void QueryRect(const Rect &rect, std::vector<int> &result) const;
+
+        /**
+         * @brief 获取子元素安排位置的空间索引，可用于调整网格的边长
+         */
+        SpatialIndex &GetSpatialIndex();
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -10,6 +11,21 @@
 #include <typeindex>
 #include <vector>
 
+/**
+ * @brief 委托内部可直接存储的可调用对象的最大字节数，更大的可调用对象将在堆上分配
+ * @note  默认值可以容纳捕获3个指针的lambda表达式以及成员函数绑定
+ */
+#ifndef SW_DELEGATE_INLINE_SIZE
+#define SW_DELEGATE_INLINE_SIZE (4 * sizeof(void *))
+#endif
+
+/**
+ * @brief 委托内部可直接存储的可调用对象个数，多播委托的元素超过该数量时在堆上分配存储空间
+ */
+#ifndef SW_DELEGATE_INLINE_COUNT
+#define SW_DELEGATE_INLINE_COUNT 2
+#endif
+
 namespace sw
 {
     // ICallable接口声明
@@ -44,6 +60,32 @@ namespace sw
          */
         virtual ICallable *Clone() const = 0;
 
+        /**
+         * @brief        将当前可调用对象克隆到指定的缓冲区中
+         * @param buffer 缓冲区，按std::max_align_t对齐
+         * @param size   缓冲区的字节数
+         * @return       克隆成功则返回缓冲区中的对象，否则返回nullptr
+         * @note         默认实现返回nullptr，此时调用方会改为调用Clone在堆上克隆，重写该函数时需同时重写MoveInto
+         * @note         克隆到缓冲区中的对象在每次调用委托时都会再次被克隆，调用发生在副本上，
+         *               因此只有复制开销小且调用不会改变自身状态的可调用对象才应重写该函数
+         */
+        virtual ICallable *CloneInto(void *buffer, size_t size) const
+        {
+            return nullptr;
+        }
+
+        /**
+         * @brief        将当前可调用对象移动到指定的缓冲区中，调用方随后会销毁当前对象
+         * @param buffer 缓冲区，按std::max_align_t对齐
+         * @param size   缓冲区的字节数
+         * @return       移动成功则返回缓冲区中的对象，否则返回nullptr
+         * @note         对于CloneInto能成功的缓冲区，该函数也必须成功
+         */
+        virtual ICallable *MoveInto(void *buffer, size_t size) noexcept
+        {
+            return nullptr;
+        }
+
         /**
          * @brief 获取当前可调用对象的类型信息
          */
@@ -60,7 +102,10 @@ namespace sw
     /*================================================================================*/
 
     /**
-     * @brief 用于存储和管理多个可调用对象的列表，针对单个可调用对象的情况进行优化
+     * @brief 用于存储和管理多个可调用对象的列表
+     * @note  较小的可调用对象直接存储在列表内部，前SW_DELEGATE_INLINE_COUNT个元素也存储在列表内部，
+     *        因此在常见情况下添加可调用对象不会分配堆内存
+     * @note  复制列表时内部存储的可调用对象会被克隆，堆上的可调用对象则被共享，任何常量操作都不会修改列表
      */
     template <typename T>
     class CallableList
@@ -72,32 +117,172 @@ namespace sw
         using TCallable = ICallable<T>;
 
         /**
-         * @brief 智能指针类型别名，用于存储可调用对象的唯一指针
+         * @brief 可以直接存储在列表内部的可调用对象的最大尺寸
          */
-        using TSinglePtr = std::unique_ptr<TCallable>;
+        static constexpr size_t InlineSize = SW_DELEGATE_INLINE_SIZE;
 
         /**
-         * @brief 列表类型别名，用于存储多个可调用对象的智能指针
+         * @brief 列表内部可以存储的元素个数，超过该数量时在堆上分配存储空间
          */
-        using TSharedList = std::vector<std::shared_ptr<TCallable>>;
+        static constexpr size_t InlineCount = SW_DELEGATE_INLINE_COUNT > 0 ? SW_DELEGATE_INLINE_COUNT : 1;
+
+        /**
+         * @brief 判断指定类型的可调用对象是否可以直接存储在列表内部
+         */
+        template <typename TImpl>
+        static constexpr bool IsInlineStorable() noexcept
+        {
+            return sizeof(TImpl) <= InlineSize && alignof(TImpl) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible<TImpl>::value;
+        }
 
     private:
         /**
-         * @brief 内部存储可调用对象的联合体
+         * @brief 存储单个可调用对象，对象较小时直接构造在内部缓冲区中，否则在堆上分配并共享所有权
          */
-        mutable union {
-            alignas(TSinglePtr) uint8_t _single[sizeof(TSinglePtr)];
-            alignas(TSharedList) uint8_t _list[sizeof(TSharedList)];
-        } _data = {};
+        class _Slot
+        {
+        private:
+            union {
+                alignas(std::max_align_t) uint8_t _buffer[InlineSize];
+                std::shared_ptr<TCallable> _shared;
+            };
+
+            TCallable *_ptr = nullptr;
+            bool _inline    = false;
+
+        public:
+            _Slot() noexcept
+            {
+            }
+
+            _Slot(const _Slot &other)
+            {
+                if (other._inline) {
+                    this->CopyFrom(*other._ptr);
+                } else if (other._ptr != nullptr) {
+                    new (&this->_shared) std::shared_ptr<TCallable>(other._shared);
+                    this->_ptr = other._ptr;
+                }
+            }
+
+            _Slot(_Slot &&other) noexcept
+            {
+                if (other._inline) {
+                    // 内部存储的可调用对象可能包含指向自身的指针，不能直接复制内存，此处移动后销毁原对象
+                    TCallable *ptr = other._ptr->MoveInto(this->_buffer, InlineSize);
+                    if (ptr != nullptr) {
+                        this->_ptr    = ptr;
+                        this->_inline = true;
+                    } else {
+                        // 只重写了CloneInto而未重写MoveInto的类型只能克隆
+                        this->CopyFrom(*other._ptr);
+                    }
+                    other.Reset();
+                } else if (other._ptr != nullptr) {
+                    new (&this->_shared) std::shared_ptr<TCallable>(std::move(other._shared));
+                    this->_ptr = other._ptr;
+                    other.Reset();
+                }
+            }
 
+            _Slot &operator=(const _Slot &) = delete;
+
+            _Slot &operator=(_Slot &&) = delete;
+
+            ~_Slot()
+            {
+                this->Reset();
+            }
+
+            TCallable *Get() const noexcept
+            {
+                return this->_ptr;
+            }
+
+            template <typename TImpl, bool AllowInline, typename... TArgs>
+            void Emplace(TArgs &&...args)
+            {
+                if (AllowInline && IsInlineStorable<TImpl>()) {
+                    this->_ptr    = new (this->_buffer) TImpl(std::forward<TArgs>(args)...);
+                    this->_inline = true;
+                } else {
+                    new (&this->_shared) std::shared_ptr<TCallable>(std::make_shared<TImpl>(std::forward<TArgs>(args)...));
+                    this->_ptr = this->_shared.get();
+                }
+            }
+
+            void Adopt(TCallable *callable)
+            {
+                new (&this->_shared) std::shared_ptr<TCallable>(callable);
+                this->_ptr = callable;
+            }
+
+            void CopyFrom(const TCallable &callable)
+            {
+                TCallable *ptr = callable.CloneInto(this->_buffer, InlineSize);
+                if (ptr != nullptr) {
+                    this->_ptr    = ptr;
+                    this->_inline = true;
+                } else {
+                    this->Adopt(callable.Clone());
+                }
+            }
+
+            void Reset() noexcept
+            {
+                if (this->_inline) {
+                    this->_ptr->~TCallable();
+                    this->_inline = false;
+                } else if (this->_ptr != nullptr) {
+                    this->_shared.~shared_ptr();
+                }
+                this->_ptr = nullptr;
+            }
+        };
+
+    public:
         /**
-         * @brief 当前状态枚举
+         * @brief 列表中单个可调用对象的副本，内部存储的可调用对象会被克隆，堆上的可调用对象则被共享
+         * @note  用于在调用期间保持可调用对象存活，副本不受列表之后的修改或销毁影响
          */
-        enum : uint8_t {
-            STATE_NONE,   // 未存储任何可调用对象
-            STATE_SINGLE, // 储存了一个可调用对象
-            STATE_LIST,   // 储存了多个可调用对象
-        } _state = STATE_NONE;
+        class Snapshot
+        {
+        private:
+            _Slot _slot;
+
+        public:
+            Snapshot(const CallableList &list, size_t index)
+                : _slot(list._GetSlots()[index])
+            {
+            }
+
+            TCallable *operator->() const noexcept
+            {
+                return this->_slot.Get();
+            }
+        };
+
+    private:
+        /**
+         * @brief 列表内部的元素存储空间
+         */
+        alignas(_Slot) uint8_t _inlineSlots[sizeof(_Slot) * InlineCount];
+
+        /**
+         * @brief 元素数量超过InlineCount时在堆上分配的存储空间，为nullptr时使用_inlineSlots
+         */
+        _Slot *_heapSlots = nullptr;
+
+        /**
+         * @brief 当前存储的元素数量
+         */
+        uint32_t _count = 0;
+
+        /**
+         * @brief 当前存储空间可容纳的元素数量
+         */
+        uint32_t _capacity = InlineCount;
 
     public:
         /**
@@ -109,6 +294,7 @@ namespace sw
 
         /**
          * @brief 拷贝构造函数
+         * @note  内部存储的可调用对象会被克隆，堆上的可调用对象与other共享
          */
         CallableList(const CallableList &other)
         {
@@ -132,20 +318,15 @@ namespace sw
                 return *this;
             }
 
-            _Reset(other._state);
+            _Release();
+            _Reserve(other._count);
 
-            switch (other._state) {
-                case STATE_NONE: {
-                    break;
-                }
-                case STATE_SINGLE: {
-                    _GetSingle().reset(other._GetSingle()->Clone());
-                    break;
-                }
-                case STATE_LIST: {
-                    _GetList() = other._GetList();
-                    break;
-                }
+            _Slot *dst = _GetSlots();
+            _Slot *src = other._GetSlots();
+
+            for (uint32_t i = 0; i < other._count; ++i) {
+                new (dst + i) _Slot(src[i]);
+                ++_count;
             }
             return *this;
         }
@@ -159,22 +340,23 @@ namespace sw
                 return *this;
             }
 
-            _Reset(other._state);
+            _Release();
 
-            switch (other._state) {
-                case STATE_NONE: {
-                    break;
-                }
-                case STATE_SINGLE: {
-                    _GetSingle() = std::move(other._GetSingle());
-                    other._Reset();
-                    break;
-                }
-                case STATE_LIST: {
-                    _GetList() = std::move(other._GetList());
-                    other._Reset();
-                    break;
+            if (other._heapSlots != nullptr) {
+                _heapSlots       = other._heapSlots;
+                _count           = other._count;
+                _capacity        = other._capacity;
+                other._heapSlots = nullptr;
+                other._count     = 0;
+                other._capacity  = InlineCount;
+            } else {
+                _Slot *dst = _GetSlots();
+                _Slot *src = other._GetSlots();
+                for (uint32_t i = 0; i < other._count; ++i) {
+                    new (dst + i) _Slot(std::move(src[i]));
+                    ++_count;
                 }
+                other._Release();
             }
             return *this;
         }
@@ -184,7 +366,7 @@ namespace sw
          */
         ~CallableList()
         {
-            _Reset();
+            _Release();
         }
 
         /**
@@ -193,17 +375,7 @@ namespace sw
          */
         size_t Count() const noexcept
         {
-            switch (_state) {
-                case STATE_SINGLE: {
-                    return 1;
-                }
-                case STATE_LIST: {
-                    return _GetList().size();
-                }
-                default: {
-                    return 0;
-                }
-            }
+            return _count;
         }
 
         /**
@@ -212,7 +384,7 @@ namespace sw
          */
         bool IsEmpty() const noexcept
         {
-            return _state == STATE_NONE;
+            return _count == 0;
         }
 
         /**
@@ -220,7 +392,7 @@ namespace sw
          */
         void Clear() noexcept
         {
-            _Reset();
+            _Release();
         }
 
         /**
@@ -232,26 +404,32 @@ namespace sw
             if (callable == nullptr) {
                 return;
             }
+            _Slot *slot = _Append();
+            slot->Adopt(callable);
+            ++_count;
+        }
 
-            switch (_state) {
-                case STATE_NONE: {
-                    _Reset(STATE_SINGLE);
-                    _GetSingle().reset(callable);
-                    break;
-                }
-                case STATE_SINGLE: {
-                    TSharedList list;
-                    list.emplace_back(_GetSingle().release());
-                    list.emplace_back(callable);
-                    _Reset(STATE_LIST);
-                    _GetList() = std::move(list);
-                    break;
-                }
-                case STATE_LIST: {
-                    _GetList().emplace_back(callable);
-                    break;
-                }
-            }
+        /**
+         * @brief 添加一个可调用对象的克隆到列表中
+         * @note  若可调用对象支持CloneInto且尺寸足够小，则直接克隆到列表内部
+         */
+        void AddClone(const TCallable &callable)
+        {
+            _Slot *slot = _Append();
+            slot->CopyFrom(callable);
+            ++_count;
+        }
+
+        /**
+         * @brief 在列表中直接构造一个TImpl类型的可调用对象
+         * @note  AllowInline为false时总是在堆上构造，复制列表时TImpl对象将被共享而不是克隆
+         */
+        template <typename TImpl, bool AllowInline = true, typename... TArgs>
+        void Emplace(TArgs &&...args)
+        {
+            _Slot *slot = _Append();
+            slot->template Emplace<TImpl, AllowInline>(std::forward<TArgs>(args)...);
+            ++_count;
         }
 
         /**
@@ -260,35 +438,21 @@ namespace sw
          */
         bool RemoveAt(size_t index) noexcept
         {
-            switch (_state) {
-                case STATE_SINGLE: {
-                    if (index != 0) {
-                        return false;
-                    } else {
-                        _Reset();
-                        return true;
-                    }
-                }
-                case STATE_LIST: {
-                    auto &list = _GetList();
-                    if (index >= list.size()) {
-                        return false;
-                    }
-                    list.erase(list.begin() + index);
-                    if (list.empty()) {
-                        _Reset();
-                    }
-                    // else if (list.size() == 1) {
-                    //     auto ptr = list.front()->Clone();
-                    //     _Reset(STATE_SINGLE);
-                    //     _GetSingle().reset(ptr);
-                    // }
-                    return true;
-                }
-                default: {
-                    return false;
-                }
+            if (index >= _count) {
+                return false;
+            }
+
+            _Slot *slots = _GetSlots();
+            for (size_t i = index; i + 1 < _count; ++i) {
+                slots[i].~_Slot();
+                new (slots + i) _Slot(std::move(slots[i + 1]));
             }
+            slots[_count - 1].~_Slot();
+
+            if (--_count == 0) {
+                _Release();
+            }
+            return true;
         }
 
         /**
@@ -297,18 +461,7 @@ namespace sw
          */
         TCallable *GetAt(size_t index) const noexcept
         {
-            switch (_state) {
-                case STATE_SINGLE: {
-                    return index == 0 ? _GetSingle().get() : nullptr;
-                }
-                case STATE_LIST: {
-                    auto &list = _GetList();
-                    return (index < list.size()) ? list[index].get() : nullptr;
-                }
-                default: {
-                    return nullptr;
-                }
-            }
+            return index < _count ? _GetSlots()[index].Get() : nullptr;
         }
 
         /**
@@ -322,62 +475,65 @@ namespace sw
 
     private:
         /**
-         * @brief 内部函数，当状态为STATE_SINGLE时返回单个可调用对象的引用，
+         * @brief 内部函数，获取当前使用的存储空间
          */
-        constexpr TSinglePtr &_GetSingle() const noexcept
+        _Slot *_GetSlots() const noexcept
         {
-            return *reinterpret_cast<TSinglePtr *>(_data._single);
+            return _heapSlots != nullptr
+                       ? _heapSlots
+                       : reinterpret_cast<_Slot *>(const_cast<uint8_t *>(_inlineSlots));
         }
 
         /**
-         * @brief 内部函数，当状态为STATE_LIST时返回可调用对象列表的引用
+         * @brief 内部函数，确保存储空间至少可容纳capacity个元素
          */
-        constexpr TSharedList &_GetList() const noexcept
+        void _Reserve(size_t capacity)
         {
-            return *reinterpret_cast<TSharedList *>(_data._list);
+            if (capacity <= _capacity) {
+                return;
+            }
+
+            _Slot *slots = static_cast<_Slot *>(::operator new(sizeof(_Slot) * capacity));
+            _Slot *old   = _GetSlots();
+
+            for (uint32_t i = 0; i < _count; ++i) {
+                new (slots + i) _Slot(std::move(old[i]));
+                old[i].~_Slot();
+            }
+
+            if (_heapSlots != nullptr) {
+                ::operator delete(_heapSlots);
+            }
+            _heapSlots = slots;
+            _capacity  = static_cast<uint32_t>(capacity);
         }
 
         /**
-         * @brief 重置当前状态，释放存储的可调用对象
+         * @brief 内部函数，在末尾构造一个空元素并返回，调用方负责在初始化后增加_count
          */
-        void _Reset() noexcept
+        _Slot *_Append()
         {
-            switch (_state) {
-                case STATE_NONE: {
-                    break;
-                }
-                case STATE_SINGLE: {
-                    _GetSingle().~TSinglePtr();
-                    _state = STATE_NONE;
-                    break;
-                }
-                case STATE_LIST: {
-                    _GetList().~TSharedList();
-                    _state = STATE_NONE;
-                    break;
-                }
+            if (_count == _capacity) {
+                _Reserve(size_t(_capacity) * 2);
             }
+            return new (_GetSlots() + _count) _Slot();
         }
 
         /**
-         * @brief 重置当前状态并根据给定状态进行初始化
+         * @brief 内部函数，销毁所有元素并释放堆上的存储空间
          */
-        void _Reset(uint8_t state) noexcept
+        void _Release() noexcept
         {
-            _Reset();
-
-            switch (state) {
-                case STATE_SINGLE: {
-                    new (_data._single) TSinglePtr();
-                    _state = STATE_SINGLE;
-                    break;
-                }
-                case STATE_LIST: {
-                    new (_data._list) TSharedList();
-                    _state = STATE_LIST;
-                    break;
-                }
+            _Slot *slots = _GetSlots();
+            for (uint32_t i = 0; i < _count; ++i) {
+                slots[i].~_Slot();
+            }
+            if (_heapSlots != nullptr) {
+                ::operator delete(_heapSlots);
+                _heapSlots = nullptr;
             }
+            _count    = 0;
+            _capacity = InlineCount;
         }
     };
 
@@ -412,6 +568,23 @@ namespace sw
             typename std::enable_if</*std::is_trivial<T>::value &&*/ std::is_standard_layout<T>::value, void>::type> : std::true_type {
         };
 
+        template <typename T, typename = void>
+        struct _IsConstInvocable : std::false_type {
+        };
+
+        template <typename T>
+        struct _IsConstInvocable<
+            T,
+            typename std::enable_if<true, decltype(void(std::declval<const T &>()(std::declval<Args>()...)))>::type> : std::true_type {
+        };
+
+        /**
+         * @brief 判断T是否可以存储在委托内部，内部存储的对象在调用前会被克隆，因此要求T复制开销小且调用时不修改自身
+         */
+        template <typename T>
+        struct _IsInlineCallable : std::integral_constant<bool, std::is_trivially_copyable<T>::value && _IsConstInvocable<T>::value> {
+        };
+
         template <typename T>
         class _CallableWrapperImpl final : public _ICallable
         {
@@ -423,11 +596,16 @@ namespace sw
                 memset(_storage, 0, sizeof(_storage));
                 new (_storage) T(value);
             }
-            _CallableWrapperImpl(T &&value)
+            _CallableWrapperImpl(T &&value) noexcept(std::is_nothrow_move_constructible<T>::value)
             {
                 memset(_storage, 0, sizeof(_storage));
                 new (_storage) T(std::move(value));
             }
+            _CallableWrapperImpl(_CallableWrapperImpl &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : _CallableWrapperImpl(std::move(other.GetValue()))
+            {
+            }
+            _CallableWrapperImpl(const _CallableWrapperImpl &) = delete;
             virtual ~_CallableWrapperImpl()
             {
                 GetValue().~T();
@@ -445,6 +623,14 @@ namespace sw
             {
                 return new _CallableWrapperImpl(GetValue());
             }
+            _ICallable *CloneInto(void *buffer, size_t size) const override
+            {
+                return _IsInlineCallable<T>::value && _CanCloneInto<_CallableWrapperImpl>(size) ? new (buffer) _CallableWrapperImpl(GetValue()) : nullptr;
+            }
+            _ICallable *MoveInto(void *buffer, size_t size) noexcept override
+            {
+                return _IsInlineCallable<T>::value && _CanCloneInto<_CallableWrapperImpl>(size) ? new (buffer) _CallableWrapperImpl(std::move(*this)) : nullptr;
+            }
             virtual std::type_index GetType() const override
             {
                 return typeid(T);
@@ -490,6 +676,13 @@ namespace sw
         template <typename T>
         using _CallableWrapper = _CallableWrapperImpl<typename std::decay<T>::type>;
 
+        template <typename TImpl>
+        static constexpr bool _CanCloneInto(size_t size) noexcept
+        {
+            return sizeof(TImpl) <= size && alignof(TImpl) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible<TImpl>::value;
+        }
+
         template <typename T>
         class _MemberFuncWrapper final : public _ICallable
         {
@@ -509,6 +702,14 @@ namespace sw
             {
                 return new _MemberFuncWrapper(*obj, func);
             }
+            _ICallable *CloneInto(void *buffer, size_t size) const override
+            {
+                return _CanCloneInto<_MemberFuncWrapper>(size) ? new (buffer) _MemberFuncWrapper(*obj, func) : nullptr;
+            }
+            _ICallable *MoveInto(void *buffer, size_t size) noexcept override
+            {
+                return _CanCloneInto<_MemberFuncWrapper>(size) ? new (buffer) _MemberFuncWrapper(*obj, func) : nullptr;
+            }
             virtual std::type_index GetType() const override
             {
                 return typeid(func);
@@ -545,6 +746,14 @@ namespace sw
             {
                 return new _ConstMemberFuncWrapper(*obj, func);
             }
+            _ICallable *CloneInto(void *buffer, size_t size) const override
+            {
+                return _CanCloneInto<_ConstMemberFuncWrapper>(size) ? new (buffer) _ConstMemberFuncWrapper(*obj, func) : nullptr;
+            }
+            _ICallable *MoveInto(void *buffer, size_t size) noexcept override
+            {
+                return _CanCloneInto<_ConstMemberFuncWrapper>(size) ? new (buffer) _ConstMemberFuncWrapper(*obj, func) : nullptr;
+            }
             virtual std::type_index GetType() const override
             {
                 return typeid(func);
@@ -625,7 +834,7 @@ namespace sw
         Delegate(const Delegate &other)
         {
             for (size_t i = 0; i < other._data.Count(); ++i) {
-                _data.Add(other._data[i]->Clone());
+                _data.AddClone(*other._data[i]);
             }
         }
 
@@ -647,7 +856,7 @@ namespace sw
             }
             _data.Clear();
             for (size_t i = 0; i < other._data.Count(); ++i) {
-                _data.Add(other._data[i]->Clone());
+                _data.AddClone(*other._data[i]);
             }
             return *this;
         }
@@ -677,11 +886,11 @@ namespace sw
                 if (delegate._data.IsEmpty()) {
                     return;
                 } else if (delegate._data.Count() == 1) {
-                    _data.Add(delegate._data[0]->Clone());
+                    _data.AddClone(*delegate._data[0]);
                     return;
                 }
             }
-            _data.Add(callable.Clone());
+            _data.AddClone(callable);
         }
 
         /**
@@ -690,7 +899,7 @@ namespace sw
         void Add(TRet (*func)(Args...))
         {
             if (func != nullptr) {
-                _data.Add(new _CallableWrapper<decltype(func)>(func));
+                _data.template Emplace<_CallableWrapper<decltype(func)>, _IsInlineCallable<decltype(func)>::value>(func);
             }
         }
 
@@ -701,7 +910,7 @@ namespace sw
         typename std::enable_if<!std::is_base_of<_ICallable, T>::value, void>::type
         Add(const T &callable)
         {
-            _data.Add(new _CallableWrapper<T>(callable));
+            _data.template Emplace<_CallableWrapper<T>, _IsInlineCallable<typename std::decay<T>::type>::value>(callable);
         }
 
         /**
@@ -710,7 +919,7 @@ namespace sw
         template <typename T>
         void Add(T &obj, TRet (T::*func)(Args...))
         {
-            _data.Add(new _MemberFuncWrapper<T>(obj, func));
+            _data.template Emplace<_MemberFuncWrapper<T>>(obj, func);
         }
 
         /**
@@ -719,7 +928,7 @@ namespace sw
         template <typename T>
         void Add(const T &obj, TRet (T::*func)(Args...) const)
         {
-            _data.Add(new _ConstMemberFuncWrapper<T>(obj, func));
+            _data.template Emplace<_ConstMemberFuncWrapper<T>>(obj, func);
         }
 
         /**
@@ -988,11 +1197,10 @@ namespace sw
             size_t count = _data.Count();
             if (count == 0) {
                 _ThrowEmptyDelegateError();
-            } else if (count == 1) {
-                results.emplace_back(_data[0]->Invoke(std::forward<Args>(args)...));
             } else {
-                auto list = _data;
-                results.reserve(count = list.Count());
+                // 调用过程中委托可能被修改或销毁，因此调用列表的副本，副本克隆内部存储的可调用对象并共享堆上的可调用对象
+                CallableList<TRet(Args...)> list = _data;
+                results.reserve(count);
                 for (size_t i = 0; i < count; ++i) {
                     results.emplace_back(list[i]->Invoke(std::forward<Args>(args)...));
                 }
@@ -1031,9 +1239,12 @@ namespace sw
             if (count == 0) {
                 _ThrowEmptyDelegateError();
             } else if (count == 1) {
-                return _data[0]->Invoke(std::forward<Args>(args)...);
+                // 调用过程中委托可能被修改或销毁，因此调用可调用对象的副本
+                typename CallableList<TRet(Args...)>::Snapshot callable(_data, 0);
+                return callable->Invoke(std::forward<Args>(args)...);
             } else {
-                auto list = _data;
+                // 调用过程中委托可能被修改或销毁，因此调用列表的副本，副本克隆内部存储的可调用对象并共享堆上的可调用对象
+                CallableList<TRet(Args...)> list = _data;
                 for (size_t i = 0; i < count - 1; ++i)
                     list[i]->Invoke(std::forward<Args>(args)...);
                 return list[count - 1]->Invoke(std::forward<Args>(args)...);
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 调度队列中回调的优先级，数值越小越先执行
+     */
+    enum class DispatchPriority {
+        Input,      // 与输入相关的回调，最先执行
+        Render,     // 更新界面内容的回调，InvokeAsync默认使用该优先级
+        Background, // 后台回调，有输入或绘制消息等待处理时推迟执行
+    };
+
+    /**
+     * @brief 可调用对象的类型擦除容器，不超过BufferSize的对象直接保存在内部缓冲区中而不分配内存
+     */
+    class DispatchCallable
+    {
+    public:
+        /**
+         * @brief 内部缓冲区的大小，足以保存std::function或捕获了几个值的lambda
+         */
+        static constexpr size_t BufferSize = 64;
+
+    private:
+        /**
+         * @brief 对缓冲区中对象的操作
+         */
+        struct _VTable {
+            void (*invoke)(void *p);
+            void (*relocate)(void *dst, void *src); // 移动构造到dst并析构src
+            void (*destroy)(void *p);
+        };
+
+        /**
+         * @brief 内部缓冲区
+         */
+        typename std::aligned_storage<BufferSize, alignof(std::max_align_t)>::type _buffer;
+
+        /**
+         * @brief 当前对象的操作，为nullptr时表示容器为空
+         */
+        const _VTable *_vtable = nullptr;
+
+    public:
+        /**
+         * @brief 初始化空的DispatchCallable
+         */
+        DispatchCallable() = default;
+
+        /**
+         * @brief 保存可调用对象
+         */
+        template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, DispatchCallable>::value>::type>
+        DispatchCallable(F &&f)
+        {
+            this->_Emplace(std::forward<F>(f));
+        }
+
+        /**
+         * @brief 移动构造，other变为空
+         */
+        DispatchCallable(DispatchCallable &&other) noexcept
+        {
+            if (other._vtable != nullptr) {
+                other._vtable->relocate(&this->_buffer, &other._buffer);
+                this->_vtable  = other._vtable;
+                other._vtable = nullptr;
+            }
+        }
+
+        /**
+         * @brief 移动赋值，other变为空
+         */
+        DispatchCallable &operator=(DispatchCallable &&other) noexcept
+        {
+            if (this != &other) {
+                this->Reset();
+                if (other._vtable != nullptr) {
+                    other._vtable->relocate(&this->_buffer, &other._buffer);
+                    this->_vtable  = other._vtable;
+                    other._vtable = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        DispatchCallable(const DispatchCallable &)            = delete;
+        DispatchCallable &operator=(const DispatchCallable &) = delete;
+
+        /**
+         * @brief 析构保存的对象
+         */
+        ~DispatchCallable()
+        {
+            this->Reset();
+        }
+
+        /**
+         * @brief 判断是否保存了对象
+         */
+        explicit operator bool() const noexcept
+        {
+            return this->_vtable != nullptr;
+        }
+
+        /**
+         * @brief 调用保存的对象
+         */
+        void operator()()
+        {
+            this->_vtable->invoke(&this->_buffer);
+        }
+
+        /**
+         * @brief 析构保存的对象，容器变为空
+         */
+        void Reset() noexcept
+        {
+            if (this->_vtable != nullptr) {
+                this->_vtable->destroy(&this->_buffer);
+                this->_vtable = nullptr;
+            }
+        }
+
+    private:
+        /**
+         * @brief 判断类型T能否直接保存在内部缓冲区中
+         */
+        template <typename T>
+        struct _IsInline : std::integral_constant<bool,
+                                                  sizeof(T) <= BufferSize &&
+                                                      alignof(std::max_align_t) % alignof(T) == 0 &&
+                                                      std::is_nothrow_move_constructible<T>::value> {
+        };
+
+        /**
+         * @brief 保存小对象
+         */
+        template <typename F>
+        typename std::enable_if<_IsInline<typename std::decay<F>::type>::value>::type _Emplace(F &&f)
+        {
+            using T = typename std::decay<F>::type;
+
+            static const _VTable vtable = {
+                [](void *p) { (*static_cast<T *>(p))(); },
+                [](void *dst, void *src) {
+                    new (dst) T(std::move(*static_cast<T *>(src)));
+                    static_cast<T *>(src)->~T();
+                },
+                [](void *p) { static_cast<T *>(p)->~T(); },
+            };
+
+            new (&this->_buffer) T(std::forward<F>(f));
+            this->_vtable = &vtable;
+        }
+
+        /**
+         * @brief 保存大对象，对象分配在堆上，缓冲区中只保存指针
+         */
+        template <typename F>
+        typename std::enable_if<!_IsInline<typename std::decay<F>::type>::value>::type _Emplace(F &&f)
+        {
+            using T = typename std::decay<F>::type;
+
+            static const _VTable vtable = {
+                [](void *p) { (**static_cast<T **>(p))(); },
+                [](void *dst, void *src) { *static_cast<T **>(dst) = *static_cast<T **>(src); },
+                [](void *p) { delete *static_cast<T **>(p); },
+            };
+
+            *reinterpret_cast<T **>(&this->_buffer) = new T(std::forward<F>(f));
+            this->_vtable = &vtable;
+        }
+    };
+
+    /**
+     * @brief 多生产者单消费者的调度队列，任意线程可添加回调，由一个线程（一般为界面线程）按优先级执行
+     * @note  每个优先级使用一个预先分配的环形缓冲区，添加回调只需一次CAS而不需要加锁，回调对象保存在格子的内部缓冲区中。
+     *        环形缓冲区已满时回调暂存到加锁的溢出队列中，此后同一优先级的回调都进入溢出队列直到其被清空，
+     *        因此同一个生产者添加的同一优先级的回调总是按添加的顺序执行。消费者每次加锁取走整个溢出队列，
+     *        溢出队列的存储空间会被重复使用，因此持续溢出时也不会为每个回调加锁两次或分配内存
+     * @note  队列通过唤醒标记保证在队列非空期间只需唤醒消费者一次：Enqueue返回true时调用方负责唤醒消费者，
+     *        消费者执行完毕后调用EndRun，若其返回true则需要再次唤醒自己
+     * @note  该类不依赖Win32
+     */
+    class DispatchQueue
+    {
+    public:
+        /**
+         * @brief 优先级的数量
+         */
+        static constexpr int PriorityCount = 3;
+
+        /**
+         * @brief 每个优先级的环形缓冲区的默认容量
+         * @note  突发的回调数超过容量时多出的回调进入溢出队列，持续溢出时每个回调的开销与加锁的队列相当，
+         *        但仍不会分配内存，也只需唤醒一次消费者
+         */
+        static constexpr size_t DefaultCapacity = 512;
+
+    private:
+        /**
+         * @brief 环形缓冲区的格子，sequence用于判断格子是否可写入或读取
+         */
+        struct _Cell {
+            std::atomic<size_t> sequence;
+            DispatchCallable callable;
+        };
+
+        /**
+         * @brief 一个优先级的环形缓冲区及溢出队列
+         */
+        struct _Ring {
+            std::unique_ptr<_Cell[]> cells;
+            size_t mask = 0;
+            char pad0[64]{};                       // 避免生产者与消费者修改的位置位于同一缓存行
+            std::atomic<size_t> enqueuePos{0};     // 生产者写入的位置
+            char pad1[64]{};                       //
+            size_t dequeuePos = 0;                 // 消费者读取的位置，只由消费者访问
+            std::atomic<size_t> overflowCount{0};  // 溢出队列与draining中尚未取出的回调数
+            std::vector<DispatchCallable> overflow; // 溢出队列，通过_overflowMutex保护
+            std::vector<DispatchCallable> draining; // 消费者从溢出队列中取走的回调，只由消费者访问
+            size_t drainPos = 0;                   // draining中下一个要取出的位置
+        };
+
+        /**
+         * @brief 各优先级的环形缓冲区
+         */
+        std::unique_ptr<_Ring[]> _rings;
+
+        /**
+         * @brief 保护溢出队列
+         */
+        std::mutex _overflowMutex;
+
+        /**
+         * @brief 唤醒标记，为true时表示已经（或即将）唤醒消费者
+         */
+        std::atomic<bool> _wakePending{false};
+
+    public:
+        /**
+         * @brief          初始化DispatchQueue
+         * @param capacity 每个优先级的环形缓冲区的容量，会向上取整为2的幂
+         */
+        explicit DispatchQueue(size_t capacity = DefaultCapacity);
+
+        DispatchQueue(const DispatchQueue &)            = delete;
+        DispatchQueue &operator=(const DispatchQueue &) = delete;
+
+        /**
+         * @brief 析构时销毁未执行的回调
+         */
+        ~DispatchQueue();
+
+        /**
+         * @brief          添加回调，可在任意线程中调用
+         * @param f        要添加的可调用对象
+         * @param priority 优先级
+         * @return         是否需要唤醒消费者，为true时调用方应唤醒消费者
+         */
+        template <typename F>
+        bool Enqueue(F &&f, DispatchPriority priority = DispatchPriority::Render)
+        {
+            // 先构造回调再占用格子，构造时抛出异常不会使队列停在未写入完成的格子上
+            DispatchCallable callable(std::forward<F>(f));
+            _Ring &ring = this->_rings[_ClampPriority(priority)];
+
+            if (ring.overflowCount.load(std::memory_order_acquire) != 0 || !_TryEnqueue(ring, callable)) {
+                this->_EnqueueOverflow(ring, std::move(callable));
+            }
+
+            return !this->_wakePending.exchange(true, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief                    按优先级执行队列中的回调，直到队列为空或超出时间预算，只能在消费者线程中调用
+         * @param budgetMilliseconds 时间预算（毫秒），至少会执行一个回调
+         * @param lowestPriority     执行的最低优先级，低于该优先级的回调保留在队列中
+         * @return                   执行的回调数
+         * @note                     每执行一个回调都会重新从最高优先级开始查找，因此执行期间新加入的高优先级回调会先执行。
+         *                           回调抛出异常时异常会传递给调用方，未执行的回调保留在队列中
+         */
+        int Run(double budgetMilliseconds, DispatchPriority lowestPriority = DispatchPriority::Background);
+
+        /**
+         * @brief                消费者判断队列中是否有指定优先级及更高优先级的回调
+         * @param lowestPriority 判断的最低优先级
+         * @note                 生产者已占用但尚未写入完成的格子也视为有回调
+         */
+        bool HasPending(DispatchPriority lowestPriority = DispatchPriority::Background) const;
+
+        /**
+         * @brief  消费者本轮执行结束后调用该函数清除唤醒标记
+         * @return 若队列中仍有回调则重新设置唤醒标记并返回true，此时调用方应再次唤醒消费者
+         */
+        bool EndRun();
+
+        /**
+         * @brief 调用方唤醒消费者失败时调用该函数清除唤醒标记，使下一次Enqueue重新请求唤醒
+         */
+        void CancelWake();
+
+        /**
+         * @brief  销毁队列中尚未执行的回调，只能在消费者线程中调用
+         * @return 销毁的回调数
+         * @note   生产者已占用但尚未写入完成的格子及其后的回调保留在队列中
+         */
+        int Clear();
+
+    private:
+        /**
+         * @brief 将优先级转换为_rings的下标
+         */
+        static int _ClampPriority(DispatchPriority priority);
+
+        /**
+         * @brief 尝试将回调移动到环形缓冲区，缓冲区已满时返回false且callable不变
+         */
+        static bool _TryEnqueue(_Ring &ring, DispatchCallable &callable);
+
+        /**
+         * @brief 将回调加入溢出队列
+         */
+        void _EnqueueOverflow(_Ring &ring, DispatchCallable &&callable);
+
+        /**
+         * @brief 消费者从指定优先级中取出一个回调，没有回调时返回false
+         */
+        bool _TryDequeue(_Ring &ring, DispatchCallable &callable);
+
+        /**
+         * @brief 消费者从指定优先级的环形缓冲区中取出下一个回调，下一个格子尚未写入时返回false
+         */
+        static bool _TryDequeueCell(_Ring &ring, DispatchCallable &callable);
+    };
+}
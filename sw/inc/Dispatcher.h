@@ -0,0 +1,215 @@
+#pragma once
+
+#include "AsyncResult.h"
+#include "DispatchQueue.h"
+#include "MsgMonitor.h"
+#include "Property.h"
+#include "WndMsg.h"
+#include <Windows.h>
+#include <atomic>
+#include <system_error>
+#include <utility>
+
+namespace sw
+{
+    /**
+     * @brief 界面线程的调度器，其他线程添加的回调合并为一条唤醒消息，在界面线程上按优先级分批执行
+     * @note  每个线程有各自的调度器，调度器通过一个仅用于接收消息的窗口接收唤醒消息，
+     *        因此在模态对话框、菜单等的消息循环中回调同样能够执行
+     * @note  每轮最多执行TimeBudget毫秒，剩余的回调在下一轮执行；若此时有输入或绘制消息等待处理，
+     *        下一轮通过WM_TIMER唤醒以便先处理这些消息，后台优先级的回调也会被推迟
+     * @note  调度器对象在进程退出前不会释放，线程退出时只关闭调度器，因此静态存储期的窗口析构时仍可以安全地访问调度器
+     */
+    class Dispatcher
+    {
+    private:
+        /**
+         * @brief 调度器所属线程的id
+         */
+        DWORD _threadId;
+
+        /**
+         * @brief 接收唤醒消息的窗口
+         */
+        HWND _hwnd = NULL;
+
+        /**
+         * @brief 回调队列
+         */
+        DispatchQueue _queue{};
+
+        /**
+         * @brief 每轮执行回调的时间预算（毫秒）
+         */
+        double _timeBudget = 8;
+
+        /**
+         * @brief 所属线程是否已退出，为true时添加的回调直接销毁
+         */
+        std::atomic<bool> _shutdown{false};
+
+        /**
+         * @brief 初始化当前线程的调度器
+         */
+        Dispatcher();
+
+    public:
+        /**
+         * @brief 每轮执行回调的时间预算（毫秒），默认为8，超出预算后剩余的回调在下一轮执行
+         * @note  只能在调度器所属的线程中访问
+         */
+        const Property<double> TimeBudget;
+
+        /**
+         * @brief 调度器所属线程的id
+         */
+        const ReadOnlyProperty<DWORD> ThreadId;
+
+    public:
+        Dispatcher(const Dispatcher &)            = delete;
+        Dispatcher &operator=(const Dispatcher &) = delete;
+
+        /**
+         * @brief 销毁接收唤醒消息的窗口，未执行的回调随之销毁
+         */
+        ~Dispatcher();
+
+        /**
+         * @brief 获取当前线程的调度器，首次调用时创建
+         * @note  线程局部变量先于静态对象析构，因此调度器不随线程局部变量释放，
+         *        线程退出时销毁接收唤醒消息的窗口与未执行的回调
+         */
+        static Dispatcher &GetCurrent();
+
+        /**
+         * @brief 判断当前线程是否为调度器所属的线程
+         */
+        bool CheckAccess() const;
+
+        /**
+         * @brief          在调度器所属的线程上执行回调，可在任意线程中调用，函数立即返回
+         * @param f        要执行的可调用对象，不超过DispatchCallable::BufferSize的对象不会分配内存
+         * @param priority 优先级
+         * @note           启用MsgMonitor时回调执行时记录排队时间，计入WM_DispatcherWake
+         * @note           所属线程退出后回调不会执行，也不会被加入队列
+         */
+        template <typename F>
+        void InvokeAsync(F &&f, DispatchPriority priority = DispatchPriority::Render)
+        {
+            if (this->_shutdown.load(std::memory_order_acquire)) {
+                return;
+            }
+            bool wake = MsgMonitor::IsEnabled()
+                            ? this->_queue.Enqueue(MsgMonitor::MakeQueuedCall(WM_DispatcherWake, std::forward<F>(f)), priority)
+                            : this->_queue.Enqueue(std::forward<F>(f), priority);
+            if (wake) {
+                this->_PostWake();
+            }
+        }
+
+        /**
+         * @brief          在调度器所属的线程上执行回调，可在任意线程中调用，函数立即返回可等待回调结果的AsyncResult
+         * @tparam T       回调的返回值类型，可以为void
+         * @param f        要执行的可调用对象，抛出的异常保存在结果中
+         * @param priority 优先级
+         * @note           所属线程退出时未执行的回调的结果为std::future_errc::broken_promise异常
+         */
+        template <typename T, typename F>
+        AsyncResult<T> InvokeAsync(F &&f, DispatchPriority priority = DispatchPriority::Render)
+        {
+            AsyncResult<T> result;
+            this->InvokeAsync(MakeAsyncInvoker<T>(std::forward<F>(f), result), priority);
+            return result;
+        }
+
+#if SW_HAS_COROUTINE
+        /**
+         * @brief 切换到调度器所属线程的等待体
+         */
+        struct SwitchToAwaiter {
+            Dispatcher *dispatcher;
+            DispatchPriority priority;
+
+            bool await_ready() const
+            {
+                return this->dispatcher->CheckAccess();
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                this->dispatcher->InvokeAsync([handle] { handle.resume(); }, this->priority);
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        /**
+         * @brief 切换到线程池的等待体
+         */
+        struct ThreadPoolAwaiter {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                if (!TrySubmitThreadpoolCallback(ThreadPoolAwaiter::_Callback, handle.address(), NULL)) {
+                    throw std::system_error((int)GetLastError(), std::system_category());
+                }
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+        private:
+            static void CALLBACK _Callback(PTP_CALLBACK_INSTANCE, PVOID context)
+            {
+                std::coroutine_handle<>::from_address(context).resume();
+            }
+        };
+
+        /**
+         * @brief          返回一个等待体，协程co_await该等待体后在调度器所属的线程上继续执行，不阻塞任何线程
+         * @param priority 恢复协程的回调的优先级
+         * @note           已经在调度器所属的线程上时不会挂起；调度器销毁时尚未恢复的协程不会再恢复
+         */
+        SwitchToAwaiter SwitchTo(DispatchPriority priority = DispatchPriority::Render)
+        {
+            return SwitchToAwaiter{this, priority};
+        }
+
+        /**
+         * @brief 返回一个等待体，协程co_await该等待体后在系统线程池的线程上继续执行
+         */
+        static ThreadPoolAwaiter SwitchToThreadPool()
+        {
+            return ThreadPoolAwaiter{};
+        }
+#endif
+
+    private:
+        /**
+         * @brief 所属线程退出时关闭调度器，销毁接收唤醒消息的窗口与未执行的回调
+         */
+        void _Shutdown();
+
+        /**
+         * @brief 投递唤醒消息
+         */
+        void _PostWake();
+
+        /**
+         * @brief 收到唤醒消息或唤醒定时器到期时执行一轮回调
+         */
+        void _OnWake();
+
+        /**
+         * @brief 接收唤醒消息的窗口的窗口过程
+         */
+        static LRESULT CALLBACK _WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Font.h"
+#include "HandleCache.h"
+
+namespace sw
+{
+    /**
+     * @brief 字体句柄缓存，属性完全相同的字体共享同一个HFONT
+     * @note  缓存以字体在当前DPI下对应的LOGFONTW为键，DPI改变后相同的Font会得到新的句柄
+     * @note  缓存是进程范围的，可以在任意线程中获取与释放句柄
+     */
+    class FontCache
+    {
+    private:
+        FontCache() = delete;
+
+    public:
+        /**
+         * @brief      获取与字体对应的句柄并增加其引用计数
+         * @param font 字体
+         * @return     字体句柄，使用完毕后需调用Release释放，创建失败时返回NULL
+         */
+        static HFONT Acquire(const Font &font);
+
+        /**
+         * @brief       释放由Acquire获取的字体句柄
+         * @param hfont 字体句柄
+         * @return      句柄是否由缓存管理
+         */
+        static bool Release(HFONT hfont);
+
+        /**
+         * @brief 销毁当前未被使用的字体句柄
+         */
+        static void Trim();
+
+        /**
+         * @brief       设置最多保留的未被使用的字体句柄数
+         * @param count 句柄数，为0时字体句柄在不被使用后立即销毁
+         */
+        static void SetMaxIdleCount(size_t count);
+
+        /**
+         * @brief 获取字体缓存的统计信息
+         */
+        static HandleCacheStats GetStats();
+
+        /**
+         * @brief 清零字体缓存的命中、未命中与淘汰次数
+         */
+        static void ResetStats();
+    };
+}
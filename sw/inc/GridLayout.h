@@ -186,6 +186,9 @@ namespace sw
 
     /**
      * @brief 网格布局方式
+     * @note  行列信息与子元素的measure顺序在两次Measure之间缓存，缓存是整体有效或整体失效的：
+     *        每次Measure仍会逐个比较子元素及其布局标记以检查缓存是否有效，并重新计算所有行列的尺寸，
+     *        不会只重新measure受影响的AutoSize行列。未改变的子元素由UIElement的测量缓存直接返回
      */
     class GridLayout : public LayoutHost
     {
@@ -195,6 +198,7 @@ namespace sw
          */
         struct _ChildInfo {
             ILayout *instance;         // 子元素对象
+            uint64_t rawLayoutTag;     // 子元素原始的布局标记，用于判断布局标记是否改变
             GridLayoutTag layoutTag;   // 布局标记
             GridRCType rowMeasureType; // 元素measure行时的类型
             GridRCType colMeasureType; // 元素measure列时的类型
@@ -222,9 +226,14 @@ namespace sw
          * @brief 一些内部数据
          */
         struct {
+            bool valid = false;                   // 内部数据是否有效，无效时需要重新生成
+            std::vector<GridRow> rows;            // 生成内部数据时的行定义
+            std::vector<GridColumn> cols;         // 生成内部数据时的列定义
             std::vector<_RowInfo> rowsInfo;       // 行信息
             std::vector<_ColInfo> colsInfo;       // 列信息
-            std::vector<_ChildInfo> childrenInfo; // 子元素信息
+            std::vector<_ChildInfo> childrenInfo; // 子元素信息，顺序与子元素索引相同
+            std::vector<int> colMeasureOrder;     // measure列时子元素的顺序，保存childrenInfo的索引
+            std::vector<int> rowMeasureOrder;     // measure行时子元素的顺序，保存childrenInfo的索引
             std::vector<Rect> cells;              // 保存格信息
         } _internalData;
 
@@ -252,12 +261,28 @@ namespace sw
          */
         virtual void ArrangeOverride(const Size &finalSize) override;
 
+        /**
+         * @brief 使缓存的行列信息和子元素排序失效，下次Measure时重新生成
+         * @note  行列定义、子元素数量及布局标记的改变会被自动检测，一般无需手动调用该函数
+         */
+        void InvalidateInternalData();
+
     private:
         /**
-         * @brief 更新内部数据
+         * @brief 更新内部数据，若行列定义和子元素均未改变则只重置各行列的尺寸
          */
         void _UpdateInternalData();
 
+        /**
+         * @brief 判断缓存的内部数据是否仍与当前的行列定义及子元素一致
+         */
+        bool _IsInternalDataValid();
+
+        /**
+         * @brief 将各行列的尺寸重置为measure前的初始值
+         */
+        void _ResetTracksSize();
+
         /**
          * @brief 获取指定行列处的网格信息
          */
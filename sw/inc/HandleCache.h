@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Delegate.h"
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace sw
+{
+    /**
+     * @brief 句柄缓存的统计信息
+     */
+    struct HandleCacheStats {
+        uint64_t hits      = 0; // 命中次数，即Acquire时已存在相同键的句柄
+        uint64_t misses    = 0; // 未命中次数，即Acquire时创建了新句柄
+        uint64_t evictions = 0; // 因空闲句柄过多而被销毁的句柄数
+        size_t liveHandles = 0; // 当前缓存中存在的句柄数，包括空闲句柄
+        size_t idleHandles = 0; // 当前引用计数为0但仍保留在缓存中的句柄数
+    };
+
+    /**
+     * @brief            引用计数的句柄缓存，键相等的请求共享同一个句柄
+     * @tparam TKey      键类型，需要能被THash和TKeyEqual处理
+     * @tparam THandle   句柄类型，值初始化的THandle表示无效句柄
+     * @tparam THash     键的哈希函数
+     * @tparam TKeyEqual 键的比较函数
+     * @note             引用计数降为0的句柄不会立即销毁，而是按最近释放的顺序保留最多MaxIdleCount个，
+     *                   超出时销毁最早释放的句柄，以避免在几个值之间反复切换时重复创建句柄
+     * @note             该类不依赖Win32，也不是线程安全的
+     */
+    template <
+        typename TKey,
+        typename THandle,
+        typename THash     = std::hash<TKey>,
+        typename TKeyEqual = std::equal_to<TKey>>
+    class HandleCache
+    {
+    public:
+        /**
+         * @brief 创建句柄的函数类型
+         */
+        using FnCreate = Func<const TKey &, THandle>;
+
+        /**
+         * @brief 销毁句柄的函数类型
+         */
+        using FnDestroy = Action<THandle>;
+
+    private:
+        struct _Entry;
+
+        /**
+         * @brief 按键存储的表项类型
+         */
+        using _EntryMap = std::unordered_map<TKey, _Entry, THash, TKeyEqual>;
+
+        /**
+         * @brief 表项在_EntryMap中的节点，unordered_map重新哈希时节点地址不变
+         */
+        using _Node = typename _EntryMap::value_type;
+
+        /**
+         * @brief 缓存中的一个句柄，空闲句柄通过idlePrev和idleNext串成侵入式链表，进出空闲链表时不需要分配内存
+         */
+        struct _Entry {
+            THandle handle{};
+            size_t refCount = 0;
+            _Node *idlePrev = nullptr;
+            _Node *idleNext = nullptr;
+        };
+
+        FnCreate _create;
+        FnDestroy _destroy;
+        _EntryMap _entries{};
+        std::unordered_map<THandle, _Node *> _handles{};
+        _Node *_idleHead  = nullptr; // 最近释放的空闲句柄
+        _Node *_idleTail  = nullptr; // 最早释放的空闲句柄
+        size_t _idleCount = 0;
+        size_t _maxIdleCount;
+        HandleCacheStats _stats{};
+
+    public:
+        /**
+         * @brief              构造句柄缓存
+         * @param create       创建句柄的函数
+         * @param destroy      销毁句柄的函数
+         * @param maxIdleCount 最多保留的空闲句柄数
+         */
+        HandleCache(const FnCreate &create, const FnDestroy &destroy, size_t maxIdleCount = 16)
+            : _create(create), _destroy(destroy), _maxIdleCount(maxIdleCount)
+        {
+        }
+
+        HandleCache(const HandleCache &) = delete;
+
+        HandleCache &operator=(const HandleCache &) = delete;
+
+        /**
+         * @brief 析构时销毁缓存中的所有句柄
+         */
+        ~HandleCache()
+        {
+            for (auto &node : this->_entries) {
+                this->_destroy(node.second.handle);
+            }
+        }
+
+        /**
+         * @brief     获取与键对应的句柄并增加其引用计数，若不存在则创建
+         * @param key 键
+         * @return    句柄，创建失败时返回值初始化的THandle且不会被缓存
+         * @note      每次成功的Acquire都需要对应一次Release
+         */
+        THandle Acquire(const TKey &key)
+        {
+            auto it = this->_entries.find(key);
+
+            if (it != this->_entries.end()) {
+                _Entry &entry = it->second;
+                if (entry.refCount++ == 0) {
+                    this->_UnlinkIdle(&*it);
+                }
+                ++this->_stats.hits;
+                return entry.handle;
+            }
+
+            ++this->_stats.misses;
+
+            THandle handle = this->_create(key);
+            if (handle == THandle{}) {
+                return handle;
+            }
+
+            auto result = this->_entries.emplace(key, _Entry{});
+            _Node &node = *result.first;
+
+            node.second.handle   = handle;
+            node.second.refCount = 1;
+            this->_handles[handle] = &node;
+            return handle;
+        }
+
+        /**
+         * @brief        减少句柄的引用计数，计数降为0时句柄成为空闲句柄
+         * @param handle 由Acquire获取的句柄
+         * @return       句柄是否由该缓存管理
+         */
+        bool Release(THandle handle)
+        {
+            auto it = this->_handles.find(handle);
+
+            if (it == this->_handles.end() || it->second->second.refCount == 0) {
+                return false;
+            }
+
+            _Node *node = it->second;
+            if (--node->second.refCount == 0) {
+                this->_LinkIdleFront(node);
+                this->_TrimIdle(this->_maxIdleCount);
+            }
+            return true;
+        }
+
+        /**
+         * @brief 销毁所有空闲句柄
+         */
+        void Trim()
+        {
+            this->_TrimIdle(0);
+        }
+
+        /**
+         * @brief 获取最多保留的空闲句柄数
+         */
+        size_t GetMaxIdleCount() const
+        {
+            return this->_maxIdleCount;
+        }
+
+        /**
+         * @brief 设置最多保留的空闲句柄数，多余的空闲句柄会被立即销毁
+         */
+        void SetMaxIdleCount(size_t count)
+        {
+            this->_maxIdleCount = count;
+            this->_TrimIdle(count);
+        }
+
+        /**
+         * @brief 获取统计信息
+         */
+        HandleCacheStats GetStats() const
+        {
+            HandleCacheStats stats = this->_stats;
+            stats.liveHandles      = this->_entries.size();
+            stats.idleHandles      = this->_idleCount;
+            return stats;
+        }
+
+        /**
+         * @brief 清零命中、未命中与淘汰次数
+         */
+        void ResetStats()
+        {
+            this->_stats = HandleCacheStats{};
+        }
+
+    private:
+        /**
+         * @brief 从最早释放的空闲句柄开始销毁，直到空闲句柄数不超过count
+         */
+        void _TrimIdle(size_t count)
+        {
+            while (this->_idleCount > count) {
+                _Node *node = this->_idleTail;
+                this->_UnlinkIdle(node);
+
+                THandle handle = node->second.handle;
+                this->_handles.erase(handle);
+                this->_entries.erase(this->_entries.find(node->first));
+                this->_destroy(handle);
+                ++this->_stats.evictions;
+            }
+        }
+
+        /**
+         * @brief 将句柄加入空闲链表的头部
+         */
+        void _LinkIdleFront(_Node *node)
+        {
+            node->second.idlePrev = nullptr;
+            node->second.idleNext = this->_idleHead;
+
+            if (this->_idleHead != nullptr) {
+                this->_idleHead->second.idlePrev = node;
+            } else {
+                this->_idleTail = node;
+            }
+
+            this->_idleHead = node;
+            ++this->_idleCount;
+        }
+
+        /**
+         * @brief 将句柄从空闲链表中移除
+         */
+        void _UnlinkIdle(_Node *node)
+        {
+            _Node *prev = node->second.idlePrev;
+            _Node *next = node->second.idleNext;
+
+            (prev != nullptr ? prev->second.idleNext : this->_idleHead) = next;
+            (next != nullptr ? next->second.idlePrev : this->_idleTail) = prev;
+
+            node->second.idlePrev = nullptr;
+            node->second.idleNext = nullptr;
+            --this->_idleCount;
+        }
+    };
+}
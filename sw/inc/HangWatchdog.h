@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Delegate.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 被监视的线程正在进行的工作
+     */
+    struct HangActivity {
+        uint32_t message      = 0;       // 正在处理的消息
+        const char *className = nullptr; // 处理消息的对象的类型名，需为字符串常量或typeid(...).name()的结果
+        uint64_t handle       = 0;       // 处理消息的窗口句柄
+    };
+
+    /**
+     * @brief 一次卡顿的记录
+     */
+    struct HangReport {
+        uint64_t id         = 0;     // 卡顿的序号，从1开始
+        HangActivity activity;       // 检测到卡顿时正在进行的工作
+        uint64_t beginNs    = 0;     // 开始忙碌的时间（纳秒），与HangWatchdog::Now相同的时间基准
+        double durationMs   = 0;     // 卡顿的时长（毫秒），卡顿尚未结束时为检测时已持续的时长
+        bool finished       = false; // 卡顿是否已经结束
+    };
+
+    /**
+     * @brief 卡顿的回调函数，在看门狗线程中调用，检测到卡顿时与卡顿结束时各调用一次
+     */
+    using HangHandler = Action<const HangReport &>;
+
+    /**
+     * @brief 卡顿看门狗，在单独的线程中检查被监视的线程是否在指定时间内没有回到消息循环
+     * @note  被监视的线程在处理消息前后调用Enter与Leave，可以嵌套；在等待消息前后调用Idle与Resume。
+     *        每次调用都表示线程有进展，看门狗只在线程处于忙碌状态且超过阈值没有进展时报告卡顿，
+     *        因此嵌套的消息循环（如模态对话框）在正常处理消息时不会被误报
+     * @note  Enter、Leave、Idle与Resume只能在被监视的线程中调用，开销为几次原子写入与一次读取时钟；
+     *        看门狗线程通过原子变量读取状态，不会阻塞被监视的线程
+     * @note  该类不依赖Win32
+     */
+    class HangWatchdog
+    {
+    public:
+        /**
+         * @brief 最多保留的卡顿记录数，超过时丢弃最早的记录
+         */
+        static constexpr size_t MaxReportCount = 64;
+
+    private:
+        /**
+         * @brief 卡顿阈值（纳秒）
+         */
+        uint64_t _thresholdNs;
+
+        /**
+         * @brief 卡顿的回调函数
+         */
+        HangHandler _handler;
+
+        /**
+         * @brief 状态的序列计数，被监视的线程每次改变状态时加2，写入期间为奇数，看门狗线程以此判断线程是否有进展
+         */
+        std::atomic<uint64_t> _sequence{0};
+
+        /**
+         * @brief 开始忙碌或最近一次有进展的时间，为0时表示线程处于空闲状态
+         */
+        std::atomic<uint64_t> _busySince{0};
+
+        /**
+         * @brief 发布给看门狗线程的当前工作
+         */
+        std::atomic<uint32_t> _activityMessage{0};
+        std::atomic<const char *> _activityClassName{nullptr};
+        std::atomic<uint64_t> _activityHandle{0};
+
+        /**
+         * @brief 当前工作，只由被监视的线程访问
+         */
+        HangActivity _current{};
+
+        /**
+         * @brief Enter的嵌套层数，只由被监视的线程访问
+         */
+        int _depth = 0;
+
+        /**
+         * @brief 保护卡顿记录与停止标记
+         */
+        mutable std::mutex _mutex;
+
+        /**
+         * @brief 用于唤醒看门狗线程以停止
+         */
+        std::condition_variable _cv;
+
+        /**
+         * @brief 是否已请求停止
+         */
+        bool _stopRequested = false;
+
+        /**
+         * @brief 卡顿记录
+         */
+        std::vector<HangReport> _reports{};
+
+        /**
+         * @brief 下一次卡顿的序号
+         */
+        uint64_t _nextReportId = 1;
+
+        /**
+         * @brief 看门狗线程
+         */
+        std::thread _thread;
+
+    public:
+        /**
+         * @brief             初始化并启动看门狗线程
+         * @param thresholdMs 卡顿阈值（毫秒），被监视的线程忙碌且超过该时间没有进展时视为卡顿
+         * @param handler     卡顿的回调函数，在看门狗线程中调用，可以为空，不应抛出异常
+         */
+        explicit HangWatchdog(double thresholdMs, const HangHandler &handler = HangHandler());
+
+        HangWatchdog(const HangWatchdog &)            = delete;
+        HangWatchdog &operator=(const HangWatchdog &) = delete;
+
+        /**
+         * @brief 停止并等待看门狗线程退出
+         */
+        ~HangWatchdog();
+
+        /**
+         * @brief 获取当前时间（纳秒），相对于首次调用该函数的时间，总是大于0
+         */
+        static uint64_t Now();
+
+        /**
+         * @brief          被监视的线程开始一项工作，如处理一条消息
+         * @param activity 工作的内容
+         * @return         之前的工作，需在对应的Leave中传入
+         */
+        HangActivity Enter(const HangActivity &activity);
+
+        /**
+         * @brief          被监视的线程结束一项工作，恢复到之前的工作；回到最外层时进入空闲状态
+         * @param previous 对应的Enter的返回值
+         */
+        void Leave(const HangActivity &previous);
+
+        /**
+         * @brief 被监视的线程开始等待消息，进入空闲状态
+         */
+        void Idle();
+
+        /**
+         * @brief 被监视的线程等待消息结束，若仍处于某项工作中则恢复忙碌状态
+         */
+        void Resume();
+
+        /**
+         * @brief 获取所有卡顿记录，尚未结束的卡顿的时长为当前已持续的时长
+         */
+        std::vector<HangReport> GetReports() const;
+
+        /**
+         * @brief 清除卡顿记录
+         */
+        void ClearReports();
+
+    private:
+        /**
+         * @brief           发布当前的状态，只在被监视的线程中调用
+         * @param busySince 开始忙碌的时间，为0时表示空闲
+         */
+        void _Publish(uint64_t busySince);
+
+        /**
+         * @brief           读取被监视的线程发布的状态
+         * @param busySince 输出开始忙碌的时间
+         * @param activity  输出当前工作
+         * @return          读取时的序列计数
+         */
+        uint64_t _Snapshot(uint64_t &busySince, HangActivity &activity) const;
+
+        /**
+         * @brief 看门狗线程的主函数
+         */
+        void _Run();
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Delegate.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+namespace sw
+{
+    /**
+     * @brief 空闲回调的截止时间，回调通过其判断本轮还能继续工作多久
+     */
+    class IdleDeadline
+    {
+    private:
+        /**
+         * @brief 截止时间
+         */
+        std::chrono::steady_clock::time_point _deadline;
+
+    public:
+        /**
+         * @brief                    初始化截止时间
+         * @param budgetMilliseconds 从现在起的时间预算（毫秒）
+         */
+        explicit IdleDeadline(double budgetMilliseconds);
+
+        /**
+         * @brief 获取距截止时间剩余的毫秒数，已超过截止时间时返回0
+         */
+        double TimeRemaining() const;
+
+        /**
+         * @brief 判断是否还有剩余时间
+         */
+        bool HasTimeRemaining() const;
+    };
+
+    /**
+     * @brief 空闲回调，参数为本轮的截止时间，返回值表示是否还有未完成的工作，返回false时回调被移除
+     */
+    using IdleHandler = Func<IdleDeadline &, bool>;
+
+    /**
+     * @brief 空闲回调队列，消息队列为空时由消息循环在时间预算内轮流执行注册的回调
+     * @note  回调应将工作拆分为小块，并在IdleDeadline没有剩余时间时返回true以便下一轮继续，
+     *        各回调按注册顺序轮流执行，上一轮未轮到的回调在下一轮优先执行
+     * @note  回调中可以添加或移除任意回调（包括自身）
+     * @note  该类不依赖Win32，不是线程安全的，只能在一个线程中使用
+     */
+    class IdleQueue
+    {
+    private:
+        /**
+         * @brief 注册的回调
+         */
+        struct _Item {
+            uint64_t id;         // 回调的标识
+            IdleHandler handler; // 回调
+            bool removed;        // 是否已移除，执行结束后从_items中删除
+        };
+
+        /**
+         * @brief 注册的回调，使用deque保证执行回调期间添加回调不会移动已有的回调
+         */
+        std::deque<_Item> _items{};
+
+        /**
+         * @brief 下一轮首先执行的回调的下标
+         */
+        size_t _cursor = 0;
+
+        /**
+         * @brief 下一个回调的标识
+         */
+        uint64_t _nextId = 1;
+
+        /**
+         * @brief 未移除的回调数
+         */
+        size_t _count = 0;
+
+        /**
+         * @brief 是否正在执行回调
+         */
+        bool _running = false;
+
+    public:
+        /**
+         * @brief         注册空闲回调
+         * @param handler 回调
+         * @return        回调的标识，可用于Remove
+         */
+        uint64_t Add(const IdleHandler &handler);
+
+        /**
+         * @brief  移除空闲回调
+         * @return 回调是否存在
+         */
+        bool Remove(uint64_t id);
+
+        /**
+         * @brief 判断是否有注册的回调
+         */
+        bool HasWork() const;
+
+        /**
+         * @brief 获取注册的回调数
+         */
+        size_t GetCount() const;
+
+        /**
+         * @brief                    在时间预算内轮流执行回调，直到所有回调都完成或超出预算
+         * @param budgetMilliseconds 时间预算（毫秒），至少会执行一个回调
+         * @return                   执行的回调数
+         * @note                     回调抛出异常时异常会传递给调用方，该回调保留在队列中
+         */
+        int Run(double budgetMilliseconds);
+
+    private:
+        /**
+         * @brief 删除已移除的回调
+         */
+        void _Compact();
+    };
+}
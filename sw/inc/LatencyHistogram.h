@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace sw
+{
+    /**
+     * @brief 延迟直方图，以纳秒记录耗时，按对数分段的桶计数
+     * @note  每个2的幂区间再等分为SubBucketCount个桶，相对误差不超过1/SubBucketCount，
+     *        记录一个样本只需计算桶的下标并累加计数，不分配内存
+     * @note  该类不依赖Win32，不是线程安全的
+     */
+    class LatencyHistogram
+    {
+    public:
+        /**
+         * @brief 每个2的幂区间的桶数
+         */
+        static constexpr int SubBucketCount = 8;
+
+        /**
+         * @brief 桶的总数，可区分的最大值约为2^41纳秒（约36分钟），更大的值计入最后一个桶
+         */
+        static constexpr int BucketCount = SubBucketCount * 39;
+
+    private:
+        /**
+         * @brief 各桶的样本数
+         */
+        uint64_t _buckets[BucketCount] = {};
+
+        /**
+         * @brief 样本数
+         */
+        uint64_t _count = 0;
+
+        /**
+         * @brief 样本的总和
+         */
+        uint64_t _total = 0;
+
+        /**
+         * @brief 最小的样本
+         */
+        uint64_t _minimum = 0;
+
+        /**
+         * @brief 最大的样本
+         */
+        uint64_t _maximum = 0;
+
+    public:
+        /**
+         * @brief             记录一个样本
+         * @param nanoseconds 耗时（纳秒）
+         */
+        void Record(uint64_t nanoseconds);
+
+        /**
+         * @brief 将另一个直方图的样本合并到当前直方图
+         */
+        void Merge(const LatencyHistogram &other);
+
+        /**
+         * @brief 清除所有样本
+         */
+        void Clear();
+
+        /**
+         * @brief 获取样本数
+         */
+        uint64_t GetCount() const;
+
+        /**
+         * @brief 获取样本的总和（纳秒）
+         */
+        uint64_t GetTotal() const;
+
+        /**
+         * @brief 获取最小的样本（纳秒），没有样本时返回0
+         */
+        uint64_t GetMinimum() const;
+
+        /**
+         * @brief 获取最大的样本（纳秒），没有样本时返回0
+         */
+        uint64_t GetMaximum() const;
+
+        /**
+         * @brief 获取平均值（纳秒），没有样本时返回0
+         */
+        double GetAverage() const;
+
+        /**
+         * @brief            获取百分位数（纳秒），结果为所在桶的上界且不超过最大的样本
+         * @param percentile 百分位，取值范围为0到100
+         */
+        uint64_t GetPercentile(double percentile) const;
+
+        /**
+         * @brief 获取指定桶的样本数
+         */
+        uint64_t GetBucketCount(int index) const;
+
+        /**
+         * @brief 获取指定桶可容纳的最小值（纳秒）
+         */
+        static uint64_t GetBucketLowerBound(int index);
+
+        /**
+         * @brief 获取指定桶可容纳的最大值（纳秒）
+         */
+        static uint64_t GetBucketUpperBound(int index);
+
+        /**
+         * @brief 获取值所在的桶的下标
+         */
+        static int GetBucketIndex(uint64_t nanoseconds);
+
+        /**
+         * @brief 输出为JSON对象，包括样本数、总和、最值、常用百分位数及非空的桶，时间单位为微秒
+         */
+        std::wstring ToJson() const;
+    };
+}
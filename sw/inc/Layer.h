@@ -2,6 +2,7 @@
 
 #include "LayoutHost.h"
 #include "ScrollEnums.h"
+#include "TimerService.h"
 #include "UIElement.h"
 
 namespace sw
@@ -42,6 +43,21 @@ namespace sw
          */
         bool _mouseWheelScrollEnabled = true;
 
+        /**
+         * @brief 滚动内容的方式
+         */
+        sw::ScrollMode _scrollMode = sw::ScrollMode::Arrange;
+
+        /**
+         * @brief 鼠标滚轮停止滚动后重新安排子元素的定时器所属的定时器服务
+         */
+        TimerService *_wheelSettleService = nullptr;
+
+        /**
+         * @brief 鼠标滚轮停止滚动后重新安排子元素的定时器，首次使用时创建
+         */
+        TimerWheel::TimerId _wheelSettleTimer = 0;
+
     public:
         /**
          * @brief 自定义的布局方式，赋值后将自动与所指向的布局关联，每个布局只能关联一个对象，设为nullptr可恢复默认布局
@@ -88,6 +104,12 @@ namespace sw
          */
         const Property<bool> MouseWheelScrollEnabled;
 
+        /**
+         * @brief 滚动内容的方式，默认为Arrange。子元素较多时使用Blit可使滚动更流畅
+         * @note  Blit模式下滚动过程中子元素不会重新安排，按滚动位置决定子元素的布局（如VirtualizingPanel）不应使用该模式
+         */
+        const Property<sw::ScrollMode> ScrollMode;
+
     public:
         /**
          * @brief 初始化Layer
@@ -115,6 +137,24 @@ namespace sw
          */
         void _MeasureAndArrangeWithoutResize();
 
+        /**
+         * @brief            使用设定的布局方式以指定的客户区尺寸对子元素进行Measure和Arrange，不改变当前的尺寸和DesireSize
+         * @param clientSize 客户区尺寸
+         */
+        void _MeasureAndArrangeWithoutResize(const Size &clientSize);
+
+        /**
+         * @brief            布局偏移量改变后按照ScrollMode移动子元素
+         * @param oldOffsetX 改变前的水平偏移量
+         * @param oldOffsetY 改变前的垂直偏移量
+         */
+        void _ScrollContent(double oldOffsetX, double oldOffsetY);
+
+        /**
+         * @brief Blit模式下鼠标滚轮滚动后调用，在滚动停止一段时间后重新安排子元素
+         */
+        void _ArrangeAfterWheelSettled();
+
     protected:
         /**
          * @brief 更新布局
@@ -178,6 +218,24 @@ namespace sw
          */
         virtual bool OnRoutedEvent(RoutedEventArgs &eventArgs, const RoutedEventHandler &handler) override;
 
+        /**
+         * @brief  判断子元素所需尺寸未改变时，能否只在原来的位置重新安排该子元素而不更新当前元素的布局
+         * @return 未设置布局方式时子元素按照其当前位置安排，布局被禁用时不应更新子元素，此时返回false
+         */
+        virtual bool CanArrangeChildInPlace() override;
+
+        /**
+         * @brief 窗口位置的改变全部提交后调用该函数，此时更新滚动条的范围
+         */
+        virtual void OnArrangeCommitted() override;
+
+        /**
+         * @brief             获取内容在指定方向上的总长度，UpdateScrollRange以此作为滚动条范围
+         * @param orientation 滚动条方向
+         * @return            默认返回子元素的最右侧或最底部的位置，虚拟化的面板可重写该函数返回估算的长度
+         */
+        virtual double GetScrollExtent(ScrollOrientation orientation);
+
     public:
         /**
          * @brief 禁用布局，禁用布局后调用UpdateLayout不会更新布局
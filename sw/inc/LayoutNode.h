@@ -0,0 +1,200 @@
+#pragma once
+
+#include "Alignment.h"
+#include "ILayout.h"
+#include "LayoutHost.h"
+#include "Thickness.h"
+#include "WindowPositioner.h"
+#include <cstdint>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 轻量的布局节点，不依赖窗口句柄，按照与UIElement相同的规则参与Measure和Arrange
+     * @note  可用于在没有Win32环境的平台上单独测试、测量各布局方式
+     */
+    class LayoutNode : public ILayout
+    {
+    private:
+        /**
+         * @brief 布局标记
+         */
+        uint64_t _layoutTag = 0;
+
+        /**
+         * @brief 布局方式，为nullptr时节点按照普通元素处理，不对子节点进行布局
+         */
+        LayoutHost *_layout = nullptr;
+
+        /**
+         * @brief 父节点
+         */
+        LayoutNode *_parent = nullptr;
+
+        /**
+         * @brief 所有子节点，节点不负责子节点的生命周期
+         */
+        std::vector<LayoutNode *> _children{};
+
+        /**
+         * @brief 当前节点所需要占用的尺寸
+         */
+        Size _desireSize{};
+
+        /**
+         * @brief 最近一次Arrange后节点在父节点中的位置，不包含边距
+         */
+        Rect _arrangeRect{};
+
+        /**
+         * @brief 最近一次Arrange后节点的像素位置，节点位置改变时会通过WindowPositioner提交，句柄为节点的地址
+         */
+        PixelRect _pixelRect{};
+
+        /**
+         * @brief 是否已经提交过像素位置
+         */
+        bool _hasPixelRect = false;
+
+    public:
+        /**
+         * @brief 节点自身的尺寸，相当于普通元素的用户区尺寸，在未设置布局方式时作为所需尺寸
+         */
+        Size size{};
+
+        /**
+         * @brief 边距
+         */
+        Thickness margin{};
+
+        /**
+         * @brief 水平对齐方式
+         */
+        HorizontalAlignment horizontalAlignment = HorizontalAlignment::Center;
+
+        /**
+         * @brief 垂直对齐方式
+         */
+        VerticalAlignment verticalAlignment = VerticalAlignment::Center;
+
+    public:
+        /**
+         * @brief 初始化LayoutNode
+         */
+        LayoutNode();
+
+        /**
+         * @brief 初始化指定尺寸的LayoutNode
+         */
+        LayoutNode(const Size &size);
+
+        /**
+         * @brief 析构时会从父节点中移除当前节点
+         */
+        virtual ~LayoutNode();
+
+        LayoutNode(const LayoutNode &)            = delete; // 删除拷贝构造函数
+        LayoutNode &operator=(const LayoutNode &) = delete; // 删除拷贝赋值运算符
+
+    public:
+        /**
+         * @brief        设置布局方式，传入的对象会与当前节点关联，设为nullptr时取消布局
+         * @param layout 布局方式
+         */
+        void SetLayout(LayoutHost *layout);
+
+        /**
+         * @brief 获取布局方式
+         */
+        LayoutHost *GetLayout();
+
+        /**
+         * @brief 设置布局标记
+         */
+        void SetLayoutTag(uint64_t layoutTag);
+
+        /**
+         * @brief 获取父节点
+         */
+        LayoutNode *GetParent();
+
+        /**
+         * @brief 获取子节点数量
+         */
+        int GetChildCount();
+
+        /**
+         * @brief 获取指定索引处的子节点
+         */
+        LayoutNode &GetChildAt(int index);
+
+        /**
+         * @brief  添加子节点，若节点已有父节点则会先从原来的父节点中移除
+         * @return 若函数成功则返回true，否则返回false
+         */
+        bool AddChild(LayoutNode *node);
+
+        /**
+         * @brief  添加子节点并设置布局标记
+         * @return 若函数成功则返回true，否则返回false
+         */
+        bool AddChild(LayoutNode *node, uint64_t layoutTag);
+
+        /**
+         * @brief  移除子节点
+         * @return 移除是否成功
+         */
+        bool RemoveChild(LayoutNode *node);
+
+        /**
+         * @brief 移除所有子节点
+         */
+        void ClearChildren();
+
+        /**
+         * @brief 获取最近一次Arrange后节点在父节点中的位置，不包含边距
+         */
+        Rect GetArrangeRect();
+
+        /**
+         * @brief               对当前节点进行一次完整的布局，相当于以指定的尺寸调用Measure和Arrange
+         * @param availableSize 可用的尺寸
+         * @note                布局过程中所有节点位置的改变会作为一批提交给当前的窗口定位器
+         */
+        void UpdateLayout(const Size &availableSize);
+
+    public:
+        /**
+         * @brief 获取布局标记
+         */
+        virtual uint64_t GetLayoutTag() override;
+
+        /**
+         * @brief 获取子节点的数量
+         */
+        virtual int GetChildLayoutCount() override;
+
+        /**
+         * @brief 获取对应索引处的子节点
+         */
+        virtual ILayout &GetChildLayoutAt(int index) override;
+
+        /**
+         * @brief 获取节点所需尺寸
+         */
+        virtual Size GetDesireSize() override;
+
+        /**
+         * @brief               测量节点所需尺寸
+         * @param availableSize 可用的尺寸
+         */
+        virtual void Measure(const Size &availableSize) override;
+
+        /**
+         * @brief               安排节点位置
+         * @param finalPosition 最终节点所安排的位置
+         */
+        virtual void Arrange(const Rect &finalPosition) override;
+    };
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 布局分析中一个元素的统计信息
+     */
+    struct LayoutProfileNode {
+        const void *element       = nullptr; // 元素的地址，仅用于标识元素
+        const void *parentElement = nullptr; // 父元素的地址
+        const char *name          = "";      // 元素的类型名
+        int parent                = -1;      // 父元素对应节点的索引，父元素未参与本次布局时为-1
+        std::vector<int> children;           // 子元素对应节点的索引
+        uint32_t measureCount     = 0;       // Measure的调用次数，包括命中测量缓存的次数
+        uint32_t measureCacheHits = 0;       // 命中测量缓存的次数
+        uint32_t arrangeCount     = 0;       // Arrange的调用次数
+        uint32_t windowMoves      = 0;       // 移动窗口的次数
+        uint64_t measureNs        = 0;       // Measure的总耗时（纳秒），包括测量子元素的时间
+        uint64_t arrangeNs        = 0;       // Arrange的总耗时（纳秒），包括安排子元素的时间
+    };
+
+    /**
+     * @brief 布局分析中的一次Measure或Arrange调用
+     */
+    struct LayoutProfileEvent {
+        int node;            // 元素对应节点的索引
+        bool arrange;        // 为true时表示Arrange，否则表示Measure
+        bool cacheHit;       // Measure是否命中了测量缓存
+        uint64_t beginNs;    // 开始时间（纳秒），相对于首次记录的时间
+        uint64_t durationNs; // 耗时（纳秒）
+    };
+
+    /**
+     * @brief 一次布局过程的分析结果
+     */
+    struct LayoutProfilePass {
+        uint64_t id         = 0;  // 布局过程的序号，从1开始
+        const char *reason  = ""; // 触发布局的原因，如"Flush"或"UpdateLayout"
+        uint64_t beginNs    = 0;  // 开始时间（纳秒），相对于首次记录的时间
+        uint64_t durationNs = 0;  // 耗时（纳秒）
+        std::vector<LayoutProfileNode> nodes;   // 参与本次布局的元素
+        std::vector<int> roots;                 // 父元素未参与本次布局的节点的索引
+        std::vector<LayoutProfileEvent> events; // 所有Measure与Arrange调用，按开始的顺序排列
+
+        /**
+         * @brief 获取所有元素Measure调用次数的总和
+         */
+        uint32_t GetMeasureCount() const;
+
+        /**
+         * @brief 获取所有元素命中测量缓存次数的总和
+         */
+        uint32_t GetMeasureCacheHits() const;
+
+        /**
+         * @brief 获取所有元素Arrange调用次数的总和
+         */
+        uint32_t GetArrangeCount() const;
+
+        /**
+         * @brief 获取所有元素移动窗口次数的总和
+         */
+        uint32_t GetWindowMoves() const;
+
+        /**
+         * @brief 以缩进的文本形式输出各元素的统计信息，每行一个元素
+         */
+        std::wstring ToString() const;
+    };
+
+    /**
+     * @brief 布局分析器，记录每次布局过程中各元素Measure与Arrange的调用次数、耗时、测量缓存命中次数及窗口移动次数
+     * @note  分析器默认关闭，关闭时各记录点只有一次判断的开销。启用状态是全局的，记录的结果是线程局部的
+     */
+    class LayoutProfiler
+    {
+    private:
+        LayoutProfiler() = delete;
+
+        /**
+         * @brief 是否已启用
+         */
+        static bool _enabled;
+
+    public:
+        /**
+         * @brief 判断分析器是否已启用
+         */
+        static bool IsEnabled()
+        {
+            return _enabled;
+        }
+
+        /**
+         * @brief         启用或关闭分析器，关闭时不会清除已记录的结果
+         * @param enabled 是否启用
+         * @note          应在没有布局进行时调用
+         */
+        static void SetEnabled(bool enabled);
+
+        /**
+         * @brief       设置当前线程最多保留的布局过程数，超过时丢弃最早的结果
+         * @param count 布局过程数，至少为1，默认为16
+         */
+        static void SetMaxPassCount(size_t count);
+
+        /**
+         * @brief 清除当前线程记录的所有结果
+         */
+        static void Clear();
+
+        /**
+         * @brief 获取当前线程保留的布局过程，按时间顺序排列
+         */
+        static const std::vector<LayoutProfilePass> &GetPasses();
+
+        /**
+         * @brief 获取当前线程最近一次完成的布局过程，没有记录时返回nullptr
+         */
+        static const LayoutProfilePass *GetLastPass();
+
+        /**
+         * @brief 将当前线程保留的布局过程输出为Chrome Trace Event格式的JSON，可在chrome://tracing或Perfetto中查看
+         */
+        static std::wstring ToChromeTrace();
+
+        /**
+         * @brief      将ToChromeTrace的结果以UTF-8编码保存到文件
+         * @param path 文件路径
+         * @return     是否保存成功
+         */
+        static bool SaveChromeTrace(const std::string &path);
+
+    public:
+        /**
+         * @brief        开始一次布局过程，可以嵌套调用，只有最外层的调用会开始新的布局过程
+         * @param reason 触发布局的原因，需为字符串常量
+         */
+        static void BeginPass(const char *reason);
+
+        /**
+         * @brief 结束一次布局过程
+         */
+        static void EndPass();
+
+        /**
+         * @brief               开始记录元素的一次Measure调用，不处于布局过程中时会开始一次隐式的布局过程
+         * @param element       元素的地址
+         * @param parentElement 父元素的地址
+         * @param name          元素的类型名，需为字符串常量或typeid(...).name()的结果
+         */
+        static void BeginMeasure(const void *element, const void *parentElement, const char *name);
+
+        /**
+         * @brief          结束最近一次开始记录的Measure调用
+         * @param cacheHit 是否命中了测量缓存
+         */
+        static void EndMeasure(bool cacheHit);
+
+        /**
+         * @brief               开始记录元素的一次Arrange调用，不处于布局过程中时会开始一次隐式的布局过程
+         * @param element       元素的地址
+         * @param parentElement 父元素的地址
+         * @param name          元素的类型名，需为字符串常量或typeid(...).name()的结果
+         */
+        static void BeginArrange(const void *element, const void *parentElement, const char *name);
+
+        /**
+         * @brief 结束最近一次开始记录的Arrange调用
+         */
+        static void EndArrange();
+
+        /**
+         * @brief 记录一次窗口移动，计入当前正在安排的元素
+         */
+        static void RecordWindowMove();
+    };
+}
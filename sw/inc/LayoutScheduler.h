@@ -0,0 +1,101 @@
+#pragma once
+
+#include "MeasureCache.h"
+#include <vector>
+
+namespace sw
+{
+    class UIElement; // UIElement.h
+
+    /**
+     * @brief 布局调度器，合并同一轮消息循环中的布局更新请求，并只更新布局发生变化的子树
+     * @note  调度器的状态是线程局部的，每个线程有各自独立的待更新队列
+     */
+    class LayoutScheduler
+    {
+    private:
+        LayoutScheduler() = delete;
+
+        /**
+         * @brief 待更新的元素及其布局失效前的测量结果
+         */
+        struct _PendingItem {
+            UIElement *element;
+            MeasureCache previous;
+        };
+
+        /**
+         * @brief 需要重新安排的元素及其在界面树中的深度
+         */
+        struct _ArrangeItem {
+            UIElement *element;
+            int depth;
+        };
+
+    public:
+        /**
+         * @brief         将元素加入待更新队列，并在当前消息循环中安排一次布局更新
+         * @param element 布局失效的元素
+         * @note          一般由UIElement::InvalidateMeasure调用，无需手动调用
+         */
+        static void Schedule(UIElement &element);
+
+        /**
+         * @brief         将元素从待更新队列中移除，元素析构时会自动调用该函数
+         * @param element 要移除的元素
+         */
+        static void Cancel(UIElement &element);
+
+        /**
+         * @brief 立即处理当前线程待更新队列中的所有元素
+         * @note  若需要在InvalidateMeasure后立即获取布局结果，可调用该函数
+         */
+        static void Flush();
+
+        /**
+         * @brief 判断当前线程是否有待更新布局的元素
+         */
+        static bool HasPending();
+
+        /**
+         * @brief 获取当前线程最近一次Flush中测量缓存的命中与未命中次数
+         */
+        static MeasureCacheStats GetLastFlushMeasureStats();
+
+    private:
+        /**
+         * @brief          从布局失效的元素开始向上重新测量，直到遇到所需尺寸未改变的元素或根元素，并将其记录为需要重新安排的元素
+         * @param element  布局失效的元素
+         * @param previous 元素布局失效前的测量结果
+         */
+        static void _MeasureUpward(UIElement *element, const MeasureCache &previous);
+
+        /**
+         * @brief          以失效前测量过的每个可用尺寸重新测量元素，判断所需尺寸是否均未改变
+         * @param element  要测量的元素
+         * @param previous 元素布局失效前的测量结果
+         * @return         所需尺寸均未改变时返回true，无法确定时返回false
+         */
+        static bool _IsDesireSizeUnchanged(UIElement *element, const MeasureCache &previous);
+
+        /**
+         * @brief 向待更新队列中的元素投递WM_FlushLayout消息，若已投递则不做任何操作
+         */
+        static void _PostFlushMessage(UIElement *element);
+
+        /**
+         * @brief 获取元素在界面树中的深度，根元素的深度为0
+         */
+        static int _GetDepth(UIElement *element);
+
+        /**
+         * @brief 当前线程待更新的元素
+         */
+        static std::vector<_PendingItem> &_GetPendingElements();
+
+        /**
+         * @brief 当前线程Flush时需要重新安排的元素
+         */
+        static std::vector<_ArrangeItem> &_GetArrangeItems();
+    };
+}
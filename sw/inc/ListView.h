@@ -66,11 +66,60 @@ namespace sw
         operator LVCOLUMNW() const;
     };
 
+    /**
+     * @brief 虚拟模式下为列表视图提供数据的接口，列表视图只在需要显示某一行时才向数据源获取该行的内容
+     */
+    class IListViewDataSource
+    {
+    public:
+        /**
+         * @brief 默认虚析构函数
+         */
+        virtual ~IListViewDataSource() = default;
+
+    public:
+        /**
+         * @brief 获取行数
+         */
+        virtual int GetRowCount() = 0;
+
+        /**
+         * @brief     获取指定单元格的文本
+         * @param row 所在行
+         * @param col 所在列
+         */
+        virtual std::wstring GetCellText(int row, int col) = 0;
+
+        /**
+         * @brief       列表视图即将显示指定范围内的行，可在该函数中预先加载这些行的数据
+         * @param first 第一行的索引
+         * @param last  最后一行的索引（包含）
+         */
+        virtual void PrepareRows(int first, int last);
+
+        /**
+         * @brief         查找第一列文本与指定文本匹配的行，用于键盘输入时定位到对应的行
+         * @param text    要查找的文本，比较时不区分大小写
+         * @param start   开始查找的行
+         * @param partial 为true时只要求行的文本以text开头，否则要求完全相同
+         * @param wrap    查找到最后一行时是否从第一行继续查找
+         * @return        找到的行的索引，未找到时返回-1
+         * @note          默认实现通过GetCellText逐行比较，行数较多时可重写该函数使用数据源自身的索引
+         */
+        virtual int FindRow(const std::wstring &text, int start, bool partial, bool wrap);
+    };
+
     /**
      * @brief 列表视图
      */
     class ListView : public ItemsControl<StrList>
     {
+    private:
+        /**
+         * @brief 虚拟模式的数据源
+         */
+        IListViewDataSource *_dataSource = nullptr;
+
     public:
         /**
          * @brief 列数
@@ -112,6 +161,14 @@ namespace sw
          */
         const Property<bool> Editable;
 
+        /**
+         * @brief 虚拟模式的数据源，不为nullptr时列表视图以LVS_OWNERDATA样式工作，内容全部从数据源获取
+         * @note  切换是否使用数据源会重新创建控件句柄，原有的子项会被清空，列与颜色等设置会保留。
+         *        虚拟模式下AddItem、InsertItem、UpdateItem与RemoveItemAt等修改子项的函数均返回false，
+         *        数据源的行数改变后应调用UpdateRowCount，内容改变后应调用RedrawRows
+         */
+        const Property<IListViewDataSource *> DataSource;
+
     public:
         /**
          * @brief 初始化ListView
@@ -212,6 +269,25 @@ namespace sw
          */
         virtual void OnGetDispInfo(NMLVDISPINFOW *pNMInfo);
 
+        /**
+         * @brief         虚拟模式下当OnNotified接收到LVN_ODCACHEHINT通知时调用该函数
+         * @param pNMHint 包含即将显示的行的范围
+         */
+        virtual void OnCacheHint(NMLVCACHEHINT *pNMHint);
+
+        /**
+         * @brief         虚拟模式下当OnNotified接收到LVN_ODFINDITEMW通知时调用该函数
+         * @param pNMFind 包含查找的条件
+         * @return        找到的行的索引，未找到时返回-1
+         */
+        virtual int OnFindItem(NMLVFINDITEMW *pNMFind);
+
+        /**
+         * @brief           虚拟模式下一组连续的行的状态改变时调用该函数
+         * @param pNMChange 包含状态改变的行的范围与新旧状态
+         */
+        virtual void OnRangeStateChanged(NMLVODSTATECHANGE *pNMChange);
+
         /**
          * @brief  编辑状态结束后调用该函数
          * @return 是否应用新文本
@@ -245,6 +321,23 @@ namespace sw
          */
         virtual bool InsertItem(int index, const StrList &item) override;
 
+        /**
+         * @brief         批量添加子项，添加期间暂停重绘，结束后恢复原来的重绘状态
+         * @param columns 要添加的内容，每一列为一个列表，columns[j][i]为新添加的第i行第j列的文本
+         * @return        成功添加的行数
+         * @note          行数以第一列为准，其余列中缺少的单元格保持为空
+         */
+        int AddItems(const List<StrList> &columns);
+
+        /**
+         * @brief         批量添加子项到指定索引，添加期间暂停重绘，结束后恢复原来的重绘状态
+         * @param index   要插入的位置，超出范围时添加到末尾
+         * @param columns 要添加的内容，每一列为一个列表，columns[j][i]为新添加的第i行第j列的文本
+         * @return        成功添加的行数
+         * @note          行数以第一列为准，其余列中缺少的单元格保持为空
+         */
+        int InsertItems(int index, const List<StrList> &columns);
+
         /**
          * @brief          更新指定位置的子项
          * @param index    要更新子项的位置
@@ -396,6 +489,21 @@ namespace sw
          */
         void CancelEdit();
 
+        /**
+         * @brief  虚拟模式下数据源的行数改变后调用该函数，将列表视图的行数更新为数据源的行数
+         * @return 操作是否成功，不处于虚拟模式时返回false
+         * @note   该操作不会遍历数据源，只有当前可见的行会被重绘，滚动位置保持不变
+         */
+        bool UpdateRowCount();
+
+        /**
+         * @brief       虚拟模式下数据源中某些行的内容改变后调用该函数重绘这些行
+         * @param first 第一行的索引
+         * @param last  最后一行的索引（包含）
+         * @return      操作是否成功
+         */
+        bool RedrawRows(int first, int last);
+
     private:
         /**
          * @brief 获取行数
@@ -417,5 +525,11 @@ namespace sw
          * @return 先前的样式
          */
         DWORD _SetExtendedListViewStyle(DWORD style);
+
+        /**
+         * @brief           重新创建控件句柄以切换LVS_OWNERDATA样式，保留列、扩展样式、颜色与图像列表
+         * @param ownerData 是否使用LVS_OWNERDATA样式
+         */
+        void _UpdateOwnerDataStyle(bool ownerData);
     };
 };
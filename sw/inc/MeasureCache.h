@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Size.h"
+#include <cstdint>
+
+/**
+ * @brief 每个元素最多缓存的测量结果个数
+ * @note  GridLayout在一次布局中会以不同的可用尺寸测量同一子元素两次，默认值为此留有余量
+ */
+#ifndef SW_MEASURE_CACHE_SIZE
+#define SW_MEASURE_CACHE_SIZE 4
+#endif
+
+namespace sw
+{
+    /**
+     * @brief 测量缓存的统计信息
+     */
+    struct MeasureCacheStats {
+        uint64_t hits   = 0; // 命中次数，即Measure时直接使用了缓存的结果
+        uint64_t misses = 0; // 未命中次数，即Measure时调用了MeasureOverride
+    };
+
+    /**
+     * @brief 元素的测量缓存，记录最近几次不同可用尺寸下的所需尺寸
+     * @note  缓存不感知布局是否失效，元素布局失效时需要调用Clear，统计信息是线程局部的
+     */
+    class MeasureCache
+    {
+    public:
+        /**
+         * @brief 最多缓存的测量结果个数
+         */
+        static constexpr int Capacity = SW_MEASURE_CACHE_SIZE;
+
+    private:
+        /**
+         * @brief 一次测量的结果
+         */
+        struct _Entry {
+            Size availableSize;
+            Size desireSize;
+        };
+
+        /**
+         * @brief 按最近使用的顺序排列的测量结果
+         */
+        _Entry _entries[Capacity];
+
+        /**
+         * @brief 当前缓存的测量结果个数
+         */
+        int _count = 0;
+
+        /**
+         * @brief 上次清空后是否因缓存已满丢弃过结果
+         */
+        bool _evicted = false;
+
+    public:
+        /**
+         * @brief               查找可用尺寸对应的所需尺寸，命中时该结果成为最近使用的结果
+         * @param availableSize 可用尺寸
+         * @param desireSize    命中时为缓存的所需尺寸
+         * @return              是否命中
+         */
+        bool TryGet(const Size &availableSize, Size &desireSize);
+
+        /**
+         * @brief               添加一次测量的结果并使其成为最近使用的结果，已有相同可用尺寸的结果时替换该结果，缓存已满时丢弃最久未使用的结果
+         * @param availableSize 可用尺寸
+         * @param desireSize    所需尺寸
+         */
+        void Add(const Size &availableSize, const Size &desireSize);
+
+        /**
+         * @brief 清空缓存
+         */
+        void Clear();
+
+        /**
+         * @brief 获取当前缓存的测量结果个数
+         */
+        int GetCount() const;
+
+        /**
+         * @brief 判断上次清空后是否因缓存已满丢弃过结果，为false时缓存包含清空后测量过的所有可用尺寸
+         */
+        bool HasEvicted() const;
+
+        /**
+         * @brief       获取指定结果的可用尺寸
+         * @param index 结果的索引，0为最近使用的结果
+         */
+        const Size &GetAvailableSizeAt(int index) const;
+
+        /**
+         * @brief       获取指定结果的所需尺寸
+         * @param index 结果的索引，0为最近使用的结果
+         */
+        const Size &GetDesireSizeAt(int index) const;
+
+        /**
+         * @brief 获取当前线程的统计信息
+         */
+        static MeasureCacheStats GetStats();
+
+        /**
+         * @brief 清零当前线程的统计信息
+         */
+        static void ResetStats();
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace sw
+{
+    /**
+     * @brief 一组耗时的统计信息（毫秒）
+     */
+    struct TimingStatistics {
+        uint64_t count = 0; // 样本数
+        double total   = 0; // 总耗时
+        double minimum = 0; // 最短耗时
+        double maximum = 0; // 最长耗时
+
+        /**
+         * @brief 添加一个样本
+         */
+        void Add(double milliseconds);
+
+        /**
+         * @brief 获取平均耗时，没有样本时返回0
+         */
+        double GetAverage() const;
+    };
+
+    /**
+     * @brief 帧节奏模式下传给App::FrameHandler的帧信息
+     */
+    struct MsgLoopFrame {
+        uint64_t index = 0; // 帧序号，从0开始
+        double time    = 0; // 帧的计划时间（毫秒），相对于进入帧节奏模式的时间
+        double delta   = 0; // 与上一帧实际开始时间的间隔（毫秒），第一帧为0
+    };
+
+    /**
+     * @brief 消息循环一轮的计时信息，每轮依次分发已到达的消息、渲染一帧（帧节奏模式）、执行空闲回调，然后等待新的消息
+     */
+    struct MsgLoopTurn {
+        uint64_t index    = 0;     // 轮次序号，从1开始
+        double wait       = 0;     // 本轮开始前等待消息的时间（毫秒）
+        int messageCount  = 0;     // 分发的消息数
+        double dispatch   = 0;     // 分发消息的耗时（毫秒）
+        bool frame        = false; // 是否渲染了一帧
+        double frameTime  = 0;     // FrameHandler的耗时（毫秒）
+        double frameDelta = 0;     // 与上一帧实际开始时间的间隔（毫秒）
+        int skippedFrames = 0;     // 因上一帧或消息处理超时而跳过的帧数
+        int idleCallbacks = 0;     // 执行的空闲回调数
+        double idle       = 0;     // 执行空闲回调的耗时（毫秒）
+    };
+
+    /**
+     * @brief 消息循环的累计统计信息
+     */
+    struct MsgLoopStatistics {
+        uint64_t turns         = 0; // 轮数
+        uint64_t messages      = 0; // 分发的消息总数
+        uint64_t frames        = 0; // 渲染的帧数
+        uint64_t skippedFrames = 0; // 跳过的帧数
+        uint64_t idleCallbacks = 0; // 执行的空闲回调总数
+        TimingStatistics wait;       // 每轮等待消息的时间
+        TimingStatistics dispatch;   // 每轮分发消息的耗时，只统计有消息的轮次
+        TimingStatistics frameTime;  // 每帧FrameHandler的耗时
+        TimingStatistics frameDelta; // 相邻两帧的间隔
+        TimingStatistics idle;       // 每轮执行空闲回调的耗时，只统计执行了回调的轮次
+
+        /**
+         * @brief 累计一轮的计时信息
+         */
+        void Add(const MsgLoopTurn &turn);
+
+        /**
+         * @brief 以多行文本的形式输出统计信息
+         */
+        std::wstring ToString() const;
+    };
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "HangWatchdog.h"
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 消息监视器，记录界面线程中各类消息的处理耗时与排队时间，并可启动卡顿看门狗
+     * @note  监视器默认关闭，关闭时各记录点只有一次判断的开销。启用状态是全局的，直方图与看门狗是线程局部的
+     * @note  处理耗时由WndBase的窗口过程、调度器与定时器服务记录，包括处理期间嵌套处理的其他消息（如模态对话框的消息循环）的时间；
+     *        排队时间由App::MsgLoop按消息的投递时间记录，精度为系统时钟的精度（通常为10到16毫秒），
+     *        WM_InvokeAction与WM_DispatcherWake的排队时间为每个回调从调用Invoke或InvokeAsync到开始执行的时间，精度为纳秒
+     * @note  该类不依赖Win32，消息以数值表示
+     */
+    class MsgMonitor
+    {
+    private:
+        MsgMonitor() = delete;
+
+        /**
+         * @brief 是否已启用，其他线程调用InvokeAsync时同样需要读取
+         */
+        static std::atomic<bool> _enabled;
+
+    public:
+        /**
+         * @brief 记录一次消息处理的作用域，构造时开始计时并通知看门狗，析构时记录处理耗时
+         */
+        class DispatchScope
+        {
+        private:
+            bool _active = false;
+            uint32_t _message;
+            uint64_t _beginNs;
+            HangWatchdog *_watchdog;
+            HangActivity _previous;
+
+        public:
+            /**
+             * @brief           开始处理消息，监视器未启用时不做任何事
+             * @param message   消息
+             * @param className 处理消息的对象的类型名，需为字符串常量或typeid(...).name()的结果
+             * @param handle    处理消息的窗口句柄
+             */
+            DispatchScope(uint32_t message, const char *className, uint64_t handle)
+            {
+                if (MsgMonitor::IsEnabled()) this->_Begin(message, className, handle);
+            }
+
+            DispatchScope(const DispatchScope &)            = delete;
+            DispatchScope &operator=(const DispatchScope &) = delete;
+
+            /**
+             * @brief 结束处理消息并记录耗时
+             */
+            ~DispatchScope()
+            {
+                if (this->_active) this->_End();
+            }
+
+        private:
+            void _Begin(uint32_t message, const char *className, uint64_t handle);
+            void _End();
+        };
+
+        /**
+         * @brief 只通知看门狗的作用域，用于消息循环中不属于某条消息的工作，如帧回调与空闲回调
+         */
+        class BusyScope
+        {
+        private:
+            HangWatchdog *_watchdog = nullptr;
+            HangActivity _previous;
+
+        public:
+            /**
+             * @brief           开始工作，监视器未启用或没有启动看门狗时不做任何事
+             * @param message   正在处理的消息，不属于某条消息时为0
+             * @param className 工作的名称，需为字符串常量
+             * @param handle    相关的窗口句柄
+             */
+            BusyScope(uint32_t message, const char *className, uint64_t handle = 0)
+            {
+                if (MsgMonitor::IsEnabled()) this->_Begin(message, className, handle);
+            }
+
+            BusyScope(const BusyScope &)            = delete;
+            BusyScope &operator=(const BusyScope &) = delete;
+
+            /**
+             * @brief 结束工作
+             */
+            ~BusyScope()
+            {
+                if (this->_watchdog != nullptr) this->_End();
+            }
+
+        private:
+            void _Begin(uint32_t message, const char *className, uint64_t handle);
+            void _End();
+        };
+
+        /**
+         * @brief 记录排队时间的回调包装，执行时记录从创建到执行的时间后调用原回调
+         */
+        template <typename F>
+        struct QueuedCall {
+            F callback;        // 原回调
+            uint32_t message;  // 计入的消息
+            uint64_t queuedNs; // 创建的时间
+
+            void operator()()
+            {
+                MsgMonitor::RecordQueueWait(this->message, MsgMonitor::Now() - this->queuedNs);
+                this->callback();
+            }
+        };
+
+    public:
+        /**
+         * @brief 判断监视器是否已启用
+         */
+        static bool IsEnabled()
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief         启用或关闭监视器，关闭时不会清除已记录的结果，也不会停止看门狗
+         * @param enabled 是否启用
+         */
+        static void SetEnabled(bool enabled);
+
+        /**
+         * @brief 清除当前线程记录的直方图与看门狗的卡顿记录
+         */
+        static void Clear();
+
+        /**
+         * @brief 获取当前时间（纳秒），与HangWatchdog::Now相同
+         */
+        static uint64_t Now();
+
+        /**
+         * @brief             记录一次消息处理的耗时
+         * @param message     消息
+         * @param nanoseconds 耗时（纳秒）
+         */
+        static void RecordDispatch(uint32_t message, uint64_t nanoseconds);
+
+        /**
+         * @brief             记录一次消息的排队时间
+         * @param message     消息
+         * @param nanoseconds 从投递到开始处理的时间（纳秒）
+         */
+        static void RecordQueueWait(uint32_t message, uint64_t nanoseconds);
+
+        /**
+         * @brief          包装回调，使其执行时记录排队时间
+         * @param message  计入的消息
+         * @param callback 原回调
+         */
+        template <typename F>
+        static QueuedCall<typename std::decay<F>::type> MakeQueuedCall(uint32_t message, F &&callback)
+        {
+            return {std::forward<F>(callback), message, Now()};
+        }
+
+        /**
+         * @brief 获取当前线程中指定消息的处理耗时的直方图，没有记录时返回nullptr
+         */
+        static const LatencyHistogram *GetDispatchHistogram(uint32_t message);
+
+        /**
+         * @brief 获取当前线程中指定消息的排队时间的直方图，没有记录时返回nullptr
+         */
+        static const LatencyHistogram *GetQueueWaitHistogram(uint32_t message);
+
+        /**
+         * @brief 获取当前线程中有处理耗时记录的所有消息，按数值排列
+         */
+        static std::vector<uint32_t> GetDispatchMessages();
+
+        /**
+         * @brief 获取当前线程中有排队时间记录的所有消息，按数值排列
+         */
+        static std::vector<uint32_t> GetQueueWaitMessages();
+
+        /**
+         * @brief             为当前线程启动卡顿看门狗并启用监视器，已有看门狗时替换原有的看门狗
+         * @param thresholdMs 卡顿阈值（毫秒），线程处理消息超过该时间没有回到消息循环时视为卡顿
+         * @param handler     卡顿的回调函数，在看门狗线程中调用，可以为空
+         * @return            启动的看门狗
+         */
+        static HangWatchdog &StartWatchdog(double thresholdMs, const HangHandler &handler = HangHandler());
+
+        /**
+         * @brief 停止当前线程的卡顿看门狗，不能在消息处理的作用域中调用
+         */
+        static void StopWatchdog();
+
+        /**
+         * @brief 获取当前线程的卡顿看门狗，没有启动时返回nullptr
+         */
+        static HangWatchdog *GetWatchdog();
+
+        /**
+         * @brief 通知看门狗当前线程开始等待消息
+         */
+        static void NotifyIdle();
+
+        /**
+         * @brief 通知看门狗当前线程等待消息结束
+         */
+        static void NotifyResume();
+
+        /**
+         * @brief 获取消息用于显示的名称，常见的系统消息与SimpleWindow的消息返回其名称，其他消息返回数值
+         */
+        static std::wstring GetMessageName(uint32_t message);
+
+        /**
+         * @brief 将当前线程的直方图与卡顿记录输出为JSON，时间单位为微秒与毫秒
+         */
+        static std::wstring ToJson();
+
+        /**
+         * @brief      将ToJson的结果以UTF-8编码保存到文件
+         * @param path 文件路径
+         * @return     是否保存成功
+         */
+        static bool SaveJson(const std::string &path);
+    };
+}
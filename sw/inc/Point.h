@@ -1,8 +1,11 @@
 #pragma once
 
-#include <Windows.h>
 #include <string>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
 namespace sw
 {
     /**
@@ -29,6 +32,7 @@ namespace sw
          */
         Point(double x, double y);
 
+#if defined(_WIN32)
         /**
          * @brief 从POINT构造Point结构体
          */
@@ -38,6 +42,7 @@ namespace sw
          * @brief 隐式转换POINT
          */
         operator POINT() const;
+#endif
 
         /**
          * @brief 判断两个Point是否相等
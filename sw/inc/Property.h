@@ -38,6 +38,18 @@ namespace sw
     template <typename T>
     class WriteOnlyProperty;
 
+    // 向前声明
+    template <typename TOwner, typename T>
+    class MemberProperty;
+
+    // 向前声明
+    template <typename TOwner, typename T>
+    class ReadOnlyMemberProperty;
+
+    // 向前声明
+    template <typename TOwner, typename T>
+    class WriteOnlyMemberProperty;
+
     // SFINAE templates
     _SW_DEFINE_OPERATION_HELPER(_AddOperationHelper, +);
     _SW_DEFINE_OPERATION_HELPER(_SubOperationHelper, -);
@@ -94,6 +106,27 @@ namespace sw
     struct _IsPropertyImpl<WriteOnlyProperty<T>> : std::true_type {
     };
 
+    /**
+     * @brief _IsPropertyImpl模板特化
+     */
+    template <typename TOwner, typename T>
+    struct _IsPropertyImpl<MemberProperty<TOwner, T>> : std::true_type {
+    };
+
+    /**
+     * @brief _IsPropertyImpl模板特化
+     */
+    template <typename TOwner, typename T>
+    struct _IsPropertyImpl<ReadOnlyMemberProperty<TOwner, T>> : std::true_type {
+    };
+
+    /**
+     * @brief _IsPropertyImpl模板特化
+     */
+    template <typename TOwner, typename T>
+    struct _IsPropertyImpl<WriteOnlyMemberProperty<TOwner, T>> : std::true_type {
+    };
+
     /**
      * @brief 判断类型是否为属性的辅助模板
      */
@@ -1669,4 +1702,123 @@ namespace sw
             this->_setter(value);
         }
     };
+
+    /*================================================================================*/
+
+    /**
+     * @brief 成员属性，getter和setter为以所属对象指针为参数的函数指针
+     * @note  与Property不同，成员属性不使用委托保存getter和setter，构造时不会分配堆内存，
+     *        getter和setter可以是不捕获任何变量的lambda表达式，通过参数访问所属对象
+     */
+    template <typename TOwner, typename T>
+    class MemberProperty : public PropertyBase<T, MemberProperty<TOwner, T>>
+    {
+    public:
+        using TBase = PropertyBase<T, MemberProperty<TOwner, T>>;
+        using FnGet = T (*)(TOwner *);
+        using FnSet = void (*)(TOwner *, const T &);
+        using TBase::operator=;
+
+    private:
+        TOwner *_owner;
+        FnGet _getter;
+        FnSet _setter;
+
+    public:
+        /**
+         * @brief        构造成员属性
+         * @param owner  属性所属的对象
+         * @param getter 获取属性值的函数
+         * @param setter 设置属性值的函数
+         */
+        MemberProperty(TOwner *owner, FnGet getter, FnSet setter)
+            : _owner(owner), _getter(getter), _setter(setter)
+        {
+        }
+
+        /**
+         * @brief 获取属性值
+         */
+        T GetterImpl() const
+        {
+            return this->_getter(this->_owner);
+        }
+
+        /**
+         * @brief 设置属性值
+         */
+        void SetterImpl(const T &value) const
+        {
+            this->_setter(this->_owner, value);
+        }
+    };
+
+    /**
+     * @brief 只读成员属性
+     */
+    template <typename TOwner, typename T>
+    class ReadOnlyMemberProperty : public PropertyBase<T, ReadOnlyMemberProperty<TOwner, T>>
+    {
+    public:
+        using TBase = PropertyBase<T, ReadOnlyMemberProperty<TOwner, T>>;
+        using FnGet = T (*)(TOwner *);
+
+    private:
+        TOwner *_owner;
+        FnGet _getter;
+
+    public:
+        /**
+         * @brief        构造只读成员属性
+         * @param owner  属性所属的对象
+         * @param getter 获取属性值的函数
+         */
+        ReadOnlyMemberProperty(TOwner *owner, FnGet getter)
+            : _owner(owner), _getter(getter)
+        {
+        }
+
+        /**
+         * @brief 获取属性值
+         */
+        T GetterImpl() const
+        {
+            return this->_getter(this->_owner);
+        }
+    };
+
+    /**
+     * @brief 只写成员属性
+     */
+    template <typename TOwner, typename T>
+    class WriteOnlyMemberProperty : public PropertyBase<T, WriteOnlyMemberProperty<TOwner, T>>
+    {
+    public:
+        using TBase = PropertyBase<T, WriteOnlyMemberProperty<TOwner, T>>;
+        using FnSet = void (*)(TOwner *, const T &);
+        using TBase::operator=;
+
+    private:
+        TOwner *_owner;
+        FnSet _setter;
+
+    public:
+        /**
+         * @brief        构造只写成员属性
+         * @param owner  属性所属的对象
+         * @param setter 设置属性值的函数
+         */
+        WriteOnlyMemberProperty(TOwner *owner, FnSet setter)
+            : _owner(owner), _setter(setter)
+        {
+        }
+
+        /**
+         * @brief 设置属性值
+         */
+        void SetterImpl(const T &value) const
+        {
+            this->_setter(this->_owner, value);
+        }
+    };
 }
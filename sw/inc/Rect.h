@@ -2,9 +2,12 @@
 
 #include "Point.h"
 #include "Size.h"
-#include <Windows.h>
 #include <string>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
 namespace sw
 {
     /**
@@ -41,6 +44,7 @@ namespace sw
          */
         Rect(double left, double top, double width, double height);
 
+#if defined(_WIN32)
         /**
          * @brief 从RECT构造Rect
          */
@@ -50,6 +54,7 @@ namespace sw
          * @brief 隐式转换RECT
          */
         operator RECT() const;
+#endif
 
         /**
          * @brief 获取Rect左上角的位置
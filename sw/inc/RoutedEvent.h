@@ -2,6 +2,8 @@
 
 #include "Delegate.h"
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace sw
 {
@@ -172,4 +174,114 @@ namespace sw
      * @note  第一个参数为注册事件监听器的元素，第二个参数为具体的事件参数
      */
     using RoutedEventHandler = Action<UIElement &, RoutedEventArgs &>;
+
+    /**
+     * @brief 路由事件处理函数表，按事件类型保存元素注册的处理函数
+     * @note  表项按事件类型有序存储，并用一个64位掩码记录已注册的类型，
+     *        冒泡时对于未注册该类型处理函数的元素可在常数时间内跳过，且查找不会分配内存
+     * @note  THandler为处理函数的类型，UIElement与WindowlessElement的处理函数的第一个参数类型不同
+     */
+    template <typename THandler>
+    class BasicRoutedEventHandlerTable
+    {
+    private:
+        /**
+         * @brief 表项，处理函数单独分配以保证其地址在表增长时不变，从而允许在处理函数中注册其他事件
+         */
+        struct _Entry {
+            RoutedEventType eventType;
+            std::unique_ptr<THandler> handler;
+        };
+
+        /**
+         * @brief 按事件类型升序排列的表项
+         */
+        std::vector<_Entry> _entries{};
+
+        /**
+         * @brief 已注册事件类型的掩码，第n位表示存在类型值模64等于n的表项
+         */
+        uint64_t _mask = 0;
+
+    public:
+        /**
+         * @brief           查找指定类型的处理函数
+         * @param eventType 路由事件类型
+         * @return          若存在该类型的表项则返回其处理函数，否则返回nullptr
+         * @note            返回的处理函数可能为空委托
+         */
+        THandler *Find(RoutedEventType eventType) const
+        {
+            if ((this->_mask & _GetMaskBit(eventType)) == 0) {
+                return nullptr;
+            }
+
+            size_t index = this->_LowerBound(eventType);
+
+            if (index < this->_entries.size() && this->_entries[index].eventType == eventType) {
+                return this->_entries[index].handler.get();
+            } else {
+                return nullptr;
+            }
+        }
+
+        /**
+         * @brief           获取指定类型的处理函数，若不存在则添加一个空的处理函数
+         * @param eventType 路由事件类型
+         */
+        THandler &GetOrAdd(RoutedEventType eventType)
+        {
+            size_t index = this->_LowerBound(eventType);
+
+            if (index < this->_entries.size() && this->_entries[index].eventType == eventType) {
+                return *this->_entries[index].handler;
+            }
+
+            _Entry entry{eventType, std::unique_ptr<THandler>(new THandler)};
+            this->_entries.insert(this->_entries.begin() + index, std::move(entry));
+            this->_mask |= _GetMaskBit(eventType);
+            return *this->_entries[index].handler;
+        }
+
+        /**
+         * @brief 获取表项的数量
+         */
+        size_t Count() const
+        {
+            return this->_entries.size();
+        }
+
+    private:
+        /**
+         * @brief 获取事件类型在掩码中对应的位
+         */
+        static uint64_t _GetMaskBit(RoutedEventType eventType)
+        {
+            return uint64_t(1) << (uint32_t(eventType) & 63);
+        }
+
+        /**
+         * @brief 获取第一个类型不小于eventType的表项的索引
+         */
+        size_t _LowerBound(RoutedEventType eventType) const
+        {
+            // 表项通常很少，直接二分查找
+            size_t low = 0, high = this->_entries.size();
+
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (this->_entries[mid].eventType < eventType) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+    };
+
+    /**
+     * @brief UIElement的路由事件处理函数表
+     */
+    using RoutedEventHandlerTable = BasicRoutedEventHandlerTable<RoutedEventHandler>;
 }
@@ -32,4 +32,12 @@ namespace sw
         Right         = SB_RIGHT,         // Scrolls to the lower right.
         EndScroll     = SB_ENDSCROLL,     // Ends scroll.
     };
+
+    /**
+     * @brief 滚动内容的方式
+     */
+    enum class ScrollMode {
+        Arrange, // 每次滚动都按新的偏移量重新测量和安排所有子元素
+        Blit,    // 使用ScrollWindowEx移动已绘制的内容与子窗口，只重绘露出的区域，滚动结束时再重新安排
+    };
 }
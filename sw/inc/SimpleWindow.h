@@ -4,7 +4,9 @@
 #include "Alignment.h"
 #include "Animation.h"
 #include "App.h"
+#include "AsyncResult.h"
 #include "BmpBox.h"
+#include "BrushCache.h"
 #include "Button.h"
 #include "ButtonBase.h"
 #include "Canvas.h"
@@ -22,6 +24,8 @@
 #include "Delegate.h"
 #include "Dictionary.h"
 #include "Dip.h"
+#include "DispatchQueue.h"
+#include "Dispatcher.h"
 #include "DockLayout.h"
 #include "DockPanel.h"
 #include "EnumBit.h"
@@ -30,10 +34,13 @@
 #include "FillLayout.h"
 #include "FolderDialog.h"
 #include "Font.h"
+#include "FontCache.h"
 #include "FontDialog.h"
 #include "Grid.h"
 #include "GridLayout.h"
 #include "GroupBox.h"
+#include "HandleCache.h"
+#include "HangWatchdog.h"
 #include "HitTestResult.h"
 #include "HotKeyControl.h"
 #include "HwndHost.h"
@@ -44,21 +51,28 @@
 #include "ITag.h"
 #include "Icon.h"
 #include "IconBox.h"
+#include "IdleQueue.h"
 #include "ImageList.h"
 #include "ItemsControl.h"
 #include "Keys.h"
 #include "KnownColor.h"
 #include "Label.h"
+#include "LatencyHistogram.h"
 #include "Layer.h"
 #include "LayoutHost.h"
+#include "LayoutProfiler.h"
+#include "LayoutScheduler.h"
 #include "List.h"
 #include "ListBox.h"
 #include "ListView.h"
+#include "MeasureCache.h"
 #include "Menu.h"
 #include "MenuBase.h"
 #include "MenuItem.h"
 #include "MonthCalendar.h"
 #include "MsgBox.h"
+#include "MsgLoopStatistics.h"
+#include "MsgMonitor.h"
 #include "Panel.h"
 #include "PanelBase.h"
 #include "PasswordBox.h"
@@ -75,6 +89,7 @@
 #include "ScrollEnums.h"
 #include "Size.h"
 #include "Slider.h"
+#include "SpatialIndex.h"
 #include "Splitter.h"
 #include "StackLayout.h"
 #include "StackLayoutH.h"
@@ -88,12 +103,27 @@
 #include "TextBoxBase.h"
 #include "Thickness.h"
 #include "Timer.h"
+#include "TimerService.h"
+#include "TimerWheel.h"
 #include "ToolTip.h"
 #include "UIElement.h"
 #include "UniformGrid.h"
 #include "UniformGridLayout.h"
 #include "Utils.h"
+#include "VirtualizingLayout.h"
+#include "VirtualizingPanel.h"
+#include "VirtualizingStackPanel.h"
+#include "VirtualizingWrapPanel.h"
 #include "Window.h"
+#include "WindowPositioner.h"
+#include "WindowlessElement.h"
+#include "WindowlessGrid.h"
+#include "WindowlessHost.h"
+#include "WindowlessLabel.h"
+#include "WindowlessPanel.h"
+#include "WindowlessSlot.h"
+#include "WindowlessSplitter.h"
+#include "WindowlessStackPanel.h"
 #include "WndBase.h"
 #include "WndMsg.h"
 #include "WrapLayout.h"
@@ -101,6 +131,8 @@
 #include "WrapLayoutV.h"
 #include "WrapPanel.h"
 
+// MinGW不支持#pragma comment，且会产生-Wunknown-pragmas警告，此时通过CMake链接comctl32
+#if defined(_MSC_VER)
 // 启用视觉样式
 #pragma comment(linker, "\"/manifestdependency:type='win32' \
 name='Microsoft.Windows.Common-Controls' version='6.0.0.0' \
@@ -108,3 +140,4 @@ processorArchitecture='*' publicKeyToken='6595b64144ccf1df' language='*'\"")
 
 // Comctl32
 #pragma comment(lib, "comctl32.lib")
+#endif
@@ -1,8 +1,11 @@
 #pragma once
 
-#include <Windows.h>
 #include <string>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
 namespace sw
 {
     /**
@@ -29,6 +32,7 @@ namespace sw
          */
         Size(double width, double height);
 
+#if defined(_WIN32)
         /**
          * @brief 从SIZE构造Size结构体
          */
@@ -38,6 +42,7 @@ namespace sw
          * @brief 隐式转换SIZE
          */
         operator SIZE() const;
+#endif
 
         /**
          * @brief 判断两个Size是否相等
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Point.h"
+#include "Rect.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 基于均匀网格的空间索引，记录一组矩形并快速查找包含某点或与某矩形相交的项
+     * @note  项以从0开始的整数标识，通常为子元素的索引，索引较大的项视为位于上层。
+     *        查询函数使用内部的去重标记，同一个索引不能同时在多个线程中使用
+     */
+    class SpatialIndex
+    {
+    private:
+        /**
+         * @brief 记录每一项的信息
+         */
+        struct _Item {
+            Rect rect{};           // 项的矩形
+            int cellLeft   = 0;    // 覆盖的第一列网格
+            int cellTop    = 0;    // 覆盖的第一行网格
+            int cellRight  = -1;   // 覆盖的最后一列网格
+            int cellBottom = -1;   // 覆盖的最后一行网格
+            bool inserted  = false; // 是否已加入网格或_largeItems
+            bool large     = false; // 是否覆盖的网格过多而记录在_largeItems中
+        };
+
+        /**
+         * @brief 网格的边长
+         */
+        double _cellSize;
+
+        /**
+         * @brief 所有项，以项的索引为下标
+         */
+        std::vector<_Item> _items{};
+
+        /**
+         * @brief 每个网格中的项，键为网格的行列组合而成的值，只保存非空的网格
+         */
+        std::unordered_map<uint64_t, std::vector<int>> _cells{};
+
+        /**
+         * @brief 覆盖的网格数超过MaxCellsPerItem的项，查询时逐个判断
+         */
+        std::vector<int> _largeItems{};
+
+        /**
+         * @brief 已加入索引的项数
+         */
+        int _insertedCount = 0;
+
+        /**
+         * @brief 每一项最近一次被查询到时的查询序号，用于去重
+         */
+        mutable std::vector<uint32_t> _queryMarks{};
+
+        /**
+         * @brief 当前的查询序号
+         */
+        mutable uint32_t _queryId = 0;
+
+    public:
+        /**
+         * @brief 一项最多加入的网格数，超过时该项不加入网格而在查询时单独判断
+         */
+        static constexpr int MaxCellsPerItem = 64;
+
+        /**
+         * @brief          初始化空间索引
+         * @param cellSize 网格的边长，应与多数项的尺寸相近，小于等于0时使用默认值128
+         */
+        explicit SpatialIndex(double cellSize = 128);
+
+        /**
+         * @brief 获取网格的边长
+         */
+        double GetCellSize() const;
+
+        /**
+         * @brief          设置网格的边长，已有的项会按新的边长重新加入
+         * @param cellSize 网格的边长，小于等于0时忽略
+         */
+        void SetCellSize(double cellSize);
+
+        /**
+         * @brief 获取项的数量上限，即最大的项索引加1
+         */
+        int GetCount() const;
+
+        /**
+         * @brief       设置项的数量上限，索引大于等于count的项会被移除
+         * @param count 项的数量上限
+         */
+        void SetCount(int count);
+
+        /**
+         * @brief 移除所有项
+         */
+        void Clear();
+
+        /**
+         * @brief       添加或更新一项，覆盖的网格不变时只更新记录的矩形
+         * @param index 项的索引，不能小于0
+         * @param rect  项的矩形，宽或高不大于0时该项被移除
+         */
+        void Update(int index, const Rect &rect);
+
+        /**
+         * @brief       移除一项
+         * @param index 项的索引
+         */
+        void Remove(int index);
+
+        /**
+         * @brief       判断一项是否在索引中
+         * @param index 项的索引
+         */
+        bool Contains(int index) const;
+
+        /**
+         * @brief       获取一项的矩形
+         * @param index 项的索引
+         * @return      项的矩形，项不在索引中时返回空矩形
+         */
+        Rect GetRect(int index) const;
+
+        /**
+         * @brief       查找包含指定点的最上层的项，即索引最大的项
+         * @param point 要查找的点
+         * @return      项的索引，没有包含该点的项时返回-1
+         */
+        int HitTest(const Point &point) const;
+
+        /**
+         * @brief        查找包含指定点的所有项
+         * @param point  要查找的点
+         * @param result 按索引从小到大保存结果，查找前会被清空
+         */
+        void QueryPoint(const Point &point, std::vector<int> &result) const;
+
+        /**
+         * @brief        查找与指定矩形相交的所有项
+         * @param rect   要查找的矩形
+         * @param result 按索引从小到大保存结果，查找前会被清空
+         */
+        void QueryRect(const Rect &rect, std::vector<int> &result) const;
+
+    private:
+        /**
+         * @brief 由网格的行列得到_cells的键
+         */
+        static uint64_t _GetCellKey(int col, int row);
+
+        /**
+         * @brief 计算坐标所在的网格
+         */
+        int _GetCell(double pos) const;
+
+        /**
+         * @brief 将项加入其覆盖的网格
+         */
+        void _AddToCells(int index, _Item &item);
+
+        /**
+         * @brief 将项从其覆盖的网格中移除
+         */
+        void _RemoveFromCells(int index, _Item &item);
+
+        /**
+         * @brief 开始一次新的查询并返回查询序号
+         */
+        uint32_t _BeginQuery() const;
+    };
+}
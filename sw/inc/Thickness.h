@@ -1,8 +1,11 @@
 #pragma once
 
-#include <Windows.h>
 #include <string>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
 namespace sw
 {
     /**
@@ -49,6 +52,7 @@ namespace sw
          */
         Thickness(double left, double top, double right, double bottom);
 
+#if defined(_WIN32)
         /**
          * @brief 从RECT结构体构造Thickness结构体
          */
@@ -58,6 +62,7 @@ namespace sw
          * @brief 隐式转换为RECT
          */
         operator RECT() const;
+#endif
 
         /**
          * @brief 判断两个Thickness是否相同
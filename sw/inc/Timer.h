@@ -1,6 +1,8 @@
 #pragma once
 
-#include "WndBase.h"
+#include "Delegate.h"
+#include "Property.h"
+#include "TimerService.h"
 
 namespace sw
 {
@@ -13,10 +15,22 @@ namespace sw
 
     /**
      * @brief 计时器
+     * @note  计时器不创建窗口也不占用单独的系统定时器，同一线程中的所有计时器由TimerService通过一个系统定时器驱动，
+     *        只能在创建计时器的线程中使用
      */
-    class Timer : public WndBase
+    class Timer
     {
     private:
+        /**
+         * @brief 创建计时器的线程的定时器服务
+         */
+        TimerService *_service;
+
+        /**
+         * @brief 计时器在定时器服务中的标识
+         */
+        TimerWheel::TimerId _id;
+
         /**
          * @brief 是否已启动
          */
@@ -27,11 +41,37 @@ namespace sw
          */
         uint32_t _interval = 1000;
 
+        /**
+         * @brief 容差
+         */
+        uint32_t _tolerance = 0;
+
+        /**
+         * @brief 是否重复触发
+         */
+        bool _autoReset = true;
+
     public:
         /**
          * @brief 相对于上一次触发的Tick事件引发下一次Tick事件之间的时间（以毫秒为单位）
          */
-        Property<uint32_t> Interval;
+        const MemberProperty<Timer, uint32_t> Interval;
+
+        /**
+         * @brief 允许Tick事件推迟引发的时间（以毫秒为单位），默认为0，
+         *        设置容差后触发时间相近的计时器会合并到同一次唤醒中，大量计时器同时运行时可以显著减少唤醒次数
+         */
+        const MemberProperty<Timer, uint32_t> Tolerance;
+
+        /**
+         * @brief 是否重复引发Tick事件，默认为true，为false时只引发一次Tick事件，随后计时器自动停止
+         */
+        const MemberProperty<Timer, bool> AutoReset;
+
+        /**
+         * @brief 计时器是否已启动
+         */
+        const ReadOnlyMemberProperty<Timer, bool> IsStarted;
 
         /**
          * @brief 计时器触发事件
@@ -44,6 +84,14 @@ namespace sw
          */
         Timer();
 
+        Timer(const Timer &)            = delete;
+        Timer &operator=(const Timer &) = delete;
+
+        /**
+         * @brief 停止并销毁计时器
+         */
+        virtual ~Timer();
+
         /**
          * @brief 开始计时器
          */
@@ -62,22 +110,13 @@ namespace sw
 
     private:
         /**
-         * @brief      通过窗口句柄获取Timer指针
-         * @param hwnd 窗口句柄
-         * @return     若函数成功则返回对象的指针，否则返回nullptr
-         */
-        static Timer *_GetTimerPtr(HWND hwnd);
-
-        /**
-         * @brief       关联窗口句柄与Timer对象
-         * @param hwnd  窗口句柄
-         * @param timer 与句柄关联的对象
+         * @brief 按当前的参数重新启动计时器
          */
-        static void _SetTimerPtr(HWND hwnd, Timer &timer);
+        void _Restart();
 
         /**
-         * @brief TimerProc回调函数
+         * @brief 定时器服务中的计时器到期时调用该函数
          */
-        static void CALLBACK _TimerProc(HWND hwnd, UINT msg, UINT_PTR idTimer, DWORD time);
+        void _OnTimerExpired();
     };
 }
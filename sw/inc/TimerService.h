@@ -0,0 +1,110 @@
+#pragma once
+
+#include "TimerWheel.h"
+#include <Windows.h>
+#include <cstdint>
+
+namespace sw
+{
+    /**
+     * @brief 界面线程的定时器服务，线程中的所有逻辑定时器通过一个时间轮复用一个系统定时器
+     * @note  每个线程有各自的定时器服务，定时器服务通过一个仅用于接收消息的窗口接收WM_TIMER，
+     *        系统定时器总是设置为时间轮中下一个需要处理的时间，没有启动的定时器时不占用系统定时器
+     * @note  定时器服务及其创建的定时器只能在所属的线程中使用
+     * @note  定时器服务在进程退出前不会释放，线程退出时只销毁接收WM_TIMER的窗口，之后定时器不再到期
+     */
+    class TimerService
+    {
+    private:
+        /**
+         * @brief 接收WM_TIMER的窗口
+         */
+        HWND _hwnd = NULL;
+
+        /**
+         * @brief 时间轮，时间为GetTickCount64的返回值
+         */
+        TimerWheel _wheel;
+
+        /**
+         * @brief 系统定时器当前设置的到期时间，未设置时为UINT64_MAX
+         */
+        uint64_t _armedTime = UINT64_MAX;
+
+        /**
+         * @brief 初始化当前线程的定时器服务
+         */
+        TimerService();
+
+    public:
+        TimerService(const TimerService &)            = delete;
+        TimerService &operator=(const TimerService &) = delete;
+
+        /**
+         * @brief 销毁接收WM_TIMER的窗口
+         */
+        ~TimerService();
+
+        /**
+         * @brief 获取当前线程的定时器服务，首次调用时创建
+         * @note  线程局部变量先于静态对象析构，因此定时器服务不随线程局部变量释放，静态存储期的定时器析构时仍可以访问
+         */
+        static TimerService &GetCurrent();
+
+        /**
+         * @brief          创建定时器，创建后处于停止状态
+         * @param callback 定时器到期时执行的回调
+         */
+        TimerWheel::TimerId Create(DispatchCallable &&callback);
+
+        /**
+         * @brief 销毁定时器
+         */
+        bool Destroy(TimerWheel::TimerId id);
+
+        /**
+         * @brief           启动定时器，已启动的定时器重新开始计时
+         * @param id        定时器的标识
+         * @param delay     从现在起到第一次到期的时间（毫秒）
+         * @param period    周期（毫秒），为0时为一次性定时器
+         * @param tolerance 容差（毫秒），定时器可以推迟至多tolerance毫秒到期，以便与其他定时器合并为一次唤醒
+         */
+        bool Start(TimerWheel::TimerId id, uint32_t delay, uint32_t period = 0, uint32_t tolerance = 0);
+
+        /**
+         * @brief 停止定时器
+         */
+        bool Stop(TimerWheel::TimerId id);
+
+        /**
+         * @brief 判断定时器是否已启动
+         */
+        bool IsActive(TimerWheel::TimerId id) const;
+
+        /**
+         * @brief 获取已启动的定时器数
+         */
+        size_t GetActiveCount() const;
+
+    private:
+        /**
+         * @brief 所属线程退出时销毁接收WM_TIMER的窗口
+         */
+        void _Shutdown();
+
+        /**
+         * @brief 执行到期的定时器并重新设置系统定时器
+         */
+        void _OnTimer();
+
+        /**
+         * @brief 将系统定时器设置为时间轮中下一个需要处理的时间，force为false时只在该时间早于已设置的时间时修改
+         */
+        void _Arm(bool force);
+
+        /**
+         * @brief 接收WM_TIMER的窗口的窗口过程
+         */
+        static LRESULT CALLBACK _WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+    };
+}
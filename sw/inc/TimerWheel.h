@@ -0,0 +1,217 @@
+#pragma once
+
+#include "DispatchQueue.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 分层时间轮，在一个时钟上复用任意数量的逻辑定时器
+     * @note  时间以毫秒为单位的整数表示，由调用方提供（如GetTickCount64或模拟的时钟），时间轮只在Advance时前进。
+     *        共LevelCount层，每层SlotCount个槽，第k层的一个槽覆盖SlotCount^k毫秒，
+     *        定时器按剩余时间放入对应层的槽中，到达上层槽的起始时间时再下放到下层
+     * @note  Start与Stop只需修改双向链表和位图，时间复杂度为O(1)；Advance跳过没有定时器的槽，
+     *        GetNextExpiry通过每层的位图直接找到下一个需要处理的时间，用于设置唯一的系统定时器
+     * @note  定时器的回调在Advance中执行，回调中可以启动、停止、创建或销毁任意定时器（包括自身）。
+     *        回调抛出异常时异常会传递给调用方，尚未执行的到期定时器在下一次Advance时执行
+     * @note  该类不依赖Win32，不是线程安全的，只能在一个线程中使用
+     */
+    class TimerWheel
+    {
+    public:
+        /**
+         * @brief 定时器的标识，0表示无效的定时器
+         */
+        using TimerId = uint64_t;
+
+        /**
+         * @brief 每层的槽数
+         */
+        static constexpr int SlotCount = 64;
+
+        /**
+         * @brief 层数，可直接表示的最长时间为SlotCount^LevelCount毫秒（约12天），更长的定时器会多次下放
+         */
+        static constexpr int LevelCount = 5;
+
+    private:
+        /**
+         * @brief 每层槽号所占的位数
+         */
+        static constexpr int _SlotBits = 6;
+
+        /**
+         * @brief 双向循环链表的节点，槽的链表头为哨兵节点
+         */
+        struct _Node {
+            _Node *prev = this;
+            _Node *next = this;
+        };
+
+        /**
+         * @brief 定时器
+         */
+        struct _Entry : _Node {
+            DispatchCallable callback{};   // 到期时执行的回调
+            uint64_t due        = 0;       // 名义上的到期时间
+            uint64_t expires    = 0;       // 按容差合并后实际的到期时间
+            uint64_t period     = 0;       // 周期，为0时为一次性定时器
+            uint64_t tolerance  = 0;       // 容差
+            uint32_t index      = 0;       // 在_entries中的下标
+            uint32_t generation = 1;       // 每次销毁后加1，用于使旧的TimerId失效
+            int level           = -1;      // 所在的层，-1表示不在任何槽中，LevelCount表示在到期链表中
+            int slot            = 0;       // 所在的槽
+            bool allocated      = false;   // 是否已创建
+            bool destroyPending = false;   // 是否在执行回调期间被销毁
+        };
+
+        /**
+         * @brief 所有定时器，使用deque保证扩容时已有定时器的地址不变
+         */
+        std::deque<_Entry> _entries{};
+
+        /**
+         * @brief 已销毁的定时器的下标
+         */
+        std::vector<uint32_t> _freeList{};
+
+        /**
+         * @brief 各层的槽
+         */
+        _Node _slots[LevelCount][SlotCount];
+
+        /**
+         * @brief 各层非空的槽的位图
+         */
+        uint64_t _bitmaps[LevelCount] = {};
+
+        /**
+         * @brief 已到期等待执行回调的定时器
+         */
+        _Node _expired{};
+
+        /**
+         * @brief 正在执行回调的定时器
+         */
+        _Entry *_firing = nullptr;
+
+        /**
+         * @brief 时间轮已处理到的时间，到期时间不晚于该时间的定时器均已到期
+         */
+        uint64_t _now;
+
+        /**
+         * @brief 已启动的定时器数
+         */
+        size_t _activeCount = 0;
+
+    public:
+        /**
+         * @brief     初始化时间轮
+         * @param now 当前时间
+         */
+        explicit TimerWheel(uint64_t now = 0);
+
+        TimerWheel(const TimerWheel &)            = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        /**
+         * @brief          创建定时器，创建后处于停止状态
+         * @param callback 定时器到期时执行的回调
+         * @return         定时器的标识
+         */
+        TimerId Create(DispatchCallable &&callback);
+
+        /**
+         * @brief  销毁定时器，在定时器自身的回调中销毁时回调执行完毕后才析构
+         * @return 定时器是否存在
+         */
+        bool Destroy(TimerId id);
+
+        /**
+         * @brief           启动定时器，已启动的定时器按新的参数重新开始计时
+         * @param id        定时器的标识
+         * @param due       到期时间，不晚于当前时间时在下一次Advance中到期
+         * @param period    周期，为0时为一次性定时器，到期后自动停止
+         * @param tolerance 容差，定时器可以推迟至多tolerance毫秒到期，以便与其他定时器合并
+         * @return          定时器是否存在
+         */
+        bool Start(TimerId id, uint64_t due, uint64_t period = 0, uint64_t tolerance = 0);
+
+        /**
+         * @brief  停止定时器
+         * @return 定时器是否存在
+         */
+        bool Stop(TimerId id);
+
+        /**
+         * @brief 判断定时器是否存在且已启动
+         */
+        bool IsActive(TimerId id) const;
+
+        /**
+         * @brief     将时间轮前进到指定时间，执行期间到期的定时器的回调
+         * @param now 当前时间，早于时间轮的时间时只执行已到期的回调
+         * @return    执行的回调数
+         * @note      回调按到期时间的顺序执行，执行回调时GetNow返回该定时器实际的到期时间
+         */
+        int Advance(uint64_t now);
+
+        /**
+         * @brief      获取下一次需要调用Advance的时间
+         * @param time 若有已启动的定时器则输出下一次需要调用Advance的时间，该时间不晚于最早到期的定时器
+         * @return     是否有已启动的定时器
+         * @note       只有最早的定时器位于上层时，返回的时间为其所在的槽下放的时间，早于其到期时间
+         */
+        bool GetNextExpiry(uint64_t &time) const;
+
+        /**
+         * @brief 获取时间轮已处理到的时间
+         */
+        uint64_t GetNow() const;
+
+        /**
+         * @brief 获取已启动的定时器数
+         */
+        size_t GetActiveCount() const;
+
+    private:
+        /**
+         * @brief 通过标识获取定时器，定时器不存在时返回nullptr
+         */
+        _Entry *_Find(TimerId id) const;
+
+        /**
+         * @brief 将定时器按实际的到期时间放入对应的槽，已到期时放入到期链表
+         */
+        void _Insert(_Entry *entry);
+
+        /**
+         * @brief 将定时器从所在的槽或到期链表中移除
+         */
+        void _Unlink(_Entry *entry);
+
+        /**
+         * @brief 将链表中的所有节点移动到到期链表末尾
+         */
+        void _SpliceToExpired(_Node &list);
+
+        /**
+         * @brief 将上层槽中的定时器重新放入下层
+         */
+        void _Cascade(int level, int slot);
+
+        /**
+         * @brief  依次执行到期链表中的定时器的回调
+         * @return 执行的回调数
+         */
+        int _RunExpired();
+
+        /**
+         * @brief 析构定时器的回调并回收定时器
+         */
+        void _Free(_Entry *entry);
+    };
+}
@@ -7,16 +7,30 @@
 #include "EventHandlerWrapper.h"
 #include "ILayout.h"
 #include "ITag.h"
+#include "LayoutScheduler.h"
+#include "MeasureCache.h"
 #include "RoutedEvent.h"
 #include "RoutedEventArgs.h"
 #include "Thickness.h"
+#include "WindowPositioner.h"
 #include "WndBase.h"
 #include "WndMsg.h"
 #include <cstdint>
-#include <map>
 #include <string>
 #include <vector>
 
+/**
+ * @brief 是否在获取子元素范围时与逐个遍历子元素的结果进行比对，默认在调试版本中开启
+ * @note  子元素的范围在子元素被安排或移动时增量更新，开启后结果不一致时会触发断言
+ */
+#ifndef SW_VERIFY_CHILD_EXTENT
+#if defined(_DEBUG)
+#define SW_VERIFY_CHILD_EXTENT 1
+#else
+#define SW_VERIFY_CHILD_EXTENT 0
+#endif
+#endif
+
 namespace sw
 {
     /**
@@ -77,6 +91,8 @@ namespace sw
      */
     class UIElement : public WndBase, public ILayout, public ITag
     {
+        friend class LayoutScheduler;
+
     private:
         /**
          * @brief 布局更新条件
@@ -142,9 +158,9 @@ namespace sw
         std::vector<UIElement *> _layoutVisibleChildren{};
 
         /**
-         * @brief 记录路由事件的map
+         * @brief 记录路由事件的处理函数表
          */
-        std::map<RoutedEventType, RoutedEventHandler> _eventMap{};
+        RoutedEventHandlerTable _eventTable{};
 
         /**
          * @brief 储存用户自定义信息
@@ -181,6 +197,21 @@ namespace sw
          */
         double _childBottommost = 0;
 
+        /**
+         * @brief _childRightmost和_childBottommost是否需要重新遍历子元素计算，参与布局的子元素改变或范围最大的子元素缩小时置为true
+         */
+        bool _childExtentInvalid = true;
+
+        /**
+         * @brief 当前元素（包括Margin）在父元素内容中最右边的位置，元素加入父元素、移动或安排时更新，由父元素计算子元素的范围时使用
+         */
+        double _extentRight = 0;
+
+        /**
+         * @brief 当前元素（包括Margin）在父元素内容中最底边的位置，由父元素计算子元素的范围时使用
+         */
+        double _extentBottom = 0;
+
         /**
          * @brief 元素是否悬浮，若元素悬浮则该元素不会随滚动条滚动而改变位置
          */
@@ -227,22 +258,53 @@ namespace sw
         Size _lastMeasureAvailableSize{};
 
         /**
-         * @brief 用于存储批量调整子元素位置时调用DeferWindowPos的句柄
+         * @brief 上一次实际调用MeasureOverride时的可用大小，子元素当前的测量结果与该尺寸对应
+         * @note  与_lastMeasureAvailableSize不同时表示上一次Measure命中了较早的缓存，子元素的测量结果已过时，Arrange前需要重新测量
          */
-        HDWP _hdwpChildren = NULL;
+        Size _lastMeasureOverrideSize{};
 
         /**
-         * @brief OnColor函数中使用的背景画刷句柄
+         * @brief 最近几次Measure的结果，布局失效时清空
          */
-        HBRUSH _hCtlColorBrush = NULL;
+        MeasureCache _measureCache{};
+
+        /**
+         * @brief 上一次Arrange函数调用时的位置
+         */
+        sw::Rect _lastArrangeFinalPosition{};
+
+        /**
+         * @brief 元素是否已被当前的父元素安排过，即_lastArrangeFinalPosition是否有效
+         */
+        bool _hasArranged = false;
+
+        /**
+         * @brief 元素是否在LayoutScheduler的待更新队列中
+         */
+        bool _layoutPending = false;
+
+        /**
+         * @brief 上一次Arrange时窗口的像素位置
+         */
+        PixelRect _lastArrangePixelRect{};
 
         /**
-         * @brief 记录上一次调用OnColor时的文本颜色
+         * @brief 上一次移动窗口时所在批次的序号，用于判断当前批次中是否已有未提交的位置改变
          */
-        COLORREF _lastTextColor = 0;
+        uint64_t _moveBatchId = 0;
 
         /**
-         * @brief 记录上一次调用OnColor时的背景颜色
+         * @brief 是否已登记在批次提交后调用OnArrangeCommitted
+         */
+        bool _arrangeCommittedQueued = false;
+
+        /**
+         * @brief OnColor函数中使用的背景画刷句柄，由BrushCache管理
+         */
+        HBRUSH _hCtlColorBrush = NULL;
+
+        /**
+         * @brief 记录_hCtlColorBrush对应的背景颜色
          */
         COLORREF _lastBackColor = 0;
 
@@ -250,108 +312,108 @@ namespace sw
         /**
          * @brief 边距
          */
-        const Property<Thickness> Margin;
+        const MemberProperty<UIElement, Thickness> Margin;
 
         /**
          * @brief 水平对齐方式
          */
-        const Property<HorizontalAlignment> HorizontalAlignment;
+        const MemberProperty<UIElement, HorizontalAlignment> HorizontalAlignment;
 
         /**
          * @brief 垂直对齐方式
          */
-        const Property<VerticalAlignment> VerticalAlignment;
+        const MemberProperty<UIElement, VerticalAlignment> VerticalAlignment;
 
         /**
          * @brief 子元素数量
          */
-        const ReadOnlyProperty<int> ChildCount;
+        const ReadOnlyMemberProperty<UIElement, int> ChildCount;
 
         /**
          * @brief 是否在不可见时不参与布局
          */
-        const Property<bool> CollapseWhenHide;
+        const MemberProperty<UIElement, bool> CollapseWhenHide;
 
         /**
          * @brief 指向父元素的指针，当前元素为顶级窗口时该值为nullptr
          */
-        const ReadOnlyProperty<UIElement *> Parent;
+        const ReadOnlyMemberProperty<UIElement, UIElement *> Parent;
 
         /**
          * @brief 储存用户自定义信息的标记
          */
-        const Property<uint64_t> Tag;
+        const MemberProperty<UIElement, uint64_t> Tag;
 
         /**
          * @brief 布局标记，对于不同的布局有不同含义
          */
-        const Property<uint64_t> LayoutTag;
+        const MemberProperty<UIElement, uint64_t> LayoutTag;
 
         /**
          * @brief 右键按下时弹出的菜单
          */
-        const Property<sw::ContextMenu *> ContextMenu;
+        const MemberProperty<UIElement, sw::ContextMenu *> ContextMenu;
 
         /**
          * @brief 元素是否悬浮，若元素悬浮则该元素不会随滚动条滚动而改变位置
          */
-        const Property<bool> Float;
+        const MemberProperty<UIElement, bool> Float;
 
         /**
          * @brief 表示用户是否可以通过按下Tab键将焦点移动到当前元素
          */
-        const Property<bool> TabStop;
+        const MemberProperty<UIElement, bool> TabStop;
 
         /**
          * @brief 背景颜色，修改该属性会同时将Transparent属性设为false，对于部分控件该属性可能不生效
          */
-        const Property<Color> BackColor;
+        const MemberProperty<UIElement, Color> BackColor;
 
         /**
          * @brief 文本颜色，修改该属性会同时将InheritTextColor属性设为false，对于部分控件该属性可能不生效
          */
-        const Property<Color> TextColor;
+        const MemberProperty<UIElement, Color> TextColor;
 
         /**
          * @brief 是否使用透明背景（此属性并非真正意义上的透明，将该属性设为true可继承父元素的背景颜色）
          */
-        const Property<bool> Transparent;
+        const MemberProperty<UIElement, bool> Transparent;
 
         /**
          * @brief 是否继承父元素的文本颜色
          */
-        const Property<bool> InheritTextColor;
+        const MemberProperty<UIElement, bool> InheritTextColor;
 
         /**
          * @brief 触发布局更新的条件
          * @note  修改该属性不会立即触发布局更新
          */
-        const Property<sw::LayoutUpdateCondition> LayoutUpdateCondition;
+        const MemberProperty<UIElement, sw::LayoutUpdateCondition> LayoutUpdateCondition;
 
         /**
          * @brief 当前元素的布局状态是否有效
          */
-        const ReadOnlyProperty<bool> IsMeasureValid;
+        const ReadOnlyMemberProperty<UIElement, bool> IsMeasureValid;
 
         /**
          * @brief 最小宽度，当值为负数或0时表示不限制
          */
-        const Property<double> MinWidth;
+        const MemberProperty<UIElement, double> MinWidth;
 
         /**
          * @brief 最小高度，当值为负数或0时表示不限制
          */
-        const Property<double> MinHeight;
+        const MemberProperty<UIElement, double> MinHeight;
 
         /**
          * @brief 最大宽度，当值为负数或0时表示不限制
          */
-        const Property<double> MaxWidth;
+        const MemberProperty<UIElement, double> MaxWidth;
 
         /**
          * @brief 最大高度，当值为负数或0时表示不限制
          */
-        const Property<double> MaxHeight;
+        const MemberProperty<UIElement, double> MaxHeight;
 
     public:
         /**
@@ -443,7 +505,7 @@ namespace sw
         template <typename T>
         void AddHandler(RoutedEventType eventType, T &obj, void (T::*handler)(UIElement &, RoutedEventArgs &))
         {
-            if (handler) this->_eventMap[eventType].Add(obj, handler);
+            if (handler) this->_eventTable.GetOrAdd(eventType).Add(obj, handler);
         }
 
         /**
@@ -525,7 +587,11 @@ namespace sw
         template <typename T>
         bool RemoveHandler(RoutedEventType eventType, T &obj, void (T::*handler)(UIElement &, RoutedEventArgs &))
         {
-            return handler == nullptr ? false : this->_eventMap[eventType].Remove(obj, handler);
+            if (handler == nullptr) {
+                return false;
+            }
+            RoutedEventHandler *eventHandler = this->_eventTable.Find(eventType);
+            return eventHandler != nullptr && eventHandler->Remove(obj, handler);
         }
 
         /**
@@ -789,7 +855,8 @@ namespace sw
         bool IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition condition);
 
         /**
-         * @brief 使元素的布局状态失效，并立即触发布局更新
+         * @brief 使元素的布局状态失效，并在当前消息循环中安排一次布局更新
+         * @note  同一轮消息循环中的多次调用会被合并，若需要立即更新布局可调用LayoutScheduler::Flush
          */
         void InvalidateMeasure();
 
@@ -877,18 +944,26 @@ namespace sw
 
         /**
          * @brief        获取所有子元素在当前元素中最右边的位置（只考虑参与布局的子窗口且忽略悬浮的元素）
-         * @param update 是否更字段
+         * @param update 是否更新字段，字段在子元素被安排或移动时增量维护，更新通常不需要遍历子元素
          * @return       _childRightmost字段
          */
         double GetChildRightmost(bool update);
 
         /**
          * @brief        获取所有子元素在当前元素中最底边的位置（只考虑参与布局的子窗口且忽略悬浮的元素）
-         * @param update 是否更字段
+         * @param update 是否更新字段，字段在子元素被安排或移动时增量维护，更新通常不需要遍历子元素
          * @return       _childBottommost字段
          */
         double GetChildBottommost(bool update);
 
+        /**
+         * @brief    使用ScrollWindowEx滚动客户区中已绘制的内容并移动所有子窗口，只重绘露出的区域
+         * @param dx 水平滚动的像素数
+         * @param dy 垂直滚动的像素数
+         * @note     内部使用，调用前需先修改布局偏移量。子元素因此移动时不会使布局失效，悬浮的元素会被移回原位置
+         */
+        void BlitScrollChildren(int dx, int dy);
+
         /**
          * @brief 更新子元素的Z轴位置
          */
@@ -984,6 +1059,33 @@ namespace sw
          */
         virtual void OnMinMaxSizeChanged();
 
+        /**
+         * @brief  判断子元素所需尺寸未改变时，能否只在原来的位置重新安排该子元素而不更新当前元素的布局
+         * @return 默认返回true，若子元素的位置不完全由布局决定则应返回false
+         */
+        virtual bool CanArrangeChildInPlace();
+
+        /**
+         * @brief 通过QueueArrangeCommitted登记后，在所在批次的窗口位置改变全部提交后调用该函数
+         */
+        virtual void OnArrangeCommitted();
+
+        /**
+         * @brief 登记当前元素，在所在批次的窗口位置改变全部提交后调用OnArrangeCommitted，若当前不处于批次中则立即调用
+         * @note  Arrange中窗口位置的改变会延迟到批次结束时提交，需要依赖窗口实际尺寸的操作应在OnArrangeCommitted中进行
+         */
+        void QueueArrangeCommitted();
+
+        /**
+         * @brief 开始一批窗口位置的改变，批次可以嵌套，所有改变会在最外层的批次结束时一并提交
+         */
+        static void BeginArrangeBatch();
+
+        /**
+         * @brief 结束一批窗口位置的改变，若为最外层的批次则提交所有改变，并调用期间登记的元素的OnArrangeCommitted函数
+         */
+        static void EndArrangeBatch();
+
         /**
          * @brief           路由事件经过当前元素时调用该函数
          * @param eventArgs 事件参数
@@ -1208,11 +1310,32 @@ namespace sw
          */
         void _SetMeasureInvalidated();
 
+        /**
+         * @brief 不使用缓存测量元素，调用MeasureOverride并记录结果
+         */
+        void _MeasureCore(const Size &availableSize);
+
+        /**
+         * @brief 判断当前是否正在提交批次，且窗口已位于上一次Arrange的位置，即窗口位置的改变是由Arrange造成的
+         */
+        bool _IsCommittingOwnArrange();
+
         /**
          * @brief 更新_layoutVisibleChildren的内容
          */
         void _UpdateLayoutVisibleChildren();
 
+        /**
+         * @brief 确保_childRightmost和_childBottommost为最新的值，需要时遍历子元素保存的范围重新计算
+         */
+        void _UpdateChildExtent();
+
+        /**
+         * @brief      当前元素的位置改变后更新其在父元素中的范围，并增量更新父元素的_childRightmost和_childBottommost
+         * @param rect 当前元素新的位置，相对于父元素的客户区
+         */
+        void _UpdateExtentInParent(const sw::Rect &rect);
+
         /**
          * @brief 循环获取界面树上的下一个节点
          */
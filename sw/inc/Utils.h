@@ -86,6 +86,20 @@ namespace sw
          */
         static std::wstring FormatStr(const wchar_t *fmt, ...);
 
+        /**
+         * @brief     将字符串转为JSON字符串，两侧加上引号，并转义引号、反斜杠与控制字符
+         * @param str 输入的字符串
+         * @return    可直接写入JSON的字符串
+         */
+        static std::wstring ToJsonStr(const std::wstring &str);
+
+        /**
+         * @brief      获取类型名用于显示的形式，去掉MSVC的class/struct前缀，GCC与Clang下还原修饰过的名称
+         * @param name typeid(T).name()的返回值，为nullptr时返回空字符串
+         * @return     用于显示的类型名
+         */
+        static std::wstring GetTypeDisplayName(const char *name);
+
     public:
         /**
          * @brief 取两值中的较大值
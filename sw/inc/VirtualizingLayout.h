@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Alignment.h"
+#include "Delegate.h"
+#include "LayoutHost.h"
+#include "Point.h"
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化布局，所有项使用相同的尺寸，只测量和安排与视口相交的项
+     * @note  子元素作为可复用的容器，设子元素数量为n，则第k个子元素显示满足i%n==k且位于实现范围内的第i项，
+     *        未使用的子元素被安排为空矩形。关联对象需在realizeItems中确保子元素数量不少于实现范围内的项数
+     */
+    class VirtualizingLayout : public LayoutHost
+    {
+    private:
+        /**
+         * @brief 最近一次测量时实现的第一项的索引
+         */
+        int _first = 0;
+
+        /**
+         * @brief 最近一次测量时实现的最后一项的下一项的索引
+         */
+        int _last = 0;
+
+    public:
+        /**
+         * @brief 排列方式，与StackLayout和WrapLayout的含义相同
+         */
+        Orientation orientation = Orientation::Vertical;
+
+        /**
+         * @brief 是否自动换行，为true时按WrapLayout的方式排列，否则按StackLayout的方式排列
+         */
+        bool wrap = false;
+
+        /**
+         * @brief 每一项的尺寸，不换行时项在排列方向的垂直方向上会拉伸至与视口相同
+         */
+        Size itemSize{100, 24};
+
+        /**
+         * @brief 项的总数
+         */
+        int itemCount = 0;
+
+        /**
+         * @brief 视口前后额外实现的行数，用于减少滚动时重新绑定容器的次数
+         */
+        int overscan = 2;
+
+        /**
+         * @brief 获取视口左上角在内容中的位置，为空时视为(0,0)
+         */
+        Func<Point> getViewportOffset;
+
+        /**
+         * @brief 测量子元素前调用，参数为需要实现的项的索引范围[first,last)
+         */
+        Action<int, int> realizeItems;
+
+    public:
+        /**
+         * @brief               测量元素所需尺寸，无需考虑边框和边距
+         * @param availableSize 可用的尺寸
+         * @return              返回内容的总尺寸
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief           安排子元素的位置，可重写该函数以实现自定义布局
+         * @param finalSize 可用于排列子元素的最终尺寸
+         */
+        virtual void ArrangeOverride(const Size &finalSize) override;
+
+        /**
+         * @brief              计算需要实现的项的索引范围
+         * @param viewportSize 视口尺寸
+         * @param offset       视口左上角在内容中的位置
+         * @param first        第一项的索引
+         * @param last         最后一项的下一项的索引
+         */
+        void GetRealizedRange(const Size &viewportSize, const Point &offset, int &first, int &last);
+
+        /**
+         * @brief              获取指定项在内容中的位置
+         * @param index        项的索引
+         * @param viewportSize 视口尺寸
+         */
+        Rect GetItemRect(int index, const Size &viewportSize);
+
+        /**
+         * @brief              获取内容的总尺寸
+         * @param viewportSize 视口尺寸
+         */
+        Size GetExtent(const Size &viewportSize);
+
+        /**
+         * @brief            获取子元素在最近一次测量时对应的项的索引
+         * @param childIndex 子元素的索引
+         * @return           未使用的子元素返回-1
+         */
+        int GetItemIndexOfChild(int childIndex);
+
+    private:
+        /**
+         * @brief 滚动方向是否为垂直方向
+         */
+        bool _IsVerticalScroll();
+
+        /**
+         * @brief 获取每行的项数
+         */
+        int _GetItemsPerLine(const Size &viewportSize);
+
+        /**
+         * @brief 获取每一项实际占用的尺寸
+         */
+        Size _GetSlotSize(const Size &viewportSize);
+    };
+}
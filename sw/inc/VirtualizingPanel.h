@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Panel.h"
+#include "VirtualizingLayout.h"
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 创建虚拟化面板中项的容器的函数类型，返回的元素由面板负责释放
+     */
+    using VirtualizingContainerFactory = Func<UIElement *>;
+
+    /**
+     * @brief 将容器绑定到指定索引处的项的函数类型
+     */
+    using VirtualizingContainerPreparer = Action<UIElement &, int>;
+
+    /**
+     * @brief 虚拟化面板，只为与视口相交的项创建和安排容器，滚动时复用已有的容器
+     * @note  面板的子元素全部由面板管理，不应手动添加或移除子元素，需开启滚动条才能浏览全部的项
+     */
+    class VirtualizingPanel : public Panel
+    {
+    private:
+        /**
+         * @brief 默认布局对象
+         */
+        VirtualizingLayout _virtualizingLayout = VirtualizingLayout();
+
+        /**
+         * @brief 由面板创建的所有容器，与子元素的顺序相同
+         */
+        std::vector<UIElement *> _containers{};
+
+        /**
+         * @brief 每个容器当前绑定的项的索引，-1表示未绑定
+         */
+        std::vector<int> _containerItems{};
+
+        /**
+         * @brief 是否正在添加容器，此时添加子元素不需要更新布局
+         */
+        bool _addingContainers = false;
+
+    public:
+        /**
+         * @brief 创建容器的函数，实现的项数超过已有容器的数量时调用
+         */
+        VirtualizingContainerFactory CreateContainer;
+
+        /**
+         * @brief 绑定容器的函数，容器被分配给新的项时调用
+         */
+        VirtualizingContainerPreparer PrepareContainer;
+
+        /**
+         * @brief 项的总数
+         */
+        const Property<int> ItemCount;
+
+        /**
+         * @brief 每一项的尺寸，用于估算内容的总尺寸及计算可见的项
+         */
+        const Property<sw::Size> ItemSize;
+
+        /**
+         * @brief 视口前后额外实现的行数
+         */
+        const Property<int> Overscan;
+
+    public:
+        /**
+         * @brief 初始化VirtualizingPanel
+         */
+        VirtualizingPanel();
+
+        /**
+         * @brief 释放所有容器
+         */
+        virtual ~VirtualizingPanel();
+
+        /**
+         * @brief 重新绑定所有已实现的项，用于项的数据改变时刷新显示
+         */
+        void RefreshItems();
+
+        /**
+         * @brief       滚动使指定索引处的项可见
+         * @param index 项的索引
+         */
+        void ScrollIntoView(int index);
+
+    protected:
+        /**
+         * @brief 获取虚拟化布局对象，派生类通过该对象设置排列方式
+         */
+        VirtualizingLayout &GetVirtualizingLayout();
+
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout() override;
+
+        /**
+         * @brief             获取内容在指定方向上的总长度
+         * @param orientation 滚动条方向
+         * @return            根据项的总数及尺寸估算的长度
+         */
+        virtual double GetScrollExtent(ScrollOrientation orientation) override;
+
+        /**
+         * @brief         添加子元素后调用该函数
+         * @param element 添加的子元素
+         */
+        virtual void OnAddedChild(UIElement &element) override;
+
+    private:
+        /**
+         * @brief       确保容器数量足够并绑定范围内的项
+         * @param first 第一项的索引
+         * @param last  最后一项的下一项的索引
+         */
+        void _RealizeItems(int first, int last);
+
+        /**
+         * @brief 将所有容器标记为未绑定
+         */
+        void _ResetContainerItems();
+    };
+}
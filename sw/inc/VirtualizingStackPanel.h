@@ -0,0 +1,24 @@
+#pragma once
+
+#include "VirtualizingPanel.h"
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化的堆叠面板，按StackPanel的方式排列项
+     */
+    class VirtualizingStackPanel : public VirtualizingPanel
+    {
+    public:
+        /**
+         * @brief 排列方式
+         */
+        const Property<sw::Orientation> Orientation;
+
+    public:
+        /**
+         * @brief 初始化VirtualizingStackPanel
+         */
+        VirtualizingStackPanel();
+    };
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "VirtualizingPanel.h"
+
+namespace sw
+{
+    /**
+     * @brief 虚拟化的自动换行面板，按WrapPanel的方式排列项
+     */
+    class VirtualizingWrapPanel : public VirtualizingPanel
+    {
+    public:
+        /**
+         * @brief 排列方式
+         */
+        const Property<sw::Orientation> Orientation;
+
+    public:
+        /**
+         * @brief 初始化VirtualizingWrapPanel
+         */
+        VirtualizingWrapPanel();
+    };
+}
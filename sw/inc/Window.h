@@ -28,6 +28,17 @@ namespace sw
         CenterOwner,  // 所有者窗口中心
     };
 
+    /**
+     * @brief 窗口绘制的统计信息
+     */
+    struct WindowPaintStats {
+        uint64_t paintCount          = 0; // 处理WM_PAINT的次数
+        uint64_t bytesBlitted        = 0; // 从后台缓冲区复制到窗口的字节数
+        uint64_t bufferReallocations = 0; // 后台缓冲区的分配次数
+        int bufferWidth              = 0; // 当前后台缓冲区的宽度，以像素为单位
+        int bufferHeight             = 0; // 当前后台缓冲区的高度，以像素为单位
+    };
+
     /**
      * @brief 窗口
      */
@@ -84,6 +95,31 @@ namespace sw
          */
         bool _isDestroying = false;
 
+        /**
+         * @brief 后台缓冲区的内存DC
+         */
+        HDC _hdcBackBuffer = NULL;
+
+        /**
+         * @brief 后台缓冲区位图
+         */
+        HBITMAP _hBackBuffer = NULL;
+
+        /**
+         * @brief 内存DC创建时默认选入的位图，释放缓冲区前需要恢复
+         */
+        HBITMAP _hBackBufferOld = NULL;
+
+        /**
+         * @brief 后台缓冲区每个像素的字节数
+         */
+        int _backBufferBytesPerPixel = 0;
+
+        /**
+         * @brief 绘制的统计信息
+         */
+        WindowPaintStats _paintStats{};
+
     public:
         /**
          * @brief 当前线程的活动窗口
@@ -99,74 +135,74 @@ namespace sw
         /**
          * @brief 窗口初次启动的位置
          */
-        const Property<WindowStartupLocation> StartupLocation;
+        const MemberProperty<Window, WindowStartupLocation> StartupLocation;
 
         /**
          * @brief 窗口状态
          */
-        const Property<WindowState> State;
+        const MemberProperty<Window, WindowState> State;
 
         /**
          * @brief 窗口是否可调整大小
          */
-        const Property<bool> SizeBox;
+        const MemberProperty<Window, bool> SizeBox;
 
         /**
          * @brief 最大化按钮是否可用
          */
-        const Property<bool> MaximizeBox;
+        const MemberProperty<Window, bool> MaximizeBox;
 
         /**
          * @brief 最小化按钮是否可用
          */
-        const Property<bool> MinimizeBox;
+        const MemberProperty<Window, bool> MinimizeBox;
 
         /**
          * @brief 窗口是否置顶
          */
-        const Property<bool> Topmost;
+        const MemberProperty<Window, bool> Topmost;
 
         /**
          * @brief 是否显示为ToolWindow (窄边框)
          */
-        const Property<bool> ToolWindow;
+        const MemberProperty<Window, bool> ToolWindow;
 
         /**
          * @brief 窗口顶部的菜单栏
          */
-        const Property<sw::Menu *> Menu;
+        const MemberProperty<Window, sw::Menu *> Menu;
 
         /**
          * @brief  窗口是否显示为模态窗口，当调用ShowDialog时该属性值为true，否则为false
          */
-        const ReadOnlyProperty<bool> IsModal;
+        const ReadOnlyMemberProperty<Window, bool> IsModal;
 
         /**
          * @brief 拥有者窗口
          */
-        const Property<Window *> Owner;
+        const MemberProperty<Window, Window *> Owner;
 
         /**
          * @brief 窗口是否为分层窗口，即WS_EX_LAYERED样式是否被设置
          */
-        const Property<bool> IsLayered;
+        const MemberProperty<Window, bool> IsLayered;
 
         /**
          * @brief 窗口的透明度，范围为0.0~1.0
          * @note  只有将IsLayered设为true该属性才生效，初始值为0.0但需手动设置新值后才会生效
          */
-        const Property<double> Opacity;
+        const MemberProperty<Window, double> Opacity;
 
         /**
          * @brief 窗口无边框
          */
-        const Property<bool> Borderless;
+        const MemberProperty<Window, bool> Borderless;
 
         /**
          * @brief 窗口的对话框结果，ShowDialog返回该值
          * @note  该属性仅在窗口作为模态对话框显示时有效，默认值为0，该属性一旦被设置则会自动关闭窗口
          */
-        const Property<int> DialogResult;
+        const MemberProperty<Window, int> DialogResult;
 
     public:
         /**
@@ -174,6 +210,11 @@ namespace sw
          */
         Window();
 
+        /**
+         * @brief 释放后台缓冲区
+         */
+        virtual ~Window();
+
     protected:
         /**
          * @brief 对WndProc的封装
@@ -293,6 +334,22 @@ namespace sw
          */
         void SizeToContent();
 
+        /**
+         * @brief 获取绘制的统计信息
+         */
+        WindowPaintStats GetPaintStats();
+
+        /**
+         * @brief 清零绘制的统计信息，不影响当前后台缓冲区的尺寸
+         */
+        void ResetPaintStats();
+
+        /**
+         * @brief 释放后台缓冲区，下次绘制时按照当前客户区尺寸重新创建
+         * @note  后台缓冲区只在客户区超出其尺寸时增长，窗口从最大化还原后可调用该函数回收内存
+         */
+        void ReleaseBackBuffer();
+
         /**
          * @brief 设置窗口的默认布局方式
          */
@@ -334,5 +391,14 @@ namespace sw
          * @return 图标句柄
          */
         static HICON _GetWindowDefaultIcon();
+
+        /**
+         * @brief        确保后台缓冲区不小于指定尺寸，增长时额外预留部分空间以减少调整窗口大小时的重新分配
+         * @param hdc    窗口的DC
+         * @param width  所需的宽度
+         * @param height 所需的高度
+         * @return       后台缓冲区是否可用
+         */
+        bool _EnsureBackBuffer(HDC hdc, int width, int height);
     };
 }
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace sw
+{
+    /**
+     * @brief 以像素为单位的窗口位置，坐标相对于父窗口的客户区
+     */
+    struct PixelRect {
+        int left   = 0; // 左边
+        int top    = 0; // 顶边
+        int width  = 0; // 宽度
+        int height = 0; // 高度
+
+        /**
+         * @brief 判断两个PixelRect是否相等
+         */
+        bool operator==(const PixelRect &other) const;
+
+        /**
+         * @brief 判断两个PixelRect是否不相等
+         */
+        bool operator!=(const PixelRect &other) const;
+    };
+
+    /**
+     * @brief 窗口定位器接口，布局时所有窗口位置的改变都通过该接口提交
+     * @note  窗口句柄以void*传递，使该接口不依赖Win32，可在其他平台上记录布局结果
+     */
+    class IWindowPositioner
+    {
+    public:
+        /**
+         * @brief 默认虚析构函数
+         */
+        virtual ~IWindowPositioner() = default;
+
+    public:
+        /**
+         * @brief 开始一批位置改变
+         */
+        virtual void BeginBatch() = 0;
+
+        /**
+         * @brief              记录窗口位置的改变
+         * @param handle       窗口句柄
+         * @param parentHandle 父窗口句柄，父窗口相同的窗口可以合并提交
+         * @param rect         窗口的新位置
+         */
+        virtual void Move(void *handle, void *parentHandle, const PixelRect &rect) = 0;
+
+        /**
+         * @brief 提交当前批次中所有的位置改变
+         */
+        virtual void EndBatch() = 0;
+    };
+
+    /**
+     * @brief 记录所有位置改变的窗口定位器，可用于统计每次布局移动窗口的次数
+     */
+    class RecordingWindowPositioner : public IWindowPositioner
+    {
+    public:
+        /**
+         * @brief 一次位置改变的记录
+         */
+        struct Record {
+            void *handle;       // 窗口句柄
+            void *parentHandle; // 父窗口句柄
+            PixelRect rect;     // 窗口的新位置
+            int batch;          // 所在批次的序号，从0开始
+        };
+
+        /**
+         * @brief 所有位置改变的记录
+         */
+        std::vector<Record> records;
+
+        /**
+         * @brief 已提交的批次数量
+         */
+        int batchCount = 0;
+
+        /**
+         * @brief 记录后将调用转发给该定位器，为nullptr时只记录不移动窗口
+         */
+        IWindowPositioner *next = nullptr;
+
+    public:
+        /**
+         * @brief 开始一批位置改变
+         */
+        virtual void BeginBatch() override;
+
+        /**
+         * @brief 记录窗口位置的改变
+         */
+        virtual void Move(void *handle, void *parentHandle, const PixelRect &rect) override;
+
+        /**
+         * @brief 提交当前批次中所有的位置改变
+         */
+        virtual void EndBatch() override;
+
+        /**
+         * @brief 获取指定批次中位置改变的数量
+         */
+        int GetMoveCount(int batch) const;
+
+        /**
+         * @brief 清空所有记录
+         */
+        void Clear();
+    };
+
+    /**
+     * @brief 管理当前线程使用的窗口定位器，并将嵌套的批次合并为一批
+     * @note  只有最外层的批次结束时才会调用定位器的EndBatch，因此一次布局中所有位置的改变会被一次性提交
+     */
+    class WindowPositioner
+    {
+    private:
+        WindowPositioner() = delete;
+
+    public:
+        /**
+         * @brief 获取默认的窗口定位器，在Windows上为使用DeferWindowPos合并提交的定位器，其他平台上为nullptr
+         */
+        static IWindowPositioner *GetDefault();
+
+        /**
+         * @brief 获取当前线程使用的窗口定位器
+         */
+        static IWindowPositioner *GetCurrent();
+
+        /**
+         * @brief            设置当前线程使用的窗口定位器，传入nullptr时恢复为默认定位器
+         * @param positioner 窗口定位器，调用方负责其生命周期
+         * @note             不应在批次进行中修改定位器
+         */
+        static void SetCurrent(IWindowPositioner *positioner);
+
+        /**
+         * @brief 开始一批位置改变，可以嵌套调用
+         */
+        static void BeginBatch();
+
+        /**
+         * @brief  结束一批位置改变
+         * @return 若结束的是最外层的批次，即位置改变已被提交，则返回true，否则返回false
+         */
+        static bool EndBatch();
+
+        /**
+         * @brief 判断当前是否处于批次中
+         */
+        static bool IsInBatch();
+
+        /**
+         * @brief 获取当前批次的嵌套层数，不处于批次中时为0
+         */
+        static int GetBatchDepth();
+
+        /**
+         * @brief 获取当前批次的序号，每开始一个最外层批次序号加一，可用于判断某个窗口在当前批次中是否已有位置改变
+         */
+        static uint64_t GetBatchId();
+
+        /**
+         * @brief              记录窗口位置的改变，若当前不处于批次中则立即提交
+         * @param handle       窗口句柄
+         * @param parentHandle 父窗口句柄
+         * @param rect         窗口的新位置
+         */
+        static void Move(void *handle, void *parentHandle, const PixelRect &rect);
+    };
+}
@@ -0,0 +1,479 @@
+#pragma once
+
+#include "Alignment.h"
+#include "Delegate.h"
+#include "ILayout.h"
+#include "MeasureCache.h"
+#include "Point.h"
+#include "Property.h"
+#include "RoutedEvent.h"
+#include "RoutedEventArgs.h"
+#include "SpatialIndex.h"
+#include "Thickness.h"
+#include <Windows.h>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace sw
+{
+    class WindowlessElement; // 向前声明
+    class WindowlessHost;    // WindowlessHost.h
+
+    /**
+     * @brief 无窗口元素路由事件的处理函数类型
+     */
+    using WindowlessEventHandler = Action<WindowlessElement &, RoutedEventArgs &>;
+
+    /**
+     * @brief 无窗口元素，不创建窗口句柄，由最近的宿主窗口（WindowlessHost）负责绘制、命中测试及分发鼠标消息
+     * @note  元素的位置为宿主内容区域中的坐标，不包括宿主的滚动偏移量，子元素的生命周期由用户管理
+     */
+    class WindowlessElement : public ILayout
+    {
+        friend class WindowlessHost;
+
+    private:
+        /**
+         * @brief 元素所在的宿主
+         */
+        WindowlessHost *_host = nullptr;
+
+        /**
+         * @brief 父元素
+         */
+        WindowlessElement *_parent = nullptr;
+
+        /**
+         * @brief 所有子元素
+         */
+        std::vector<WindowlessElement *> _children{};
+
+        /**
+         * @brief 参与布局的子元素，即所有Visible为true的子元素
+         */
+        std::vector<WindowlessElement *> _layoutVisibleChildren{};
+
+        /**
+         * @brief 记录路由事件的处理函数表
+         */
+        BasicRoutedEventHandlerTable<WindowlessEventHandler> _eventTable{};
+
+        /**
+         * @brief 布局标记
+         */
+        uint64_t _layoutTag = 0;
+
+        /**
+         * @brief 边距
+         */
+        Thickness _margin{};
+
+        /**
+         * @brief 水平对齐方式
+         */
+        sw::HorizontalAlignment _horizontalAlignment = sw::HorizontalAlignment::Center;
+
+        /**
+         * @brief 垂直对齐方式
+         */
+        sw::VerticalAlignment _verticalAlignment = sw::VerticalAlignment::Center;
+
+        /**
+         * @brief 指定的宽度，为NaN时表示根据内容决定
+         */
+        double _width = std::numeric_limits<double>::quiet_NaN();
+
+        /**
+         * @brief 指定的高度，为NaN时表示根据内容决定
+         */
+        double _height = std::numeric_limits<double>::quiet_NaN();
+
+        /**
+         * @brief 是否可见
+         */
+        bool _visible = true;
+
+        /**
+         * @brief 是否参与命中测试
+         */
+        bool _hitTestVisible = true;
+
+        /**
+         * @brief 元素所需的尺寸，包括边距
+         */
+        Size _desireSize{};
+
+        /**
+         * @brief 元素在宿主内容区域中的位置与尺寸，不包括边距
+         */
+        sw::Rect _bounds{};
+
+        /**
+         * @brief 元素及其所有子孙元素所占的范围，用于绘制时的裁剪与命中测试
+         */
+        sw::Rect _extent{};
+
+        /**
+         * @brief 内容区域左上角在宿主内容区域中的位置，子元素相对于该点安排
+         */
+        Point _contentOrigin{};
+
+        /**
+         * @brief 子元素范围的空间索引，子元素数量达到SpatialIndexThreshold时在Arrange中创建
+         */
+        std::unique_ptr<SpatialIndex> _childIndex{};
+
+        /**
+         * @brief _childIndex是否与当前的子元素一致，添加或移除子元素后需等待下次安排
+         */
+        bool _childIndexValid = false;
+
+        /**
+         * @brief 测量结果的缓存
+         */
+        MeasureCache _measureCache{};
+
+        /**
+         * @brief 上一次Measure函数调用时的可用尺寸
+         */
+        Size _lastMeasureAvailableSize{};
+
+        /**
+         * @brief 上一次实际调用MeasureOverride时的可用尺寸，与_lastMeasureAvailableSize不同时子元素的测量结果已过时
+         */
+        Size _lastMeasureOverrideSize{};
+
+    public:
+        /**
+         * @brief 子元素数量达到该值时使用空间索引进行命中测试与绘制裁剪
+         */
+        static constexpr int SpatialIndexThreshold = 32;
+
+        /**
+         * @brief 边距
+         */
+        const MemberProperty<WindowlessElement, Thickness> Margin;
+
+        /**
+         * @brief 水平对齐方式
+         */
+        const MemberProperty<WindowlessElement, sw::HorizontalAlignment> HorizontalAlignment;
+
+        /**
+         * @brief 垂直对齐方式
+         */
+        const MemberProperty<WindowlessElement, sw::VerticalAlignment> VerticalAlignment;
+
+        /**
+         * @brief 指定的宽度，为NaN时表示根据内容决定，默认为NaN
+         */
+        const MemberProperty<WindowlessElement, double> Width;
+
+        /**
+         * @brief 指定的高度，为NaN时表示根据内容决定，默认为NaN
+         */
+        const MemberProperty<WindowlessElement, double> Height;
+
+        /**
+         * @brief 是否可见，不可见的元素不参与布局、绘制及命中测试
+         */
+        const MemberProperty<WindowlessElement, bool> Visible;
+
+        /**
+         * @brief 是否参与命中测试，为false时鼠标消息会交给其下方的元素
+         */
+        const MemberProperty<WindowlessElement, bool> IsHitTestVisible;
+
+        /**
+         * @brief 布局标记，对于不同的布局有不同含义
+         */
+        const MemberProperty<WindowlessElement, uint64_t> LayoutTag;
+
+        /**
+         * @brief 元素在宿主内容区域中的位置与尺寸，在安排后更新
+         */
+        const ReadOnlyMemberProperty<WindowlessElement, sw::Rect> Bounds;
+
+        /**
+         * @brief 父元素
+         */
+        const ReadOnlyMemberProperty<WindowlessElement, WindowlessElement *> Parent;
+
+        /**
+         * @brief 元素所在的宿主，未添加到宿主时为nullptr
+         */
+        const ReadOnlyMemberProperty<WindowlessElement, WindowlessHost *> Host;
+
+        /**
+         * @brief 子元素数量
+         */
+        const ReadOnlyMemberProperty<WindowlessElement, int> ChildCount;
+
+    public:
+        /**
+         * @brief 初始化WindowlessElement
+         */
+        WindowlessElement();
+
+        /**
+         * @brief 从父元素中移除当前元素并解除与子元素的关系
+         */
+        virtual ~WindowlessElement();
+
+        WindowlessElement(const WindowlessElement &)            = delete;
+        WindowlessElement &operator=(const WindowlessElement &) = delete;
+
+        /**
+         * @brief         添加子元素
+         * @param element 要添加的元素
+         * @return        添加是否成功，元素已有父元素时添加失败
+         */
+        bool AddChild(WindowlessElement *element);
+
+        /**
+         * @brief         添加子元素
+         * @param element 要添加的元素
+         * @return        添加是否成功，元素已有父元素时添加失败
+         */
+        bool AddChild(WindowlessElement &element);
+
+        /**
+         * @brief         移除子元素
+         * @param element 要移除的元素
+         * @return        移除是否成功
+         */
+        bool RemoveChild(WindowlessElement *element);
+
+        /**
+         * @brief         移除子元素
+         * @param element 要移除的元素
+         * @return        移除是否成功
+         */
+        bool RemoveChild(WindowlessElement &element);
+
+        /**
+         * @brief 移除所有子元素
+         */
+        void ClearChildren();
+
+        /**
+         * @brief         获取子元素的索引
+         * @param element 子元素
+         * @return        子元素的索引，不存在时返回-1
+         */
+        int IndexOf(WindowlessElement &element);
+
+        /**
+         * @brief       获取指定索引处的子元素
+         * @param index 子元素的索引
+         */
+        WindowlessElement &operator[](int index) const;
+
+        /**
+         * @brief           添加路由事件处理函数
+         * @param eventType 路由事件类型
+         * @param handler   处理函数
+         */
+        void AddHandler(RoutedEventType eventType, const WindowlessEventHandler &handler);
+
+        /**
+         * @brief             根据事件参数类型添加路由事件处理函数
+         * @tparam TEventArgs 路由事件的参数类型，必须继承自TypedRoutedEventArgs<...>
+         * @param handler     处理函数
+         */
+        template <typename TEventArgs>
+        typename std::enable_if<std::is_base_of<RoutedEventArgs, TEventArgs>::value && sw::_IsTypedRoutedEventArgs<TEventArgs>::value>::type
+        AddHandler(const Action<WindowlessElement &, TEventArgs &> &handler)
+        {
+            if (handler) {
+                this->AddHandler(TEventArgs::EventType, WindowlessEventHandler([handler](WindowlessElement &sender, RoutedEventArgs &args) {
+                                     handler(sender, static_cast<TEventArgs &>(args));
+                                 }));
+            }
+        }
+
+        /**
+         * @brief           移除路由事件处理函数
+         * @param eventType 路由事件类型
+         * @param handler   处理函数
+         * @return          是否成功移除
+         */
+        bool RemoveHandler(RoutedEventType eventType, const WindowlessEventHandler &handler);
+
+        /**
+         * @brief           移除指定类型的所有路由事件处理函数
+         * @param eventType 路由事件类型
+         * @note            表项不会被移除，处理函数可能正在执行
+         */
+        void RemoveAllHandlers(RoutedEventType eventType);
+
+        /**
+         * @brief           触发路由事件，事件从当前元素开始沿父元素向上传递
+         * @param eventArgs 事件参数
+         * @return          事件是否已被处理
+         */
+        bool RaiseRoutedEvent(RoutedEventArgs &eventArgs);
+
+        /**
+         * @brief       获取指定位置处最上层的可命中元素
+         * @param point 宿主内容区域中的位置
+         * @return      命中的元素，可能为当前元素或其后代元素，未命中时返回nullptr
+         * @note        结果基于最近一次安排时的位置
+         */
+        WindowlessElement *HitTest(const Point &point);
+
+        /**
+         * @brief 使当前元素及其祖先元素的测量结果失效，并通知宿主更新布局
+         */
+        void InvalidateMeasure();
+
+        /**
+         * @brief 使元素所在的区域在宿主下次绘制时重绘
+         */
+        void Redraw();
+
+        /**
+         * @brief          绘制当前元素及其子元素
+         * @param hdc      绘制用的DC，原点为宿主内容区域的原点
+         * @param clipRect 需要绘制的区域（像素），不与该区域相交的元素会被跳过
+         */
+        void Draw(HDC hdc, const RECT &clipRect);
+
+        /**
+         * @brief 获取布局标记
+         */
+        virtual uint64_t GetLayoutTag() override;
+
+        /**
+         * @brief 获取参与布局的子元素数量
+         */
+        virtual int GetChildLayoutCount() override;
+
+        /**
+         * @brief 获取对应索引处的子元素，只索引参与布局的子元素
+         */
+        virtual ILayout &GetChildLayoutAt(int index) override;
+
+        /**
+         * @brief 获取当前元素所需尺寸
+         */
+        virtual Size GetDesireSize() override;
+
+        /**
+         * @brief               测量元素所需尺寸，无需考虑边距
+         * @param availableSize 可用的尺寸
+         */
+        virtual void Measure(const Size &availableSize) override;
+
+        /**
+         * @brief               安排元素位置
+         * @param finalPosition 最终元素所安排的位置，相对于父元素的内容区域
+         */
+        virtual void Arrange(const sw::Rect &finalPosition) override;
+
+    protected:
+        /**
+         * @brief 获取内容区域与元素边界之间的距离，如边框与内边距，测量与安排时会自动扣除
+         */
+        virtual Thickness GetContentPadding();
+
+        /**
+         * @brief               测量内容所需的尺寸
+         * @param availableSize 可用的尺寸，已扣除边距与GetContentPadding
+         * @return              内容所需的尺寸，默认返回Size(0, 0)
+         */
+        virtual Size MeasureOverride(const Size &availableSize);
+
+        /**
+         * @brief           安排子元素的位置
+         * @param finalSize 内容区域的尺寸，子元素安排的位置相对于内容区域
+         */
+        virtual void ArrangeOverride(const Size &finalSize);
+
+        /**
+         * @brief      绘制元素自身的内容，子元素在其之后绘制
+         * @param hdc  绘制用的DC
+         * @param rect 元素的边界（像素），原点为宿主内容区域的原点
+         */
+        virtual void OnDraw(HDC hdc, const RECT &rect);
+
+        /**
+         * @brief           路由事件经过当前元素时调用该函数
+         * @param eventArgs 事件参数
+         * @param handler   当前元素注册的处理函数，未注册时为空
+         * @return          若已处理该事件则返回true，否则返回false以调用处理函数
+         */
+        virtual bool OnRoutedEvent(RoutedEventArgs &eventArgs, const WindowlessEventHandler &handler);
+
+        /**
+         * @brief 鼠标进入元素时调用该函数
+         */
+        virtual void OnMouseEnter();
+
+        /**
+         * @brief 鼠标离开元素时调用该函数
+         */
+        virtual void OnMouseLeave();
+
+        /**
+         * @brief         元素所在的宿主改变后调用该函数
+         * @param oldHost 原来的宿主
+         */
+        virtual void OnHostChanged(WindowlessHost *oldHost);
+
+        /**
+         * @brief Visible属性改变后调用该函数
+         */
+        virtual void OnVisibleChanged();
+
+        /**
+         * @brief 宿主的字体改变后调用该函数，依赖字体的元素应在此清除记录的文本尺寸
+         */
+        virtual void OnHostFontChanged();
+
+        /**
+         * @brief 获取父元素内容区域左上角在宿主内容区域中的位置，根元素返回(0, 0)
+         */
+        Point GetParentContentOrigin();
+
+        /**
+         * @brief 获取元素边界对应的像素矩形，原点为宿主内容区域的原点
+         */
+        RECT GetPixelBounds();
+
+        /**
+         * @brief        设置元素的边界，用于重写了Arrange的派生类
+         * @param bounds 元素在宿主内容区域中的位置与尺寸
+         */
+        void SetBounds(const sw::Rect &bounds);
+
+    private:
+        /**
+         * @brief      设置当前元素及其后代元素的宿主
+         * @param host 新的宿主
+         */
+        void _SetHost(WindowlessHost *host);
+
+        /**
+         * @brief 更新参与布局的子元素
+         */
+        void _UpdateLayoutVisibleChildren();
+
+        /**
+         * @brief 安排子元素后更新_extent与_childIndex
+         */
+        void _UpdateExtentAndChildIndex();
+
+        /**
+         * @brief 宿主字体改变时清除当前元素及其后代元素的测量缓存
+         */
+        void _NotifyHostFontChanged();
+
+        /**
+         * @brief 不使用缓存测量元素，调用MeasureOverride并记录结果
+         */
+        void _MeasureCore(const Size &availableSize);
+    };
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "GridLayout.h"
+#include "WindowlessPanel.h"
+
+namespace sw
+{
+    /**
+     * @brief 无窗口网格面板
+     */
+    class WindowlessGrid : public WindowlessPanel
+    {
+    private:
+        /**
+         * @brief 默认布局对象
+         */
+        GridLayout _gridLayout = GridLayout();
+
+    public:
+        /**
+         * @brief 初始化WindowlessGrid
+         */
+        WindowlessGrid();
+
+        /**
+         * @brief 添加行
+         */
+        void AddRow(const GridRow &row);
+
+        /**
+         * @brief 设置行信息
+         */
+        void SetRows(std::initializer_list<GridRow> rows);
+
+        /**
+         * @brief 添加列
+         */
+        void AddColumn(const GridColumn &col);
+
+        /**
+         * @brief 设置列信息
+         */
+        void SetColumns(std::initializer_list<GridColumn> cols);
+
+        /**
+         * @brief 清空行
+         */
+        void ClearRows();
+
+        /**
+         * @brief 清空列
+         */
+        void ClearColumns();
+
+        /**
+         * @brief 获取指定元素的网格布局标记
+         */
+        static GridLayoutTag GetGridLayoutTag(WindowlessElement &element);
+
+        /**
+         * @brief 给指定元素设置网格布局标记
+         */
+        static void SetGridLayoutTag(WindowlessElement &element, const GridLayoutTag &tag);
+
+    protected:
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout() override;
+    };
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Panel.h"
+#include "WindowlessElement.h"
+
+namespace sw
+{
+    /**
+     * @brief 无窗口元素的宿主面板，负责无窗口元素树的布局、绘制、命中测试及鼠标消息的分发
+     * @note  鼠标事件先在命中的无窗口元素上路由，未被处理时再按普通面板的方式触发，事件参数中的坐标为宿主的用户区坐标
+     */
+    class WindowlessHost : public Panel
+    {
+        friend class WindowlessElement;
+
+    private:
+        /**
+         * @brief 将宿主的布局交给无窗口元素树的布局对象
+         */
+        class _ContentLayout : public LayoutHost
+        {
+        public:
+            /**
+             * @brief 所属的宿主
+             */
+            WindowlessHost *host = nullptr;
+
+            /**
+             * @brief 测量内容所需的尺寸
+             */
+            virtual Size MeasureOverride(const Size &availableSize) override;
+
+            /**
+             * @brief 安排内容并重绘宿主
+             */
+            virtual void ArrangeOverride(const Size &finalSize) override;
+        };
+
+        /**
+         * @brief 默认布局对象
+         */
+        _ContentLayout _contentLayout{};
+
+        /**
+         * @brief 无窗口元素树的根元素
+         */
+        WindowlessElement *_content = nullptr;
+
+        /**
+         * @brief 鼠标当前所在的无窗口元素
+         */
+        WindowlessElement *_mouseOverElement = nullptr;
+
+        /**
+         * @brief 是否已请求WM_MOUSELEAVE
+         */
+        bool _trackingMouseLeave = false;
+
+    public:
+        /**
+         * @brief 无窗口元素树的根元素，元素不能已有父元素或宿主，元素的生命周期由用户管理
+         */
+        const Property<WindowlessElement *> Content;
+
+        /**
+         * @brief 鼠标当前所在的无窗口元素
+         */
+        const ReadOnlyProperty<WindowlessElement *> MouseOverElement;
+
+    public:
+        /**
+         * @brief 初始化WindowlessHost
+         */
+        WindowlessHost();
+
+        /**
+         * @brief 解除与无窗口元素树的关系
+         */
+        virtual ~WindowlessHost();
+
+        /**
+         * @brief       获取指定位置处最上层的可命中无窗口元素
+         * @param point 用户区中的位置
+         * @return      命中的元素，未命中时返回nullptr
+         */
+        WindowlessElement *HitTestElement(const Point &point);
+
+    protected:
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout() override;
+
+        /**
+         * @brief             获取内容在指定方向上的总长度
+         * @param orientation 滚动条方向
+         * @return            根元素所需的尺寸
+         */
+        virtual double GetScrollExtent(ScrollOrientation orientation) override;
+
+        /**
+         * @brief  接收到WM_PAINT时调用该函数
+         * @return 若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnPaint() override;
+
+        /**
+         * @brief       字体改变时调用该函数
+         * @param hfont 字体句柄
+         */
+        virtual void FontChanged(HFONT hfont) override;
+
+        /**
+         * @brief               接收到WM_MOUSEMOVE时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseMove(Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief  接收到WM_MOUSELEAVE时调用该函数
+         * @return 若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseLeave() override;
+
+        /**
+         * @brief               接收到WM_MOUSEWHEEL时调用该函数
+         * @param wheelDelta    滚轮滚动的距离，为120的倍数
+         * @param mousePosition 鼠标在屏幕中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseWheel(int wheelDelta, Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief               接收到WM_LBUTTONDOWN时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseLeftButtonDown(Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief               接收到WM_LBUTTONUP时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseLeftButtonUp(Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief               接收到WM_RBUTTONDOWN时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseRightButtonDown(Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief               接收到WM_RBUTTONUP时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseRightButtonUp(Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief               接收到WM_MBUTTONDOWN时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseMiddleButtonDown(Point mousePosition, MouseKey keyState) override;
+
+        /**
+         * @brief               接收到WM_MBUTTONUP时调用该函数
+         * @param mousePosition 鼠标在用户区中的位置
+         * @param keyState      指示某些按键是否按下
+         * @return              若已处理该消息则返回true，否则返回false以调用DefaultWndProc
+         */
+        virtual bool OnMouseMiddleButtonUp(Point mousePosition, MouseKey keyState) override;
+
+    private:
+        /**
+         * @brief         在指定位置处命中的无窗口元素上触发路由事件
+         * @param point   用户区中的位置
+         * @param args    事件参数
+         * @param handled 事件是否已被处理
+         * @return        事件被处理时返回args.handledMsg
+         */
+        bool _RaiseElementEvent(const Point &point, RoutedEventArgs &args, bool &handled);
+
+        /**
+         * @brief      使无窗口元素树中的指定区域在下次绘制时重绘
+         * @param rect 宿主内容区域中的像素矩形
+         */
+        void _InvalidateContentRect(const RECT &rect);
+
+        /**
+         * @brief         无窗口元素离开宿主时调用该函数
+         * @param element 离开的元素
+         */
+        void _OnElementDetached(WindowlessElement &element);
+
+        /**
+         * @brief         更新鼠标所在的无窗口元素
+         * @param element 鼠标所在的元素
+         */
+        void _SetMouseOverElement(WindowlessElement *element);
+    };
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Color.h"
+#include "Label.h"
+#include "WindowlessElement.h"
+#include <string>
+
+namespace sw
+{
+    /**
+     * @brief 无窗口标签，使用宿主的字体绘制文本
+     */
+    class WindowlessLabel : public WindowlessElement
+    {
+    private:
+        /**
+         * @brief 文本
+         */
+        std::wstring _text{};
+
+        /**
+         * @brief 文本颜色
+         */
+        Color _textColor = KnownColor::ControlText;
+
+        /**
+         * @brief 是否使用宿主的文本颜色
+         */
+        bool _inheritTextColor = true;
+
+        /**
+         * @brief 文本的水平对齐方式
+         */
+        sw::HorizontalAlignment _horizontalContentAlignment = sw::HorizontalAlignment::Left;
+
+        /**
+         * @brief 文本的垂直对齐方式
+         */
+        sw::VerticalAlignment _verticalContentAlignment = sw::VerticalAlignment::Center;
+
+        /**
+         * @brief 文本过长时末尾的处理方式
+         */
+        sw::TextTrimming _textTrimming = sw::TextTrimming::None;
+
+        /**
+         * @brief 是否自动换行
+         */
+        bool _autoWrap = false;
+
+        /**
+         * @brief 单行文本所需的尺寸
+         */
+        Size _textSize{};
+
+        /**
+         * @brief 计算_textSize时使用的字体，为NULL时表示_textSize需要重新计算
+         */
+        HFONT _textSizeFont = NULL;
+
+    public:
+        /**
+         * @brief 文本
+         */
+        const MemberProperty<WindowlessLabel, std::wstring> Text;
+
+        /**
+         * @brief 文本颜色，修改该属性会同时将InheritTextColor属性设为false
+         */
+        const MemberProperty<WindowlessLabel, Color> TextColor;
+
+        /**
+         * @brief 是否使用宿主的文本颜色，默认为true
+         */
+        const MemberProperty<WindowlessLabel, bool> InheritTextColor;
+
+        /**
+         * @brief 文本的水平对齐方式，Stretch视为Left
+         */
+        const MemberProperty<WindowlessLabel, sw::HorizontalAlignment> HorizontalContentAlignment;
+
+        /**
+         * @brief 文本的垂直对齐方式，Stretch视为Top
+         */
+        const MemberProperty<WindowlessLabel, sw::VerticalAlignment> VerticalContentAlignment;
+
+        /**
+         * @brief 文本过长时末尾的处理方式
+         */
+        const MemberProperty<WindowlessLabel, sw::TextTrimming> TextTrimming;
+
+        /**
+         * @brief 是否自动换行
+         */
+        const MemberProperty<WindowlessLabel, bool> AutoWrap;
+
+    public:
+        /**
+         * @brief 初始化WindowlessLabel
+         */
+        WindowlessLabel();
+
+    protected:
+        /**
+         * @brief               测量文本所需的尺寸
+         * @param availableSize 可用的尺寸
+         * @return              文本所需的尺寸
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief      绘制文本
+         * @param hdc  绘制用的DC
+         * @param rect 元素的边界（像素）
+         */
+        virtual void OnDraw(HDC hdc, const RECT &rect) override;
+
+        /**
+         * @brief         元素所在的宿主改变后调用该函数
+         * @param oldHost 原来的宿主
+         */
+        virtual void OnHostChanged(WindowlessHost *oldHost) override;
+
+        /**
+         * @brief 宿主的字体改变后调用该函数
+         */
+        virtual void OnHostFontChanged() override;
+
+    private:
+        /**
+         * @brief 使用宿主的字体更新_textSize
+         */
+        void _UpdateTextSize();
+
+        /**
+         * @brief 获取绘制文本时使用的DrawText格式
+         */
+        UINT _GetDrawTextFormat();
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Color.h"
+#include "FillLayout.h"
+#include "Panel.h"
+#include "WindowlessElement.h"
+
+namespace sw
+{
+    /**
+     * @brief 无窗口面板，通过布局对象安排子元素，可绘制背景与边框
+     */
+    class WindowlessPanel : public WindowlessElement
+    {
+    private:
+        /**
+         * @brief 默认布局对象
+         */
+        FillLayout _defaultLayout = FillLayout();
+
+        /**
+         * @brief 用户设置的布局对象
+         */
+        LayoutHost *_customLayout = nullptr;
+
+        /**
+         * @brief 背景颜色
+         */
+        Color _backColor = KnownColor::Control;
+
+        /**
+         * @brief 是否不绘制背景
+         */
+        bool _transparent = true;
+
+        /**
+         * @brief 边框类型
+         */
+        sw::BorderStyle _borderStyle = sw::BorderStyle::None;
+
+        /**
+         * @brief 内边距
+         */
+        Thickness _padding{};
+
+    public:
+        /**
+         * @brief 背景颜色，修改该属性会同时将Transparent属性设为false
+         */
+        const MemberProperty<WindowlessPanel, Color> BackColor;
+
+        /**
+         * @brief 是否不绘制背景，默认为true
+         */
+        const MemberProperty<WindowlessPanel, bool> Transparent;
+
+        /**
+         * @brief 边框类型
+         */
+        const MemberProperty<WindowlessPanel, sw::BorderStyle> BorderStyle;
+
+        /**
+         * @brief 内边距
+         */
+        const MemberProperty<WindowlessPanel, Thickness> Padding;
+
+        /**
+         * @brief 自定义的布局对象，为nullptr时使用默认布局
+         */
+        const MemberProperty<WindowlessPanel, LayoutHost *> Layout;
+
+    public:
+        /**
+         * @brief 初始化WindowlessPanel
+         */
+        WindowlessPanel();
+
+    protected:
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout();
+
+        /**
+         * @brief 获取边框与内边距的总宽度
+         */
+        virtual Thickness GetContentPadding() override;
+
+        /**
+         * @brief               通过布局对象测量子元素
+         * @param availableSize 可用的尺寸
+         * @return              子元素所需的尺寸
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief           通过布局对象安排子元素
+         * @param finalSize 内容区域的尺寸
+         */
+        virtual void ArrangeOverride(const Size &finalSize) override;
+
+        /**
+         * @brief      绘制背景与边框
+         * @param hdc  绘制用的DC
+         * @param rect 元素的边界（像素）
+         */
+        virtual void OnDraw(HDC hdc, const RECT &rect) override;
+
+    private:
+        /**
+         * @brief 获取当前使用的布局对象
+         */
+        LayoutHost *_GetLayout();
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "UIElement.h"
+#include "WindowlessElement.h"
+
+namespace sw
+{
+    /**
+     * @brief 在无窗口元素树中占位的元素，用于在无窗口面板中放置普通的窗口元素
+     * @note  所放置的元素会作为宿主的子元素添加，其测量与安排由该占位元素代为进行，元素的生命周期由用户管理
+     */
+    class WindowlessSlot : public WindowlessElement
+    {
+    private:
+        /**
+         * @brief 所放置的窗口元素
+         */
+        UIElement *_element = nullptr;
+
+    public:
+        /**
+         * @brief 所放置的窗口元素，不能已有父元素
+         */
+        const MemberProperty<WindowlessSlot, UIElement *> Element;
+
+    public:
+        /**
+         * @brief 初始化WindowlessSlot
+         */
+        WindowlessSlot();
+
+        /**
+         * @brief 将所放置的元素从宿主中移除
+         */
+        virtual ~WindowlessSlot();
+
+        /**
+         * @brief 获取所放置元素所需的尺寸
+         */
+        virtual Size GetDesireSize() override;
+
+        /**
+         * @brief               测量所放置的元素
+         * @param availableSize 可用的尺寸
+         */
+        virtual void Measure(const Size &availableSize) override;
+
+        /**
+         * @brief               安排所放置的元素
+         * @param finalPosition 最终元素所安排的位置，相对于父元素的内容区域
+         */
+        virtual void Arrange(const sw::Rect &finalPosition) override;
+
+    protected:
+        /**
+         * @brief         元素所在的宿主改变后调用该函数，将所放置的元素移动到新的宿主中
+         * @param oldHost 原来的宿主
+         */
+        virtual void OnHostChanged(WindowlessHost *oldHost) override;
+
+        /**
+         * @brief Visible属性改变后调用该函数，同步所放置元素的Visible属性
+         */
+        virtual void OnVisibleChanged() override;
+
+    private:
+        /**
+         * @brief 判断所放置的元素是否已添加到宿主中
+         */
+        bool _IsElementHosted();
+    };
+}
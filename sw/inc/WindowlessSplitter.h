@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Alignment.h"
+#include "WindowlessElement.h"
+
+namespace sw
+{
+    /**
+     * @brief 无窗口分隔条
+     */
+    class WindowlessSplitter : public WindowlessElement
+    {
+    private:
+        /**
+         * @brief 记录分隔条方向
+         */
+        sw::Orientation _orientation = sw::Orientation::Horizontal;
+
+    public:
+        /**
+         * @brief 分隔条的方向，给该属性赋值同时会改变HorizontalAlignment和VerticalAlignment属性的值
+         */
+        const MemberProperty<WindowlessSplitter, sw::Orientation> Orientation;
+
+    public:
+        /**
+         * @brief 初始化WindowlessSplitter
+         */
+        WindowlessSplitter();
+
+    protected:
+        /**
+         * @brief               测量分隔条所需的尺寸
+         * @param availableSize 可用的尺寸
+         * @return              与Splitter的默认尺寸相同
+         */
+        virtual Size MeasureOverride(const Size &availableSize) override;
+
+        /**
+         * @brief      在中间绘制分隔线
+         * @param hdc  绘制用的DC
+         * @param rect 元素的边界（像素）
+         */
+        virtual void OnDraw(HDC hdc, const RECT &rect) override;
+    };
+}
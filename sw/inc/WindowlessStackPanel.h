@@ -0,0 +1,37 @@
+#pragma once
+
+#include "StackLayout.h"
+#include "WindowlessPanel.h"
+
+namespace sw
+{
+    /**
+     * @brief 无窗口堆叠面板
+     */
+    class WindowlessStackPanel : public WindowlessPanel
+    {
+    private:
+        /**
+         * @brief 默认布局对象
+         */
+        StackLayout _stackLayout = StackLayout();
+
+    public:
+        /**
+         * @brief 排列方式
+         */
+        const MemberProperty<WindowlessStackPanel, sw::Orientation> Orientation;
+
+    public:
+        /**
+         * @brief 初始化WindowlessStackPanel
+         */
+        WindowlessStackPanel();
+
+    protected:
+        /**
+         * @brief 获取默认布局对象
+         */
+        virtual LayoutHost *GetDefaultLayout() override;
+    };
+}
@@ -4,6 +4,7 @@
 #include "Cursor.h"
 #include "Delegate.h"
 #include "Dip.h"
+#include "Dispatcher.h"
 #include "Font.h"
 #include "HitTestResult.h"
 #include "Keys.h"
@@ -14,6 +15,7 @@
 #include "Size.h"
 #include "WndMsg.h"
 #include <Windows.h>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <windowsx.h>
@@ -52,7 +54,18 @@ namespace sw
         HWND _hwnd = NULL;
 
         /**
-         * @brief 字体句柄
+         * @brief 创建对象的线程的调度器，InvokeAsync通过其在窗口线程上执行回调
+         */
+        Dispatcher *_dispatcher = &Dispatcher::GetCurrent();
+
+        /**
+         * @brief 对象存活期间有效的令牌，InvokeAsync的回调通过其弱引用判断对象是否已被销毁
+         * @note  首次调用InvokeAsync时才创建，未使用InvokeAsync的对象不会分配内存
+         */
+        std::shared_ptr<bool> _aliveToken;
+
+        /**
+         * @brief 字体句柄，由FontCache管理，相同的字体共享同一个句柄
          */
         HFONT _hfont = NULL;
 
@@ -95,118 +108,118 @@ namespace sw
         /**
          * @brief 窗口句柄
          */
-        const ReadOnlyProperty<HWND> Handle;
+        const ReadOnlyMemberProperty<WndBase, HWND> Handle;
 
         /**
          * @brief 字体
          */
-        const Property<sw::Font> Font;
+        const MemberProperty<WndBase, sw::Font> Font;
 
         /**
          * @brief 字体名称
          */
-        const Property<std::wstring> FontName;
+        const MemberProperty<WndBase, std::wstring> FontName;
 
         /**
          * @brief 字体大小
          */
-        const Property<double> FontSize;
+        const MemberProperty<WndBase, double> FontSize;
 
         /**
          * @brief 字体粗细
          */
-        const Property<sw::FontWeight> FontWeight;
+        const MemberProperty<WndBase, sw::FontWeight> FontWeight;
 
         /**
          * @brief 位置和尺寸
          */
-        const Property<sw::Rect> Rect;
+        const MemberProperty<WndBase, sw::Rect> Rect;
 
         /**
          * @brief 左边
          */
-        const Property<double> Left;
+        const MemberProperty<WndBase, double> Left;
 
         /**
          * @brief 顶边
          */
-        const Property<double> Top;
+        const MemberProperty<WndBase, double> Top;
 
         /**
          * @brief 宽度
          */
-        const Property<double> Width;
+        const MemberProperty<WndBase, double> Width;
 
         /**
          * @brief 高度
          */
-        const Property<double> Height;
+        const MemberProperty<WndBase, double> Height;
 
         /**
          * @brief 用户区尺寸
          */
-        const ReadOnlyProperty<sw::Rect> ClientRect;
+        const ReadOnlyMemberProperty<WndBase, sw::Rect> ClientRect;
 
         /**
          * @brief 用户区宽度
          */
-        const ReadOnlyProperty<double> ClientWidth;
+        const ReadOnlyMemberProperty<WndBase, double> ClientWidth;
 
         /**
          * @brief 用户区高度
          */
-        const ReadOnlyProperty<double> ClientHeight;
+        const ReadOnlyMemberProperty<WndBase, double> ClientHeight;
 
         /**
          * @brief 窗口或控件是否可用
          */
-        const Property<bool> Enabled;
+        const MemberProperty<WndBase, bool> Enabled;
 
         /**
          * @brief 窗口或控件是否可见
          */
-        const Property<bool> Visible;
+        const MemberProperty<WndBase, bool> Visible;
 
         /**
          * @brief 窗口标题或控件文本
          */
-        const Property<std::wstring> Text;
+        const MemberProperty<WndBase, std::wstring> Text;
 
         /**
          * @brief 窗口是否拥有焦点
          */
-        const Property<bool> Focused;
+        const MemberProperty<WndBase, bool> Focused;
 
         /**
          * @brief 父窗口
          */
-        const ReadOnlyProperty<WndBase *> Parent;
+        const ReadOnlyMemberProperty<WndBase, WndBase *> Parent;
 
         /**
          * @brief 是否已销毁，当该值为true时不应该继续使用当前对象
          */
-        const ReadOnlyProperty<bool> IsDestroyed;
+        const ReadOnlyMemberProperty<WndBase, bool> IsDestroyed;
 
         /**
          * @brief 是否接受拖放文件
          */
-        const Property<bool> AcceptFiles;
+        const MemberProperty<WndBase, bool> AcceptFiles;
 
         /**
          * @brief 当前对象是否是控件
          */
-        const ReadOnlyProperty<bool> IsControl;
+        const ReadOnlyMemberProperty<WndBase, bool> IsControl;
 
         /**
          * @brief 窗口类名
          */
-        const ReadOnlyProperty<std::wstring> ClassName;
+        const ReadOnlyMemberProperty<WndBase, std::wstring> ClassName;
 
         /**
          * @brief 窗口是一组控件中的第一个控件
          * @note  当窗口拥有WS_GROUP样式时该属性值为true，否则为false
          */
-        const Property<bool> GroupStart;
+        const MemberProperty<WndBase, bool> GroupStart;
 
     protected:
         /**
@@ -843,9 +856,56 @@ namespace sw
         /**
          * @brief        在窗口线程上执行指定委托，并立即返回
          * @param action 要执行的委托
+         * @note         委托以DispatchPriority::Render优先级加入窗口线程的调度器，多次调用只会投递一条唤醒消息
+         * @note         对象销毁后尚未执行的委托不会再执行
          */
         void InvokeAsync(const SimpleAction &action);
 
+        /**
+         * @brief          在窗口线程上以指定优先级执行可调用对象，并立即返回
+         * @param f        要执行的可调用对象，连同存活令牌不超过DispatchCallable::BufferSize的对象不会分配内存
+         * @param priority 优先级
+         * @note           对象销毁后尚未执行的可调用对象不会再执行，只会被销毁
+         */
+        template <typename F>
+        void InvokeAsync(F &&f, DispatchPriority priority)
+        {
+            this->_dispatcher->InvokeAsync(_BoundCallback<typename std::decay<F>::type>{this->_GetAliveToken(), std::forward<F>(f)}, priority);
+        }
+
+        /**
+         * @brief          在窗口线程上执行可调用对象，并立即返回可等待其结果的AsyncResult
+         * @tparam T       可调用对象的返回值类型，可以为void，如InvokeAsync<int>([] { return 1; })
+         * @param f        要执行的可调用对象，抛出的异常保存在结果中，通过AsyncResult::Get重新抛出
+         * @param priority 优先级
+         * @note           不要在窗口线程上阻塞等待结果，应使用AsyncResult::Then或co_await
+         * @note           对象销毁时尚未执行的可调用对象不会再执行，其结果为std::future_errc::broken_promise异常
+         */
+        template <typename T, typename F>
+        AsyncResult<T> InvokeAsync(F &&f, DispatchPriority priority = DispatchPriority::Render)
+        {
+            AsyncResult<T> result;
+            this->InvokeAsync(MakeAsyncInvoker<T>(std::forward<F>(f), result), priority);
+            return result;
+        }
+
+#if SW_HAS_COROUTINE
+        /**
+         * @brief          返回一个等待体，协程co_await该等待体后在窗口线程上继续执行，已在窗口线程上时不会挂起
+         * @param priority 恢复协程的回调的优先级
+         * @note           通过co_await Dispatcher::SwitchToThreadPool()回到线程池
+         */
+        Dispatcher::SwitchToAwaiter SwitchToUiThread(DispatchPriority priority = DispatchPriority::Render) const
+        {
+            return this->_dispatcher->SwitchTo(priority);
+        }
+#endif
+
+        /**
+         * @brief 获取窗口线程的调度器
+         */
+        Dispatcher &GetDispatcher() const;
+
         /**
          * @brief 获取当前窗口所属线程的线程id
          */
@@ -889,6 +949,27 @@ namespace sw
          */
         static void _SetWndBase(HWND hwnd, WndBase &wnd);
 
+        /**
+         * @brief 获取对象的存活令牌，令牌不存在时创建
+         * @note  InvokeAsync可以在任意线程上调用，因此通过原子操作读写_aliveToken
+         */
+        std::shared_ptr<bool> _GetAliveToken();
+
+        /**
+         * @brief 绑定到对象生存期的回调，对象销毁后不再执行
+         * @note  回调在窗口线程上执行，对象也只应在窗口线程上销毁，因此判断与执行之间对象不会被销毁
+         */
+        template <typename F>
+        struct _BoundCallback {
+            std::weak_ptr<bool> alive;
+            F f;
+
+            void operator()()
+            {
+                if (!this->alive.expired()) this->f();
+            }
+        };
+
     public:
         /**
          * @brief      通过窗口句柄获取WndBase
@@ -18,6 +18,12 @@ namespace sw
         // 在窗口线程上执行指定委托，lParam为指向sw::Action<>的指针，wParam表示是否对委托指针执行delete
         WM_InvokeAction,
 
+        // 由LayoutScheduler投递给待更新布局的元素，收到该消息时处理当前线程中所有待更新的布局，wParam和lParam均未使用
+        WM_FlushLayout,
+
+        // 其他线程向调度器添加回调后投递给调度器窗口的唤醒消息，wParam和lParam均未使用
+        WM_DispatcherWake,
+
         // SimpleWindow所用消息的结束位置
         WM_SimpleWindowEnd,
     };
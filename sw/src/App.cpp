@@ -1,5 +1,14 @@
 #include "App.h"
+#include "MsgMonitor.h"
 #include "Path.h"
+#include "Utils.h"
+#include "WndMsg.h"
+#include <chrono>
+
+// 较旧的Windows SDK中没有该定义，系统不支持时CreateWaitableTimerExW失败并改用普通计时器
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 
 namespace
 {
@@ -8,6 +17,121 @@ namespace
      */
     thread_local sw::AppQuitMode _appQuitMode = sw::AppQuitMode::Auto;
 
+    /**
+     * @brief 每轮执行空闲回调的时间预算（毫秒）
+     */
+    thread_local double _idleTimeBudget = 4;
+
+    /**
+     * @brief 目标帧间隔（毫秒），为0时不使用帧节奏模式
+     */
+    thread_local double _frameInterval = 0;
+
+    /**
+     * @brief 当前线程的空闲回调
+     */
+    thread_local sw::IdleQueue _idleQueue;
+
+    /**
+     * @brief 当前线程消息循环的累计统计信息
+     */
+    thread_local sw::MsgLoopStatistics _msgLoopStatistics;
+
+    /**
+     * @brief 是否统计当前线程消息循环的计时信息
+     */
+    thread_local bool _msgLoopStatisticsEnabled = false;
+
+    /**
+     * @brief 消息循环使用的时钟
+     */
+    using _LoopClock = std::chrono::steady_clock;
+
+    /**
+     * @brief 计算两个时间点之间的毫秒数
+     */
+    double _ElapsedMs(_LoopClock::time_point begin, _LoopClock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - begin).count();
+    }
+
+    /**
+     * @brief 帧节奏模式下用于等待下一帧的可等待计时器，系统支持时使用高精度计时器
+     */
+    class _FrameTimer
+    {
+    private:
+        HANDLE _handle = NULL;
+
+    public:
+        _FrameTimer() = default;
+
+        _FrameTimer(const _FrameTimer &)            = delete;
+        _FrameTimer &operator=(const _FrameTimer &) = delete;
+
+        ~_FrameTimer()
+        {
+            if (this->_handle != NULL) CloseHandle(this->_handle);
+        }
+
+        /**
+         * @brief              等待消息到达或超时
+         * @param milliseconds 超时时间（毫秒）
+         */
+        void Wait(double milliseconds)
+        {
+            if (this->_handle == NULL) {
+                this->_handle = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+                if (this->_handle == NULL) {
+                    this->_handle = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+                }
+            }
+
+            LARGE_INTEGER due;
+            due.QuadPart = -(LONGLONG)(milliseconds * 10000); // 相对时间，以100纳秒为单位
+
+            if (this->_handle != NULL && SetWaitableTimer(this->_handle, &due, 0, NULL, NULL, FALSE)) {
+                MsgWaitForMultipleObjectsEx(1, &this->_handle, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            } else {
+                // 无法使用可等待计时器时退化为超时等待，精度受系统时钟分辨率限制
+                MsgWaitForMultipleObjectsEx(0, NULL, (DWORD)(milliseconds + 0.999), QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            }
+        }
+    };
+
+    /**
+     * @brief 分发一条消息
+     */
+    void _DispatchMsg(MSG &msg)
+    {
+        if (msg.hwnd == NULL) {
+            if (sw::App::NullHwndMsgHandler)
+                sw::App::NullHwndMsgHandler(msg);
+        } else {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+
+    /**
+     * @brief 记录消息从投递到取出的时间，精度为系统时钟的精度
+     * @note  WM_PAINT与WM_TIMER在取出时才生成，没有排队时间；
+     *        WM_DispatcherWake由调度器按每个回调记录更精确的排队时间
+     */
+    void _RecordQueueWait(const MSG &msg)
+    {
+        switch (msg.message) {
+            case WM_PAINT:
+            case WM_TIMER:
+            case sw::WM_DispatcherWake:
+                return;
+        }
+        DWORD elapsed = GetTickCount() - msg.time;
+        if (elapsed < 0x80000000) {
+            sw::MsgMonitor::RecordQueueWait(msg.message, (uint64_t)elapsed * 1000000);
+        }
+    }
+
     /**
      * @brief  获取当前exe文件路径
      */
@@ -52,6 +176,16 @@ namespace
  */
 thread_local sw::Action<MSG &> sw::App::NullHwndMsgHandler;
 
+/**
+ * @brief 帧节奏模式下每帧调用的回调函数
+ */
+thread_local sw::Action<const sw::MsgLoopFrame &> sw::App::FrameHandler;
+
+/**
+ * @brief 消息循环每轮结束时调用的回调函数
+ */
+thread_local sw::Action<const sw::MsgLoopTurn &> sw::App::MsgLoopTurnHandler;
+
 /**
  */
 
@@ -98,19 +232,188 @@ const sw::Property<sw::AppQuitMode> sw::App::QuitMode(
     } //
 );
 
+const sw::Property<double> sw::App::IdleTimeBudget(
+    // get
+    []() -> double {
+        return _idleTimeBudget;
+    },
+    // set
+    [](const double &value) {
+        _idleTimeBudget = value;
+    } //
+);
+
+const sw::Property<double> sw::App::FrameInterval(
+    // get
+    []() -> double {
+        return _frameInterval;
+    },
+    // set
+    [](const double &value) {
+        _frameInterval = value;
+    } //
+);
+
+const sw::Property<bool> sw::App::MsgLoopStatisticsEnabled(
+    // get
+    []() -> bool {
+        return _msgLoopStatisticsEnabled;
+    },
+    // set
+    [](const bool &value) {
+        _msgLoopStatisticsEnabled = value;
+    } //
+);
+
+uint64_t sw::App::AddIdleHandler(const IdleHandler &handler)
+{
+    return _idleQueue.Add(handler);
+}
+
+bool sw::App::RemoveIdleHandler(uint64_t id)
+{
+    return _idleQueue.Remove(id);
+}
+
+const sw::MsgLoopStatistics &sw::App::GetMsgLoopStatistics()
+{
+    return _msgLoopStatistics;
+}
+
+void sw::App::ResetMsgLoopStatistics()
+{
+    _msgLoopStatistics = MsgLoopStatistics{};
+}
+
 int sw::App::MsgLoop()
 {
-    MSG msg;
-    while (GetMessageW(&msg, NULL, 0, 0) > 0) {
-        if (msg.hwnd == NULL) {
-            if (NullHwndMsgHandler)
-                NullHwndMsgHandler(msg);
+    MSG msg{};
+    _FrameTimer frameTimer;
+
+    bool framePacing    = false;        // 是否处于帧节奏模式
+    uint64_t frameIndex = 0;            // 下一帧的序号
+    _LoopClock::time_point frameOrigin; // 进入帧节奏模式的时间
+    _LoopClock::time_point nextFrame;   // 下一帧的计划时间
+    _LoopClock::time_point lastFrame;   // 上一帧实际开始的时间
+    _LoopClock::duration frameStep{};   // 帧间隔
+
+    uint64_t turnIndex = 0;
+    double waitTime    = 0;
+
+    for (;;) {
+        MsgLoopTurn turn;
+        turn.index = ++turnIndex;
+        turn.wait  = waitTime;
+
+        // 进入、退出帧节奏模式或修改帧间隔
+        double interval = _frameInterval;
+        if (interval > 0) {
+            auto step = std::chrono::duration_cast<_LoopClock::duration>(std::chrono::duration<double, std::milli>(interval));
+            if (step.count() <= 0) {
+                step = _LoopClock::duration(1);
+            }
+            if (!framePacing) {
+                framePacing = true;
+                frameIndex  = 0;
+                frameOrigin = nextFrame = lastFrame = _LoopClock::now();
+            } else if (step != frameStep) {
+                nextFrame = lastFrame + step;
+            }
+            frameStep = step;
         } else {
-            TranslateMessage(&msg);
-            DispatchMessageW(&msg);
+            framePacing = false;
+        }
+
+        // 只在需要计时信息或处于帧节奏模式时读取时钟，默认情况下每轮只有分发消息与等待的开销
+        bool monitoring = MsgMonitor::IsEnabled();
+        bool timing     = _msgLoopStatisticsEnabled || MsgLoopTurnHandler;
+        bool useClock   = timing || framePacing;
+
+        // 分发已到达的消息，帧节奏模式下到达下一帧的时间后先渲染帧
+        _LoopClock::time_point dispatchBegin;
+        if (timing) dispatchBegin = _LoopClock::now();
+        while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) {
+                return (int)msg.wParam;
+            }
+            if (monitoring) {
+                _RecordQueueWait(msg);
+                MsgMonitor::BusyScope scope(msg.message, "sw::App::MsgLoop", reinterpret_cast<uint64_t>(msg.hwnd));
+                _DispatchMsg(msg);
+            } else {
+                _DispatchMsg(msg);
+            }
+            ++turn.messageCount;
+            if (framePacing && _LoopClock::now() >= nextFrame) {
+                break;
+            }
+        }
+        _LoopClock::time_point now;
+        if (useClock) now = _LoopClock::now();
+        if (timing && turn.messageCount != 0) {
+            turn.dispatch = _ElapsedMs(dispatchBegin, now);
+        }
+
+        // 渲染帧，错过的帧直接跳过以保持节奏
+        if (framePacing && now >= nextFrame) {
+            int64_t missed = (int64_t)((now - nextFrame) / frameStep);
+
+            MsgLoopFrame frame;
+            frame.index = frameIndex++;
+            frame.time  = _ElapsedMs(frameOrigin, nextFrame + missed * frameStep);
+            frame.delta = frame.index == 0 ? 0 : _ElapsedMs(lastFrame, now);
+
+            turn.frame         = true;
+            turn.frameDelta    = frame.delta;
+            turn.skippedFrames = (int)missed;
+
+            lastFrame = now;
+            nextFrame += (missed + 1) * frameStep;
+
+            if (FrameHandler) {
+                MsgMonitor::BusyScope scope(0, "sw::App::FrameHandler");
+                FrameHandler(frame);
+            }
+
+            auto frameEnd  = _LoopClock::now();
+            turn.frameTime = _ElapsedMs(now, frameEnd);
+            now            = frameEnd;
+        }
+
+        // 执行空闲回调，帧节奏模式下不超过距下一帧的时间
+        if (_idleQueue.HasWork()) {
+            double budget = _idleTimeBudget;
+            if (framePacing) {
+                budget = Utils::Min(budget, _ElapsedMs(now, nextFrame));
+            }
+            if (budget > 0 || !framePacing) {
+                MsgMonitor::BusyScope scope(0, "sw::App::IdleHandler");
+                turn.idleCallbacks = _idleQueue.Run(budget);
+                if (timing) turn.idle = _ElapsedMs(now, _LoopClock::now());
+            }
+        }
+
+        if (timing) {
+            if (_msgLoopStatisticsEnabled) _msgLoopStatistics.Add(turn);
+            if (MsgLoopTurnHandler) MsgLoopTurnHandler(turn);
+        }
+
+        // 仍有空闲回调时不等待，下一轮处理新到达的消息后继续执行
+        waitTime = 0;
+        if (!_idleQueue.HasWork()) {
+            // 嵌套在消息处理中的消息循环（如模态窗口）等待消息时不视为卡顿
+            if (monitoring) MsgMonitor::NotifyIdle();
+            _LoopClock::time_point waitBegin;
+            if (useClock) waitBegin = _LoopClock::now();
+            if (!framePacing) {
+                MsgWaitForMultipleObjectsEx(0, NULL, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            } else if (waitBegin < nextFrame) {
+                frameTimer.Wait(_ElapsedMs(waitBegin, nextFrame));
+            }
+            if (timing) waitTime = _ElapsedMs(waitBegin, _LoopClock::now());
+            if (monitoring) MsgMonitor::NotifyResume();
         }
     }
-    return (int)msg.wParam;
 }
 
 void sw::App::QuitMsgLoop(int exitCode)
@@ -1,4 +1,5 @@
 #include "BmpBox.h"
+#include "BrushCache.h"
 #include <cmath>
 
 sw::BmpBox::BmpBox()
@@ -75,7 +76,7 @@ bool sw::BmpBox::OnPaint()
     RECT clientRect;
     GetClientRect(hwnd, &clientRect);
 
-    HBRUSH hBackColorBrush = CreateSolidBrush(this->GetRealBackColor());
+    HBRUSH hBackColorBrush = BrushCache::Acquire(this->GetRealBackColor());
     FillRect(hdc, &clientRect, hBackColorBrush);
 
     if (this->_hBitmap != NULL &&
@@ -129,7 +130,7 @@ bool sw::BmpBox::OnPaint()
     }
 
     EndPaint(hwnd, &ps);
-    DeleteObject(hBackColorBrush);
+    BrushCache::Release(hBackColorBrush);
     return true;
 }
 
@@ -0,0 +1,77 @@
+#include "BrushCache.h"
+#include <mutex>
+
+namespace
+{
+    /**
+     * @brief 画刷缓存类型，以COLORREF为键
+     */
+    using _BrushHandleCache = sw::HandleCache<COLORREF, HBRUSH>;
+
+    /**
+     * @brief 画刷缓存最多保留的未被使用的画刷数
+     */
+    constexpr size_t _BrushCacheMaxIdleCount = 64;
+
+    /**
+     * @brief 保护画刷缓存的互斥锁
+     */
+    std::mutex &_GetBrushCacheMutex()
+    {
+        static std::mutex *mutex = new std::mutex;
+        return *mutex;
+    }
+
+    /**
+     * @brief 获取进程范围的画刷缓存，调用时需持有_GetBrushCacheMutex
+     * @note  缓存有意不释放，静态存储期的窗口析构时仍会释放其画刷
+     */
+    _BrushHandleCache &_GetBrushHandleCache()
+    {
+        static _BrushHandleCache *cache = new _BrushHandleCache(
+            [](const COLORREF &color) -> HBRUSH {
+                return CreateSolidBrush(color);
+            },
+            [](HBRUSH hbrush) {
+                DeleteObject(hbrush);
+            },
+            _BrushCacheMaxIdleCount);
+        return *cache;
+    }
+}
+
+HBRUSH sw::BrushCache::Acquire(const Color &color)
+{
+    std::lock_guard<std::mutex> lock(_GetBrushCacheMutex());
+    return _GetBrushHandleCache().Acquire(color);
+}
+
+bool sw::BrushCache::Release(HBRUSH hbrush)
+{
+    std::lock_guard<std::mutex> lock(_GetBrushCacheMutex());
+    return _GetBrushHandleCache().Release(hbrush);
+}
+
+void sw::BrushCache::Trim()
+{
+    std::lock_guard<std::mutex> lock(_GetBrushCacheMutex());
+    _GetBrushHandleCache().Trim();
+}
+
+void sw::BrushCache::SetMaxIdleCount(size_t count)
+{
+    std::lock_guard<std::mutex> lock(_GetBrushCacheMutex());
+    _GetBrushHandleCache().SetMaxIdleCount(count);
+}
+
+sw::HandleCacheStats sw::BrushCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_GetBrushCacheMutex());
+    return _GetBrushHandleCache().GetStats();
+}
+
+void sw::BrushCache::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(_GetBrushCacheMutex());
+    _GetBrushHandleCache().ResetStats();
+}
@@ -20,3 +20,60 @@ sw::LayoutHost *sw::Canvas::GetDefaultLayout()
 {
     return &this->_canvasLayout;
 }
+
+sw::UIElement *sw::Canvas::HitTest(const Point &point)
+{
+    // 使用自定义布局时空间索引不会更新，逐个判断子元素的位置
+    if (this->Layout.Get() != nullptr) {
+        for (int i = this->ChildCount.Get() - 1; i >= 0; --i) {
+            UIElement &child = (*this)[i];
+            sw::Rect rect    = child.Rect;
+            if (child.Visible.Get() &&
+                point.x >= rect.left && point.x < rect.left + rect.width &&
+                point.y >= rect.top && point.y < rect.top + rect.height) {
+                return &child;
+            }
+        }
+        return nullptr;
+    }
+
+    // 索引中的位置不包括滚动偏移量
+    int index = this->_canvasLayout.HitTest(Point(
+        point.x - this->GetInternalArrangeOffsetX(),
+        point.y - this->GetInternalArrangeOffsetY()));
+
+    if (index < 0 || index >= this->_canvasLayout.GetChildLayoutCount()) {
+        return nullptr;
+    }
+    return &static_cast<UIElement &>(this->_canvasLayout.GetChildLayoutAt(index));
+}
+
+std::vector<sw::UIElement *> sw::Canvas::QueryRect(const sw::Rect &rect)
+{
+    std::vector<UIElement *> result;
+
+    if (this->Layout.Get() != nullptr) {
+        int childCount = this->ChildCount.Get();
+        for (int i = 0; i < childCount; ++i) {
+            UIElement &child   = (*this)[i];
+            sw::Rect childRect = child.Rect;
+            if (child.Visible.Get() &&
+                childRect.left < rect.left + rect.width && rect.left < childRect.left + childRect.width &&
+                childRect.top < rect.top + rect.height && rect.top < childRect.top + childRect.height) {
+                result.push_back(&child);
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> indices;
+    this->_canvasLayout.QueryRect(
+        sw::Rect(rect.left - this->GetInternalArrangeOffsetX(), rect.top - this->GetInternalArrangeOffsetY(), rect.width, rect.height),
+        indices);
+
+    int childCount = this->_canvasLayout.GetChildLayoutCount();
+    for (int index : indices) {
+        if (index < childCount) result.push_back(&static_cast<UIElement &>(this->_canvasLayout.GetChildLayoutAt(index)));
+    }
+    return result;
+}
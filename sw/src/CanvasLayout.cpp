@@ -1,6 +1,7 @@
 #include "CanvasLayout.h"
 #include "Utils.h"
 #include <cmath>
+#include <cstring>
 
 sw::CanvasLayoutTag::CanvasLayoutTag()
     : left(0), top(0)
@@ -13,16 +14,19 @@ sw::CanvasLayoutTag::CanvasLayoutTag(float left, float top)
 }
 
 sw::CanvasLayoutTag::CanvasLayoutTag(uint64_t layoutTag)
-    : left(reinterpret_cast<float *>(&layoutTag)[0]),
-      top(reinterpret_cast<float *>(&layoutTag)[1])
 {
+    // 低4字节为left，高4字节为top，使用memcpy避免违反严格别名规则
+    float values[2];
+    std::memcpy(values, &layoutTag, sizeof(values));
+    this->left = values[0];
+    this->top  = values[1];
 }
 
 sw::CanvasLayoutTag::operator uint64_t() const
 {
+    float values[2] = {this->left, this->top};
     uint64_t result;
-    reinterpret_cast<float *>(&result)[0] = left;
-    reinterpret_cast<float *>(&result)[1] = top;
+    std::memcpy(&result, values, sizeof(result));
     return result;
 }
 
@@ -52,6 +56,24 @@ void sw::CanvasLayout::ArrangeOverride(const Size &finalSize)
         ILayout &item        = this->GetChildLayoutAt(i);
         Size childDesireSize = item.GetDesireSize();
         CanvasLayoutTag tag  = item.GetLayoutTag();
-        item.Arrange(Rect{tag.left, tag.top, childDesireSize.width, childDesireSize.height});
+        Rect rect{tag.left, tag.top, childDesireSize.width, childDesireSize.height};
+        item.Arrange(rect);
+        this->_spatialIndex.Update(i, rect);
     }
+    this->_spatialIndex.SetCount(childCount);
+}
+
+int sw::CanvasLayout::HitTest(const Point &point) const
+{
+    return this->_spatialIndex.HitTest(point);
+}
+
+void sw::CanvasLayout::QueryRect(const Rect &rect, std::vector<int> &result) const
+{
+    this->_spatialIndex.QueryRect(rect, result);
+}
+
+sw::SpatialIndex &sw::CanvasLayout::GetSpatialIndex()
+{
+    return this->_spatialIndex;
 }
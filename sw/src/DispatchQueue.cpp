@@ -0,0 +1,225 @@
+#include "DispatchQueue.h"
+#include <chrono>
+
+constexpr size_t sw::DispatchCallable::BufferSize;
+constexpr int sw::DispatchQueue::PriorityCount;
+constexpr size_t sw::DispatchQueue::DefaultCapacity;
+
+namespace
+{
+    /**
+     * @brief Run中两次读取时钟之间的回调耗时低于预算的该分之一时才增大读取间隔
+     */
+    constexpr int _ClockCheckFraction = 64;
+
+    /**
+     * @brief Run中两次读取时钟之间最多执行的回调数
+     */
+    constexpr int _MaxClockCheckStride = 64;
+}
+
+sw::DispatchQueue::DispatchQueue(size_t capacity)
+    : _rings(new _Ring[PriorityCount])
+{
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    for (int i = 0; i < PriorityCount; ++i) {
+        _Ring &ring = this->_rings[i];
+        ring.cells.reset(new _Cell[size]);
+        ring.mask = size - 1;
+        for (size_t j = 0; j < size; ++j) {
+            ring.cells[j].sequence.store(j, std::memory_order_relaxed);
+        }
+    }
+}
+
+sw::DispatchQueue::~DispatchQueue()
+{
+    // 未执行的回调随格子与溢出队列一同析构
+}
+
+int sw::DispatchQueue::Run(double budgetMilliseconds, DispatchPriority lowestPriority)
+{
+    using Clock = std::chrono::steady_clock;
+
+    auto budget    = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMilliseconds));
+    auto lastCheck = Clock::now();
+    auto deadline  = lastCheck + budget;
+
+    int lowest = _ClampPriority(lowestPriority);
+    int count  = 0;
+
+    // 每执行stride个回调读取一次时钟，回调很快时读取时钟的开销可能超过回调本身
+    int stride     = 1;
+    int untilCheck = 1;
+
+    DispatchCallable callable;
+
+    for (;;) {
+        bool found = false;
+        for (int i = 0; i <= lowest && !found; ++i) {
+            found = this->_TryDequeue(this->_rings[i], callable);
+        }
+        if (!found) {
+            break;
+        }
+
+        // 执行前已将回调移出格子，回调中可以继续添加回调，抛出异常时也不会影响队列
+        callable();
+        callable.Reset();
+        ++count;
+
+        if (--untilCheck == 0) {
+            auto now = Clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            // 上一段回调的总耗时远小于预算时加倍间隔，否则恢复为每个回调检查一次，超出预算的时间因此不超过预算的几十分之一
+            stride     = (now - lastCheck) * _ClockCheckFraction < budget ? (stride < _MaxClockCheckStride ? stride * 2 : stride) : 1;
+            untilCheck = stride;
+            lastCheck  = now;
+        }
+    }
+    return count;
+}
+
+bool sw::DispatchQueue::HasPending(DispatchPriority lowestPriority) const
+{
+    int lowest = _ClampPriority(lowestPriority);
+
+    for (int i = 0; i <= lowest; ++i) {
+        const _Ring &ring = this->_rings[i];
+        if (ring.enqueuePos.load(std::memory_order_acquire) != ring.dequeuePos ||
+            ring.overflowCount.load(std::memory_order_acquire) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool sw::DispatchQueue::EndRun()
+{
+    // 使用exchange与生产者的exchange同步，保证能看到在此之前设置唤醒标记的生产者写入的回调
+    this->_wakePending.exchange(false, std::memory_order_acq_rel);
+
+    if (!this->HasPending()) {
+        return false;
+    }
+
+    // 清除标记后有生产者添加了回调，若生产者已负责唤醒则无需再次唤醒
+    return !this->_wakePending.exchange(true, std::memory_order_acq_rel);
+}
+
+void sw::DispatchQueue::CancelWake()
+{
+    this->_wakePending.store(false, std::memory_order_release);
+}
+
+int sw::DispatchQueue::Clear()
+{
+    int count = 0;
+
+    for (int i = 0; i < PriorityCount; ++i) {
+        for (;;) {
+            DispatchCallable callable;
+            if (!this->_TryDequeue(this->_rings[i], callable)) break;
+            ++count;
+        }
+    }
+    return count;
+}
+
+int sw::DispatchQueue::_ClampPriority(DispatchPriority priority)
+{
+    int index = (int)priority;
+    return index < 0 ? 0 : (index >= PriorityCount ? PriorityCount - 1 : index);
+}
+
+bool sw::DispatchQueue::_TryEnqueue(_Ring &ring, DispatchCallable &callable)
+{
+    size_t pos = ring.enqueuePos.load(std::memory_order_relaxed);
+    _Cell *cell;
+
+    for (;;) {
+        cell          = &ring.cells[pos & ring.mask];
+        size_t seq    = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            // 格子空闲，尝试占用
+            if (ring.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // 格子中的回调尚未被消费者取走，缓冲区已满
+            return false;
+        } else {
+            // 格子已被其他生产者占用
+            pos = ring.enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->callable = std::move(callable);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void sw::DispatchQueue::_EnqueueOverflow(_Ring &ring, DispatchCallable &&callable)
+{
+    std::lock_guard<std::mutex> lock(this->_overflowMutex);
+    ring.overflow.push_back(std::move(callable));
+    ring.overflowCount.fetch_add(1, std::memory_order_release);
+}
+
+bool sw::DispatchQueue::_TryDequeue(_Ring &ring, DispatchCallable &callable)
+{
+    if (_TryDequeueCell(ring, callable)) {
+        return true;
+    }
+
+    if (ring.drainPos == ring.draining.size()) {
+        if (ring.overflowCount.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+
+        // 上次取走的回调已全部执行，清空后与溢出队列交换，两者的存储空间都会被保留
+        ring.draining.clear();
+        ring.drainPos = 0;
+        {
+            std::lock_guard<std::mutex> lock(this->_overflowMutex);
+            ring.draining.swap(ring.overflow);
+        }
+
+        if (ring.draining.empty()) {
+            return false;
+        }
+    }
+
+    // 生产者在将回调加入溢出队列之前占用的格子，在此处加锁之后一定可见，因此取走溢出队列后需再次检查环形缓冲区，
+    // 若在取走之前检查，检查与取走之间生产者可能先填满环形缓冲区再溢出，导致后加入的回调先执行
+    if (_TryDequeueCell(ring, callable)) {
+        return true;
+    }
+
+    // 有生产者已占用格子但尚未写入完成，其后的回调需等待该格子写入完成后才能取出
+    if (ring.enqueuePos.load(std::memory_order_acquire) != ring.dequeuePos) {
+        return false;
+    }
+
+    callable = std::move(ring.draining[ring.drainPos++]);
+    ring.overflowCount.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool sw::DispatchQueue::_TryDequeueCell(_Ring &ring, DispatchCallable &callable)
+{
+    _Cell &cell = ring.cells[ring.dequeuePos & ring.mask];
+
+    if (cell.sequence.load(std::memory_order_acquire) != ring.dequeuePos + 1) {
+        return false;
+    }
+
+    callable = std::move(cell.callable);
+    cell.sequence.store(ring.dequeuePos + ring.mask + 1, std::memory_order_release);
+    ++ring.dequeuePos;
+    return true;
+}
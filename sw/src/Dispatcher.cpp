@@ -0,0 +1,163 @@
+#include "Dispatcher.h"
+#include "App.h"
+
+namespace
+{
+    /**
+     * @brief 调度器窗口的窗口类名
+     */
+    constexpr wchar_t _DispatcherClassName[] = L"sw::Dispatcher";
+
+    /**
+     * @brief 推迟到下一轮执行时使用的定时器id
+     */
+    constexpr UINT_PTR _DispatcherWakeTimerId = 1;
+}
+
+sw::Dispatcher::Dispatcher()
+    : _threadId(GetCurrentThreadId()),
+
+      TimeBudget(
+          // get
+          [this]() -> double {
+              return this->_timeBudget;
+          },
+          // set
+          [this](const double &value) {
+              this->_timeBudget = value;
+          }),
+
+      ThreadId(
+          // get
+          [this]() -> DWORD {
+              return this->_threadId;
+          })
+{
+    static thread_local ATOM dispatcherClsAtom = 0;
+
+    if (dispatcherClsAtom == 0) {
+        WNDCLASSEXW wc{};
+        wc.cbSize         = sizeof(wc);
+        wc.hInstance      = App::Instance;
+        wc.lpfnWndProc    = Dispatcher::_WndProc;
+        wc.lpszClassName  = _DispatcherClassName;
+        dispatcherClsAtom = RegisterClassExW(&wc);
+    }
+
+    this->_hwnd = CreateWindowExW(
+        0,                    // Optional window styles
+        _DispatcherClassName, // Window class
+        L"",                  // Window text
+        0,                    // Window style
+        0, 0, 0, 0,           // Size and position
+        HWND_MESSAGE,         // Parent window, message-only
+        NULL,                 // Menu
+        App::Instance,        // Instance handle
+        NULL                  // Additional application data
+    );
+
+    SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+}
+
+sw::Dispatcher::~Dispatcher()
+{
+    if (this->_hwnd != NULL) {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, 0);
+        DestroyWindow(this->_hwnd);
+    }
+}
+
+sw::Dispatcher &sw::Dispatcher::GetCurrent()
+{
+    /**
+     * @brief 线程退出时关闭当前线程的调度器
+     */
+    struct _ExitGuard {
+        Dispatcher *dispatcher = nullptr;
+
+        ~_ExitGuard()
+        {
+            if (this->dispatcher != nullptr) {
+                this->dispatcher->_Shutdown();
+            }
+        }
+    };
+
+    // 调度器有意不释放：主线程的线程局部变量在静态对象之前析构，静态存储期的窗口仍保存着调度器的指针
+    static thread_local Dispatcher *dispatcher = nullptr;
+    static thread_local _ExitGuard guard;
+
+    if (dispatcher == nullptr) {
+        dispatcher       = new Dispatcher;
+        guard.dispatcher = dispatcher;
+    }
+    return *dispatcher;
+}
+
+bool sw::Dispatcher::CheckAccess() const
+{
+    return this->_threadId == GetCurrentThreadId();
+}
+
+void sw::Dispatcher::_Shutdown()
+{
+    this->_shutdown.store(true, std::memory_order_release);
+
+    // 窗口句柄保持不变，其他线程此时投递唤醒消息会失败，与窗口被系统销毁后的情况相同
+    if (this->_hwnd != NULL) {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, 0);
+        KillTimer(this->_hwnd, _DispatcherWakeTimerId);
+        DestroyWindow(this->_hwnd);
+    }
+    this->_queue.Clear();
+}
+
+void sw::Dispatcher::_PostWake()
+{
+    // 投递失败（如消息队列已满）时清除唤醒标记，由下一次InvokeAsync重新投递
+    if (!PostMessageW(this->_hwnd, WM_DispatcherWake, 0, 0)) {
+        this->_queue.CancelWake();
+    }
+}
+
+void sw::Dispatcher::_OnWake()
+{
+    KillTimer(this->_hwnd, _DispatcherWakeTimerId);
+
+    // 有输入消息等待处理时推迟后台回调
+    bool inputPending = HIWORD(GetQueueStatus(QS_INPUT)) != 0;
+
+    try {
+        this->_queue.Run(this->_timeBudget, inputPending ? DispatchPriority::Render : DispatchPriority::Background);
+    } catch (...) {
+        // 回调抛出异常时唤醒标记仍为true，需要重新投递唤醒消息，否则剩余的回调不会再执行
+        this->_PostWake();
+        throw;
+    }
+
+    if (!this->_queue.HasPending()) {
+        if (this->_queue.EndRun()) this->_PostWake();
+        return;
+    }
+
+    // 仍有回调未执行，唤醒标记保持不变，安排下一轮执行
+    // 投递的消息先于输入与绘制消息被取出，因此有这些消息时改用优先级最低的WM_TIMER唤醒
+    if (HIWORD(GetQueueStatus(QS_INPUT | QS_PAINT)) != 0) {
+        SetTimer(this->_hwnd, _DispatcherWakeTimerId, USER_TIMER_MINIMUM, NULL);
+    } else {
+        this->_PostWake();
+    }
+}
+
+LRESULT sw::Dispatcher::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    if (uMsg == WM_DispatcherWake || (uMsg == WM_TIMER && wParam == _DispatcherWakeTimerId)) {
+        auto dispatcher = reinterpret_cast<Dispatcher *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+        if (dispatcher != nullptr) {
+            MsgMonitor::DispatchScope scope(uMsg, "sw::Dispatcher", reinterpret_cast<uint64_t>(hwnd));
+            dispatcher->_OnWake();
+        }
+        return 0;
+    }
+    return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+}
@@ -0,0 +1,101 @@
+#include "FontCache.h"
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+    /**
+     * @brief 字体缓存的键，LOGFONTW由值初始化后填充，未使用的字节均为0，因此可以逐字节比较
+     */
+    struct _FontKey {
+        LOGFONTW logFont;
+
+        bool operator==(const _FontKey &other) const
+        {
+            return std::memcmp(&this->logFont, &other.logFont, sizeof(LOGFONTW)) == 0;
+        }
+    };
+
+    /**
+     * @brief 字体缓存键的哈希函数，FNV-1a
+     */
+    struct _FontKeyHash {
+        size_t operator()(const _FontKey &key) const
+        {
+            const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&key.logFont);
+
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < sizeof(LOGFONTW); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    /**
+     * @brief 字体缓存类型
+     */
+    using _FontHandleCache = sw::HandleCache<_FontKey, HFONT, _FontKeyHash>;
+
+    /**
+     * @brief 保护字体缓存的互斥锁
+     */
+    std::mutex &_GetFontCacheMutex()
+    {
+        static std::mutex *mutex = new std::mutex;
+        return *mutex;
+    }
+
+    /**
+     * @brief 获取进程范围的字体缓存，调用时需持有_GetFontCacheMutex
+     * @note  缓存有意不释放，静态存储期的窗口析构时仍会释放其字体句柄
+     */
+    _FontHandleCache &_GetFontHandleCache()
+    {
+        static _FontHandleCache *cache = new _FontHandleCache(
+            [](const _FontKey &key) -> HFONT {
+                return CreateFontIndirectW(&key.logFont);
+            },
+            [](HFONT hfont) {
+                DeleteObject(hfont);
+            });
+        return *cache;
+    }
+}
+
+HFONT sw::FontCache::Acquire(const Font &font)
+{
+    std::lock_guard<std::mutex> lock(_GetFontCacheMutex());
+    return _GetFontHandleCache().Acquire(_FontKey{font});
+}
+
+bool sw::FontCache::Release(HFONT hfont)
+{
+    std::lock_guard<std::mutex> lock(_GetFontCacheMutex());
+    return _GetFontHandleCache().Release(hfont);
+}
+
+void sw::FontCache::Trim()
+{
+    std::lock_guard<std::mutex> lock(_GetFontCacheMutex());
+    _GetFontHandleCache().Trim();
+}
+
+void sw::FontCache::SetMaxIdleCount(size_t count)
+{
+    std::lock_guard<std::mutex> lock(_GetFontCacheMutex());
+    _GetFontHandleCache().SetMaxIdleCount(count);
+}
+
+sw::HandleCacheStats sw::FontCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_GetFontCacheMutex());
+    return _GetFontHandleCache().GetStats();
+}
+
+void sw::FontCache::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(_GetFontCacheMutex());
+    _GetFontHandleCache().ResetStats();
+}
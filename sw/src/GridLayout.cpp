@@ -131,24 +131,12 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure列
 
-    // 对childrenInfo进行排序
+    // 按照_UpdateInternalData中确定的顺序measure
     // 优先级 FixSize > AutoSize > FillRemain
-    // 对于优先级相同的则按照columnSpan从小到大排序
-    std::sort(
-        this->_internalData.childrenInfo.begin(),
-        this->_internalData.childrenInfo.end(),
-        [](const _ChildInfo &a, const _ChildInfo &b) -> bool {
-            if (a.colMeasureType != b.colMeasureType) {
-                // 先FixSize，后AutoSize，最后FillRemain
-                return a.colMeasureType < b.colMeasureType;
-            } else {
-                // 若类型相同，则按照跨列数从小到大measure
-                return a.layoutTag.columnSpan < b.layoutTag.columnSpan;
-            }
-        });
-
-    for (_ChildInfo &childInfo : this->_internalData.childrenInfo) {
-        bool breakFlag = false; // 标记是否退出循环
+    // 对于优先级相同的则按照columnSpan从小到大
+    for (int index : this->_internalData.colMeasureOrder) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[index];
+        bool breakFlag        = false; // 标记是否退出循环
 
         switch (childInfo.colMeasureType) {
             case GridRCType::FixSize: {
@@ -278,28 +266,17 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure行
 
-    // 对childrenInfo进行排序
+    // 按照_UpdateInternalData中确定的顺序measure
     // 优先级 FixSize > AutoSize > FillRemain
-    // 对于优先级相同的则按照rowSpan从小到大排序
-    std::sort(
-        this->_internalData.childrenInfo.begin(),
-        this->_internalData.childrenInfo.end(),
-        [](const _ChildInfo &a, const _ChildInfo &b) -> bool {
-            if (a.rowMeasureType != b.rowMeasureType) {
-                // 先FixSize，后AutoSize，最后FillRemain
-                return a.rowMeasureType < b.rowMeasureType;
-            } else {
-                // 若类型相同，则按照跨列数从小到大measure
-                return a.layoutTag.rowSpan < b.layoutTag.rowSpan;
-            }
-        });
+    // 对于优先级相同的则按照rowSpan从小到大
+    const std::vector<int> &rowMeasureOrder = this->_internalData.rowMeasureOrder;
 
     int measureIndex = 0;
 
     // Measure行类型为FixSize的元素
     while (measureIndex < childCount &&
-           this->_internalData.childrenInfo[measureIndex].rowMeasureType == GridRCType::FixSize) {
-        _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+           this->_internalData.childrenInfo[rowMeasureOrder[measureIndex]].rowMeasureType == GridRCType::FixSize) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
         Size measureSize{};
         for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -311,8 +288,8 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
 
     // Measure行类型为AutoSize的元素
     while (measureIndex < childCount &&
-           this->_internalData.childrenInfo[measureIndex].rowMeasureType == GridRCType::AutoSize) {
-        _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+           this->_internalData.childrenInfo[rowMeasureOrder[measureIndex]].rowMeasureType == GridRCType::AutoSize) {
+        _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
         Size measureSize{0, INFINITY};
         for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i) {
@@ -356,7 +333,7 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
     if (heightSizeToContent) {
         // 高度由内容决定，依据所占宽度最大元素为基准计算列宽度
         while (measureIndex < childCount) {
-            _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
             Size measureSize{0, INFINITY};
             for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -431,7 +408,7 @@ sw::Size sw::GridLayout::MeasureOverride(const Size &availableSize)
         }
         // Measure
         while (measureIndex < childCount) {
-            _ChildInfo &childInfo = this->_internalData.childrenInfo[measureIndex++];
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[rowMeasureOrder[measureIndex++]];
 
             Size measureSize{};
             for (int i = 0; i < childInfo.layoutTag.columnSpan; ++i)
@@ -490,8 +467,23 @@ void sw::GridLayout::ArrangeOverride(const Size &finalSize)
     }
 }
 
+void sw::GridLayout::InvalidateInternalData()
+{
+    this->_internalData.valid = false;
+}
+
 void sw::GridLayout::_UpdateInternalData()
 {
+    // 行列定义、子元素及其布局标记均未改变时无需重新生成内部数据，
+    // 此时只需重置各行列的尺寸，子元素的measure顺序也可以直接沿用
+    if (this->_IsInternalDataValid()) {
+        this->_ResetTracksSize();
+        return;
+    }
+
+    this->_internalData.rows.assign(this->rows.begin(), this->rows.end());
+    this->_internalData.cols.assign(this->columns.begin(), this->columns.end());
+
     this->_internalData.rowsInfo.clear();
     this->_internalData.colsInfo.clear();
     this->_internalData.childrenInfo.clear();
@@ -592,7 +584,8 @@ void sw::GridLayout::_UpdateInternalData()
 
         for (int i = 0; i < childCount; ++i) {
             ILayout &item     = this->GetChildLayoutAt(i);
-            GridLayoutTag tag = item.GetLayoutTag();
+            uint64_t rawTag   = item.GetLayoutTag();
+            GridLayoutTag tag = rawTag;
 
             // 确保row和column的值不会超过网格的大小
             // 由于类型是uint16_t，不存在值小于0的情况
@@ -650,6 +643,7 @@ void sw::GridLayout::_UpdateInternalData()
             }
 
             info.instance       = &item;
+            info.rawLayoutTag   = rawTag;
             info.layoutTag      = tag;
             info.rowMeasureType = rowMeasureType;
             info.colMeasureType = colMeasureType;
@@ -658,10 +652,116 @@ void sw::GridLayout::_UpdateInternalData()
         }
     }
 
+    // measure顺序
+    // 优先级 FixSize > AutoSize > FillRemain
+    // 对于优先级相同的则按照跨行/列数从小到大排序，仍相同时保持子元素原本的顺序
+    {
+        std::vector<_ChildInfo> &childrenInfo = this->_internalData.childrenInfo;
+        std::vector<int> &colMeasureOrder     = this->_internalData.colMeasureOrder;
+        std::vector<int> &rowMeasureOrder     = this->_internalData.rowMeasureOrder;
+
+        int childCount = (int)childrenInfo.size();
+        colMeasureOrder.resize(childCount);
+        rowMeasureOrder.resize(childCount);
+
+        for (int i = 0; i < childCount; ++i) {
+            colMeasureOrder[i] = i;
+            rowMeasureOrder[i] = i;
+        }
+
+        std::sort(colMeasureOrder.begin(), colMeasureOrder.end(),
+                  [&childrenInfo](int a, int b) -> bool {
+                      const _ChildInfo &infoA = childrenInfo[a];
+                      const _ChildInfo &infoB = childrenInfo[b];
+                      if (infoA.colMeasureType != infoB.colMeasureType) {
+                          // 先FixSize，后AutoSize，最后FillRemain
+                          return infoA.colMeasureType < infoB.colMeasureType;
+                      } else if (infoA.layoutTag.columnSpan != infoB.layoutTag.columnSpan) {
+                          // 若类型相同，则按照跨列数从小到大measure
+                          return infoA.layoutTag.columnSpan < infoB.layoutTag.columnSpan;
+                      } else {
+                          return a < b;
+                      }
+                  });
+
+        std::sort(rowMeasureOrder.begin(), rowMeasureOrder.end(),
+                  [&childrenInfo](int a, int b) -> bool {
+                      const _ChildInfo &infoA = childrenInfo[a];
+                      const _ChildInfo &infoB = childrenInfo[b];
+                      if (infoA.rowMeasureType != infoB.rowMeasureType) {
+                          // 先FixSize，后AutoSize，最后FillRemain
+                          return infoA.rowMeasureType < infoB.rowMeasureType;
+                      } else if (infoA.layoutTag.rowSpan != infoB.layoutTag.rowSpan) {
+                          // 若类型相同，则按照跨行数从小到大measure
+                          return infoA.layoutTag.rowSpan < infoB.layoutTag.rowSpan;
+                      } else {
+                          return a < b;
+                      }
+                  });
+    }
+
     // cells
     {
         this->_internalData.cells.resize(this->_internalData.rowsInfo.size() * this->_internalData.colsInfo.size());
     }
+
+    this->_internalData.valid = true;
+}
+
+bool sw::GridLayout::_IsInternalDataValid()
+{
+    if (!this->_internalData.valid) {
+        return false;
+    }
+
+    // 行定义
+    {
+        std::vector<GridRow> &rows = this->rows.GetStdVector();
+        if (rows.size() != this->_internalData.rows.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const GridRow &row = this->_internalData.rows[i];
+            if (rows[i].type != row.type || rows[i].height != row.height) return false;
+        }
+    }
+
+    // 列定义
+    {
+        std::vector<GridColumn> &cols = this->columns.GetStdVector();
+        if (cols.size() != this->_internalData.cols.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < cols.size(); ++i) {
+            const GridColumn &col = this->_internalData.cols[i];
+            if (cols[i].type != col.type || cols[i].width != col.width) return false;
+        }
+    }
+
+    // 子元素及其布局标记
+    {
+        int childCount = this->GetChildLayoutCount();
+        if (childCount != (int)this->_internalData.childrenInfo.size()) {
+            return false;
+        }
+        for (int i = 0; i < childCount; ++i) {
+            ILayout &item         = this->GetChildLayoutAt(i);
+            _ChildInfo &childInfo = this->_internalData.childrenInfo[i];
+            if (&item != childInfo.instance || item.GetLayoutTag() != childInfo.rawLayoutTag) return false;
+        }
+    }
+
+    return true;
+}
+
+void sw::GridLayout::_ResetTracksSize()
+{
+    for (_RowInfo &rowInfo : this->_internalData.rowsInfo) {
+        rowInfo.size = rowInfo.row.type == GridRCType::FixSize ? rowInfo.row.height : 0;
+    }
+    for (_ColInfo &colInfo : this->_internalData.colsInfo) {
+        colInfo.size = colInfo.col.type == GridRCType::FixSize ? colInfo.col.width : 0;
+    }
 }
 
 sw::Rect &sw::GridLayout::_GetCell(int row, int col)
@@ -1,4 +1,5 @@
 #include "GroupBox.h"
+#include "BrushCache.h"
 #include "Utils.h"
 
 namespace
@@ -38,7 +39,7 @@ void sw::GroupBox::OnDrawBorder(HDC hdc, RECT &rect)
         rect.top + headerHeight};
 
     if (hdc != NULL) {
-        HBRUSH hBrush = CreateSolidBrush(GetRealBackColor());
+        HBRUSH hBrush = BrushCache::Acquire(GetRealBackColor());
         ::SetBkColor(hdc, GetRealBackColor());
         ::SetTextColor(hdc, GetRealTextColor());
         ::SelectObject(hdc, GetFontHandle());
@@ -75,7 +76,7 @@ void sw::GroupBox::OnDrawBorder(HDC hdc, RECT &rect)
         std::wstring &text = GetInternalText();
         DrawTextW(hdc, text.c_str(), (int)text.size(), &rtHeaderText, DT_SINGLELINE);
 
-        DeleteObject(hBrush);
+        BrushCache::Release(hBrush);
     }
 
     rect.left += borderThicknessX;
@@ -0,0 +1,185 @@
+#include "HangWatchdog.h"
+#include <chrono>
+
+constexpr size_t sw::HangWatchdog::MaxReportCount;
+
+sw::HangWatchdog::HangWatchdog(double thresholdMs, const HangHandler &handler)
+    : _thresholdNs(thresholdMs > 0 ? (uint64_t)(thresholdMs * 1e6) : 1),
+      _handler(handler)
+{
+    this->_thread = std::thread([this] { this->_Run(); });
+}
+
+sw::HangWatchdog::~HangWatchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stopRequested = true;
+    }
+    this->_cv.notify_all();
+    this->_thread.join();
+}
+
+uint64_t sw::HangWatchdog::Now()
+{
+    static const auto origin = std::chrono::steady_clock::now();
+    return 1 + (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+sw::HangActivity sw::HangWatchdog::Enter(const HangActivity &activity)
+{
+    HangActivity previous = this->_current;
+    this->_current        = activity;
+    ++this->_depth;
+    this->_Publish(Now());
+    return previous;
+}
+
+void sw::HangWatchdog::Leave(const HangActivity &previous)
+{
+    this->_current = previous;
+    if (this->_depth > 1) {
+        --this->_depth;
+        this->_Publish(Now());
+    } else {
+        this->_depth = 0;
+        this->_Publish(0);
+    }
+}
+
+void sw::HangWatchdog::Idle()
+{
+    this->_Publish(0);
+}
+
+void sw::HangWatchdog::Resume()
+{
+    this->_Publish(this->_depth > 0 ? Now() : 0);
+}
+
+std::vector<sw::HangReport> sw::HangWatchdog::GetReports() const
+{
+    std::vector<HangReport> reports;
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        reports = this->_reports;
+    }
+
+    uint64_t now = Now();
+    for (HangReport &report : reports) {
+        if (!report.finished) report.durationMs = (now - report.beginNs) / 1e6;
+    }
+    return reports;
+}
+
+void sw::HangWatchdog::ClearReports()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_reports.clear();
+}
+
+void sw::HangWatchdog::_Publish(uint64_t busySince)
+{
+    // 只有被监视的线程写入，不需要原子的读-改-写
+    uint64_t sequence = this->_sequence.load(std::memory_order_relaxed);
+    this->_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    this->_busySince.store(busySince, std::memory_order_relaxed);
+    this->_activityMessage.store(this->_current.message, std::memory_order_relaxed);
+    this->_activityClassName.store(this->_current.className, std::memory_order_relaxed);
+    this->_activityHandle.store(this->_current.handle, std::memory_order_relaxed);
+
+    this->_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+uint64_t sw::HangWatchdog::_Snapshot(uint64_t &busySince, HangActivity &activity) const
+{
+    while (true) {
+        uint64_t sequence = this->_sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        busySince          = this->_busySince.load(std::memory_order_relaxed);
+        activity.message   = this->_activityMessage.load(std::memory_order_relaxed);
+        activity.className = this->_activityClassName.load(std::memory_order_relaxed);
+        activity.handle    = this->_activityHandle.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (this->_sequence.load(std::memory_order_relaxed) == sequence) {
+            return sequence;
+        }
+    }
+}
+
+void sw::HangWatchdog::_Run()
+{
+    // 检查间隔为阈值的1/4，卡顿的检测延迟不超过阈值的1.25倍
+    auto interval = std::chrono::nanoseconds(this->_thresholdNs / 4 > 1000000 ? this->_thresholdNs / 4 : 1000000);
+
+    bool hanging         = false; // 是否有尚未结束的卡顿
+    uint64_t hangId      = 0;     // 尚未结束的卡顿的序号
+    uint64_t hangSeq     = 0;     // 检测到卡顿时的序列计数
+    uint64_t hangBeginNs = 0;     // 尚未结束的卡顿开始忙碌的时间
+    HangReport hangReport;        // 尚未结束的卡顿
+
+    std::unique_lock<std::mutex> lock(this->_mutex);
+
+    while (!this->_cv.wait_for(lock, interval, [this] { return this->_stopRequested; })) {
+        lock.unlock();
+
+        uint64_t busySince;
+        HangActivity activity;
+        uint64_t sequence = this->_Snapshot(busySince, activity);
+        uint64_t now      = Now();
+
+        bool notify = false;
+
+        if (hanging && sequence != hangSeq) {
+            // 被监视的线程有了进展，卡顿结束，时长的误差不超过一个检查间隔
+            hanging               = false;
+            hangReport.durationMs = (now - hangBeginNs) / 1e6;
+            hangReport.finished   = true;
+            notify                = true;
+
+            lock.lock();
+            for (auto it = this->_reports.rbegin(); it != this->_reports.rend(); ++it) {
+                if (it->id == hangId) {
+                    *it = hangReport;
+                    break;
+                }
+            }
+            lock.unlock();
+
+        } else if (!hanging && busySince != 0 && now > busySince && now - busySince >= this->_thresholdNs) {
+            hanging     = true;
+            hangSeq     = sequence;
+            hangBeginNs = busySince;
+
+            lock.lock();
+            hangId = this->_nextReportId++;
+
+            hangReport.id         = hangId;
+            hangReport.activity   = activity;
+            hangReport.beginNs    = busySince;
+            hangReport.durationMs = (now - busySince) / 1e6;
+            hangReport.finished   = false;
+
+            if (this->_reports.size() >= MaxReportCount) {
+                this->_reports.erase(this->_reports.begin());
+            }
+            this->_reports.push_back(hangReport);
+            lock.unlock();
+
+            notify = true;
+        }
+
+        if (notify && this->_handler) {
+            this->_handler(hangReport);
+        }
+
+        lock.lock();
+    }
+}
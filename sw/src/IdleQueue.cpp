@@ -0,0 +1,111 @@
+#include "IdleQueue.h"
+#include <algorithm>
+
+sw::IdleDeadline::IdleDeadline(double budgetMilliseconds)
+    : _deadline(std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::milli>(budgetMilliseconds)))
+{
+}
+
+double sw::IdleDeadline::TimeRemaining() const
+{
+    double remaining = std::chrono::duration<double, std::milli>(this->_deadline - std::chrono::steady_clock::now()).count();
+    return remaining > 0 ? remaining : 0;
+}
+
+bool sw::IdleDeadline::HasTimeRemaining() const
+{
+    return std::chrono::steady_clock::now() < this->_deadline;
+}
+
+uint64_t sw::IdleQueue::Add(const IdleHandler &handler)
+{
+    uint64_t id = this->_nextId++;
+    this->_items.push_back(_Item{id, handler, false});
+    ++this->_count;
+    return id;
+}
+
+bool sw::IdleQueue::Remove(uint64_t id)
+{
+    for (size_t i = 0; i < this->_items.size(); ++i) {
+        _Item &item = this->_items[i];
+        if (item.id == id && !item.removed) {
+            item.removed = true;
+            --this->_count;
+            if (!this->_running) this->_Compact();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool sw::IdleQueue::HasWork() const
+{
+    return this->_count != 0;
+}
+
+size_t sw::IdleQueue::GetCount() const
+{
+    return this->_count;
+}
+
+int sw::IdleQueue::Run(double budgetMilliseconds)
+{
+    if (this->_count == 0 || this->_running) {
+        return 0;
+    }
+
+    struct _RunGuard {
+        IdleQueue *queue;
+        ~_RunGuard()
+        {
+            this->queue->_running = false;
+            this->queue->_Compact();
+        }
+    } guard{this};
+
+    this->_running = true;
+
+    IdleDeadline deadline(budgetMilliseconds);
+    int count = 0;
+
+    while (this->_count != 0) {
+        if (count != 0 && !deadline.HasTimeRemaining()) {
+            break;
+        }
+
+        // 回调中添加的回调位于末尾，同样参与轮流执行
+        size_t index = this->_cursor < this->_items.size() ? this->_cursor : 0;
+        this->_cursor = index + 1;
+
+        if (this->_items[index].removed) {
+            continue;
+        }
+
+        ++count;
+        if (!this->_items[index].handler(deadline)) {
+            // 回调中可能已经移除了自身
+            if (!this->_items[index].removed) {
+                this->_items[index].removed = true;
+                --this->_count;
+            }
+        }
+    }
+    return count;
+}
+
+void sw::IdleQueue::_Compact()
+{
+    // 保持_cursor指向同一个回调
+    size_t cursor = 0;
+    for (size_t i = 0; i < this->_cursor && i < this->_items.size(); ++i) {
+        if (!this->_items[i].removed) ++cursor;
+    }
+
+    this->_items.erase(
+        std::remove_if(this->_items.begin(), this->_items.end(), [](const _Item &item) { return item.removed; }),
+        this->_items.end());
+    this->_cursor = cursor;
+}
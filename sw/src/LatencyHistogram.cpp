@@ -0,0 +1,169 @@
+#include "LatencyHistogram.h"
+#include "Utils.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+constexpr int sw::LatencyHistogram::SubBucketCount;
+constexpr int sw::LatencyHistogram::BucketCount;
+
+namespace
+{
+    /**
+     * @brief 每个2的幂区间的桶数对应的位数
+     */
+    constexpr int _SubBucketBits = 3;
+
+    /**
+     * @brief 获取非零整数最高的为1的位的位置
+     */
+    int _HighestBit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return (int)index;
+#else
+        int index = 0;
+        while (value >>= 1) ++index;
+        return index;
+#endif
+    }
+}
+
+void sw::LatencyHistogram::Record(uint64_t nanoseconds)
+{
+    ++this->_buckets[GetBucketIndex(nanoseconds)];
+
+    if (this->_count == 0 || nanoseconds < this->_minimum) this->_minimum = nanoseconds;
+    if (this->_count == 0 || nanoseconds > this->_maximum) this->_maximum = nanoseconds;
+    this->_total += nanoseconds;
+    ++this->_count;
+}
+
+void sw::LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+    if (other._count == 0) {
+        return;
+    }
+    for (int i = 0; i < BucketCount; ++i) {
+        this->_buckets[i] += other._buckets[i];
+    }
+    if (this->_count == 0 || other._minimum < this->_minimum) this->_minimum = other._minimum;
+    if (this->_count == 0 || other._maximum > this->_maximum) this->_maximum = other._maximum;
+    this->_total += other._total;
+    this->_count += other._count;
+}
+
+void sw::LatencyHistogram::Clear()
+{
+    *this = LatencyHistogram{};
+}
+
+uint64_t sw::LatencyHistogram::GetCount() const
+{
+    return this->_count;
+}
+
+uint64_t sw::LatencyHistogram::GetTotal() const
+{
+    return this->_total;
+}
+
+uint64_t sw::LatencyHistogram::GetMinimum() const
+{
+    return this->_minimum;
+}
+
+uint64_t sw::LatencyHistogram::GetMaximum() const
+{
+    return this->_maximum;
+}
+
+double sw::LatencyHistogram::GetAverage() const
+{
+    return this->_count == 0 ? 0 : (double)this->_total / this->_count;
+}
+
+uint64_t sw::LatencyHistogram::GetPercentile(double percentile) const
+{
+    if (this->_count == 0) {
+        return 0;
+    }
+
+    // 第rank个样本所在的桶，rank从1开始
+    double rank     = percentile / 100 * this->_count;
+    uint64_t target = rank <= 1 ? 1 : (uint64_t)(rank + 0.5);
+    if (target > this->_count) target = this->_count;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += this->_buckets[i];
+        if (seen >= target) {
+            uint64_t upper = GetBucketUpperBound(i);
+            return upper < this->_maximum ? upper : this->_maximum;
+        }
+    }
+    return this->_maximum;
+}
+
+uint64_t sw::LatencyHistogram::GetBucketCount(int index) const
+{
+    return (index >= 0 && index < BucketCount) ? this->_buckets[index] : 0;
+}
+
+uint64_t sw::LatencyHistogram::GetBucketLowerBound(int index)
+{
+    if (index < SubBucketCount) {
+        return (uint64_t)index;
+    }
+    int exponent = index / SubBucketCount - 1 + _SubBucketBits;
+    int sub      = index % SubBucketCount;
+    return (uint64_t)(SubBucketCount + sub) << (exponent - _SubBucketBits);
+}
+
+uint64_t sw::LatencyHistogram::GetBucketUpperBound(int index)
+{
+    if (index >= BucketCount - 1) {
+        return UINT64_MAX;
+    }
+    return GetBucketLowerBound(index + 1) - 1;
+}
+
+int sw::LatencyHistogram::GetBucketIndex(uint64_t nanoseconds)
+{
+    if (nanoseconds < (uint64_t)SubBucketCount) {
+        return (int)nanoseconds;
+    }
+
+    // 最高位决定所在的2的幂区间，其后的_SubBucketBits位决定区间内的桶
+    int exponent = _HighestBit(nanoseconds);
+    int sub      = (int)((nanoseconds >> (exponent - _SubBucketBits)) & (SubBucketCount - 1));
+    int index    = (exponent - _SubBucketBits + 1) * SubBucketCount + sub;
+    return index < BucketCount ? index : BucketCount - 1;
+}
+
+std::wstring sw::LatencyHistogram::ToJson() const
+{
+    std::wstring result = Utils::FormatStr(
+        L"{\"count\":%llu,\"totalUs\":%.3f,\"minUs\":%.3f,\"maxUs\":%.3f,\"avgUs\":%.3f,"
+        L"\"p50Us\":%.3f,\"p90Us\":%.3f,\"p99Us\":%.3f,\"p999Us\":%.3f,\"buckets\":[",
+        (unsigned long long)this->_count, this->_total / 1e3, this->_minimum / 1e3, this->_maximum / 1e3,
+        this->GetAverage() / 1e3, this->GetPercentile(50) / 1e3, this->GetPercentile(90) / 1e3,
+        this->GetPercentile(99) / 1e3, this->GetPercentile(99.9) / 1e3);
+
+    // 只输出非空的桶，每个桶为[下界, 样本数]
+    bool first = true;
+    for (int i = 0; i < BucketCount; ++i) {
+        if (this->_buckets[i] == 0) continue;
+        result += Utils::FormatStr(L"%ls[%.3f,%llu]", first ? L"" : L",",
+                                   GetBucketLowerBound(i) / 1e3, (unsigned long long)this->_buckets[i]);
+        first = false;
+    }
+
+    result += L"]}";
+    return result;
+}
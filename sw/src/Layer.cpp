@@ -1,4 +1,5 @@
 #include "Layer.h"
+#include "LayoutProfiler.h"
 #include <cmath>
 
 namespace
@@ -7,6 +8,23 @@ namespace
      * @brief 滚动条滚动一行的距离
      */
     constexpr int _LayerScrollBarLineInterval = 20;
+
+    /**
+     * @brief Blit模式下鼠标滚轮停止滚动多久后重新安排子元素（毫秒）
+     */
+    constexpr uint32_t _LayerWheelSettleDelay = 200;
+
+    /**
+     * @brief 获取滚动条正在拖动的位置，WM_VSCROLL和WM_HSCROLL中的位置只有16位，内容较长时会溢出
+     */
+    int _GetScrollTrackPos(HWND hwnd, int bar)
+    {
+        SCROLLINFO info{};
+        info.cbSize = sizeof(info);
+        info.fMask  = SIF_TRACKPOS;
+        GetScrollInfo(hwnd, bar, &info);
+        return info.nTrackPos;
+    }
 }
 
 sw::Layer::Layer()
@@ -93,8 +111,10 @@ sw::Layer::Layer()
               LayoutHost *layout = this->_GetLayout();
 
               if (layout != nullptr && !this->_horizontalScrollDisabled && this->HorizontalScrollBar) {
+                  double oldOffsetX = this->GetInternalArrangeOffsetX();
+                  double oldOffsetY = this->GetInternalArrangeOffsetY();
                   this->GetInternalArrangeOffsetX() = -HorizontalScrollPos;
-                  this->_MeasureAndArrangeWithoutResize();
+                  this->_ScrollContent(oldOffsetX, oldOffsetY);
               }
           }),
 
@@ -118,8 +138,10 @@ sw::Layer::Layer()
               LayoutHost *layout = this->_GetLayout();
 
               if (layout != nullptr && !this->_verticalScrollDisabled && this->VerticalScrollBar) {
+                  double oldOffsetX = this->GetInternalArrangeOffsetX();
+                  double oldOffsetY = this->GetInternalArrangeOffsetY();
                   this->GetInternalArrangeOffsetY() = -VerticalScrollPos;
-                  this->_MeasureAndArrangeWithoutResize();
+                  this->_ScrollContent(oldOffsetX, oldOffsetY);
               }
           }),
 
@@ -157,12 +179,25 @@ sw::Layer::Layer()
           // set
           [this](const bool &value) {
               this->_mouseWheelScrollEnabled = value;
+          }),
+
+      ScrollMode(
+          // get
+          [this]() -> sw::ScrollMode {
+              return this->_scrollMode;
+          },
+          // set
+          [this](const sw::ScrollMode &value) {
+              this->_scrollMode = value;
           })
 {
 }
 
 sw::Layer::~Layer()
 {
+    if (this->_wheelSettleTimer != 0) {
+        this->_wheelSettleService->Destroy(this->_wheelSettleTimer);
+    }
 }
 
 sw::LayoutHost *sw::Layer::_GetLayout()
@@ -178,6 +213,8 @@ void sw::Layer::_MeasureAndArrangeWithoutLayout()
 
     int childCount = this->GetChildLayoutCount();
 
+    UIElement::BeginArrangeBatch();
+
     for (int i = 0; i < childCount; ++i) {
         // measure
         UIElement &item = static_cast<UIElement &>(this->GetChildLayoutAt(i));
@@ -188,14 +225,52 @@ void sw::Layer::_MeasureAndArrangeWithoutLayout()
         Thickness itemMargin = item.Margin;
         item.Arrange(sw::Rect{itemRect.left - itemMargin.left, itemRect.top - itemMargin.top, desireSize.width, desireSize.height});
     }
+
+    UIElement::EndArrangeBatch();
 }
 
 void sw::Layer::_MeasureAndArrangeWithoutResize()
 {
-    LayoutHost *layout  = this->_GetLayout();
-    sw::Size clientSize = this->ClientRect->GetSize();
+    this->_MeasureAndArrangeWithoutResize(this->ClientRect->GetSize());
+}
+
+void sw::Layer::_MeasureAndArrangeWithoutResize(const Size &clientSize)
+{
+    LayoutHost *layout = this->_GetLayout();
+
+    UIElement::BeginArrangeBatch();
     layout->MeasureOverride(clientSize);
     layout->ArrangeOverride(clientSize);
+    UIElement::EndArrangeBatch();
+}
+
+void sw::Layer::_ScrollContent(double oldOffsetX, double oldOffsetY)
+{
+    // 正在安排时窗口的位置尚未提交，无法移动已绘制的内容，此时按原方式重新安排
+    if (this->_scrollMode != sw::ScrollMode::Blit || WindowPositioner::IsInBatch()) {
+        this->_MeasureAndArrangeWithoutResize();
+        return;
+    }
+
+    // Arrange中偏移量单独换算为像素后与子元素的位置相加，因此按偏移量换算后的差值移动子元素与重新安排的结果相同
+    // 若布局已失效，LayoutScheduler稍后会按新的偏移量重新安排，因此这里只需移动内容
+    int dx = Dip::DipToPxX(this->GetInternalArrangeOffsetX()) - Dip::DipToPxX(oldOffsetX);
+    int dy = Dip::DipToPxY(this->GetInternalArrangeOffsetY()) - Dip::DipToPxY(oldOffsetY);
+    this->BlitScrollChildren(dx, dy);
+}
+
+void sw::Layer::_ArrangeAfterWheelSettled()
+{
+    if (this->_wheelSettleTimer == 0) {
+        this->_wheelSettleService = &TimerService::GetCurrent();
+        this->_wheelSettleTimer   = this->_wheelSettleService->Create([this]() {
+            if (this->_scrollMode == sw::ScrollMode::Blit) {
+                this->_MeasureAndArrangeWithoutResize();
+            }
+        });
+    }
+    // 每次滚动都重新开始计时，连续滚动时只在最后一次滚动后安排一次
+    this->_wheelSettleService->Start(this->_wheelSettleTimer, _LayerWheelSettleDelay);
 }
 
 void sw::Layer::UpdateLayout()
@@ -206,13 +281,23 @@ void sw::Layer::UpdateLayout()
 
     LayoutHost *layout = this->_GetLayout();
 
+    bool profiling = LayoutProfiler::IsEnabled();
+    if (profiling) {
+        LayoutProfiler::BeginPass("UpdateLayout");
+    }
+
     if (layout == nullptr) {
         this->_MeasureAndArrangeWithoutLayout();
     } else {
         this->_MeasureAndArrangeWithoutResize();
     }
 
-    this->UpdateScrollRange();
+    if (profiling) {
+        LayoutProfiler::EndPass();
+    }
+
+    // 子元素的位置改变提交后才能得到正确的滚动范围
+    this->QueueArrangeCommitted();
     // this->Redraw();
 }
 
@@ -261,6 +346,13 @@ void sw::Layer::OnScroll(ScrollOrientation scrollbar, ScrollEvent event, double
                 this->ScrollHorizontal(_LayerScrollBarLineInterval);
                 break;
             }
+            case ScrollEvent::EndScroll: {
+                // Blit模式下滚动过程中没有重新安排子元素，滚动结束时安排一次
+                if (this->_scrollMode == sw::ScrollMode::Blit) {
+                    this->_MeasureAndArrangeWithoutResize();
+                }
+                break;
+            }
             default: {
                 break;
             }
@@ -296,6 +388,12 @@ void sw::Layer::OnScroll(ScrollOrientation scrollbar, ScrollEvent event, double
                 this->ScrollVertical(_LayerScrollBarLineInterval);
                 break;
             }
+            case ScrollEvent::EndScroll: {
+                if (this->_scrollMode == sw::ScrollMode::Blit) {
+                    this->_MeasureAndArrangeWithoutResize();
+                }
+                break;
+            }
             default: {
                 break;
             }
@@ -306,14 +404,14 @@ void sw::Layer::OnScroll(ScrollOrientation scrollbar, ScrollEvent event, double
 bool sw::Layer::OnVerticalScroll(int event, int pos)
 {
     this->OnScroll(ScrollOrientation::Vertical, (ScrollEvent)event,
-                   (event == SB_THUMBTRACK || event == SB_THUMBPOSITION) ? Dip::PxToDipY(pos) : (0.0));
+                   (event == SB_THUMBTRACK || event == SB_THUMBPOSITION) ? Dip::PxToDipY(_GetScrollTrackPos(this->Handle, SB_VERT)) : (0.0));
     return true;
 }
 
 bool sw::Layer::OnHorizontalScroll(int event, int pos)
 {
     this->OnScroll(ScrollOrientation::Horizontal, (ScrollEvent)event,
-                   (event == SB_THUMBTRACK || event == SB_THUMBPOSITION) ? Dip::PxToDipX(pos) : (0.0));
+                   (event == SB_THUMBTRACK || event == SB_THUMBPOSITION) ? Dip::PxToDipX(_GetScrollTrackPos(this->Handle, SB_HORZ)) : (0.0));
     return true;
 }
 
@@ -339,13 +437,15 @@ void sw::Layer::ArrangeOverride(const Size &finalSize)
         this->_MeasureAndArrangeWithoutLayout();
     } else if (!this->_autoSize) {
         // 已设置布局方式，但是AutoSize被取消，此时子元素也未Measure
-        this->_MeasureAndArrangeWithoutResize();
+        // 当前元素的位置改变可能尚未提交，使用传入的尺寸而不是当前的客户区尺寸
+        this->_MeasureAndArrangeWithoutResize(finalSize);
     } else {
         // 已设置布局方式且AutoSize为true，此时子元素已Measure，调用Arrange即可
         layout->ArrangeOverride(finalSize);
     }
 
-    this->UpdateScrollRange();
+    // 滚动范围依赖当前元素及子元素的实际尺寸，需等到位置改变提交后再更新
+    this->QueueArrangeCommitted();
 }
 
 bool sw::Layer::RequestBringIntoView(const sw::Rect &screenRect)
@@ -412,10 +512,31 @@ bool sw::Layer::OnRoutedEvent(RoutedEventArgs &eventArgs, const RoutedEventHandl
                 eventArgs.handled = true;
             }
         }
+        // 滚轮滚动不会产生SB_ENDSCROLL，Blit模式下在滚动停止后重新安排一次
+        if (eventArgs.handled && this->_scrollMode == sw::ScrollMode::Blit) {
+            this->_ArrangeAfterWheelSettled();
+        }
     }
     return true;
 }
 
+bool sw::Layer::CanArrangeChildInPlace()
+{
+    return !this->_layoutDisabled && this->_GetLayout() != nullptr;
+}
+
+void sw::Layer::OnArrangeCommitted()
+{
+    this->UpdateScrollRange();
+}
+
+double sw::Layer::GetScrollExtent(ScrollOrientation orientation)
+{
+    return orientation == ScrollOrientation::Horizontal
+               ? this->GetChildRightmost(true)
+               : this->GetChildBottommost(true);
+}
+
 void sw::Layer::DisableLayout()
 {
     this->_layoutDisabled = true;
@@ -521,7 +642,7 @@ void sw::Layer::UpdateScrollRange()
     }
 
     if (this->HorizontalScrollBar) {
-        double childRightmost = this->GetChildRightmost(true);
+        double childRightmost = this->GetScrollExtent(ScrollOrientation::Horizontal);
 
         if (int(childRightmost - this->ClientWidth) > 0) {
             this->_horizontalScrollDisabled = false;
@@ -542,7 +663,7 @@ void sw::Layer::UpdateScrollRange()
     }
 
     if (this->VerticalScrollBar) {
-        double childBottommost = this->GetChildBottommost(true);
+        double childBottommost = this->GetScrollExtent(ScrollOrientation::Vertical);
 
         if (int(childBottommost - this->ClientHeight) > 0) {
             this->_verticalScrollDisabled = false;
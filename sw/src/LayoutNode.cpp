@@ -0,0 +1,223 @@
+#include "LayoutNode.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+
+sw::LayoutNode::LayoutNode()
+{
+}
+
+sw::LayoutNode::LayoutNode(const Size &size)
+    : size(size)
+{
+}
+
+sw::LayoutNode::~LayoutNode()
+{
+    if (this->_parent != nullptr) {
+        this->_parent->RemoveChild(this);
+    }
+    for (LayoutNode *child : this->_children) {
+        child->_parent = nullptr;
+    }
+}
+
+void sw::LayoutNode::SetLayout(LayoutHost *layout)
+{
+    if (layout != nullptr)
+        layout->Associate(this);
+    this->_layout = layout;
+}
+
+sw::LayoutHost *sw::LayoutNode::GetLayout()
+{
+    return this->_layout;
+}
+
+void sw::LayoutNode::SetLayoutTag(uint64_t layoutTag)
+{
+    this->_layoutTag = layoutTag;
+}
+
+sw::LayoutNode *sw::LayoutNode::GetParent()
+{
+    return this->_parent;
+}
+
+int sw::LayoutNode::GetChildCount()
+{
+    return (int)this->_children.size();
+}
+
+sw::LayoutNode &sw::LayoutNode::GetChildAt(int index)
+{
+    return *this->_children[index];
+}
+
+bool sw::LayoutNode::AddChild(LayoutNode *node)
+{
+    if (node == nullptr || node == this || node->_parent == this) {
+        return false;
+    }
+    if (node->_parent != nullptr) {
+        node->_parent->RemoveChild(node);
+    }
+    node->_parent = this;
+    this->_children.push_back(node);
+    return true;
+}
+
+bool sw::LayoutNode::AddChild(LayoutNode *node, uint64_t layoutTag)
+{
+    if (node == nullptr) {
+        return false;
+    }
+    node->_layoutTag = layoutTag;
+    return this->AddChild(node);
+}
+
+bool sw::LayoutNode::RemoveChild(LayoutNode *node)
+{
+    auto it = std::find(this->_children.begin(), this->_children.end(), node);
+    if (it == this->_children.end()) {
+        return false;
+    }
+    node->_parent = nullptr;
+    this->_children.erase(it);
+    return true;
+}
+
+void sw::LayoutNode::ClearChildren()
+{
+    for (LayoutNode *child : this->_children) {
+        child->_parent = nullptr;
+    }
+    this->_children.clear();
+}
+
+sw::Rect sw::LayoutNode::GetArrangeRect()
+{
+    return this->_arrangeRect;
+}
+
+void sw::LayoutNode::UpdateLayout(const Size &availableSize)
+{
+    WindowPositioner::BeginBatch();
+    this->Measure(availableSize);
+    this->Arrange(Rect{0, 0, availableSize.width, availableSize.height});
+    WindowPositioner::EndBatch();
+}
+
+uint64_t sw::LayoutNode::GetLayoutTag()
+{
+    return this->_layoutTag;
+}
+
+int sw::LayoutNode::GetChildLayoutCount()
+{
+    return (int)this->_children.size();
+}
+
+sw::ILayout &sw::LayoutNode::GetChildLayoutAt(int index)
+{
+    return *this->_children[index];
+}
+
+sw::Size sw::LayoutNode::GetDesireSize()
+{
+    return this->_desireSize;
+}
+
+void sw::LayoutNode::Measure(const Size &availableSize)
+{
+    Size measureSize  = availableSize;
+    Thickness &margin = this->margin;
+
+    measureSize.width -= margin.left + margin.right;
+    measureSize.height -= margin.top + margin.bottom;
+
+    if (this->_layout != nullptr && this->_layout->IsAssociated(this)) {
+        this->_desireSize = this->_layout->MeasureOverride(measureSize);
+    } else {
+        this->_desireSize = this->size;
+    }
+
+    this->_desireSize.width += margin.left + margin.right;
+    this->_desireSize.height += margin.top + margin.bottom;
+}
+
+void sw::LayoutNode::Arrange(const Rect &finalPosition)
+{
+    Size &desireSize  = this->_desireSize;
+    Thickness &margin = this->margin;
+
+    Rect rect;
+    rect.width  = desireSize.width - margin.left - margin.right;
+    rect.height = desireSize.height - margin.top - margin.bottom;
+
+    if (this->horizontalAlignment == HorizontalAlignment::Stretch) {
+        rect.width = finalPosition.width - margin.left - margin.right;
+    }
+
+    if (this->verticalAlignment == VerticalAlignment::Stretch) {
+        rect.height = finalPosition.height - margin.top - margin.bottom;
+    }
+
+    switch (this->horizontalAlignment) {
+        case HorizontalAlignment::Center:
+        case HorizontalAlignment::Stretch: {
+            rect.left = finalPosition.left + (finalPosition.width - rect.width - margin.left - margin.right) / 2 + margin.left;
+            break;
+        }
+        case HorizontalAlignment::Left: {
+            rect.left = finalPosition.left + margin.left;
+            break;
+        }
+        case HorizontalAlignment::Right: {
+            rect.left = finalPosition.left + finalPosition.width - rect.width - margin.right;
+            break;
+        }
+    }
+
+    switch (this->verticalAlignment) {
+        case VerticalAlignment::Center:
+        case VerticalAlignment::Stretch: {
+            rect.top = finalPosition.top + (finalPosition.height - rect.height - margin.top - margin.bottom) / 2 + margin.top;
+            break;
+        }
+        case VerticalAlignment::Top: {
+            rect.top = finalPosition.top + margin.top;
+            break;
+        }
+        case VerticalAlignment::Bottom: {
+            rect.top = finalPosition.top + finalPosition.height - rect.height - margin.bottom;
+            break;
+        }
+    }
+
+    rect.width  = Utils::Max(0.0, rect.width);
+    rect.height = Utils::Max(0.0, rect.height);
+
+    this->_arrangeRect = rect;
+
+    WindowPositioner::BeginBatch();
+
+    // 与UIElement相同，只有像素位置改变时才提交
+    PixelRect pixelRect;
+    pixelRect.left   = (int)std::lround(rect.left);
+    pixelRect.top    = (int)std::lround(rect.top);
+    pixelRect.width  = (int)std::lround(rect.width);
+    pixelRect.height = (int)std::lround(rect.height);
+
+    if (!this->_hasPixelRect || pixelRect != this->_pixelRect) {
+        this->_pixelRect    = pixelRect;
+        this->_hasPixelRect = true;
+        WindowPositioner::Move(this, this->_parent, pixelRect);
+    }
+
+    if (this->_layout != nullptr && this->_layout->IsAssociated(this)) {
+        this->_layout->ArrangeOverride(rect.GetSize());
+    }
+
+    WindowPositioner::EndBatch();
+}
@@ -0,0 +1,343 @@
+#include "LayoutProfiler.h"
+#include "Utils.h"
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+    /**
+     * @brief 正在记录的Measure或Arrange调用
+     */
+    struct _Frame {
+        int node;     // 元素对应节点的索引
+        size_t event; // 对应事件的索引
+    };
+
+    /**
+     * @brief 线程局部的分析器状态
+     */
+    struct _ProfilerState {
+        std::vector<sw::LayoutProfilePass> passes;         // 已完成的布局过程
+        size_t maxPassCount = 16;                          // 最多保留的布局过程数
+        uint64_t nextPassId = 1;                           // 下一个布局过程的序号
+        sw::LayoutProfilePass current;                     // 正在进行的布局过程
+        int passDepth     = 0;                             // 布局过程的嵌套层数
+        bool implicitPass = false;                         // 当前布局过程是否为隐式开始的
+        std::unordered_map<const void *, int> nodeIndices; // 元素地址到节点索引的映射
+        std::vector<_Frame> frames;                        // 正在记录的调用
+    };
+
+    thread_local _ProfilerState _state;
+
+    /**
+     * @brief 获取当前时间（纳秒），相对于首次调用该函数的时间
+     */
+    uint64_t _Now()
+    {
+        static const auto origin = std::chrono::steady_clock::now();
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    /**
+     * @brief 获取元素对应的节点，不存在时添加
+     */
+    int _GetNode(const void *element, const void *parentElement, const char *name)
+    {
+        auto it = _state.nodeIndices.find(element);
+        if (it != _state.nodeIndices.end()) {
+            return it->second;
+        }
+
+        int index = (int)_state.current.nodes.size();
+        _state.current.nodes.emplace_back();
+
+        sw::LayoutProfileNode &node = _state.current.nodes.back();
+        node.element                = element;
+        node.parentElement          = parentElement;
+        node.name                   = name;
+
+        _state.nodeIndices.emplace(element, index);
+        return index;
+    }
+
+    /**
+     * @brief 开始记录一次调用
+     */
+    void _BeginCall(const void *element, const void *parentElement, const char *name, bool arrange)
+    {
+        if (_state.passDepth == 0) {
+            sw::LayoutProfiler::BeginPass("Implicit");
+            _state.implicitPass = true;
+        }
+
+        int node = _GetNode(element, parentElement, name);
+        _state.frames.push_back({node, _state.current.events.size()});
+        _state.current.events.push_back({node, arrange, false, _Now(), 0});
+    }
+
+    /**
+     * @brief 结束最近一次开始记录的调用，返回对应的事件，没有正在记录的调用时返回nullptr
+     */
+    sw::LayoutProfileEvent *_EndCall()
+    {
+        if (_state.frames.empty()) {
+            return nullptr;
+        }
+
+        _Frame frame = _state.frames.back();
+        _state.frames.pop_back();
+
+        sw::LayoutProfileEvent &event = _state.current.events[frame.event];
+        event.durationNs              = _Now() - event.beginNs;
+        return &event;
+    }
+
+    /**
+     * @brief 隐式开始的布局过程在所有调用结束后自动结束
+     */
+    void _EndImplicitPass()
+    {
+        if (_state.frames.empty() && _state.implicitPass && _state.passDepth == 1) {
+            sw::LayoutProfiler::EndPass();
+        }
+    }
+}
+
+bool sw::LayoutProfiler::_enabled = false;
+
+uint32_t sw::LayoutProfilePass::GetMeasureCount() const
+{
+    uint32_t count = 0;
+    for (const LayoutProfileNode &node : this->nodes) count += node.measureCount;
+    return count;
+}
+
+uint32_t sw::LayoutProfilePass::GetMeasureCacheHits() const
+{
+    uint32_t count = 0;
+    for (const LayoutProfileNode &node : this->nodes) count += node.measureCacheHits;
+    return count;
+}
+
+uint32_t sw::LayoutProfilePass::GetArrangeCount() const
+{
+    uint32_t count = 0;
+    for (const LayoutProfileNode &node : this->nodes) count += node.arrangeCount;
+    return count;
+}
+
+uint32_t sw::LayoutProfilePass::GetWindowMoves() const
+{
+    uint32_t count = 0;
+    for (const LayoutProfileNode &node : this->nodes) count += node.windowMoves;
+    return count;
+}
+
+std::wstring sw::LayoutProfilePass::ToString() const
+{
+    std::wstring result = Utils::FormatStr(
+        L"%ls #%llu: %.3f ms, measure %u (cache hits %u), arrange %u, window moves %u\n",
+        Utils::ToWideStr(this->reason).c_str(), (unsigned long long)this->id, this->durationNs / 1e6,
+        this->GetMeasureCount(), this->GetMeasureCacheHits(), this->GetArrangeCount(), this->GetWindowMoves());
+
+    // 深度优先遍历，栈中记录节点索引及其深度
+    std::vector<std::pair<int, int>> stack;
+    for (auto it = this->roots.rbegin(); it != this->roots.rend(); ++it) {
+        stack.emplace_back(*it, 1);
+    }
+
+    while (!stack.empty()) {
+        int index = stack.back().first;
+        int depth = stack.back().second;
+        stack.pop_back();
+
+        const LayoutProfileNode &node = this->nodes[index];
+
+        result.append(depth * 2, L' ');
+        result += Utils::GetTypeDisplayName(node.name);
+        result += Utils::FormatStr(L": measure %u (hits %u) %.3f ms, arrange %u %.3f ms, moves %u\n",
+                                   node.measureCount, node.measureCacheHits, node.measureNs / 1e6,
+                                   node.arrangeCount, node.arrangeNs / 1e6, node.windowMoves);
+
+        for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+            stack.emplace_back(*it, depth + 1);
+        }
+    }
+    return result;
+}
+
+void sw::LayoutProfiler::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+
+    // 丢弃当前线程未完成的布局过程，避免启用状态在布局过程中改变时记录不完整
+    _state.current      = LayoutProfilePass{};
+    _state.passDepth    = 0;
+    _state.implicitPass = false;
+    _state.nodeIndices.clear();
+    _state.frames.clear();
+}
+
+void sw::LayoutProfiler::SetMaxPassCount(size_t count)
+{
+    _state.maxPassCount = count < 1 ? 1 : count;
+
+    if (_state.passes.size() > _state.maxPassCount) {
+        _state.passes.erase(_state.passes.begin(), _state.passes.end() - _state.maxPassCount);
+    }
+}
+
+void sw::LayoutProfiler::Clear()
+{
+    _state.passes.clear();
+}
+
+const std::vector<sw::LayoutProfilePass> &sw::LayoutProfiler::GetPasses()
+{
+    return _state.passes;
+}
+
+const sw::LayoutProfilePass *sw::LayoutProfiler::GetLastPass()
+{
+    return _state.passes.empty() ? nullptr : &_state.passes.back();
+}
+
+std::wstring sw::LayoutProfiler::ToChromeTrace()
+{
+    std::wstring result = L"{\"traceEvents\":[";
+    bool first          = true;
+
+    // 每个布局过程及其中的每次调用都输出为一个完整事件（ph为X），时间单位为微秒
+    for (const LayoutProfilePass &pass : _state.passes) {
+        result += first ? L"\n" : L",\n";
+        first = false;
+
+        result += L"{\"name\":";
+        result += Utils::ToJsonStr(Utils::FormatStr(L"%ls #%llu", Utils::ToWideStr(pass.reason).c_str(), (unsigned long long)pass.id));
+        result += Utils::FormatStr(
+            L",\"cat\":\"layout\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,"
+            L"\"args\":{\"measures\":%u,\"measureCacheHits\":%u,\"arranges\":%u,\"windowMoves\":%u}}",
+            pass.beginNs / 1e3, pass.durationNs / 1e3,
+            pass.GetMeasureCount(), pass.GetMeasureCacheHits(), pass.GetArrangeCount(), pass.GetWindowMoves());
+
+        for (const LayoutProfileEvent &event : pass.events) {
+            const LayoutProfileNode &node = pass.nodes[event.node];
+
+            result += L",\n{\"name\":";
+            result += Utils::ToJsonStr(Utils::GetTypeDisplayName(node.name));
+            result += Utils::FormatStr(
+                L",\"cat\":\"%ls\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,"
+                L"\"args\":{\"element\":\"%p\",\"cacheHit\":%ls}}",
+                event.arrange ? L"arrange" : L"measure", event.beginNs / 1e3, event.durationNs / 1e3,
+                node.element, event.cacheHit ? L"true" : L"false");
+        }
+    }
+
+    result += L"\n],\"displayTimeUnit\":\"ns\"}\n";
+    return result;
+}
+
+bool sw::LayoutProfiler::SaveChromeTrace(const std::string &path)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string json = Utils::ToMultiByteStr(ToChromeTrace(), true);
+    file.write(json.data(), json.size());
+    return (bool)file;
+}
+
+void sw::LayoutProfiler::BeginPass(const char *reason)
+{
+    if (_state.passDepth++ != 0) {
+        return;
+    }
+
+    _state.current         = LayoutProfilePass{};
+    _state.current.id      = _state.nextPassId++;
+    _state.current.reason  = reason;
+    _state.current.beginNs = _Now();
+    _state.implicitPass    = false;
+    _state.nodeIndices.clear();
+}
+
+void sw::LayoutProfiler::EndPass()
+{
+    if (_state.passDepth == 0 || --_state.passDepth != 0) {
+        return;
+    }
+
+    LayoutProfilePass &pass = _state.current;
+    pass.durationNs         = _Now() - pass.beginNs;
+
+    // 节点按首次调用的顺序添加，父元素可能在子元素之后才参与布局，因此在结束时再建立树结构
+    for (int i = 0; i < (int)pass.nodes.size(); ++i) {
+        LayoutProfileNode &node = pass.nodes[i];
+        auto it                 = _state.nodeIndices.find(node.parentElement);
+        if (node.parentElement != nullptr && it != _state.nodeIndices.end()) {
+            node.parent = it->second;
+            pass.nodes[it->second].children.push_back(i);
+        } else {
+            pass.roots.push_back(i);
+        }
+    }
+
+    if (_state.passes.size() >= _state.maxPassCount) {
+        _state.passes.erase(_state.passes.begin(), _state.passes.end() - (_state.maxPassCount - 1));
+    }
+    _state.passes.push_back(std::move(pass));
+
+    _state.current      = LayoutProfilePass{};
+    _state.implicitPass = false;
+    _state.nodeIndices.clear();
+    _state.frames.clear();
+}
+
+void sw::LayoutProfiler::BeginMeasure(const void *element, const void *parentElement, const char *name)
+{
+    _BeginCall(element, parentElement, name, false);
+}
+
+void sw::LayoutProfiler::EndMeasure(bool cacheHit)
+{
+    LayoutProfileEvent *event = _EndCall();
+    if (event == nullptr) {
+        return;
+    }
+
+    LayoutProfileNode &node = _state.current.nodes[event->node];
+    event->cacheHit         = cacheHit;
+    node.measureNs += event->durationNs;
+    node.measureCount += 1;
+    node.measureCacheHits += cacheHit ? 1 : 0;
+
+    _EndImplicitPass();
+}
+
+void sw::LayoutProfiler::BeginArrange(const void *element, const void *parentElement, const char *name)
+{
+    _BeginCall(element, parentElement, name, true);
+}
+
+void sw::LayoutProfiler::EndArrange()
+{
+    LayoutProfileEvent *event = _EndCall();
+    if (event == nullptr) {
+        return;
+    }
+
+    LayoutProfileNode &node = _state.current.nodes[event->node];
+    node.arrangeNs += event->durationNs;
+    node.arrangeCount += 1;
+
+    _EndImplicitPass();
+}
+
+void sw::LayoutProfiler::RecordWindowMove()
+{
+    if (!_state.frames.empty()) {
+        _state.current.nodes[_state.frames.back().node].windowMoves += 1;
+    }
+}
@@ -0,0 +1,277 @@
+#include "LayoutScheduler.h"
+#include "LayoutProfiler.h"
+#include "UIElement.h"
+#include <algorithm>
+
+namespace
+{
+    /**
+     * @brief 已投递WM_FlushLayout消息的窗口句柄，为NULL时表示尚未投递
+     */
+    thread_local HWND _hwndFlushPosted = NULL;
+
+    /**
+     * @brief 当前线程是否正在执行Flush
+     */
+    thread_local bool _isFlushing = false;
+
+    /**
+     * @brief 最近一次Flush的测量缓存统计信息
+     */
+    thread_local sw::MeasureCacheStats _lastFlushMeasureStats{};
+
+    /**
+     * @brief 当前线程的队列是否已析构，主线程的线程局部变量先于静态对象析构，此后静态存储期的元素析构时不再访问队列
+     */
+    thread_local bool _queuesDestroyed = false;
+}
+
+void sw::LayoutScheduler::Schedule(UIElement &element)
+{
+    if (_queuesDestroyed) {
+        return;
+    }
+
+    std::vector<_PendingItem> &pendingElements = _GetPendingElements();
+
+    if (!element._layoutPending) {
+        // 此时元素的测量缓存尚未清空，保存下来用于判断父元素是否受影响
+        element._layoutPending = true;
+        pendingElements.push_back({&element, element._measureCache});
+    } else if (element._measureCache.GetCount() != 0) {
+        // 元素加入队列后又被测量过，父元素可能已使用了新的结果，保存的结果不再可靠
+        for (_PendingItem &item : pendingElements) {
+            if (item.element == &element) item.previous.Clear();
+        }
+    }
+
+    // 正在Flush时新加入的元素会在本次Flush中一并处理
+    if (!_isFlushing) {
+        _PostFlushMessage(&element);
+    }
+}
+
+void sw::LayoutScheduler::Cancel(UIElement &element)
+{
+    if (_queuesDestroyed) {
+        element._layoutPending = false;
+        return;
+    }
+
+    std::vector<_PendingItem> &pendingElements = _GetPendingElements();
+
+    if (element._layoutPending) {
+        element._layoutPending = false;
+        if (_isFlushing) {
+            // Flush中按索引遍历队列，此时只能将其置空
+            for (_PendingItem &item : pendingElements) {
+                if (item.element == &element) item.element = nullptr;
+            }
+        } else {
+            pendingElements.erase(
+                std::remove_if(
+                    pendingElements.begin(), pendingElements.end(),
+                    [&element](const _PendingItem &item) -> bool {
+                        return item.element == &element;
+                    }),
+                pendingElements.end());
+        }
+    }
+
+    for (_ArrangeItem &item : _GetArrangeItems()) {
+        if (item.element == &element) item.element = nullptr;
+    }
+
+    // 已投递消息的窗口即将销毁，消息可能会丢失，改为向队列中的其他元素投递
+    if (!_isFlushing && _hwndFlushPosted != NULL && _hwndFlushPosted == element.Handle) {
+        _hwndFlushPosted = NULL;
+        for (const _PendingItem &item : pendingElements) {
+            if (item.element != nullptr) {
+                _PostFlushMessage(item.element);
+                break;
+            }
+        }
+    }
+}
+
+void sw::LayoutScheduler::Flush()
+{
+    if (_isFlushing || _queuesDestroyed) {
+        return;
+    }
+
+    _isFlushing      = true;
+    _hwndFlushPosted = NULL;
+
+    MeasureCacheStats statsBefore = MeasureCache::GetStats();
+
+    bool profiling = LayoutProfiler::IsEnabled();
+    if (profiling) {
+        LayoutProfiler::BeginPass("Flush");
+    }
+
+    std::vector<_PendingItem> &pendingElements = _GetPendingElements();
+    std::vector<_ArrangeItem> &arrangeItems    = _GetArrangeItems();
+
+    // 安排元素时可能触发其他元素的布局更新（如在SizeChanged事件中修改了其他元素），循环直到队列为空
+    while (!pendingElements.empty()) {
+        // 测量阶段，队列可能在遍历过程中增长，因此按索引遍历
+        for (size_t i = 0; i < pendingElements.size(); ++i) {
+            UIElement *element = pendingElements[i].element;
+            if (element != nullptr) {
+                // 测量时队列可能增长，先复制保存的结果
+                MeasureCache previous   = pendingElements[i].previous;
+                element->_layoutPending = false;
+                _MeasureUpward(element, previous);
+            }
+        }
+        pendingElements.clear();
+
+        // 安排阶段，优先安排深度较小的元素，其子树中的元素在Arrange后会清除MeasureInvalidated标记，从而避免重复安排
+        std::stable_sort(
+            arrangeItems.begin(), arrangeItems.end(),
+            [](const _ArrangeItem &a, const _ArrangeItem &b) -> bool {
+                return a.depth < b.depth;
+            });
+
+        // 所有元素的位置改变合并为一批，在安排完成后一并提交
+        UIElement::BeginArrangeBatch();
+
+        for (size_t i = 0; i < arrangeItems.size(); ++i) {
+            UIElement *element = arrangeItems[i].element;
+            if (element == nullptr ||
+                !element->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated)) {
+                continue;
+            }
+            if (element->_parent == nullptr) {
+                // 根元素，由元素自己按照当前尺寸更新整个布局
+                element->SendMessageW(WM_UpdateLayout, 0, 0);
+            } else {
+                // 所需尺寸未改变，父元素的布局不受影响，只需在原来的位置重新安排该元素
+                element->Arrange(element->_lastArrangeFinalPosition);
+            }
+        }
+        arrangeItems.clear();
+
+        UIElement::EndArrangeBatch();
+    }
+
+    if (profiling) {
+        LayoutProfiler::EndPass();
+    }
+
+    MeasureCacheStats statsAfter  = MeasureCache::GetStats();
+    _lastFlushMeasureStats.hits   = statsAfter.hits - statsBefore.hits;
+    _lastFlushMeasureStats.misses = statsAfter.misses - statsBefore.misses;
+
+    _isFlushing = false;
+}
+
+bool sw::LayoutScheduler::HasPending()
+{
+    if (_queuesDestroyed) {
+        return false;
+    }
+    return !_GetPendingElements().empty();
+}
+
+sw::MeasureCacheStats sw::LayoutScheduler::GetLastFlushMeasureStats()
+{
+    return _lastFlushMeasureStats;
+}
+
+void sw::LayoutScheduler::_MeasureUpward(UIElement *element, const MeasureCache &previous)
+{
+    MeasureCache elementPrevious = previous;
+    element->_SetMeasureInvalidated();
+
+    while (element->_parent != nullptr) {
+        UIElement *parent = element->_parent;
+
+        // 只有元素已被父元素安排过，且父元素支持在原位置重新安排子元素时才能在此处停止
+        // 父元素在一次测量中可能以多个可用尺寸测量子元素（如GridLayout的自动尺寸、WrapLayout），需逐一确认
+        if (element->_hasArranged && parent->CanArrangeChildInPlace() &&
+            _IsDesireSizeUnchanged(element, elementPrevious)) {
+            break;
+        }
+
+        elementPrevious = parent->_measureCache;
+        parent->_SetMeasureInvalidated();
+        element = parent;
+    }
+
+    std::vector<_ArrangeItem> &arrangeItems = _GetArrangeItems();
+
+    // 多个元素的布局更新传递到同一个根元素时只需更新一次
+    if (element->_parent == nullptr) {
+        for (const _ArrangeItem &item : arrangeItems) {
+            if (item.element == element) return;
+        }
+    }
+
+    arrangeItems.push_back({element, _GetDepth(element)});
+}
+
+bool sw::LayoutScheduler::_IsDesireSizeUnchanged(UIElement *element, const MeasureCache &previous)
+{
+    // 缓存丢弃过结果时无法得知父元素使用过的所有可用尺寸
+    if (previous.GetCount() == 0 || previous.HasEvicted()) {
+        return false;
+    }
+
+    // 从最久未使用的结果开始测量，使最后一次测量使用的是最近一次的可用尺寸
+    for (int i = previous.GetCount() - 1; i >= 0; --i) {
+        element->Measure(previous.GetAvailableSizeAt(i));
+        if (element->_desireSize != previous.GetDesireSizeAt(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void sw::LayoutScheduler::_PostFlushMessage(UIElement *element)
+{
+    if (_hwndFlushPosted != NULL && IsWindow(_hwndFlushPosted)) {
+        return;
+    }
+
+    HWND hwnd        = element->Handle;
+    _hwndFlushPosted = element->PostMessageW(WM_FlushLayout, 0, 0) ? hwnd : NULL;
+}
+
+int sw::LayoutScheduler::_GetDepth(UIElement *element)
+{
+    int depth = 0;
+    for (UIElement *p = element->_parent; p != nullptr; p = p->_parent) {
+        ++depth;
+    }
+    return depth;
+}
+
+std::vector<sw::LayoutScheduler::_PendingItem> &sw::LayoutScheduler::_GetPendingElements()
+{
+    struct _Queue {
+        std::vector<_PendingItem> items;
+
+        ~_Queue()
+        {
+            _queuesDestroyed = true;
+        }
+    };
+    static thread_local _Queue pendingElements;
+    return pendingElements.items;
+}
+
+std::vector<sw::LayoutScheduler::_ArrangeItem> &sw::LayoutScheduler::_GetArrangeItems()
+{
+    struct _Queue {
+        std::vector<_ArrangeItem> items;
+
+        ~_Queue()
+        {
+            _queuesDestroyed = true;
+        }
+    };
+    static thread_local _Queue arrangeItems;
+    return arrangeItems.items;
+}
@@ -1,6 +1,9 @@
 #include "ListView.h"
+#include "Utils.h"
 #include <cmath>
+#include <cwchar>
 #include <memory>
+#include <vector>
 
 namespace
 {
@@ -8,6 +11,44 @@ namespace
      * @brief 获取文本时缓冲区的初始大小
      */
     constexpr int _ListViewTextInitialBufferSize = 256;
+
+    /**
+     * @brief 将文本复制到通知提供的缓冲区，文本过长时截断
+     */
+    void _CopyToDispBuffer(const std::wstring &text, LPWSTR buffer, int bufferSize)
+    {
+        if (buffer == nullptr || bufferSize <= 0) {
+            return;
+        }
+        size_t count = Utils::Min(text.size(), size_t(bufferSize - 1));
+        std::wmemcpy(buffer, text.c_str(), count);
+        buffer[count] = L'\0';
+    }
+}
+
+void sw::IListViewDataSource::PrepareRows(int first, int last)
+{
+}
+
+int sw::IListViewDataSource::FindRow(const std::wstring &text, int start, bool partial, bool wrap)
+{
+    int rowCount = this->GetRowCount();
+    if (rowCount <= 0) {
+        return -1;
+    }
+
+    start = (start < 0 || start >= rowCount) ? 0 : start;
+
+    int searchCount = wrap ? rowCount : rowCount - start;
+    for (int i = 0; i < searchCount; ++i) {
+        int row           = (start + i) % rowCount;
+        std::wstring cell = this->GetCellText(row, 0);
+        if (partial ? (cell.size() >= text.size() && _wcsnicmp(cell.c_str(), text.c_str(), text.size()) == 0)
+                    : (_wcsicmp(cell.c_str(), text.c_str()) == 0)) {
+            return row;
+        }
+    }
+    return -1;
 }
 
 sw::ListViewColumn::ListViewColumn(const std::wstring &header)
@@ -135,6 +176,22 @@ sw::ListView::ListView()
           // set
           [this](const bool &value) {
               this->SetStyle(LVS_EDITLABELS, value);
+          }),
+
+      DataSource(
+          // get
+          [this]() -> IListViewDataSource * {
+              return this->_dataSource;
+          },
+          // set
+          [this](IListViewDataSource *const &value) {
+              bool ownerData = value != nullptr;
+              if (ownerData != this->GetStyle(LVS_OWNERDATA)) {
+                  this->_UpdateOwnerDataStyle(ownerData);
+              }
+              this->_dataSource = value;
+              this->UpdateRowCount();
+              this->Redraw();
           })
 {
     this->InitControl(WC_LISTVIEWW, L"", WS_CHILD | WS_VISIBLE | WS_CLIPSIBLINGS | WS_BORDER | LVS_REPORT, 0);
@@ -222,6 +279,18 @@ bool sw::ListView::OnNotified(NMHDR *pNMHDR, LRESULT &result)
             result = (LRESULT)this->OnEndEdit(reinterpret_cast<NMLVDISPINFOW *>(pNMHDR));
             return true;
         }
+        case LVN_ODCACHEHINT: {
+            this->OnCacheHint(reinterpret_cast<NMLVCACHEHINT *>(pNMHDR));
+            return true;
+        }
+        case LVN_ODFINDITEMW: {
+            result = (LRESULT)this->OnFindItem(reinterpret_cast<NMLVFINDITEMW *>(pNMHDR));
+            return true;
+        }
+        case LVN_ODSTATECHANGED: {
+            this->OnRangeStateChanged(reinterpret_cast<NMLVODSTATECHANGE *>(pNMHDR));
+            break;
+        }
     }
     return this->Control::OnNotified(pNMHDR, result);
 }
@@ -278,6 +347,41 @@ void sw::ListView::OnItemDoubleClicked(NMITEMACTIVATE *pNMIA)
 
 void sw::ListView::OnGetDispInfo(NMLVDISPINFOW *pNMInfo)
 {
+    LVITEMW &item = pNMInfo->item;
+
+    if (this->_dataSource == nullptr || item.iItem < 0) {
+        return;
+    }
+
+    if (item.mask & LVIF_TEXT) {
+        _CopyToDispBuffer(this->_dataSource->GetCellText(item.iItem, item.iSubItem), item.pszText, item.cchTextMax);
+    }
+}
+
+void sw::ListView::OnCacheHint(NMLVCACHEHINT *pNMHint)
+{
+    if (this->_dataSource != nullptr) {
+        this->_dataSource->PrepareRows(pNMHint->iFrom, pNMHint->iTo);
+    }
+}
+
+int sw::ListView::OnFindItem(NMLVFINDITEMW *pNMFind)
+{
+    const LVFINDINFOW &info = pNMFind->lvfi;
+
+    if (this->_dataSource == nullptr || !(info.flags & (LVFI_STRING | LVFI_PARTIAL)) || info.psz == nullptr) {
+        return -1;
+    }
+
+    return this->_dataSource->FindRow(info.psz, pNMFind->iStart, (info.flags & LVFI_PARTIAL) != 0, (info.flags & LVFI_WRAP) != 0);
+}
+
+void sw::ListView::OnRangeStateChanged(NMLVODSTATECHANGE *pNMChange)
+{
+    // 虚拟模式下范围选择不会逐项发送LVN_ITEMCHANGED
+    if ((pNMChange->uOldState ^ pNMChange->uNewState) & LVIS_SELECTED) {
+        this->OnSelectionChanged();
+    }
 }
 
 bool sw::ListView::OnEndEdit(NMLVDISPINFOW *pNMInfo)
@@ -293,7 +397,9 @@ bool sw::ListView::OnEndEdit(NMLVDISPINFOW *pNMInfo)
 
 void sw::ListView::Clear()
 {
-    this->SendMessageW(LVM_DELETEALLITEMS, 0, 0);
+    if (this->_dataSource == nullptr) {
+        this->SendMessageW(LVM_DELETEALLITEMS, 0, 0);
+    }
 }
 
 sw::StrList sw::ListView::GetItemAt(int index)
@@ -307,6 +413,13 @@ sw::StrList sw::ListView::GetItemAt(int index)
     int col = this->_GetColCount();
     if (col <= 0) return result;
 
+    if (this->_dataSource != nullptr) {
+        for (int j = 0; j < col; ++j) {
+            result.Append(this->_dataSource->GetCellText(index, j));
+        }
+        return result;
+    }
+
     int bufsize = _ListViewTextInitialBufferSize;
     std::unique_ptr<wchar_t[]> buf(new wchar_t[bufsize]);
 
@@ -342,7 +455,7 @@ bool sw::ListView::AddItem(const StrList &item)
 bool sw::ListView::InsertItem(int index, const StrList &item)
 {
     int colCount = item.Count();
-    if (colCount == 0) return false;
+    if (colCount == 0 || this->_dataSource != nullptr) return false;
 
     LVITEMW lvi;
     lvi.mask     = LVIF_TEXT;
@@ -363,9 +476,73 @@ bool sw::ListView::InsertItem(int index, const StrList &item)
     return true;
 }
 
+int sw::ListView::AddItems(const List<StrList> &columns)
+{
+    return this->InsertItems(this->_GetRowCount(), columns);
+}
+
+int sw::ListView::InsertItems(int index, const List<StrList> &columns)
+{
+    if (this->_dataSource != nullptr || columns.IsEmpty()) {
+        return 0;
+    }
+
+    int colCount = columns.Count();
+    int rowCount = columns[0].Count();
+    if (rowCount == 0) {
+        return 0;
+    }
+
+    int oldRowCount = this->_GetRowCount();
+    if (index < 0 || index > oldRowCount) {
+        index = oldRowCount;
+    }
+
+    // 暂停重绘，避免每添加一行都重新计算滚动条并重绘
+    // WM_SETREDRAW为FALSE时DefWindowProc会清除WS_VISIBLE样式，没有该样式说明控件不可见或重绘已被暂停，
+    // 此时不改变重绘状态，否则结束时发送WM_SETREDRAW TRUE会使控件变为可见或提前恢复重绘
+    bool suspendRedraw = this->GetStyle(WS_VISIBLE);
+    if (suspendRedraw) {
+        this->SendMessageW(WM_SETREDRAW, FALSE, 0);
+    }
+
+    // 预先分配所有行所需的内存，非LVS_OWNERDATA样式下该消息不改变行数
+    this->SendMessageW(LVM_SETITEMCOUNT, oldRowCount + rowCount, 0);
+
+    int inserted = 0;
+
+    LVITEMW lvi;
+    lvi.mask = LVIF_TEXT;
+
+    for (int i = 0; i < rowCount; ++i) {
+        lvi.iItem    = index + i;
+        lvi.iSubItem = 0;
+        lvi.pszText  = const_cast<LPWSTR>(columns[0][i].c_str());
+
+        int row = (int)this->SendMessageW(LVM_INSERTITEMW, 0, reinterpret_cast<LPARAM>(&lvi));
+        if (row == -1) break;
+
+        for (int j = 1; j < colCount; ++j) {
+            const StrList &column = columns[j];
+            if (i >= column.Count()) continue;
+
+            lvi.iSubItem = j;
+            lvi.pszText  = const_cast<LPWSTR>(column[i].c_str());
+            this->SendMessageW(LVM_SETITEMTEXTW, row, reinterpret_cast<LPARAM>(&lvi));
+        }
+        ++inserted;
+    }
+
+    if (suspendRedraw) {
+        this->SendMessageW(WM_SETREDRAW, TRUE, 0);
+        this->Redraw();
+    }
+    return inserted;
+}
+
 bool sw::ListView::UpdateItem(int index, const StrList &newValue)
 {
-    if (index < 0 || index >= this->_GetRowCount() || newValue.IsEmpty()) {
+    if (index < 0 || index >= this->_GetRowCount() || newValue.IsEmpty() || this->_dataSource != nullptr) {
         return false;
     }
 
@@ -385,11 +562,21 @@ bool sw::ListView::UpdateItem(int index, const StrList &newValue)
 
 bool sw::ListView::RemoveItemAt(int index)
 {
+    if (this->_dataSource != nullptr) {
+        return false;
+    }
     return this->SendMessageW(LVM_DELETEITEM, index, 0);
 }
 
 std::wstring sw::ListView::GetItemAt(int row, int col)
 {
+    if (this->_dataSource != nullptr) {
+        if (row < 0 || row >= this->_GetRowCount() || col < 0 || col >= this->_GetColCount()) {
+            return std::wstring();
+        }
+        return this->_dataSource->GetCellText(row, col);
+    }
+
     std::wstring result;
 
     int bufsize = _ListViewTextInitialBufferSize;
@@ -417,6 +604,10 @@ std::wstring sw::ListView::GetItemAt(int row, int col)
 
 bool sw::ListView::UpdateItem(int row, int col, const std::wstring &newValue)
 {
+    if (this->_dataSource != nullptr) {
+        return false;
+    }
+
     LVITEMW lvi;
     lvi.mask     = LVIF_TEXT;
     lvi.iItem    = row;
@@ -545,6 +736,24 @@ void sw::ListView::CancelEdit()
     this->SendMessageW(LVM_CANCELEDITLABEL, 0, 0);
 }
 
+bool sw::ListView::UpdateRowCount()
+{
+    if (this->_dataSource == nullptr) {
+        return false;
+    }
+
+    int rowCount = Utils::Max(0, this->_dataSource->GetRowCount());
+    return this->SendMessageW(LVM_SETITEMCOUNT, rowCount, LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
+}
+
+bool sw::ListView::RedrawRows(int first, int last)
+{
+    if (first > last) {
+        return false;
+    }
+    return this->SendMessageW(LVM_REDRAWITEMS, first, last);
+}
+
 int sw::ListView::_GetRowCount()
 {
     return (int)this->SendMessageW(LVM_GETITEMCOUNT, 0, 0);
@@ -565,3 +774,57 @@ DWORD sw::ListView::_SetExtendedListViewStyle(DWORD style)
 {
     return (DWORD)this->SendMessageW(LVM_SETEXTENDEDLISTVIEWSTYLE, 0, (LPARAM)style);
 }
+
+void sw::ListView::_UpdateOwnerDataStyle(bool ownerData)
+{
+    // 保存列的信息
+    std::vector<ListViewColumn> columns;
+    std::unique_ptr<wchar_t[]> buf(new wchar_t[_ListViewTextInitialBufferSize]);
+
+    int colCount = this->_GetColCount();
+    for (int i = 0; i < colCount; ++i) {
+        LVCOLUMNW lvc;
+        lvc.mask       = LVCF_TEXT | LVCF_WIDTH | LVCF_FMT;
+        lvc.pszText    = buf.get();
+        lvc.cchTextMax = _ListViewTextInitialBufferSize;
+        if (this->SendMessageW(LVM_GETCOLUMNW, i, reinterpret_cast<LPARAM>(&lvc))) {
+            columns.emplace_back(lvc);
+        }
+    }
+
+    DWORD exListViewStyle = this->_GetExtendedListViewStyle();
+
+    COLORREF backColor     = (COLORREF)this->SendMessageW(LVM_GETBKCOLOR, 0, 0);
+    COLORREF textColor     = (COLORREF)this->SendMessageW(LVM_GETTEXTCOLOR, 0, 0);
+    COLORREF textBackColor = (COLORREF)this->SendMessageW(LVM_GETTEXTBKCOLOR, 0, 0);
+
+    HIMAGELIST imageLists[] = {
+        (HIMAGELIST)this->SendMessageW(LVM_GETIMAGELIST, LVSIL_NORMAL, 0),
+        (HIMAGELIST)this->SendMessageW(LVM_GETIMAGELIST, LVSIL_SMALL, 0),
+        (HIMAGELIST)this->SendMessageW(LVM_GETIMAGELIST, LVSIL_STATE, 0),
+        (HIMAGELIST)this->SendMessageW(LVM_GETIMAGELIST, LVSIL_GROUPHEADER, 0),
+    };
+
+    // 旧控件销毁时不销毁图像列表，使其能够转移给新的控件
+    DWORD style = this->GetStyle();
+    this->SetStyle(LVS_SHAREIMAGELISTS, true);
+
+    style = ownerData ? (style | LVS_OWNERDATA) : (style & ~LVS_OWNERDATA);
+    this->ResetHandle(style, this->GetExtendedStyle());
+
+    this->_SetExtendedListViewStyle(exListViewStyle);
+    this->SendMessageW(LVM_SETBKCOLOR, 0, (LPARAM)backColor);
+    this->SendMessageW(LVM_SETTEXTCOLOR, 0, (LPARAM)textColor);
+    this->SendMessageW(LVM_SETTEXTBKCOLOR, 0, (LPARAM)textBackColor);
+
+    WPARAM imageListTypes[] = {LVSIL_NORMAL, LVSIL_SMALL, LVSIL_STATE, LVSIL_GROUPHEADER};
+    for (int i = 0; i < 4; ++i) {
+        if (imageLists[i] != NULL) {
+            this->SendMessageW(LVM_SETIMAGELIST, imageListTypes[i], (LPARAM)imageLists[i]);
+        }
+    }
+
+    for (int i = 0; i < (int)columns.size(); ++i) {
+        this->InsertColumn(i, columns[i]);
+    }
+}
@@ -0,0 +1,85 @@
+#include "MeasureCache.h"
+
+namespace
+{
+    /**
+     * @brief 当前线程的统计信息
+     */
+    thread_local sw::MeasureCacheStats _measureCacheStats{};
+}
+
+bool sw::MeasureCache::TryGet(const Size &availableSize, Size &desireSize)
+{
+    for (int i = 0; i < this->_count; ++i) {
+        if (this->_entries[i].availableSize != availableSize) {
+            continue;
+        }
+        _Entry entry = this->_entries[i];
+        for (; i > 0; --i) {
+            this->_entries[i] = this->_entries[i - 1];
+        }
+        this->_entries[0] = entry;
+        desireSize        = entry.desireSize;
+        ++_measureCacheStats.hits;
+        return true;
+    }
+    ++_measureCacheStats.misses;
+    return false;
+}
+
+void sw::MeasureCache::Add(const Size &availableSize, const Size &desireSize)
+{
+    // 已有相同可用尺寸的结果时替换该结果，否则占用新的位置或替换最久未使用的结果
+    int i = 0;
+    while (i < this->_count && this->_entries[i].availableSize != availableSize) {
+        ++i;
+    }
+    if (i == this->_count) {
+        if (this->_count < Capacity) {
+            ++this->_count;
+        } else {
+            i              = Capacity - 1;
+            this->_evicted = true;
+        }
+    }
+    for (; i > 0; --i) {
+        this->_entries[i] = this->_entries[i - 1];
+    }
+    this->_entries[0] = _Entry{availableSize, desireSize};
+}
+
+void sw::MeasureCache::Clear()
+{
+    this->_count   = 0;
+    this->_evicted = false;
+}
+
+int sw::MeasureCache::GetCount() const
+{
+    return this->_count;
+}
+
+bool sw::MeasureCache::HasEvicted() const
+{
+    return this->_evicted;
+}
+
+const sw::Size &sw::MeasureCache::GetAvailableSizeAt(int index) const
+{
+    return this->_entries[index].availableSize;
+}
+
+const sw::Size &sw::MeasureCache::GetDesireSizeAt(int index) const
+{
+    return this->_entries[index].desireSize;
+}
+
+sw::MeasureCacheStats sw::MeasureCache::GetStats()
+{
+    return _measureCacheStats;
+}
+
+void sw::MeasureCache::ResetStats()
+{
+    _measureCacheStats = sw::MeasureCacheStats{};
+}
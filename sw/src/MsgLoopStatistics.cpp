@@ -0,0 +1,64 @@
+#include "MsgLoopStatistics.h"
+#include "Utils.h"
+
+void sw::TimingStatistics::Add(double milliseconds)
+{
+    if (this->count == 0 || milliseconds < this->minimum) this->minimum = milliseconds;
+    if (this->count == 0 || milliseconds > this->maximum) this->maximum = milliseconds;
+    this->total += milliseconds;
+    ++this->count;
+}
+
+double sw::TimingStatistics::GetAverage() const
+{
+    return this->count == 0 ? 0 : this->total / this->count;
+}
+
+void sw::MsgLoopStatistics::Add(const MsgLoopTurn &turn)
+{
+    ++this->turns;
+    this->messages += turn.messageCount;
+    this->idleCallbacks += turn.idleCallbacks;
+    this->skippedFrames += turn.skippedFrames;
+    this->wait.Add(turn.wait);
+
+    if (turn.messageCount != 0) {
+        this->dispatch.Add(turn.dispatch);
+    }
+    if (turn.frame) {
+        ++this->frames;
+        this->frameTime.Add(turn.frameTime);
+        if (this->frames > 1) this->frameDelta.Add(turn.frameDelta);
+    }
+    if (turn.idleCallbacks != 0) {
+        this->idle.Add(turn.idle);
+    }
+}
+
+std::wstring sw::MsgLoopStatistics::ToString() const
+{
+    struct _Row {
+        const wchar_t *name;
+        const TimingStatistics *stats;
+    };
+
+    const _Row rows[] = {
+        {L"wait", &this->wait},
+        {L"dispatch", &this->dispatch},
+        {L"frame time", &this->frameTime},
+        {L"frame delta", &this->frameDelta},
+        {L"idle", &this->idle},
+    };
+
+    std::wstring result = Utils::FormatStr(
+        L"turns %llu, messages %llu, frames %llu, skipped frames %llu, idle callbacks %llu\n",
+        (unsigned long long)this->turns, (unsigned long long)this->messages, (unsigned long long)this->frames,
+        (unsigned long long)this->skippedFrames, (unsigned long long)this->idleCallbacks);
+
+    for (const _Row &row : rows) {
+        result += Utils::FormatStr(L"%-12ls count %10llu  avg %9.3f ms  min %9.3f ms  max %9.3f ms\n",
+                                   row.name, (unsigned long long)row.stats->count,
+                                   row.stats->GetAverage(), row.stats->minimum, row.stats->maximum);
+    }
+    return result;
+}
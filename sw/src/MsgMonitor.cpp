@@ -0,0 +1,379 @@
+#include "MsgMonitor.h"
+#include "Utils.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace
+{
+    /**
+     * @brief 以数组直接索引直方图的消息范围，即系统消息的范围，更大的消息保存在哈希表中
+     */
+    constexpr uint32_t _DirectMessageCount = 0x0400;
+
+    /**
+     * @brief 按消息保存的一组直方图
+     */
+    struct _HistogramSet {
+        std::vector<std::unique_ptr<sw::LatencyHistogram>> direct;                 // 系统消息的直方图
+        std::unordered_map<uint32_t, std::unique_ptr<sw::LatencyHistogram>> other; // 其他消息的直方图
+
+        /**
+         * @brief 获取消息对应的直方图，不存在时添加
+         */
+        sw::LatencyHistogram &Get(uint32_t message)
+        {
+            std::unique_ptr<sw::LatencyHistogram> *slot;
+            if (message < _DirectMessageCount) {
+                if (this->direct.empty()) this->direct.resize(_DirectMessageCount);
+                slot = &this->direct[message];
+            } else {
+                slot = &this->other[message];
+            }
+            if (*slot == nullptr) slot->reset(new sw::LatencyHistogram);
+            return **slot;
+        }
+
+        /**
+         * @brief 查找消息对应的直方图，不存在时返回nullptr
+         */
+        const sw::LatencyHistogram *Find(uint32_t message) const
+        {
+            if (message < _DirectMessageCount) {
+                return this->direct.empty() ? nullptr : this->direct[message].get();
+            }
+            auto it = this->other.find(message);
+            return it == this->other.end() ? nullptr : it->second.get();
+        }
+
+        /**
+         * @brief 获取有记录的所有消息，按数值排列
+         */
+        std::vector<uint32_t> GetMessages() const
+        {
+            std::vector<uint32_t> result;
+            for (uint32_t i = 0; i < (uint32_t)this->direct.size(); ++i) {
+                if (this->direct[i] != nullptr) result.push_back(i);
+            }
+            size_t directCount = result.size();
+            for (auto &item : this->other) {
+                result.push_back(item.first);
+            }
+            std::sort(result.begin() + directCount, result.end());
+            return result;
+        }
+
+        /**
+         * @brief 清除所有直方图
+         */
+        void Clear()
+        {
+            this->direct.clear();
+            this->other.clear();
+        }
+    };
+
+    /**
+     * @brief 线程局部的监视器状态
+     */
+    struct _MonitorState {
+        _HistogramSet dispatch;                     // 各消息的处理耗时
+        _HistogramSet queueWait;                    // 各消息的排队时间
+        std::unique_ptr<sw::HangWatchdog> watchdog; // 卡顿看门狗
+    };
+
+    thread_local _MonitorState _state;
+
+    /**
+     * @brief 常见消息的名称
+     */
+    struct _MessageName {
+        uint32_t message;
+        const wchar_t *name;
+    };
+
+    /**
+     * @brief 常见的系统消息与SimpleWindow的消息的名称，按数值排列，SimpleWindow的消息与WndMsg.h中的定义一致
+     */
+    constexpr _MessageName _MessageNames[] = {
+        {0x0000, L"WM_NULL"},
+        {0x0001, L"WM_CREATE"},
+        {0x0002, L"WM_DESTROY"},
+        {0x0003, L"WM_MOVE"},
+        {0x0005, L"WM_SIZE"},
+        {0x0006, L"WM_ACTIVATE"},
+        {0x0007, L"WM_SETFOCUS"},
+        {0x0008, L"WM_KILLFOCUS"},
+        {0x000A, L"WM_ENABLE"},
+        {0x000B, L"WM_SETREDRAW"},
+        {0x000C, L"WM_SETTEXT"},
+        {0x000D, L"WM_GETTEXT"},
+        {0x000E, L"WM_GETTEXTLENGTH"},
+        {0x000F, L"WM_PAINT"},
+        {0x0010, L"WM_CLOSE"},
+        {0x0012, L"WM_QUIT"},
+        {0x0014, L"WM_ERASEBKGND"},
+        {0x0018, L"WM_SHOWWINDOW"},
+        {0x001C, L"WM_ACTIVATEAPP"},
+        {0x0020, L"WM_SETCURSOR"},
+        {0x0021, L"WM_MOUSEACTIVATE"},
+        {0x0024, L"WM_GETMINMAXINFO"},
+        {0x002B, L"WM_DRAWITEM"},
+        {0x002C, L"WM_MEASUREITEM"},
+        {0x0030, L"WM_SETFONT"},
+        {0x0031, L"WM_GETFONT"},
+        {0x003D, L"WM_GETOBJECT"},
+        {0x0046, L"WM_WINDOWPOSCHANGING"},
+        {0x0047, L"WM_WINDOWPOSCHANGED"},
+        {0x004E, L"WM_NOTIFY"},
+        {0x007B, L"WM_CONTEXTMENU"},
+        {0x007C, L"WM_STYLECHANGING"},
+        {0x007D, L"WM_STYLECHANGED"},
+        {0x0081, L"WM_NCCREATE"},
+        {0x0082, L"WM_NCDESTROY"},
+        {0x0083, L"WM_NCCALCSIZE"},
+        {0x0084, L"WM_NCHITTEST"},
+        {0x0085, L"WM_NCPAINT"},
+        {0x0086, L"WM_NCACTIVATE"},
+        {0x0087, L"WM_GETDLGCODE"},
+        {0x00A0, L"WM_NCMOUSEMOVE"},
+        {0x00A1, L"WM_NCLBUTTONDOWN"},
+        {0x0100, L"WM_KEYDOWN"},
+        {0x0101, L"WM_KEYUP"},
+        {0x0102, L"WM_CHAR"},
+        {0x0104, L"WM_SYSKEYDOWN"},
+        {0x0105, L"WM_SYSKEYUP"},
+        {0x0111, L"WM_COMMAND"},
+        {0x0112, L"WM_SYSCOMMAND"},
+        {0x0113, L"WM_TIMER"},
+        {0x0114, L"WM_HSCROLL"},
+        {0x0115, L"WM_VSCROLL"},
+        {0x0116, L"WM_INITMENU"},
+        {0x0117, L"WM_INITMENUPOPUP"},
+        {0x0121, L"WM_ENTERIDLE"},
+        {0x0133, L"WM_CTLCOLOREDIT"},
+        {0x0134, L"WM_CTLCOLORLISTBOX"},
+        {0x0135, L"WM_CTLCOLORBTN"},
+        {0x0136, L"WM_CTLCOLORDLG"},
+        {0x0138, L"WM_CTLCOLORSTATIC"},
+        {0x0200, L"WM_MOUSEMOVE"},
+        {0x0201, L"WM_LBUTTONDOWN"},
+        {0x0202, L"WM_LBUTTONUP"},
+        {0x0203, L"WM_LBUTTONDBLCLK"},
+        {0x0204, L"WM_RBUTTONDOWN"},
+        {0x0205, L"WM_RBUTTONUP"},
+        {0x0207, L"WM_MBUTTONDOWN"},
+        {0x0208, L"WM_MBUTTONUP"},
+        {0x020A, L"WM_MOUSEWHEEL"},
+        {0x020E, L"WM_MOUSEHWHEEL"},
+        {0x0214, L"WM_SIZING"},
+        {0x0215, L"WM_CAPTURECHANGED"},
+        {0x0216, L"WM_MOVING"},
+        {0x0231, L"WM_ENTERSIZEMOVE"},
+        {0x0232, L"WM_EXITSIZEMOVE"},
+        {0x02A3, L"WM_MOUSELEAVE"},
+        {0x02E0, L"WM_DPICHANGED"},
+        {0x3401, L"WM_UpdateLayout"},
+        {0x3402, L"WM_InvokeAction"},
+        {0x3403, L"WM_FlushLayout"},
+        {0x3404, L"WM_DispatcherWake"},
+    };
+
+    /**
+     * @brief 将一组直方图作为JSON数组写入，每个元素为消息、名称及直方图
+     */
+    void _AppendHistogramSet(std::wstring &out, const _HistogramSet &set)
+    {
+        bool first = true;
+
+        out += L'[';
+        for (uint32_t message : set.GetMessages()) {
+            out += sw::Utils::FormatStr(L"%ls{\"message\":%u,\"name\":", first ? L"" : L",", message);
+            out += sw::Utils::ToJsonStr(sw::MsgMonitor::GetMessageName(message));
+            out += L",\"histogram\":";
+            out += set.Find(message)->ToJson();
+            out += L'}';
+            first = false;
+        }
+        out += L']';
+    }
+}
+
+std::atomic<bool> sw::MsgMonitor::_enabled{false};
+
+void sw::MsgMonitor::DispatchScope::_Begin(uint32_t message, const char *className, uint64_t handle)
+{
+    this->_active   = true;
+    this->_message  = message;
+    this->_watchdog = _state.watchdog.get();
+    if (this->_watchdog != nullptr) {
+        this->_previous = this->_watchdog->Enter({message, className, handle});
+    }
+    this->_beginNs = MsgMonitor::Now();
+}
+
+void sw::MsgMonitor::DispatchScope::_End()
+{
+    MsgMonitor::RecordDispatch(this->_message, MsgMonitor::Now() - this->_beginNs);
+
+    // 处理消息期间看门狗可能已被替换
+    if (this->_watchdog != nullptr && this->_watchdog == _state.watchdog.get()) {
+        this->_watchdog->Leave(this->_previous);
+    }
+}
+
+void sw::MsgMonitor::BusyScope::_Begin(uint32_t message, const char *className, uint64_t handle)
+{
+    this->_watchdog = _state.watchdog.get();
+    if (this->_watchdog != nullptr) {
+        this->_previous = this->_watchdog->Enter({message, className, handle});
+    }
+}
+
+void sw::MsgMonitor::BusyScope::_End()
+{
+    if (this->_watchdog == _state.watchdog.get()) {
+        this->_watchdog->Leave(this->_previous);
+    }
+}
+
+void sw::MsgMonitor::SetEnabled(bool enabled)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void sw::MsgMonitor::Clear()
+{
+    _state.dispatch.Clear();
+    _state.queueWait.Clear();
+    if (_state.watchdog != nullptr) {
+        _state.watchdog->ClearReports();
+    }
+}
+
+uint64_t sw::MsgMonitor::Now()
+{
+    return HangWatchdog::Now();
+}
+
+void sw::MsgMonitor::RecordDispatch(uint32_t message, uint64_t nanoseconds)
+{
+    _state.dispatch.Get(message).Record(nanoseconds);
+}
+
+void sw::MsgMonitor::RecordQueueWait(uint32_t message, uint64_t nanoseconds)
+{
+    _state.queueWait.Get(message).Record(nanoseconds);
+}
+
+const sw::LatencyHistogram *sw::MsgMonitor::GetDispatchHistogram(uint32_t message)
+{
+    return _state.dispatch.Find(message);
+}
+
+const sw::LatencyHistogram *sw::MsgMonitor::GetQueueWaitHistogram(uint32_t message)
+{
+    return _state.queueWait.Find(message);
+}
+
+std::vector<uint32_t> sw::MsgMonitor::GetDispatchMessages()
+{
+    return _state.dispatch.GetMessages();
+}
+
+std::vector<uint32_t> sw::MsgMonitor::GetQueueWaitMessages()
+{
+    return _state.queueWait.GetMessages();
+}
+
+sw::HangWatchdog &sw::MsgMonitor::StartWatchdog(double thresholdMs, const HangHandler &handler)
+{
+    // 先停止原有的看门狗，避免两个看门狗线程同时存在
+    _state.watchdog.reset();
+    _state.watchdog.reset(new HangWatchdog(thresholdMs, handler));
+    SetEnabled(true);
+    return *_state.watchdog;
+}
+
+void sw::MsgMonitor::StopWatchdog()
+{
+    _state.watchdog.reset();
+}
+
+sw::HangWatchdog *sw::MsgMonitor::GetWatchdog()
+{
+    return _state.watchdog.get();
+}
+
+void sw::MsgMonitor::NotifyIdle()
+{
+    if (_state.watchdog != nullptr) {
+        _state.watchdog->Idle();
+    }
+}
+
+void sw::MsgMonitor::NotifyResume()
+{
+    if (_state.watchdog != nullptr) {
+        _state.watchdog->Resume();
+    }
+}
+
+std::wstring sw::MsgMonitor::GetMessageName(uint32_t message)
+{
+    auto end = std::end(_MessageNames);
+    auto it  = std::lower_bound(std::begin(_MessageNames), end, message,
+                                [](const _MessageName &item, uint32_t value) { return item.message < value; });
+    if (it != end && it->message == message) {
+        return it->name;
+    }
+
+    if (message >= 0x0400 && message < 0x8000) {
+        return Utils::FormatStr(L"WM_USER+0x%X", message - 0x0400);
+    } else if (message >= 0x8000 && message < 0xC000) {
+        return Utils::FormatStr(L"WM_APP+0x%X", message - 0x8000);
+    } else {
+        return Utils::FormatStr(L"0x%04X", message);
+    }
+}
+
+std::wstring sw::MsgMonitor::ToJson()
+{
+    std::wstring result;
+
+    result += L"{\"dispatch\":";
+    _AppendHistogramSet(result, _state.dispatch);
+    result += L",\"queueWait\":";
+    _AppendHistogramSet(result, _state.queueWait);
+    result += L",\"hangs\":[";
+
+    if (_state.watchdog != nullptr) {
+        bool first = true;
+        for (const HangReport &report : _state.watchdog->GetReports()) {
+            result += Utils::FormatStr(L"%ls{\"id\":%llu,\"message\":%u,\"name\":",
+                                       first ? L"" : L",", (unsigned long long)report.id, report.activity.message);
+            result += Utils::ToJsonStr(GetMessageName(report.activity.message));
+            result += L",\"className\":";
+            result += Utils::ToJsonStr(Utils::GetTypeDisplayName(report.activity.className));
+            result += Utils::FormatStr(L",\"handle\":%llu,\"beginMs\":%.3f,\"durationMs\":%.3f,\"finished\":%ls}",
+                                       (unsigned long long)report.activity.handle, report.beginNs / 1e6, report.durationMs,
+                                       report.finished ? L"true" : L"false");
+            first = false;
+        }
+    }
+
+    result += L"]}";
+    return result;
+}
+
+bool sw::MsgMonitor::SaveJson(const std::string &path)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string json = Utils::ToMultiByteStr(ToJson(), true);
+    file.write(json.data(), json.size());
+    return (bool)file;
+}
@@ -1,4 +1,5 @@
 #include "Panel.h"
+#include "BrushCache.h"
 #include "Utils.h"
 
 namespace
@@ -94,10 +95,10 @@ bool sw::Panel::OnPaint()
     RECT clientRect;
     GetClientRect(hwnd, &clientRect);
 
-    HBRUSH hBrush = CreateSolidBrush(this->GetRealBackColor());
+    HBRUSH hBrush = BrushCache::Acquire(this->GetRealBackColor());
     FillRect(hdc, &clientRect, hBrush);
 
-    DeleteObject(hBrush);
+    BrushCache::Release(hBrush);
     EndPaint(hwnd, &ps);
     return true;
 }
@@ -168,12 +169,12 @@ void sw::Panel::OnDrawPadding(HDC hdc, RECT &rect)
         HRGN hRgnDiff  = CreateRectRgn(0, 0, 0, 0);
         CombineRgn(hRgnDiff, hRgnOuter, hRgnInner, RGN_DIFF);
 
-        HBRUSH hBrush = CreateSolidBrush(this->GetRealBackColor());
+        HBRUSH hBrush = BrushCache::Acquire(this->GetRealBackColor());
         FillRgn(hdc, hRgnDiff, hBrush);
 
         DeleteObject(hRgnOuter);
         DeleteObject(hRgnInner);
         DeleteObject(hRgnDiff);
-        DeleteObject(hBrush);
+        BrushCache::Release(hBrush);
     }
 }
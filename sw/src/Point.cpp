@@ -1,7 +1,10 @@
 #include "Point.h"
-#include "Dip.h"
 #include "Utils.h"
 
+#if defined(_WIN32)
+#include "Dip.h"
+#endif
+
 sw::Point::Point()
     : Point(0, 0)
 {
@@ -12,6 +15,7 @@ sw::Point::Point(double x, double y)
 {
 }
 
+#if defined(_WIN32)
 sw::Point::Point(const POINT &point)
     : x(Dip::PxToDipX(point.x)), y(Dip::PxToDipY(point.y))
 {
@@ -21,6 +25,7 @@ sw::Point::operator POINT() const
 {
     return {Dip::DipToPxX(this->x), Dip::DipToPxY(this->y)};
 }
+#endif
 
 bool sw::Point::operator==(const Point &other) const
 {
@@ -1,7 +1,10 @@
 #include "Rect.h"
-#include "Dip.h"
 #include "Utils.h"
 
+#if defined(_WIN32)
+#include "Dip.h"
+#endif
+
 sw::Rect::Rect()
     : Rect(0, 0, 0, 0)
 {
@@ -12,6 +15,7 @@ sw::Rect::Rect(double left, double top, double width, double height)
 {
 }
 
+#if defined(_WIN32)
 sw::Rect::Rect(const RECT &rect)
     : left(Dip::PxToDipX(rect.left)),
       top(Dip::PxToDipY(rect.top)),
@@ -27,6 +31,7 @@ sw::Rect::operator RECT() const
             Dip::DipToPxX(this->left + this->width),
             Dip::DipToPxY(this->top + this->height)};
 }
+#endif
 
 sw::Point sw::Rect::GetPos() const
 {
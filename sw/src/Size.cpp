@@ -1,7 +1,10 @@
 #include "Size.h"
-#include "Dip.h"
 #include "Utils.h"
 
+#if defined(_WIN32)
+#include "Dip.h"
+#endif
+
 sw::Size::Size()
     : Size(0, 0)
 {
@@ -12,6 +15,7 @@ sw::Size::Size(double width, double height)
 {
 }
 
+#if defined(_WIN32)
 sw::Size::Size(const SIZE &size)
     : width(Dip::PxToDipX(size.cx)), height(Dip::PxToDipY(size.cy))
 {
@@ -21,6 +25,7 @@ sw::Size::operator SIZE() const
 {
     return {Dip::DipToPxX(this->width), Dip::DipToPxY(this->height)};
 }
+#endif
 
 bool sw::Size::operator==(const Size &other) const
 {
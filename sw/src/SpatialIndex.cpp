@@ -0,0 +1,309 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief 判断矩形是否包含点，右边与底边不计入矩形
+     */
+    bool _RectContains(const sw::Rect &rect, const sw::Point &point)
+    {
+        return point.x >= rect.left && point.x < rect.left + rect.width &&
+               point.y >= rect.top && point.y < rect.top + rect.height;
+    }
+
+    /**
+     * @brief 判断两个矩形是否相交，仅边相接时不视为相交
+     */
+    bool _RectIntersects(const sw::Rect &a, const sw::Rect &b)
+    {
+        return a.left < b.left + b.width && b.left < a.left + a.width &&
+               a.top < b.top + b.height && b.top < a.top + a.height;
+    }
+}
+
+constexpr int sw::SpatialIndex::MaxCellsPerItem;
+
+sw::SpatialIndex::SpatialIndex(double cellSize)
+    : _cellSize(cellSize > 0 ? cellSize : 128)
+{
+}
+
+double sw::SpatialIndex::GetCellSize() const
+{
+    return this->_cellSize;
+}
+
+void sw::SpatialIndex::SetCellSize(double cellSize)
+{
+    if (cellSize <= 0 || cellSize == this->_cellSize) {
+        return;
+    }
+
+    this->_cellSize = cellSize;
+    this->_cells.clear();
+    this->_largeItems.clear();
+
+    // 网格尺寸改变后每一项覆盖的网格都需要按其矩形重新计算
+    for (int i = 0; i < (int)this->_items.size(); ++i) {
+        _Item &item = this->_items[i];
+        if (!item.inserted) continue;
+
+        item.cellLeft   = this->_GetCell(item.rect.left);
+        item.cellTop    = this->_GetCell(item.rect.top);
+        item.cellRight  = this->_GetCell(item.rect.left + item.rect.width);
+        item.cellBottom = this->_GetCell(item.rect.top + item.rect.height);
+        this->_AddToCells(i, item);
+    }
+}
+
+int sw::SpatialIndex::GetCount() const
+{
+    return (int)this->_items.size();
+}
+
+void sw::SpatialIndex::SetCount(int count)
+{
+    count = std::max(count, 0);
+
+    for (int i = count; i < (int)this->_items.size(); ++i) {
+        this->Remove(i);
+    }
+    if (count < (int)this->_items.size()) {
+        this->_items.resize(count);
+        this->_queryMarks.resize(count);
+    }
+}
+
+void sw::SpatialIndex::Clear()
+{
+    this->_items.clear();
+    this->_cells.clear();
+    this->_largeItems.clear();
+    this->_queryMarks.clear();
+    this->_insertedCount = 0;
+}
+
+void sw::SpatialIndex::Update(int index, const Rect &rect)
+{
+    if (index < 0) {
+        return;
+    }
+
+    if (rect.width <= 0 || rect.height <= 0) {
+        this->Remove(index);
+        return;
+    }
+
+    if (index >= (int)this->_items.size()) {
+        this->_items.resize(index + 1);
+        this->_queryMarks.resize(index + 1, 0);
+    }
+
+    _Item &item = this->_items[index];
+
+    int cellLeft   = this->_GetCell(rect.left);
+    int cellTop    = this->_GetCell(rect.top);
+    int cellRight  = this->_GetCell(rect.left + rect.width);
+    int cellBottom = this->_GetCell(rect.top + rect.height);
+
+    // 覆盖的网格未改变时只需更新矩形，重新安排而位置不变的元素都走这条路径
+    if (item.inserted &&
+        item.cellLeft == cellLeft && item.cellTop == cellTop &&
+        item.cellRight == cellRight && item.cellBottom == cellBottom) {
+        item.rect = rect;
+        return;
+    }
+
+    if (item.inserted) {
+        this->_RemoveFromCells(index, item);
+    } else {
+        ++this->_insertedCount;
+    }
+
+    item.rect       = rect;
+    item.cellLeft   = cellLeft;
+    item.cellTop    = cellTop;
+    item.cellRight  = cellRight;
+    item.cellBottom = cellBottom;
+    item.inserted   = true;
+    this->_AddToCells(index, item);
+}
+
+void sw::SpatialIndex::Remove(int index)
+{
+    if (index < 0 || index >= (int)this->_items.size()) {
+        return;
+    }
+
+    _Item &item = this->_items[index];
+    if (item.inserted) {
+        this->_RemoveFromCells(index, item);
+        item.inserted = false;
+        item.rect     = Rect();
+        --this->_insertedCount;
+    }
+}
+
+bool sw::SpatialIndex::Contains(int index) const
+{
+    return index >= 0 && index < (int)this->_items.size() && this->_items[index].inserted;
+}
+
+sw::Rect sw::SpatialIndex::GetRect(int index) const
+{
+    return this->Contains(index) ? this->_items[index].rect : Rect();
+}
+
+int sw::SpatialIndex::HitTest(const Point &point) const
+{
+    int result = -1;
+
+    auto it = this->_cells.find(_GetCellKey(this->_GetCell(point.x), this->_GetCell(point.y)));
+    if (it != this->_cells.end()) {
+        for (int index : it->second) {
+            if (index > result && _RectContains(this->_items[index].rect, point)) result = index;
+        }
+    }
+    for (int index : this->_largeItems) {
+        if (index > result && _RectContains(this->_items[index].rect, point)) result = index;
+    }
+    return result;
+}
+
+void sw::SpatialIndex::QueryPoint(const Point &point, std::vector<int> &result) const
+{
+    result.clear();
+
+    // 一个点只落在一个网格中，网格内的项不会重复
+    auto it = this->_cells.find(_GetCellKey(this->_GetCell(point.x), this->_GetCell(point.y)));
+    if (it != this->_cells.end()) {
+        for (int index : it->second) {
+            if (_RectContains(this->_items[index].rect, point)) result.push_back(index);
+        }
+    }
+    for (int index : this->_largeItems) {
+        if (_RectContains(this->_items[index].rect, point)) result.push_back(index);
+    }
+    std::sort(result.begin(), result.end());
+}
+
+void sw::SpatialIndex::QueryRect(const Rect &rect, std::vector<int> &result) const
+{
+    result.clear();
+
+    if (rect.width <= 0 || rect.height <= 0 || this->_insertedCount == 0) {
+        return;
+    }
+
+    int cellLeft   = this->_GetCell(rect.left);
+    int cellTop    = this->_GetCell(rect.top);
+    int cellRight  = this->_GetCell(rect.left + rect.width);
+    int cellBottom = this->_GetCell(rect.top + rect.height);
+
+    double cellCount = double(cellRight - cellLeft + 1) * double(cellBottom - cellTop + 1);
+
+    if (cellCount > (double)this->_items.size()) {
+        // 查询范围内的网格数比项数还多时，直接遍历所有项更快
+        for (int i = 0; i < (int)this->_items.size(); ++i) {
+            const _Item &item = this->_items[i];
+            if (item.inserted && _RectIntersects(item.rect, rect)) result.push_back(i);
+        }
+        return;
+    }
+
+    uint32_t queryId = this->_BeginQuery();
+
+    for (int row = cellTop; row <= cellBottom; ++row) {
+        for (int col = cellLeft; col <= cellRight; ++col) {
+            auto it = this->_cells.find(_GetCellKey(col, row));
+            if (it == this->_cells.end()) continue;
+
+            for (int index : it->second) {
+                if (this->_queryMarks[index] == queryId) continue;
+                this->_queryMarks[index] = queryId;
+                if (_RectIntersects(this->_items[index].rect, rect)) result.push_back(index);
+            }
+        }
+    }
+    for (int index : this->_largeItems) {
+        if (_RectIntersects(this->_items[index].rect, rect)) result.push_back(index);
+    }
+    std::sort(result.begin(), result.end());
+}
+
+uint64_t sw::SpatialIndex::_GetCellKey(int col, int row)
+{
+    return (uint64_t(uint32_t(col)) << 32) | uint64_t(uint32_t(row));
+}
+
+int sw::SpatialIndex::_GetCell(double pos) const
+{
+    double cell = std::floor(pos / this->_cellSize);
+
+    if (std::isnan(cell)) {
+        return 0;
+    }
+
+    // 限制网格的范围，超出范围的坐标落在边缘的网格中，遍历网格时也不会溢出
+    if (cell < -1073741824.0) return -1073741824;
+    if (cell > 1073741823.0) return 1073741823;
+    return (int)cell;
+}
+
+void sw::SpatialIndex::_AddToCells(int index, _Item &item)
+{
+    double cellCount = double(item.cellRight - item.cellLeft + 1) * double(item.cellBottom - item.cellTop + 1);
+
+    item.large = cellCount > MaxCellsPerItem;
+    if (item.large) {
+        this->_largeItems.push_back(index);
+        return;
+    }
+
+    for (int row = item.cellTop; row <= item.cellBottom; ++row) {
+        for (int col = item.cellLeft; col <= item.cellRight; ++col) {
+            this->_cells[_GetCellKey(col, row)].push_back(index);
+        }
+    }
+}
+
+void sw::SpatialIndex::_RemoveFromCells(int index, _Item &item)
+{
+    if (item.large) {
+        auto it = std::find(this->_largeItems.begin(), this->_largeItems.end(), index);
+        if (it != this->_largeItems.end()) {
+            *it = this->_largeItems.back();
+            this->_largeItems.pop_back();
+        }
+        return;
+    }
+
+    for (int row = item.cellTop; row <= item.cellBottom; ++row) {
+        for (int col = item.cellLeft; col <= item.cellRight; ++col) {
+            auto it = this->_cells.find(_GetCellKey(col, row));
+            if (it == this->_cells.end()) continue;
+
+            std::vector<int> &cell = it->second;
+            auto pos = std::find(cell.begin(), cell.end(), index);
+            if (pos != cell.end()) {
+                *pos = cell.back();
+                cell.pop_back();
+            }
+            if (cell.empty()) {
+                this->_cells.erase(it);
+            }
+        }
+    }
+}
+
+uint32_t sw::SpatialIndex::_BeginQuery() const
+{
+    // 序号回绕时清空所有标记，避免与很久之前的查询混淆
+    if (++this->_queryId == 0) {
+        std::fill(this->_queryMarks.begin(), this->_queryMarks.end(), 0);
+        this->_queryId = 1;
+    }
+    return this->_queryId;
+}
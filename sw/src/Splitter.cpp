@@ -1,4 +1,5 @@
 #include "Splitter.h"
+#include "BrushCache.h"
 #include "Utils.h"
 
 sw::Splitter::Splitter()
@@ -32,7 +33,7 @@ bool sw::Splitter::OnPaint()
     RECT rect;
     GetClientRect(hwnd, &rect);
 
-    HBRUSH hBrush = CreateSolidBrush(this->GetRealBackColor());
+    HBRUSH hBrush = BrushCache::Acquire(this->GetRealBackColor());
     FillRect(hdc, &rect, hBrush);
 
     if (this->_orientation == sw::Orientation::Horizontal) {
@@ -45,7 +46,7 @@ bool sw::Splitter::OnPaint()
         DrawEdge(hdc, &rect, EDGE_ETCHED, BF_LEFT);
     }
 
-    DeleteObject(hBrush);
+    BrushCache::Release(hBrush);
     EndPaint(hwnd, &ps);
     return true;
 }
@@ -1,7 +1,10 @@
 #include "Thickness.h"
-#include "Dip.h"
 #include "Utils.h"
 
+#if defined(_WIN32)
+#include "Dip.h"
+#endif
+
 sw::Thickness::Thickness()
     : Thickness(0, 0, 0, 0)
 {
@@ -22,6 +25,7 @@ sw::Thickness::Thickness(double left, double top, double right, double bottom)
 {
 }
 
+#if defined(_WIN32)
 sw::Thickness::Thickness(const RECT &rect)
     : Thickness(
           Dip::PxToDipX(rect.left),
@@ -39,6 +43,7 @@ sw::Thickness::operator RECT() const
         Dip::DipToPxX(this->right),
         Dip::DipToPxY(this->bottom)};
 }
+#endif
 
 bool sw::Thickness::operator==(const Thickness &other) const
 {
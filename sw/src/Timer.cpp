@@ -1,37 +1,71 @@
 #include "Timer.h"
-
-namespace
-{
-    /**
-     * @brief 窗口句柄保存Timer指针的属性名称
-     */
-    constexpr wchar_t _TimerPtrProp[] = L"SWPROP_TimerPtr";
-}
+#include "Utils.h"
 
 sw::Timer::Timer()
-    : Interval(
+    : _service(&TimerService::GetCurrent()),
+
+      Interval(
+          this,
+          // get
+          [](Timer *self) -> uint32_t {
+              return self->_interval;
+          },
+          // set
+          [](Timer *self, const uint32_t &value) {
+              self->_interval = value;
+              if (self->_started) {
+                  self->_Restart();
+              }
+          }),
+
+      Tolerance(
+          this,
           // get
-          [this]() -> uint32_t {
-              return this->_interval;
+          [](Timer *self) -> uint32_t {
+              return self->_tolerance;
           },
           // set
-          [this](const uint32_t &value) {
-              this->_interval = value;
-              if (this->_started) {
-                  this->Stop();
-                  this->Start();
+          [](Timer *self, const uint32_t &value) {
+              self->_tolerance = value;
+              if (self->_started) {
+                  self->_Restart();
               }
+          }),
+
+      AutoReset(
+          this,
+          // get
+          [](Timer *self) -> bool {
+              return self->_autoReset;
+          },
+          // set
+          [](Timer *self, const bool &value) {
+              self->_autoReset = value;
+              if (self->_started) {
+                  self->_Restart();
+              }
+          }),
+
+      IsStarted(
+          this,
+          // get
+          [](Timer *self) -> bool {
+              return self->_started;
           })
 {
-    this->InitControl(L"STATIC", L"", WS_CHILD, 0);
-    Timer::_SetTimerPtr(this->Handle, *this);
+    this->_id = this->_service->Create([this]() { this->_OnTimerExpired(); });
+}
+
+sw::Timer::~Timer()
+{
+    this->_service->Destroy(this->_id);
 }
 
 void sw::Timer::Start()
 {
     if (!this->_started) {
         this->_started = true;
-        SetTimer(this->Handle, 0, this->_interval, &Timer::_TimerProc);
+        this->_Restart();
     }
 }
 
@@ -39,7 +73,7 @@ void sw::Timer::Stop()
 {
     if (this->_started) {
         this->_started = false;
-        KillTimer(this->Handle, 0);
+        this->_service->Stop(this->_id);
     }
 }
 
@@ -49,20 +83,15 @@ void sw::Timer::OnTick()
         this->Tick(*this);
 }
 
-sw::Timer *sw::Timer::_GetTimerPtr(HWND hwnd)
+void sw::Timer::_Restart()
 {
-    return reinterpret_cast<Timer *>(GetPropW(hwnd, _TimerPtrProp));
+    this->_service->Start(this->_id, this->_interval, this->_autoReset ? Utils::Max<uint32_t>(this->_interval, 1) : 0, this->_tolerance);
 }
 
-void sw::Timer::_SetTimerPtr(HWND hwnd, Timer &timer)
+void sw::Timer::_OnTimerExpired()
 {
-    SetPropW(hwnd, _TimerPtrProp, reinterpret_cast<HANDLE>(&timer));
-}
-
-void sw::Timer::_TimerProc(HWND hwnd, UINT msg, UINT_PTR idTimer, DWORD time)
-{
-    if (msg == WM_TIMER) {
-        auto timer = Timer::_GetTimerPtr(hwnd);
-        if (timer) timer->OnTick();
+    if (!this->_autoReset) {
+        this->_started = false;
     }
+    this->OnTick();
 }
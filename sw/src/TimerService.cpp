@@ -0,0 +1,188 @@
+#include "TimerService.h"
+#include "App.h"
+#include "MsgMonitor.h"
+#include "Utils.h"
+
+namespace
+{
+    /**
+     * @brief 定时器服务窗口的窗口类名
+     */
+    constexpr wchar_t _TimerServiceClassName[] = L"sw::TimerService";
+
+    /**
+     * @brief 系统定时器的id
+     */
+    constexpr UINT_PTR _TimerServiceTimerId = 1;
+}
+
+sw::TimerService::TimerService()
+    : _wheel(GetTickCount64())
+{
+    static thread_local ATOM timerServiceClsAtom = 0;
+
+    if (timerServiceClsAtom == 0) {
+        WNDCLASSEXW wc{};
+        wc.cbSize           = sizeof(wc);
+        wc.hInstance        = App::Instance;
+        wc.lpfnWndProc      = TimerService::_WndProc;
+        wc.lpszClassName    = _TimerServiceClassName;
+        timerServiceClsAtom = RegisterClassExW(&wc);
+    }
+
+    this->_hwnd = CreateWindowExW(
+        0,                      // Optional window styles
+        _TimerServiceClassName, // Window class
+        L"",                    // Window text
+        0,                      // Window style
+        0, 0, 0, 0,             // Size and position
+        HWND_MESSAGE,           // Parent window, message-only
+        NULL,                   // Menu
+        App::Instance,          // Instance handle
+        NULL                    // Additional application data
+    );
+
+    SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+}
+
+sw::TimerService::~TimerService()
+{
+    if (this->_hwnd != NULL) {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, 0);
+        DestroyWindow(this->_hwnd);
+    }
+}
+
+sw::TimerService &sw::TimerService::GetCurrent()
+{
+    /**
+     * @brief 线程退出时关闭当前线程的定时器服务
+     */
+    struct _ExitGuard {
+        TimerService *service = nullptr;
+
+        ~_ExitGuard()
+        {
+            if (this->service != nullptr) {
+                this->service->_Shutdown();
+            }
+        }
+    };
+
+    // 定时器服务有意不释放：主线程的线程局部变量在静态对象之前析构，静态存储期的定时器仍保存着定时器服务的指针
+    static thread_local TimerService *service = nullptr;
+    static thread_local _ExitGuard guard;
+
+    if (service == nullptr) {
+        service       = new TimerService;
+        guard.service = service;
+    }
+    return *service;
+}
+
+sw::TimerWheel::TimerId sw::TimerService::Create(DispatchCallable &&callback)
+{
+    return this->_wheel.Create(std::move(callback));
+}
+
+bool sw::TimerService::Destroy(TimerWheel::TimerId id)
+{
+    // 不修改系统定时器，提前到期时_OnTimer会按新的时间重新设置
+    return this->_wheel.Destroy(id);
+}
+
+bool sw::TimerService::Start(TimerWheel::TimerId id, uint32_t delay, uint32_t period, uint32_t tolerance)
+{
+    // 时间轮只在系统定时器到期时前进，到期时间以当前的系统时间计算
+    if (!this->_wheel.Start(id, GetTickCount64() + delay, period, tolerance)) {
+        return false;
+    }
+    this->_Arm(false);
+    return true;
+}
+
+bool sw::TimerService::Stop(TimerWheel::TimerId id)
+{
+    return this->_wheel.Stop(id);
+}
+
+bool sw::TimerService::IsActive(TimerWheel::TimerId id) const
+{
+    return this->_wheel.IsActive(id);
+}
+
+size_t sw::TimerService::GetActiveCount() const
+{
+    return this->_wheel.GetActiveCount();
+}
+
+void sw::TimerService::_Shutdown()
+{
+    if (this->_hwnd != NULL) {
+        SetWindowLongPtrW(this->_hwnd, GWLP_USERDATA, 0);
+        DestroyWindow(this->_hwnd);
+        this->_hwnd = NULL;
+    }
+    this->_armedTime = UINT64_MAX;
+}
+
+void sw::TimerService::_OnTimer()
+{
+    this->_armedTime = UINT64_MAX;
+
+    struct _RearmGuard {
+        TimerService *service;
+        ~_RearmGuard()
+        {
+            // 回调抛出异常时同样需要重新设置系统定时器，剩余的定时器在下一次到期时执行
+            this->service->_Arm(true);
+        }
+    } guard{this};
+
+    this->_wheel.Advance(GetTickCount64());
+}
+
+void sw::TimerService::_Arm(bool force)
+{
+    uint64_t next;
+
+    // 线程已退出，SetTimer的窗口参数为NULL时会创建线程定时器
+    if (this->_hwnd == NULL) {
+        return;
+    }
+
+    if (!this->_wheel.GetNextExpiry(next)) {
+        if (force || this->_armedTime != UINT64_MAX) {
+            KillTimer(this->_hwnd, _TimerServiceTimerId);
+            this->_armedTime = UINT64_MAX;
+        }
+        return;
+    }
+
+    if (!force && next >= this->_armedTime) {
+        return;
+    }
+
+    uint64_t now   = GetTickCount64();
+    uint64_t delay = next > now ? next - now : 0;
+
+    delay = Utils::Max<uint64_t>(delay, USER_TIMER_MINIMUM);
+    delay = Utils::Min<uint64_t>(delay, USER_TIMER_MAXIMUM);
+
+    // 对同一窗口和id调用SetTimer会替换原有的系统定时器
+    SetTimer(this->_hwnd, _TimerServiceTimerId, (UINT)delay, NULL);
+    this->_armedTime = now + delay;
+}
+
+LRESULT sw::TimerService::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    if (uMsg == WM_TIMER && wParam == _TimerServiceTimerId) {
+        auto service = reinterpret_cast<TimerService *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+        if (service != nullptr) {
+            MsgMonitor::DispatchScope scope(uMsg, "sw::TimerService", reinterpret_cast<uint64_t>(hwnd));
+            service->_OnTimer();
+        }
+        return 0;
+    }
+    return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+}
@@ -0,0 +1,373 @@
+#include "TimerWheel.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+constexpr int sw::TimerWheel::SlotCount;
+constexpr int sw::TimerWheel::LevelCount;
+constexpr int sw::TimerWheel::_SlotBits;
+
+namespace
+{
+    /**
+     * @brief 槽号的掩码
+     */
+    constexpr uint64_t _SlotMask = sw::TimerWheel::SlotCount - 1;
+
+    /**
+     * @brief 时间轮可直接表示的最长时间
+     */
+    constexpr uint64_t _MaxDelta = uint64_t(1) << (6 * sw::TimerWheel::LevelCount);
+
+    /**
+     * @brief 获取非零整数最低的为1的位的位置
+     */
+    int _LowestBit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return (int)index;
+#else
+        int index = 0;
+        while ((value & 1) == 0) {
+            value >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    /**
+     * @brief 按容差合并到期时间：向上取整为不超过tolerance+1的最大的2的幂的倍数，容差相近的定时器落在同一时刻
+     */
+    uint64_t _Coalesce(uint64_t due, uint64_t tolerance)
+    {
+        uint64_t granularity = 1;
+        while (granularity <= tolerance / 2 + (tolerance & 1) && granularity < _MaxDelta) {
+            granularity <<= 1;
+        }
+        return (due + granularity - 1) & ~(granularity - 1);
+    }
+}
+
+sw::TimerWheel::TimerWheel(uint64_t now)
+    : _now(now)
+{
+}
+
+sw::TimerWheel::TimerId sw::TimerWheel::Create(DispatchCallable &&callback)
+{
+    uint32_t index;
+    if (this->_freeList.empty()) {
+        index = (uint32_t)this->_entries.size();
+        this->_entries.emplace_back();
+        this->_entries.back().index = index;
+    } else {
+        index = this->_freeList.back();
+        this->_freeList.pop_back();
+    }
+
+    _Entry &entry    = this->_entries[index];
+    entry.callback  = std::move(callback);
+    entry.allocated = true;
+    entry.period    = 0;
+    entry.tolerance = 0;
+    return (TimerId(entry.generation) << 32) | index;
+}
+
+bool sw::TimerWheel::Destroy(TimerId id)
+{
+    _Entry *entry = this->_Find(id);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    this->_Unlink(entry);
+    entry->allocated = false;
+
+    if (entry == this->_firing) {
+        // 正在执行的回调不能析构，由_RunExpired在回调返回后回收
+        entry->destroyPending = true;
+    } else {
+        this->_Free(entry);
+    }
+    return true;
+}
+
+bool sw::TimerWheel::Start(TimerId id, uint64_t due, uint64_t period, uint64_t tolerance)
+{
+    _Entry *entry = this->_Find(id);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    this->_Unlink(entry);
+    entry->due       = due;
+    entry->period    = period;
+    entry->tolerance = tolerance;
+    entry->expires   = _Coalesce(due, tolerance);
+    this->_Insert(entry);
+    return true;
+}
+
+bool sw::TimerWheel::Stop(TimerId id)
+{
+    _Entry *entry = this->_Find(id);
+    if (entry == nullptr) {
+        return false;
+    }
+    this->_Unlink(entry);
+    return true;
+}
+
+bool sw::TimerWheel::IsActive(TimerId id) const
+{
+    _Entry *entry = this->_Find(id);
+    return entry != nullptr && entry->level >= 0;
+}
+
+int sw::TimerWheel::Advance(uint64_t now)
+{
+    // 先执行上一次因回调抛出异常而未执行的定时器
+    int count = this->_RunExpired();
+
+    while (this->_now < now) {
+        // 跳过第0层中没有定时器的槽，最远到第0层转完一圈，此时需要下放上层的槽
+        uint64_t next = this->_now + 1;
+        int index     = (int)(next & _SlotMask);
+        if (index != 0) {
+            uint64_t bits = this->_bitmaps[0] >> index;
+            next += bits != 0 ? (uint64_t)_LowestBit(bits) : (uint64_t)(SlotCount - index);
+        }
+        if (next > now) {
+            this->_now = now;
+            break;
+        }
+        this->_now = next;
+
+        if ((next & _SlotMask) == 0) {
+            for (int level = 1; level < LevelCount; ++level) {
+                int slot = (int)((next >> (_SlotBits * level)) & _SlotMask);
+                this->_Cascade(level, slot);
+                if (slot != 0) break;
+            }
+        }
+
+        this->_SpliceToExpired(this->_slots[0][next & _SlotMask]);
+        this->_bitmaps[0] &= ~(uint64_t(1) << (next & _SlotMask));
+        count += this->_RunExpired();
+    }
+    return count;
+}
+
+bool sw::TimerWheel::GetNextExpiry(uint64_t &time) const
+{
+    if (this->_expired.next != &this->_expired) {
+        time = this->_now;
+        return true;
+    }
+
+    bool found = false;
+    uint64_t result = 0;
+
+    for (int level = 0; level < LevelCount; ++level) {
+        uint64_t bits = this->_bitmaps[level];
+        if (bits == 0) continue;
+
+        // 从当前槽的下一个槽开始查找第一个非空的槽
+        int shift       = _SlotBits * level;
+        uint64_t cursor = this->_now >> shift;
+        int current     = (int)(cursor & _SlotMask);
+        int rotate      = (current + 1) & (int)_SlotMask;
+        uint64_t rotated = rotate == 0 ? bits : ((bits >> rotate) | (bits << (SlotCount - rotate)));
+        uint64_t t       = (cursor + 1 + (uint64_t)_LowestBit(rotated)) << shift;
+
+        if (!found || t < result) {
+            result = t;
+            found  = true;
+        }
+    }
+
+    if (found) time = result;
+    return found;
+}
+
+uint64_t sw::TimerWheel::GetNow() const
+{
+    return this->_now;
+}
+
+size_t sw::TimerWheel::GetActiveCount() const
+{
+    return this->_activeCount;
+}
+
+sw::TimerWheel::_Entry *sw::TimerWheel::_Find(TimerId id) const
+{
+    uint32_t index      = (uint32_t)id;
+    uint32_t generation = (uint32_t)(id >> 32);
+
+    if (index >= this->_entries.size()) {
+        return nullptr;
+    }
+    const _Entry &entry = this->_entries[index];
+    if (!entry.allocated || entry.generation != generation) {
+        return nullptr;
+    }
+    return const_cast<_Entry *>(&entry);
+}
+
+void sw::TimerWheel::_Insert(_Entry *entry)
+{
+    _Node *head;
+
+    if (entry->expires <= this->_now) {
+        head         = &this->_expired;
+        entry->level = LevelCount;
+    } else {
+        uint64_t delta   = entry->expires - this->_now;
+        uint64_t expires = entry->expires;
+        if (delta >= _MaxDelta) {
+            // 超出范围的定时器放在最上层最远的槽中，下放时按实际的到期时间重新放入
+            delta   = _MaxDelta - 1;
+            expires = this->_now + delta;
+        }
+
+        int level = 0;
+        while (level < LevelCount - 1 && delta >= (uint64_t(1) << (_SlotBits * (level + 1)))) {
+            ++level;
+        }
+        int slot = (int)((expires >> (_SlotBits * level)) & _SlotMask);
+
+        head         = &this->_slots[level][slot];
+        entry->level = level;
+        entry->slot  = slot;
+        this->_bitmaps[level] |= uint64_t(1) << slot;
+    }
+
+    entry->prev      = head->prev;
+    entry->next      = head;
+    head->prev->next = entry;
+    head->prev       = entry;
+    ++this->_activeCount;
+}
+
+void sw::TimerWheel::_Unlink(_Entry *entry)
+{
+    if (entry->level < 0) {
+        return;
+    }
+
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+
+    if (entry->level < LevelCount) {
+        _Node &head = this->_slots[entry->level][entry->slot];
+        if (head.next == &head) {
+            this->_bitmaps[entry->level] &= ~(uint64_t(1) << entry->slot);
+        }
+    }
+
+    entry->prev  = entry;
+    entry->next  = entry;
+    entry->level = -1;
+    --this->_activeCount;
+}
+
+void sw::TimerWheel::_SpliceToExpired(_Node &list)
+{
+    if (list.next == &list) {
+        return;
+    }
+
+    for (_Node *node = list.next; node != &list; node = node->next) {
+        static_cast<_Entry *>(node)->level = LevelCount;
+    }
+
+    list.next->prev           = this->_expired.prev;
+    list.prev->next           = &this->_expired;
+    this->_expired.prev->next = list.next;
+    this->_expired.prev       = list.prev;
+    list.next = list.prev = &list;
+}
+
+void sw::TimerWheel::_Cascade(int level, int slot)
+{
+    _Node &head = this->_slots[level][slot];
+    if (head.next == &head) {
+        return;
+    }
+
+    // 先取出整个链表再逐个放入，重新放入的定时器不会回到当前槽
+    _Node list;
+    list.next       = head.next;
+    list.prev       = head.prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    head.next = head.prev = &head;
+    this->_bitmaps[level] &= ~(uint64_t(1) << slot);
+
+    while (list.next != &list) {
+        _Entry *entry     = static_cast<_Entry *>(list.next);
+        list.next         = entry->next;
+        entry->next->prev = &list;
+        --this->_activeCount;
+        this->_Insert(entry);
+    }
+}
+
+int sw::TimerWheel::_RunExpired()
+{
+    int count = 0;
+
+    while (this->_expired.next != &this->_expired) {
+        _Entry *entry = static_cast<_Entry *>(this->_expired.next);
+        uint64_t now  = this->_now;
+
+        this->_Unlink(entry);
+
+        // 周期定时器在执行回调前重新启动，回调中可以停止或修改它；错过的周期直接跳过而不连续触发
+        if (entry->period != 0) {
+            uint64_t due = entry->due + entry->period;
+            if (due <= now) {
+                due = now + entry->period;
+            }
+            entry->due     = due;
+            entry->expires = _Coalesce(due, entry->tolerance);
+            this->_Insert(entry);
+        }
+
+        struct _FiringGuard {
+            TimerWheel *wheel;
+            _Entry *entry;
+            ~_FiringGuard()
+            {
+                this->wheel->_firing = nullptr;
+                if (this->entry->destroyPending) {
+                    this->wheel->_Free(this->entry);
+                }
+            }
+        } guard{this, entry};
+
+        this->_firing = entry;
+        entry->callback();
+        ++count;
+    }
+    return count;
+}
+
+void sw::TimerWheel::_Free(_Entry *entry)
+{
+    entry->callback.Reset();
+    entry->destroyPending = false;
+    entry->allocated      = false;
+    ++entry->generation;
+    if (entry->generation == 0) {
+        entry->generation = 1;
+    }
+    this->_freeList.push_back(entry->index);
+}
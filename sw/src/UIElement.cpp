@@ -1,235 +1,306 @@
 #include "UIElement.h"
+#include "BrushCache.h"
+#include "LayoutProfiler.h"
 #include "Utils.h"
 #include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <deque>
+#include <typeinfo>
+
+namespace
+{
+    /**
+     * @brief 等待批次提交后调用OnArrangeCommitted的元素
+     */
+    thread_local std::vector<sw::UIElement *> _arrangeCommittedQueue;
+
+    /**
+     * @brief 是否正在提交最外层批次中的窗口位置改变
+     */
+    thread_local bool _isCommittingArrange = false;
+
+    /**
+     * @brief 是否正在调用各元素的OnArrangeCommitted函数
+     */
+    thread_local bool _isRunningArrangeCommitted = false;
+
+    /**
+     * @brief 正在调用BlitScrollChildren的元素，其子元素在此期间的移动是由滚动造成的
+     */
+    thread_local sw::UIElement *_blitScrollingElement = nullptr;
+
+    /**
+     * @brief 元素未注册路由事件处理函数时传给OnRoutedEvent的空处理函数
+     */
+    const sw::RoutedEventHandler _emptyRoutedEventHandler;
+
+    /**
+     * @brief 将以DIP为单位的矩形转换为像素位置
+     */
+    sw::PixelRect _DipRectToPixelRect(const sw::Rect &rect)
+    {
+        sw::PixelRect pixelRect;
+        pixelRect.left   = sw::Dip::DipToPxX(rect.left);
+        pixelRect.top    = sw::Dip::DipToPxY(rect.top);
+        pixelRect.width  = sw::Dip::DipToPxX(rect.width);
+        pixelRect.height = sw::Dip::DipToPxY(rect.height);
+        return pixelRect;
+    }
+}
 
 sw::UIElement::UIElement()
     : Margin(
+          this,
           // get
-          [this]() -> Thickness {
-              return this->_margin;
+          [](UIElement *self) -> Thickness {
+              return self->_margin;
           },
           // set
-          [this](const Thickness &value) {
-              this->_margin = value;
-              this->InvalidateMeasure();
+          [](UIElement *self, const Thickness &value) {
+              self->_margin = value;
+              self->_UpdateExtentInParent(self->Rect);
+              self->InvalidateMeasure();
           }),
 
       HorizontalAlignment(
+          this,
           // get
-          [this]() -> sw::HorizontalAlignment {
-              return this->_horizontalAlignment;
+          [](UIElement *self) -> sw::HorizontalAlignment {
+              return self->_horizontalAlignment;
           },
           // set
-          [this](const sw::HorizontalAlignment &value) {
-              if (this->_SetHorzAlignment(value)) {
-                  this->InvalidateMeasure();
+          [](UIElement *self, const sw::HorizontalAlignment &value) {
+              if (self->_SetHorzAlignment(value)) {
+                  self->InvalidateMeasure();
               }
           }),
 
       VerticalAlignment(
+          this,
           // get
-          [this]() -> sw::VerticalAlignment {
-              return this->_verticalAlignment;
+          [](UIElement *self) -> sw::VerticalAlignment {
+              return self->_verticalAlignment;
           },
           // set
-          [this](const sw::VerticalAlignment &value) {
-              if (this->_SetVertAlignment(value)) {
-                  this->InvalidateMeasure();
+          [](UIElement *self, const sw::VerticalAlignment &value) {
+              if (self->_SetVertAlignment(value)) {
+                  self->InvalidateMeasure();
               }
           }),
 
       ChildCount(
+          this,
           // get
-          [this]() -> int {
-              return (int)this->_children.size();
+          [](UIElement *self) -> int {
+              return (int)self->_children.size();
           }),
 
       CollapseWhenHide(
+          this,
           // get
-          [this]() -> bool {
-              return this->_collapseWhenHide;
+          [](UIElement *self) -> bool {
+              return self->_collapseWhenHide;
           },
           // set
-          [this](const bool &value) {
-              if (this->_collapseWhenHide != value) {
-                  this->_collapseWhenHide = value;
-                  if (this->_parent && !this->Visible) {
-                      this->_parent->_UpdateLayoutVisibleChildren();
-                      this->_parent->InvalidateMeasure();
+          [](UIElement *self, const bool &value) {
+              if (self->_collapseWhenHide != value) {
+                  self->_collapseWhenHide = value;
+                  if (self->_parent && !self->Visible) {
+                      self->_parent->_UpdateLayoutVisibleChildren();
+                      self->_parent->InvalidateMeasure();
                   }
               }
           }),
 
       Parent(
+          this,
           // get
-          [this]() -> UIElement * {
-              return this->_parent;
+          [](UIElement *self) -> UIElement * {
+              return self->_parent;
           }),
 
       Tag(
+          this,
           // get
-          [this]() -> uint64_t {
-              return this->_tag;
+          [](UIElement *self) -> uint64_t {
+              return self->_tag;
           },
           // set
-          [this](const uint64_t &value) {
-              this->_tag = value;
+          [](UIElement *self, const uint64_t &value) {
+              self->_tag = value;
           }),
 
       LayoutTag(
+          this,
           // get
-          [this]() -> uint64_t {
-              return this->_layoutTag;
+          [](UIElement *self) -> uint64_t {
+              return self->_layoutTag;
           },
           // set
-          [this](const uint64_t &value) {
-              this->_layoutTag = value;
-              this->InvalidateMeasure();
+          [](UIElement *self, const uint64_t &value) {
+              self->_layoutTag = value;
+              self->InvalidateMeasure();
+              // 布局标记决定了元素在父元素中的位置，需要同时更新父元素的布局
+              if (self->_parent) self->_parent->InvalidateMeasure();
           }),
 
       ContextMenu(
+          this,
           // get
-          [this]() -> sw::ContextMenu * {
-              return this->_contextMenu;
+          [](UIElement *self) -> sw::ContextMenu * {
+              return self->_contextMenu;
           },
           // set
-          [this](sw::ContextMenu *value) {
-              this->_contextMenu = value;
+          [](UIElement *self, sw::ContextMenu *const &value) {
+              self->_contextMenu = value;
           }),
 
       Float(
+          this,
           // get
-          [this]() -> bool {
-              return this->_float;
+          [](UIElement *self) -> bool {
+              return self->_float;
           },
           // set
-          [this](const bool &value) {
-              if (this->_float != value) {
-                  this->_float = value;
-                  this->UpdateSiblingsZOrder();
+          [](UIElement *self, const bool &value) {
+              if (self->_float != value) {
+                  self->_float = value;
+                  if (self->_parent) self->_parent->_childExtentInvalid = true;
+                  self->UpdateSiblingsZOrder();
               }
           }),
 
       TabStop(
+          this,
           // get
-          [this]() -> bool {
-              return this->_tabStop;
+          [](UIElement *self) -> bool {
+              return self->_tabStop;
           },
           // set
-          [this](const bool &value) {
-              this->_tabStop = value;
+          [](UIElement *self, const bool &value) {
+              self->_tabStop = value;
           }),
 
       BackColor(
+          this,
           // get
-          [this]() -> Color {
-              return this->_backColor;
+          [](UIElement *self) -> Color {
+              return self->_backColor;
           },
           // set
-          [this](const Color &value) {
-              this->_transparent = false;
-              this->SetBackColor(value, true);
+          [](UIElement *self, const Color &value) {
+              self->_transparent = false;
+              self->SetBackColor(value, true);
           }),
 
       TextColor(
+          this,
           // get
-          [this]() -> Color {
-              return this->_textColor;
+          [](UIElement *self) -> Color {
+              return self->_textColor;
           },
           // set
-          [this](const Color &value) {
-              this->_inheritTextColor = false;
-              this->SetTextColor(value, true);
+          [](UIElement *self, const Color &value) {
+              self->_inheritTextColor = false;
+              self->SetTextColor(value, true);
           }),
 
       Transparent(
+          this,
           // get
-          [this]() -> bool {
-              return this->_transparent;
+          [](UIElement *self) -> bool {
+              return self->_transparent;
           },
           // set
-          [this](const bool &value) {
-              this->_transparent = value;
-              this->Redraw();
+          [](UIElement *self, const bool &value) {
+              self->_transparent = value;
+              self->Redraw();
           }),
 
       InheritTextColor(
+          this,
           // get
-          [this]() -> bool {
-              return this->_inheritTextColor;
+          [](UIElement *self) -> bool {
+              return self->_inheritTextColor;
           },
           // set
-          [this](const bool &value) {
-              this->_inheritTextColor = value;
-              this->Redraw();
+          [](UIElement *self, const bool &value) {
+              self->_inheritTextColor = value;
+              self->Redraw();
           }),
 
       LayoutUpdateCondition(
+          this,
           // get
-          [this]() -> sw::LayoutUpdateCondition {
-              return this->_layoutUpdateCondition;
+          [](UIElement *self) -> sw::LayoutUpdateCondition {
+              return self->_layoutUpdateCondition;
           },
           // set
-          [this](const sw::LayoutUpdateCondition &value) {
-              this->_layoutUpdateCondition = value;
+          [](UIElement *self, const sw::LayoutUpdateCondition &value) {
+              self->_layoutUpdateCondition = value;
           }),
 
       IsMeasureValid(
+          this,
           // get
-          [this]() -> bool {
-              return !this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated);
+          [](UIElement *self) -> bool {
+              return !self->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated);
           }),
 
       MinWidth(
+          this,
           // get
-          [this]() -> double {
-              return this->_minSize.width;
+          [](UIElement *self) -> double {
+              return self->_minSize.width;
           },
           // set
-          [this](const double &value) {
-              if (this->_minSize.width != value) {
-                  this->_minSize.width = value;
-                  this->OnMinMaxSizeChanged();
+          [](UIElement *self, const double &value) {
+              if (self->_minSize.width != value) {
+                  self->_minSize.width = value;
+                  self->OnMinMaxSizeChanged();
               }
           }),
 
       MinHeight(
+          this,
           // get
-          [this]() -> double {
-              return this->_minSize.height;
+          [](UIElement *self) -> double {
+              return self->_minSize.height;
           },
           // set
-          [this](const double &value) {
-              if (this->_minSize.height != value) {
-                  this->_minSize.height = value;
-                  this->OnMinMaxSizeChanged();
+          [](UIElement *self, const double &value) {
+              if (self->_minSize.height != value) {
+                  self->_minSize.height = value;
+                  self->OnMinMaxSizeChanged();
               }
           }),
 
       MaxWidth(
+          this,
           // get
-          [this]() -> double {
-              return this->_maxSize.width;
+          [](UIElement *self) -> double {
+              return self->_maxSize.width;
           },
           // set
-          [this](const double &value) {
-              if (this->_maxSize.width != value) {
-                  this->_maxSize.width = value;
-                  this->OnMinMaxSizeChanged();
+          [](UIElement *self, const double &value) {
+              if (self->_maxSize.width != value) {
+                  self->_maxSize.width = value;
+                  self->OnMinMaxSizeChanged();
               }
           }),
 
       MaxHeight(
+          this,
           // get
-          [this]() -> double {
-              return this->_maxSize.height;
+          [](UIElement *self) -> double {
+              return self->_maxSize.height;
           },
           // set
-          [this](const double &value) {
-              if (this->_maxSize.height != value) {
-                  this->_maxSize.height = value;
-                  this->OnMinMaxSizeChanged();
+          [](UIElement *self, const double &value) {
+              if (self->_maxSize.height != value) {
+                  self->_maxSize.height = value;
+                  self->OnMinMaxSizeChanged();
               }
           })
 {
@@ -240,35 +311,53 @@ sw::UIElement::~UIElement()
     // 将自己从父窗口的children中移除
     this->SetParent(nullptr);
 
+    // 从布局更新队列中移除
+    LayoutScheduler::Cancel(*this);
+
+    if (this->_arrangeCommittedQueued) {
+        std::replace(_arrangeCommittedQueue.begin(), _arrangeCommittedQueue.end(), this, static_cast<UIElement *>(nullptr));
+    }
+
     // 释放资源
     if (this->_hCtlColorBrush != NULL) {
-        DeleteObject(this->_hCtlColorBrush);
+        BrushCache::Release(this->_hCtlColorBrush);
     }
 }
 
 void sw::UIElement::RegisterRoutedEvent(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    this->_eventMap[eventType] = handler;
+    if (handler) {
+        this->_eventTable.GetOrAdd(eventType) = handler;
+    } else {
+        this->UnregisterRoutedEvent(eventType);
+    }
 }
 
 void sw::UIElement::AddHandler(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    if (handler) this->_eventMap[eventType] += handler;
+    if (handler) this->_eventTable.GetOrAdd(eventType) += handler;
 }
 
 bool sw::UIElement::RemoveHandler(RoutedEventType eventType, const RoutedEventHandler &handler)
 {
-    return handler == nullptr ? false : this->_eventMap[eventType].Remove(handler);
+    if (handler == nullptr) {
+        return false;
+    }
+    RoutedEventHandler *eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && eventHandler->Remove(handler);
 }
 
 void sw::UIElement::UnregisterRoutedEvent(RoutedEventType eventType)
 {
-    this->_eventMap[eventType] = nullptr;
+    // 不移除表项，处理函数可能正在执行
+    RoutedEventHandler *eventHandler = this->_eventTable.Find(eventType);
+    if (eventHandler != nullptr) *eventHandler = nullptr;
 }
 
 bool sw::UIElement::IsRoutedEventRegistered(RoutedEventType eventType)
 {
-    return this->_eventMap[eventType] != nullptr;
+    RoutedEventHandler *eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && *eventHandler != nullptr;
 }
 
 sw::UIElement &sw::UIElement::operator[](int index) const
@@ -595,18 +684,15 @@ bool sw::UIElement::IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition conditi
 void sw::UIElement::InvalidateMeasure()
 {
     if (this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::Supressed)) {
+        // 即使布局更新被抑制，之前的测量结果也已失效
+        this->_measureCache.Clear();
         return;
     }
 
-    UIElement *root;
-    UIElement *element = this;
-    do {
-        root = element;
-        element->_SetMeasureInvalidated();
-        element = element->_parent;
-    } while (element != nullptr);
-
-    root->SendMessageW(WM_UpdateLayout, 0, 0);
+    // 父元素是否需要更新由LayoutScheduler在测量后根据所需尺寸是否改变决定
+    // 调度器需要保存失效前的测量结果，因此在清空缓存前加入队列
+    LayoutScheduler::Schedule(*this);
+    this->_SetMeasureInvalidated();
 }
 
 bool sw::UIElement::BringIntoView()
@@ -663,36 +749,41 @@ sw::Size sw::UIElement::GetDesireSize()
 
 void sw::UIElement::Measure(const Size &availableSize)
 {
-    if (!this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::MeasureInvalidated) &&
-        this->_lastMeasureAvailableSize == availableSize) {
-        return; // 若布局未失效且可用尺寸没有变化，则无需重新测量
+    bool profiling = LayoutProfiler::IsEnabled();
+    if (profiling) {
+        LayoutProfiler::BeginMeasure(this, this->_parent, typeid(*this).name());
     }
 
-    Size measureSize    = availableSize;
-    Thickness &margin   = this->_margin;
-    sw::Rect windowRect = this->Rect;
-    sw::Rect clientRect = this->ClientRect;
-
-    // 考虑边框
-    measureSize.width -= (windowRect.width - clientRect.width) + margin.left + margin.right;
-    measureSize.height -= (windowRect.height - clientRect.height) + margin.top + margin.bottom;
-
-    // 由子类实现MeasureOverride函数来计算内容所需的尺寸
-    this->_desireSize = this->MeasureOverride(measureSize);
-    this->_desireSize.width += windowRect.width - clientRect.width;
-    this->_desireSize.height += windowRect.height - clientRect.height;
+    // 缓存在布局失效时清空，其中的结果都是在失效后测量的，因此无需再判断MeasureInvalidated标记
+    // 这样GridLayout在同一次布局中以相同的可用尺寸再次测量时也可以直接使用缓存
+    // 命中的结果不是最近一次实际测量的结果时，子元素仍保留着其他尺寸下的测量结果，由Arrange在安排前重新测量
+    Size cachedDesireSize;
+    if (this->_measureCache.TryGet(availableSize, cachedDesireSize)) {
+        this->_desireSize               = cachedDesireSize;
+        this->_lastMeasureAvailableSize = availableSize;
+        if (profiling) LayoutProfiler::EndMeasure(true);
+        return;
+    }
 
-    // 限制尺寸在最小和最大尺寸之间
-    this->ClampDesireSize(this->_desireSize);
-    this->_desireSize.width += margin.left + margin.right;
-    this->_desireSize.height += margin.top + margin.bottom;
+    this->_MeasureCore(availableSize);
 
-    // 更新_lastMeasureAvailableSize
-    this->_lastMeasureAvailableSize = availableSize;
+    if (profiling) {
+        LayoutProfiler::EndMeasure(false);
+    }
 }
 
 void sw::UIElement::Arrange(const sw::Rect &finalPosition)
 {
+    bool profiling = LayoutProfiler::IsEnabled();
+    if (profiling) {
+        LayoutProfiler::BeginArrange(this, this->_parent, typeid(*this).name());
+    }
+
+    // 上一次Measure命中了较早的缓存时，子元素的测量结果对应的是其他可用尺寸，需要先按当前尺寸重新测量
+    if (this->_lastMeasureAvailableSize != this->_lastMeasureOverrideSize) {
+        this->_MeasureCore(this->_lastMeasureAvailableSize);
+    }
+
     // 为什么在Arrange阶段清除MeasureInvalidated标记：
     // 一些复杂的布局可能会在测量阶段多次调用Measure函数，
     // 比如Grid会调用两次Measure，若在测量阶段清除该标记，
@@ -700,6 +791,10 @@ void sw::UIElement::Arrange(const sw::Rect &finalPosition)
     this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::MeasureInvalidated;
     this->_layoutUpdateCondition |= sw::LayoutUpdateCondition::Supressed;
 
+    // 记录安排的位置，当所需尺寸未改变时LayoutScheduler可以直接在原位置重新安排当前元素
+    this->_lastArrangeFinalPosition = finalPosition;
+    this->_hasArranged              = true;
+
     Size &desireSize  = this->_desireSize;
     Thickness &margin = this->_margin;
 
@@ -749,43 +844,53 @@ void sw::UIElement::Arrange(const sw::Rect &finalPosition)
         }
     }
 
-    if (this->_parent && !this->_float) { // 考虑偏移量
-        rect.left += this->_parent->_arrangeOffsetX;
-        rect.top += this->_parent->_arrangeOffsetY;
-    }
-
     rect.width  = Utils::Max(0.0, rect.width);
     rect.height = Utils::Max(0.0, rect.height);
 
-    bool hasChildren = !this->_children.empty();
-    HDWP hdwpCurrent = this->_parent ? this->_parent->_hdwpChildren : NULL;
+    UIElement::BeginArrangeBatch();
 
-    if (!hasChildren && hdwpCurrent != NULL) {
-        DeferWindowPos(hdwpCurrent, this->Handle, NULL,
-                       Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
-                       Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height),
-                       SWP_NOACTIVATE | SWP_NOZORDER);
-    } else {
-        SetWindowPos(this->Handle, NULL,
-                     Dip::DipToPxX(rect.left), Dip::DipToPxY(rect.top),
-                     Dip::DipToPxX(rect.width), Dip::DipToPxY(rect.height),
-                     SWP_NOACTIVATE | SWP_NOZORDER);
+    sw::Rect windowRect = this->Rect;
+    PixelRect pixelRect = _DipRectToPixelRect(rect);
+
+    // 偏移量单独换算为像素后再加上，而不是与位置相加后一起换算，
+    // 这样子元素的像素位置随偏移量变化的距离总是等于偏移量换算后的差值，Blit模式滚动时移动的距离与重新安排的结果一致
+    if (this->_parent && !this->_float) { // 考虑偏移量
+        pixelRect.left += Dip::DipToPxX(this->_parent->_arrangeOffsetX);
+        pixelRect.top += Dip::DipToPxY(this->_parent->_arrangeOffsetY);
     }
 
-    if (hasChildren) {
-        if (this->_children.size() >= 3) {
-            this->_hdwpChildren = BeginDeferWindowPos((int)this->_children.size());
-        }
+    // 像素位置没有改变时无需移动窗口，但若当前批次中已移动过该窗口，则需要再次记录以覆盖之前的位置
+    uint64_t batchId = WindowPositioner::GetBatchId();
+    if (pixelRect != _DipRectToPixelRect(windowRect) || this->_moveBatchId == batchId) {
+        HWND hwnd       = this->Handle;
+        HWND hwndParent = this->_parent ? (HWND)this->_parent->Handle : GetAncestor(hwnd, GA_PARENT);
+        WindowPositioner::Move(hwnd, hwndParent, pixelRect);
+        this->_moveBatchId = batchId;
+        if (profiling) LayoutProfiler::RecordWindowMove();
+    }
+    this->_lastArrangePixelRect = pixelRect;
 
-        this->ArrangeOverride(this->ClientRect->GetSize());
+    // 窗口位置的改变尚未提交，按提交后的位置更新父元素的范围，换算方式与WM_WINDOWPOSCHANGED中相同
+    this->_UpdateExtentInParent(sw::Rect(
+        Dip::PxToDipX(pixelRect.left), Dip::PxToDipY(pixelRect.top),
+        Dip::PxToDipX(pixelRect.width), Dip::PxToDipY(pixelRect.height)));
 
-        if (this->_hdwpChildren != NULL) {
-            EndDeferWindowPos(this->_hdwpChildren);
-            this->_hdwpChildren = NULL;
-        }
+    if (!this->_children.empty()) {
+        // 窗口位置的改变尚未提交，此时的客户区尺寸由新的窗口尺寸减去边框得到
+        sw::Rect clientRect = this->ClientRect;
+        sw::Size clientSize(
+            Utils::Max(0.0, Dip::PxToDipX(pixelRect.width) - (windowRect.width - clientRect.width)),
+            Utils::Max(0.0, Dip::PxToDipY(pixelRect.height) - (windowRect.height - clientRect.height)));
+        this->ArrangeOverride(clientSize);
     }
 
+    UIElement::EndArrangeBatch();
+
     this->_layoutUpdateCondition &= ~sw::LayoutUpdateCondition::Supressed;
+
+    if (profiling) {
+        LayoutProfiler::EndArrange();
+    }
 }
 
 sw::UIElement *sw::UIElement::ToUIElement()
@@ -809,9 +914,10 @@ void sw::UIElement::RaiseRoutedEvent(RoutedEventArgs &eventArgs)
 
     UIElement *element = this;
     do {
-        auto &handler = element->_eventMap[eventArgs.eventType];
-        if (!element->OnRoutedEvent(eventArgs, handler)) {
-            if (handler) handler(*element, eventArgs);
+        // 未注册该类型处理函数的元素查找时不会插入新的表项
+        RoutedEventHandler *handler = element->_eventTable.Find(eventArgs.eventType);
+        if (!element->OnRoutedEvent(eventArgs, handler != nullptr ? *handler : _emptyRoutedEventHandler)) {
+            if (handler != nullptr && *handler) (*handler)(*element, eventArgs);
         }
         if (eventArgs.handled) {
             break;
@@ -834,11 +940,7 @@ double &sw::UIElement::GetInternalArrangeOffsetY()
 double sw::UIElement::GetChildRightmost(bool update)
 {
     if (update) {
-        this->_childRightmost = 0;
-        for (UIElement *item : this->_layoutVisibleChildren) {
-            if (item->_float) continue;
-            this->_childRightmost = Utils::Max(this->_childRightmost, item->Left + item->Width + item->_margin.right - this->_arrangeOffsetX);
-        }
+        this->_UpdateChildExtent();
     }
     return this->_childRightmost;
 }
@@ -846,15 +948,37 @@ double sw::UIElement::GetChildRightmost(bool update)
 double sw::UIElement::GetChildBottommost(bool update)
 {
     if (update) {
-        this->_childBottommost = 0;
-        for (UIElement *item : this->_layoutVisibleChildren) {
-            if (item->_float) continue;
-            this->_childBottommost = Utils::Max(this->_childBottommost, item->Top + item->Height + item->_margin.bottom - this->_arrangeOffsetY);
-        }
+        this->_UpdateChildExtent();
     }
     return this->_childBottommost;
 }
 
+void sw::UIElement::BlitScrollChildren(int dx, int dy)
+{
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+
+    UIElement *oldScrollingElement = _blitScrollingElement;
+    _blitScrollingElement          = this;
+
+    // SW_SCROLLCHILDREN通过SetWindowPos移动子窗口，子元素会收到WM_WINDOWPOSCHANGED与WM_MOVE并更新其位置
+    ScrollWindowEx(this->Handle, dx, dy, NULL, NULL, NULL, NULL, SW_SCROLLCHILDREN | SW_INVALIDATE | SW_ERASE);
+
+    for (UIElement *child : this->_children) {
+        if (child->_float) {
+            sw::Rect rect = child->Rect;
+            SetWindowPos(child->Handle, NULL, Dip::DipToPxX(rect.left) - dx, Dip::DipToPxY(rect.top) - dy, 0, 0,
+                         SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOSIZE);
+        } else {
+            child->_lastArrangePixelRect.left += dx;
+            child->_lastArrangePixelRect.top += dy;
+        }
+    }
+
+    _blitScrollingElement = oldScrollingElement;
+}
+
 void sw::UIElement::UpdateChildrenZOrder(bool invalidateMeasure)
 {
     int childCount = (int)this->_children.size();
@@ -1010,6 +1134,59 @@ void sw::UIElement::OnMinMaxSizeChanged()
     this->InvalidateMeasure();
 }
 
+bool sw::UIElement::CanArrangeChildInPlace()
+{
+    return true;
+}
+
+void sw::UIElement::OnArrangeCommitted()
+{
+}
+
+void sw::UIElement::QueueArrangeCommitted()
+{
+    if (!WindowPositioner::IsInBatch()) {
+        this->OnArrangeCommitted();
+    } else if (!this->_arrangeCommittedQueued) {
+        this->_arrangeCommittedQueued = true;
+        _arrangeCommittedQueue.push_back(this);
+    }
+}
+
+void sw::UIElement::BeginArrangeBatch()
+{
+    WindowPositioner::BeginBatch();
+}
+
+void sw::UIElement::EndArrangeBatch()
+{
+    if (WindowPositioner::GetBatchDepth() != 1) {
+        WindowPositioner::EndBatch();
+        return;
+    }
+
+    // 提交期间窗口会收到WM_SIZE等消息，OnSize和OnMove据此判断是否为Arrange造成的改变
+    _isCommittingArrange = true;
+    WindowPositioner::EndBatch();
+    _isCommittingArrange = false;
+
+    // OnArrangeCommitted中可能开始新的批次，新登记的元素由外层循环继续处理
+    if (_isRunningArrangeCommitted) {
+        return;
+    }
+
+    _isRunningArrangeCommitted = true;
+    for (size_t i = 0; i < _arrangeCommittedQueue.size(); ++i) {
+        UIElement *element = _arrangeCommittedQueue[i];
+        if (element != nullptr) {
+            element->_arrangeCommittedQueued = false;
+            element->OnArrangeCommitted();
+        }
+    }
+    _arrangeCommittedQueue.clear();
+    _isRunningArrangeCommitted = false;
+}
+
 bool sw::UIElement::OnRoutedEvent(RoutedEventArgs &eventArgs, const RoutedEventHandler &handler)
 {
     return false;
@@ -1059,8 +1236,12 @@ bool sw::UIElement::SetParent(WndBase *parent)
 
 void sw::UIElement::ParentChanged(WndBase *newParent)
 {
-    this->_parent = newParent ? newParent->ToUIElement() : nullptr;
+    this->_parent      = newParent ? newParent->ToUIElement() : nullptr;
+    this->_hasArranged = false;
     this->_SetMeasureInvalidated();
+
+    // 保存的范围是相对于原来的父元素的，按新的父元素重新计算
+    this->_UpdateExtentInParent(this->Rect);
 }
 
 bool sw::UIElement::OnClose()
@@ -1071,10 +1252,15 @@ bool sw::UIElement::OnClose()
 
 bool sw::UIElement::OnMove(Point newClientPosition)
 {
+    this->_UpdateExtentInParent(this->Rect);
+
     PositionChangedEventArgs args(newClientPosition);
     this->RaiseRoutedEvent(args);
 
-    if (this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::PositionChanged)) {
+    // 父元素滚动内容时子元素的位置随之改变，此时不需要更新布局
+    bool movedByScroll = this->_parent != nullptr && _blitScrollingElement == this->_parent;
+
+    if (this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::PositionChanged) && !this->_IsCommittingOwnArrange() && !movedByScroll) {
         this->InvalidateMeasure();
     }
     return args.handledMsg;
@@ -1089,10 +1275,12 @@ bool sw::UIElement::OnSize(Size newClientSize)
         this->_origionalSize.height = this->Height;
     }
 
+    this->_UpdateExtentInParent(this->Rect);
+
     SizeChangedEventArgs args(newClientSize);
     this->RaiseRoutedEvent(args);
 
-    if (this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::SizeChanged)) {
+    if (this->IsLayoutUpdateConditionSet(sw::LayoutUpdateCondition::SizeChanged) && !this->_IsCommittingOwnArrange()) {
         this->InvalidateMeasure();
     }
     return args.handledMsg;
@@ -1118,6 +1306,7 @@ void sw::UIElement::VisibleChanged(bool newVisible)
 {
     if (this->_parent && this->_collapseWhenHide) {
         this->_parent->_UpdateLayoutVisibleChildren();
+        this->_parent->InvalidateMeasure(); // 参与布局的子元素改变，需要更新父元素的布局
     }
     if (newVisible || this->_collapseWhenHide) {
         this->InvalidateMeasure(); // visible变为true，或者需要折叠隐藏时，更新布局
@@ -1261,17 +1450,16 @@ bool sw::UIElement::OnColor(HDC hdc, HBRUSH &hRetBrush)
     ::SetTextColor(hdc, textColor);
     ::SetBkColor(hdc, backColor);
 
-    if (this->_lastTextColor != textColor ||
-        this->_lastBackColor != backColor) {
-        if (this->_hCtlColorBrush != NULL)
-            DeleteObject(this->_hCtlColorBrush);
+    // 画刷只与背景颜色有关，颜色相同的元素共享同一个画刷
+    if (this->_hCtlColorBrush != NULL && this->_lastBackColor != backColor) {
+        BrushCache::Release(this->_hCtlColorBrush);
         this->_hCtlColorBrush = NULL;
-        this->_lastTextColor  = textColor;
-        this->_lastBackColor  = backColor;
     }
 
-    if (this->_hCtlColorBrush == NULL)
-        this->_hCtlColorBrush = CreateSolidBrush(backColor);
+    if (this->_hCtlColorBrush == NULL) {
+        this->_hCtlColorBrush = BrushCache::Acquire(backColor);
+        this->_lastBackColor  = backColor;
+    }
 
     hRetBrush = this->_hCtlColorBrush;
     return true;
@@ -1331,10 +1519,50 @@ bool sw::UIElement::_SetVertAlignment(sw::VerticalAlignment value)
 void sw::UIElement::_SetMeasureInvalidated()
 {
     this->_layoutUpdateCondition |= sw::LayoutUpdateCondition::MeasureInvalidated;
+    this->_measureCache.Clear();
+}
+
+void sw::UIElement::_MeasureCore(const Size &availableSize)
+{
+    Size measureSize    = availableSize;
+    Thickness &margin   = this->_margin;
+    sw::Rect windowRect = this->Rect;
+    sw::Rect clientRect = this->ClientRect;
+
+    // 考虑边框
+    measureSize.width -= (windowRect.width - clientRect.width) + margin.left + margin.right;
+    measureSize.height -= (windowRect.height - clientRect.height) + margin.top + margin.bottom;
+
+    // 由子类实现MeasureOverride函数来计算内容所需的尺寸
+    this->_desireSize = this->MeasureOverride(measureSize);
+    this->_desireSize.width += windowRect.width - clientRect.width;
+    this->_desireSize.height += windowRect.height - clientRect.height;
+
+    // 限制尺寸在最小和最大尺寸之间
+    this->ClampDesireSize(this->_desireSize);
+    this->_desireSize.width += margin.left + margin.right;
+    this->_desireSize.height += margin.top + margin.bottom;
+
+    // 更新_lastMeasureAvailableSize并记录结果
+    this->_lastMeasureAvailableSize = availableSize;
+    this->_lastMeasureOverrideSize  = availableSize;
+    this->_measureCache.Add(availableSize, this->_desireSize);
+}
+
+bool sw::UIElement::_IsCommittingOwnArrange()
+{
+    if (!_isCommittingArrange) {
+        return false;
+    }
+
+    return _DipRectToPixelRect(this->Rect) == this->_lastArrangePixelRect;
 }
 
 void sw::UIElement::_UpdateLayoutVisibleChildren()
 {
+    // 参与布局的子元素改变后，之前的测量结果和子元素的范围不再可靠
+    this->_measureCache.Clear();
+    this->_childExtentInvalid = true;
     this->_layoutVisibleChildren.clear();
 
     for (UIElement *item : this->_children) {
@@ -1343,6 +1571,74 @@ void sw::UIElement::_UpdateLayoutVisibleChildren()
     }
 }
 
+void sw::UIElement::_UpdateChildExtent()
+{
+    if (this->_childExtentInvalid) {
+        this->_childExtentInvalid = false;
+        this->_childRightmost     = 0;
+        this->_childBottommost    = 0;
+
+        // 子元素的范围在其加入、移动或安排时已更新，此处只需遍历保存的值，无需再读取窗口位置
+        for (UIElement *item : this->_layoutVisibleChildren) {
+            if (item->_float) continue;
+            this->_childRightmost  = Utils::Max(this->_childRightmost, item->_extentRight);
+            this->_childBottommost = Utils::Max(this->_childBottommost, item->_extentBottom);
+        }
+        return;
+    }
+
+#if SW_VERIFY_CHILD_EXTENT
+    // 批次中窗口的位置尚未提交，此时无法通过遍历子元素得到安排后的范围
+    if (WindowPositioner::IsInBatch()) {
+        return;
+    }
+
+    double rightmost  = 0;
+    double bottommost = 0;
+    for (UIElement *item : this->_layoutVisibleChildren) {
+        if (item->_float) continue;
+        rightmost  = Utils::Max(rightmost, item->Left + item->Width + item->_margin.right - this->_arrangeOffsetX);
+        bottommost = Utils::Max(bottommost, item->Top + item->Height + item->_margin.bottom - this->_arrangeOffsetY);
+    }
+    assert(std::abs(rightmost - this->_childRightmost) < 1e-6 && "incremental child extent is out of date");
+    assert(std::abs(bottommost - this->_childBottommost) < 1e-6 && "incremental child extent is out of date");
+#endif
+}
+
+void sw::UIElement::_UpdateExtentInParent(const sw::Rect &rect)
+{
+    UIElement *parent = this->_parent;
+
+    if (parent == nullptr) {
+        return;
+    }
+
+    double oldRight  = this->_extentRight;
+    double oldBottom = this->_extentBottom;
+
+    // 悬浮或不参与布局的元素同样保存范围，父元素重新遍历子元素时直接使用保存的值
+    this->_extentRight  = rect.left + rect.width + this->_margin.right - parent->_arrangeOffsetX;
+    this->_extentBottom = rect.top + rect.height + this->_margin.bottom - parent->_arrangeOffsetY;
+
+    // 父元素需要重新遍历时无需增量更新，悬浮或不参与布局的元素不计入父元素的范围
+    if (parent->_childExtentInvalid || this->_float || (this->_collapseWhenHide && !this->Visible)) {
+        return;
+    }
+
+    // 范围扩大时直接更新最大值，原本位于最大值处的元素缩小时最大值可能来自其他元素，需要重新遍历
+    if (this->_extentRight >= parent->_childRightmost) {
+        parent->_childRightmost = this->_extentRight;
+    } else if (oldRight >= parent->_childRightmost) {
+        parent->_childExtentInvalid = true;
+    }
+
+    if (this->_extentBottom >= parent->_childBottommost) {
+        parent->_childBottommost = this->_extentBottom;
+    } else if (oldBottom >= parent->_childBottommost) {
+        parent->_childExtentInvalid = true;
+    }
+}
+
 sw::UIElement *sw::UIElement::_GetNextElement(UIElement *element, bool searchChildren)
 {
     if (searchChildren && !element->_children.empty()) {
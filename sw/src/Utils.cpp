@@ -1,6 +1,17 @@
 #include "Utils.h"
-#include <Windows.h>
 #include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#if defined(_WIN32)
 
 std::wstring sw::Utils::ToWideStr(const std::string &str, bool utf8)
 {
@@ -22,6 +33,30 @@ std::string sw::Utils::ToMultiByteStr(const std::wstring &wstr, bool utf8)
     return str;
 }
 
+#else
+
+std::wstring sw::Utils::ToWideStr(const std::string &str, bool utf8)
+{
+    // 非Windows平台下使用当前locale进行转换，utf8参数仅用于保持接口一致
+    size_t size = std::mbstowcs(nullptr, str.c_str(), 0);
+    if (size == static_cast<size_t>(-1)) return std::wstring();
+    std::wstring wstr(size, L'\0');
+    std::mbstowcs(&wstr[0], str.c_str(), size);
+    return wstr;
+}
+
+std::string sw::Utils::ToMultiByteStr(const std::wstring &wstr, bool utf8)
+{
+    // 非Windows平台下使用当前locale进行转换，utf8参数仅用于保持接口一致
+    size_t size = std::wcstombs(nullptr, wstr.c_str(), 0);
+    if (size == static_cast<size_t>(-1)) return std::string();
+    std::string str(size, '\0');
+    std::wcstombs(&str[0], wstr.c_str(), size);
+    return str;
+}
+
+#endif
+
 std::wstring sw::Utils::Trim(const std::wstring &str)
 {
     size_t firstNonSpace = str.find_first_not_of(L" \t\n\r\f\v");
@@ -80,13 +115,71 @@ std::wstring sw::Utils::FormatStr(const wchar_t *fmt, ...)
     va_list args;
 
     va_start(args, fmt);
-    size_t len = std::vswprintf(nullptr, 0, fmt, args);
+    int len = std::vswprintf(nullptr, 0, fmt, args);
     va_end(args);
 
-    std::wstring result(len + 1, L'\0');
-    va_start(args, fmt);
-    result.resize(std::vswprintf(&result[0], result.size(), fmt, args));
-    va_end(args);
+    if (len >= 0) {
+        std::wstring result(len + 1, L'\0');
+        va_start(args, fmt);
+        result.resize(std::vswprintf(&result[0], result.size(), fmt, args));
+        va_end(args);
+        return result;
+    }
+
+    // 标准的vswprintf在缓冲区不足时返回负数而不是所需的长度，此时逐步增大缓冲区
+    for (size_t size = 256; size <= 0x100000; size *= 2) {
+        std::wstring result(size, L'\0');
+        va_start(args, fmt);
+        len = std::vswprintf(&result[0], size, fmt, args);
+        va_end(args);
+        if (len >= 0) {
+            result.resize(len);
+            return result;
+        }
+    }
+    return std::wstring();
+}
 
+std::wstring sw::Utils::ToJsonStr(const std::wstring &str)
+{
+    std::wstring result;
+    result.reserve(str.size() + 2);
+
+    result += L'"';
+    for (wchar_t c : str) {
+        switch (c) {
+            case L'"': result += L"\\\""; break;
+            case L'\\': result += L"\\\\"; break;
+            case L'\n': result += L"\\n"; break;
+            case L'\r': result += L"\\r"; break;
+            case L'\t': result += L"\\t"; break;
+            default: {
+                if ((unsigned)c < 0x20) {
+                    result += FormatStr(L"\\u%04x", (unsigned)c);
+                } else {
+                    result += c;
+                }
+                break;
+            }
+        }
+    }
+    result += L'"';
     return result;
 }
+
+std::wstring sw::Utils::GetTypeDisplayName(const char *name)
+{
+    if (name == nullptr) return std::wstring();
+    if (std::strncmp(name, "class ", 6) == 0) return ToWideStr(name + 6);
+    if (std::strncmp(name, "struct ", 7) == 0) return ToWideStr(name + 7);
+#if defined(__GNUC__)
+    int status      = 0;
+    char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (demangled != nullptr) {
+        std::wstring result = ToWideStr(status == 0 ? demangled : name);
+        std::free(demangled);
+        return result;
+    }
+#endif
+    return ToWideStr(name);
+}
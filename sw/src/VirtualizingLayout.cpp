@@ -0,0 +1,150 @@
+#include "VirtualizingLayout.h"
+#include "Utils.h"
+#include <cmath>
+
+sw::Size sw::VirtualizingLayout::MeasureOverride(const Size &availableSize)
+{
+    Point offset = this->getViewportOffset ? this->getViewportOffset() : Point();
+    this->GetRealizedRange(availableSize, offset, this->_first, this->_last);
+
+    if (this->realizeItems) {
+        this->realizeItems(this->_first, this->_last);
+    }
+
+    Size slotSize  = this->_GetSlotSize(availableSize);
+    int childCount = this->GetChildLayoutCount();
+
+    for (int i = 0; i < childCount; ++i) {
+        ILayout &item = this->GetChildLayoutAt(i);
+        item.Measure(this->GetItemIndexOfChild(i) >= 0 ? slotSize : Size());
+    }
+
+    return this->GetExtent(availableSize);
+}
+
+void sw::VirtualizingLayout::ArrangeOverride(const Size &finalSize)
+{
+    int childCount = this->GetChildLayoutCount();
+
+    for (int i = 0; i < childCount; ++i) {
+        ILayout &item = this->GetChildLayoutAt(i);
+        int index     = this->GetItemIndexOfChild(i);
+        item.Arrange(index >= 0 ? this->GetItemRect(index, finalSize) : Rect());
+    }
+}
+
+void sw::VirtualizingLayout::GetRealizedRange(const Size &viewportSize, const Point &offset, int &first, int &last)
+{
+    first = last = 0;
+
+    if (this->itemCount <= 0) {
+        return;
+    }
+
+    bool vertical = this->_IsVerticalScroll();
+    int perLine   = this->_GetItemsPerLine(viewportSize);
+    int lineCount = (this->itemCount + perLine - 1) / perLine;
+
+    double viewportLength = vertical ? viewportSize.height : viewportSize.width;
+
+    if (std::isinf(viewportLength)) {
+        // 视口无限大时无法虚拟化，实现所有项
+        last = this->itemCount;
+        return;
+    }
+
+    Size slotSize     = this->_GetSlotSize(viewportSize);
+    double lineLength = Utils::Max(vertical ? slotSize.height : slotSize.width, 1.0);
+    double start      = Utils::Max(vertical ? offset.y : offset.x, 0.0);
+
+    int firstLine = int(std::floor(start / lineLength)) - this->overscan;
+    int lastLine  = int(std::ceil((start + viewportLength) / lineLength)) + this->overscan;
+
+    firstLine = Utils::Min(Utils::Max(firstLine, 0), lineCount);
+    lastLine  = Utils::Min(Utils::Max(lastLine, firstLine), lineCount);
+
+    first = firstLine * perLine;
+    last  = Utils::Min(lastLine * perLine, this->itemCount);
+}
+
+sw::Rect sw::VirtualizingLayout::GetItemRect(int index, const Size &viewportSize)
+{
+    int perLine   = this->_GetItemsPerLine(viewportSize);
+    Size slotSize = this->_GetSlotSize(viewportSize);
+
+    int line   = index / perLine;
+    int column = index % perLine;
+
+    return this->_IsVerticalScroll()
+               ? Rect(column * slotSize.width, line * slotSize.height, slotSize.width, slotSize.height)
+               : Rect(line * slotSize.width, column * slotSize.height, slotSize.width, slotSize.height);
+}
+
+sw::Size sw::VirtualizingLayout::GetExtent(const Size &viewportSize)
+{
+    if (this->itemCount <= 0) {
+        return Size();
+    }
+
+    int perLine   = this->_GetItemsPerLine(viewportSize);
+    int lineCount = (this->itemCount + perLine - 1) / perLine;
+    int columns   = Utils::Min(perLine, this->itemCount);
+    Size slotSize = this->_GetSlotSize(viewportSize);
+
+    return this->_IsVerticalScroll()
+               ? Size(columns * slotSize.width, lineCount * slotSize.height)
+               : Size(lineCount * slotSize.width, columns * slotSize.height);
+}
+
+int sw::VirtualizingLayout::GetItemIndexOfChild(int childIndex)
+{
+    int childCount = this->GetChildLayoutCount();
+
+    if (childCount <= 0 || this->_first >= this->_last) {
+        return -1;
+    }
+
+    int index = this->_first + (childIndex - this->_first % childCount + childCount) % childCount;
+    return index < this->_last ? index : -1;
+}
+
+bool sw::VirtualizingLayout::_IsVerticalScroll()
+{
+    // StackLayout按排列方向滚动，WrapLayout按换行的方向滚动
+    return this->wrap
+               ? this->orientation == Orientation::Horizontal
+               : this->orientation == Orientation::Vertical;
+}
+
+int sw::VirtualizingLayout::_GetItemsPerLine(const Size &viewportSize)
+{
+    if (!this->wrap) {
+        return 1;
+    }
+
+    bool vertical     = this->_IsVerticalScroll();
+    double lineLength = vertical ? viewportSize.width : viewportSize.height;
+    double itemLength = vertical ? this->itemSize.width : this->itemSize.height;
+
+    if (std::isinf(lineLength) || itemLength <= 0) {
+        return Utils::Max(this->itemCount, 1);
+    }
+    return Utils::Max(int(lineLength / itemLength), 1);
+}
+
+sw::Size sw::VirtualizingLayout::_GetSlotSize(const Size &viewportSize)
+{
+    Size slotSize = this->itemSize;
+
+    if (!this->wrap) {
+        // 与StackLayout相同，项在排列方向的垂直方向上拉伸
+        if (this->_IsVerticalScroll()) {
+            if (!std::isinf(viewportSize.width))
+                slotSize.width = Utils::Max(slotSize.width, viewportSize.width);
+        } else {
+            if (!std::isinf(viewportSize.height))
+                slotSize.height = Utils::Max(slotSize.height, viewportSize.height);
+        }
+    }
+    return slotSize;
+}
@@ -0,0 +1,177 @@
+#include "VirtualizingPanel.h"
+#include "Utils.h"
+#include <algorithm>
+
+sw::VirtualizingPanel::VirtualizingPanel()
+    : ItemCount(
+          // get
+          [this]() -> int {
+              return this->_virtualizingLayout.itemCount;
+          },
+          // set
+          [this](const int &value) {
+              int count = Utils::Max(value, 0);
+              if (this->_virtualizingLayout.itemCount != count) {
+                  this->_virtualizingLayout.itemCount = count;
+                  this->_ResetContainerItems();
+                  this->InvalidateMeasure();
+              }
+          }),
+
+      ItemSize(
+          // get
+          [this]() -> sw::Size {
+              return this->_virtualizingLayout.itemSize;
+          },
+          // set
+          [this](const sw::Size &value) {
+              if (this->_virtualizingLayout.itemSize != value) {
+                  this->_virtualizingLayout.itemSize = value;
+                  this->InvalidateMeasure();
+              }
+          }),
+
+      Overscan(
+          // get
+          [this]() -> int {
+              return this->_virtualizingLayout.overscan;
+          },
+          // set
+          [this](const int &value) {
+              int overscan = Utils::Max(value, 0);
+              if (this->_virtualizingLayout.overscan != overscan) {
+                  this->_virtualizingLayout.overscan = overscan;
+                  this->InvalidateMeasure();
+              }
+          })
+{
+    this->_virtualizingLayout.getViewportOffset = [this]() -> Point {
+        return Point(-this->GetInternalArrangeOffsetX(), -this->GetInternalArrangeOffsetY());
+    };
+    this->_virtualizingLayout.realizeItems = [this](int first, int last) {
+        this->_RealizeItems(first, last);
+    };
+
+    this->_virtualizingLayout.Associate(this);
+    this->HorizontalAlignment = HorizontalAlignment::Stretch;
+    this->VerticalAlignment   = VerticalAlignment::Stretch;
+}
+
+sw::VirtualizingPanel::~VirtualizingPanel()
+{
+    for (UIElement *container : this->_containers) {
+        delete container;
+    }
+}
+
+void sw::VirtualizingPanel::RefreshItems()
+{
+    this->_ResetContainerItems();
+    this->InvalidateMeasure();
+}
+
+void sw::VirtualizingPanel::ScrollIntoView(int index)
+{
+    if (index < 0 || index >= this->_virtualizingLayout.itemCount) {
+        return;
+    }
+
+    // 项的位置可以直接计算，不需要等待布局更新，但需要先确保滚动范围已包含该项
+    this->UpdateScrollRange();
+
+    Size clientSize = this->ClientRect->GetSize();
+    sw::Rect rect   = this->_virtualizingLayout.GetItemRect(index, clientSize);
+
+    if (this->VerticalScrollBar) {
+        double curPos = this->VerticalScrollPos;
+        if (rect.top < curPos) {
+            this->VerticalScrollPos = rect.top;
+        } else if (rect.top + rect.height > curPos + clientSize.height) {
+            this->VerticalScrollPos = rect.top + rect.height - clientSize.height;
+        }
+    }
+
+    if (this->HorizontalScrollBar) {
+        double curPos = this->HorizontalScrollPos;
+        if (rect.left < curPos) {
+            this->HorizontalScrollPos = rect.left;
+        } else if (rect.left + rect.width > curPos + clientSize.width) {
+            this->HorizontalScrollPos = rect.left + rect.width - clientSize.width;
+        }
+    }
+}
+
+sw::VirtualizingLayout &sw::VirtualizingPanel::GetVirtualizingLayout()
+{
+    return this->_virtualizingLayout;
+}
+
+sw::LayoutHost *sw::VirtualizingPanel::GetDefaultLayout()
+{
+    return &this->_virtualizingLayout;
+}
+
+double sw::VirtualizingPanel::GetScrollExtent(ScrollOrientation orientation)
+{
+    Size extent = this->_virtualizingLayout.GetExtent(this->ClientRect->GetSize());
+    return orientation == ScrollOrientation::Horizontal ? extent.width : extent.height;
+}
+
+void sw::VirtualizingPanel::OnAddedChild(UIElement &element)
+{
+    // 容器在测量过程中添加，添加后会立即参与本次布局
+    if (!this->_addingContainers) {
+        this->Panel::OnAddedChild(element);
+    }
+}
+
+void sw::VirtualizingPanel::_RealizeItems(int first, int last)
+{
+    int count = last - first;
+
+    if (count > (int)this->_containers.size() && this->CreateContainer) {
+        this->_addingContainers = true;
+
+        while ((int)this->_containers.size() < count) {
+            UIElement *container = this->CreateContainer();
+            if (container == nullptr) {
+                break;
+            }
+            if (!this->AddChild(container)) {
+                delete container;
+                break;
+            }
+            this->_containers.push_back(container);
+        }
+
+        this->_addingContainers = false;
+
+        // 项与容器的对应关系依赖容器的数量，数量改变后所有容器都需要重新绑定
+        this->_containerItems.resize(this->_containers.size());
+        this->_ResetContainerItems();
+    }
+
+    int containerCount = (int)this->_containers.size();
+    if (containerCount == 0) {
+        return;
+    }
+
+    // 容器创建失败时只绑定前containerCount项，与VirtualizingLayout中子元素与项的对应关系一致
+    last = Utils::Min(last, first + containerCount);
+
+    for (int i = first; i < last; ++i) {
+        int k = i % containerCount;
+        if (this->_containerItems[k] == i) {
+            continue;
+        }
+        this->_containerItems[k] = i;
+        if (this->PrepareContainer) {
+            this->PrepareContainer(*this->_containers[k], i);
+        }
+    }
+}
+
+void sw::VirtualizingPanel::_ResetContainerItems()
+{
+    std::fill(this->_containerItems.begin(), this->_containerItems.end(), -1);
+}
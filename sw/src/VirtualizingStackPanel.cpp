@@ -0,0 +1,16 @@
+#include "VirtualizingStackPanel.h"
+
+sw::VirtualizingStackPanel::VirtualizingStackPanel()
+    : Orientation(
+          // get
+          [this]() -> sw::Orientation {
+              return this->GetVirtualizingLayout().orientation;
+          },
+          // set
+          [this](const sw::Orientation &value) {
+              this->GetVirtualizingLayout().orientation = value;
+              this->InvalidateMeasure();
+          })
+{
+    this->GetVirtualizingLayout().wrap = false;
+}
@@ -0,0 +1,17 @@
+#include "VirtualizingWrapPanel.h"
+
+sw::VirtualizingWrapPanel::VirtualizingWrapPanel()
+    : Orientation(
+          // get
+          [this]() -> sw::Orientation {
+              return this->GetVirtualizingLayout().orientation;
+          },
+          // set
+          [this](const sw::Orientation &value) {
+              this->GetVirtualizingLayout().orientation = value;
+              this->InvalidateMeasure();
+          })
+{
+    this->GetVirtualizingLayout().wrap        = true;
+    this->GetVirtualizingLayout().orientation = sw::Orientation::Horizontal;
+}
@@ -1,4 +1,5 @@
 #include "Window.h"
+#include "FontCache.h"
 #include "Utils.h"
 #include <cmath>
 
@@ -41,19 +42,21 @@ const sw::ReadOnlyProperty<int> sw::Window::WindowCount(
 
 sw::Window::Window()
     : StartupLocation(
+          this,
           // get
-          [this]() -> WindowStartupLocation {
-              return _startupLocation;
+          [](Window *self) -> WindowStartupLocation {
+              return self->_startupLocation;
           },
           // set
-          [this](const WindowStartupLocation &value) {
-              _startupLocation = value;
+          [](Window *self, const WindowStartupLocation &value) {
+              self->_startupLocation = value;
           }),
 
       State(
+          this,
           // get
-          [this]() -> WindowState {
-              HWND hwnd = Handle;
+          [](Window *self) -> WindowState {
+              HWND hwnd = self->Handle;
               if (IsIconic(hwnd)) {
                   return WindowState::Minimized;
               } else if (IsZoomed(hwnd)) {
@@ -63,8 +66,8 @@ sw::Window::Window()
               }
           },
           // set
-          [this](const WindowState &value) {
-              HWND hwnd = Handle;
+          [](Window *self, const WindowState &value) {
+              HWND hwnd = self->Handle;
               switch (value) {
                   case WindowState::Normal:
                       ShowWindow(hwnd, SW_RESTORE);
@@ -79,129 +82,141 @@ sw::Window::Window()
           }),
 
       SizeBox(
+          this,
           // get
-          [this]() -> bool {
-              return GetStyle(WS_SIZEBOX);
+          [](Window *self) -> bool {
+              return self->GetStyle(WS_SIZEBOX);
           },
           // set
-          [this](const bool &value) {
-              SetStyle(WS_SIZEBOX, value);
+          [](Window *self, const bool &value) {
+              self->SetStyle(WS_SIZEBOX, value);
           }),
 
       MaximizeBox(
+          this,
           // get
-          [this]() -> bool {
-              return GetStyle(WS_MAXIMIZEBOX);
+          [](Window *self) -> bool {
+              return self->GetStyle(WS_MAXIMIZEBOX);
           },
           // set
-          [this](const bool &value) {
-              SetStyle(WS_MAXIMIZEBOX, value);
+          [](Window *self, const bool &value) {
+              self->SetStyle(WS_MAXIMIZEBOX, value);
           }),
 
       MinimizeBox(
+          this,
           // get
-          [this]() -> bool {
-              return GetStyle(WS_MINIMIZEBOX);
+          [](Window *self) -> bool {
+              return self->GetStyle(WS_MINIMIZEBOX);
           },
           // set
-          [this](const bool &value) {
-              SetStyle(WS_MINIMIZEBOX, value);
+          [](Window *self, const bool &value) {
+              self->SetStyle(WS_MINIMIZEBOX, value);
           }),
 
       Topmost(
+          this,
           // get
-          [this]() -> bool {
-              return GetExtendedStyle(WS_EX_TOPMOST);
+          [](Window *self) -> bool {
+              return self->GetExtendedStyle(WS_EX_TOPMOST);
           },
           // set
-          [this](const bool &value) {
-              /*SetExtendedStyle(WS_EX_TOPMOST, value);*/
+          [](Window *self, const bool &value) {
+              /*self->SetExtendedStyle(WS_EX_TOPMOST, value);*/
               HWND hWndInsertAfter = value ? HWND_TOPMOST : HWND_NOTOPMOST;
-              SetWindowPos(Handle, hWndInsertAfter, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+              SetWindowPos(self->Handle, hWndInsertAfter, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
           }),
 
       ToolWindow(
+          this,
           // get
-          [this]() -> bool {
-              return GetExtendedStyle(WS_EX_TOOLWINDOW);
+          [](Window *self) -> bool {
+              return self->GetExtendedStyle(WS_EX_TOOLWINDOW);
           },
           // set
-          [this](const bool &value) {
-              SetExtendedStyle(WS_EX_TOOLWINDOW, value);
+          [](Window *self, const bool &value) {
+              self->SetExtendedStyle(WS_EX_TOOLWINDOW, value);
           }),
 
       Menu(
+          this,
           // get
-          [this]() -> sw::Menu * {
-              return _menu;
+          [](Window *self) -> sw::Menu * {
+              return self->_menu;
           },
           // set
-          [this](sw::Menu *value) {
-              _menu = value;
-              SetMenu(Handle, value != nullptr ? value->GetHandle() : NULL);
+          [](Window *self, sw::Menu *const &value) {
+              self->_menu = value;
+              SetMenu(self->Handle, value != nullptr ? value->GetHandle() : NULL);
           }),
 
       IsModal(
+          this,
           // get
-          [this]() -> bool {
-              return _isModal;
+          [](Window *self) -> bool {
+              return self->_isModal;
           }),
 
       Owner(
+          this,
           // get
-          [this]() -> Window * {
-              HWND hOwner = reinterpret_cast<HWND>(GetWindowLongPtrW(Handle, GWLP_HWNDPARENT));
-              return _GetWindowPtr(hOwner);
+          [](Window *self) -> Window * {
+              HWND hOwner = reinterpret_cast<HWND>(GetWindowLongPtrW(self->Handle, GWLP_HWNDPARENT));
+              return Window::_GetWindowPtr(hOwner);
           },
           // set
-          [this](Window *value) {
-              SetWindowLongPtrW(Handle, GWLP_HWNDPARENT, reinterpret_cast<LONG_PTR>(value ? value->Handle.Get() : NULL));
+          [](Window *self, Window *const &value) {
+              SetWindowLongPtrW(self->Handle, GWLP_HWNDPARENT, reinterpret_cast<LONG_PTR>(value ? value->Handle.Get() : NULL));
           }),
 
       IsLayered(
+          this,
           // get
-          [this]() -> bool {
-              return GetExtendedStyle(WS_EX_LAYERED);
+          [](Window *self) -> bool {
+              return self->GetExtendedStyle(WS_EX_LAYERED);
           },
           // set
-          [this](const bool &value) {
-              SetExtendedStyle(WS_EX_LAYERED, value);
+          [](Window *self, const bool &value) {
+              self->SetExtendedStyle(WS_EX_LAYERED, value);
           }),
 
       Opacity(
+          this,
           // get
-          [this]() -> double {
+          [](Window *self) -> double {
               BYTE result;
-              return GetLayeredWindowAttributes(Handle, NULL, &result, NULL) ? (result / 255.0) : 1.0;
+              return GetLayeredWindowAttributes(self->Handle, NULL, &result, NULL) ? (result / 255.0) : 1.0;
           },
           // set
-          [this](const double &value) {
+          [](Window *self, const double &value) {
               double opacity = Utils::Min(1.0, Utils::Max(0.0, value));
-              SetLayeredWindowAttributes(Handle, 0, (BYTE)std::lround(255 * opacity), LWA_ALPHA);
+              SetLayeredWindowAttributes(self->Handle, 0, (BYTE)std::lround(255 * opacity), LWA_ALPHA);
           }),
 
       Borderless(
+          this,
           // get
-          [this]() -> bool {
-              return _isBorderless;
+          [](Window *self) -> bool {
+              return self->_isBorderless;
           },
           // set
-          [this](const bool &value) {
-              if (_isBorderless != value) {
-                  _isBorderless = value;
-                  SetStyle(WS_CAPTION | WS_THICKFRAME, !value);
+          [](Window *self, const bool &value) {
+              if (self->_isBorderless != value) {
+                  self->_isBorderless = value;
+                  self->SetStyle(WS_CAPTION | WS_THICKFRAME, !value);
               }
           }),
 
       DialogResult(
+          this,
           // get
-          [this]() -> int {
-              return _dialogResult;
+          [](Window *self) -> int {
+              return self->_dialogResult;
           },
           // set
-          [this](const int &value) {
-              _dialogResult = value;
-              Close();
+          [](Window *self, const int &value) {
+              self->_dialogResult = value;
+              self->Close();
           })
 {
     InitWindow(L"Window", WS_OVERLAPPEDWINDOW, 0);
@@ -209,6 +224,11 @@ sw::Window::Window()
     SetIcon(_GetWindowDefaultIcon());
 }
 
+sw::Window::~Window()
+{
+    ReleaseBackBuffer();
+}
+
 LRESULT sw::Window::WndProc(const ProcMsg &refMsg)
 {
     switch (refMsg.uMsg) {
@@ -261,6 +281,12 @@ LRESULT sw::Window::WndProc(const ProcMsg &refMsg)
             return 0;
         }
 
+        case WM_DISPLAYCHANGE: {
+            // 颜色深度可能已改变，后台缓冲区需要按新的格式重新创建
+            ReleaseBackBuffer();
+            return WndBase::WndProc(refMsg);
+        }
+
         case WM_DPICHANGED: {
             OnDpiChanged(LOWORD(refMsg.wParam), HIWORD(refMsg.wParam));
             return 0;
@@ -303,6 +329,7 @@ bool sw::Window::OnClose()
 bool sw::Window::OnDestroy()
 {
     RaiseRoutedEvent(Window_Closed);
+    ReleaseBackBuffer();
     return true;
 }
 
@@ -321,24 +348,23 @@ bool sw::Window::OnPaint()
     RECT rtClient;
     GetClientRect(hwnd, &rtClient);
 
-    // 创建内存 DC 和位图
-    HDC hdcMem         = CreateCompatibleDC(hdc);
-    HBITMAP hBitmap    = CreateCompatibleBitmap(hdc, rtClient.right - rtClient.left, rtClient.bottom - rtClient.top);
-    HBITMAP hBitmapOld = (HBITMAP)SelectObject(hdcMem, hBitmap);
-
-    // 在内存 DC 上进行绘制
-    HBRUSH hBrush = CreateSolidBrush(GetRealBackColor());
-    FillRect(hdcMem, &rtClient, hBrush);
+    // 只绘制无效区域，后台缓冲区在窗口的生命周期内复用
+    RECT rtPaint;
+    if (IntersectRect(&rtPaint, &ps.rcPaint, &rtClient) &&
+        _EnsureBackBuffer(hdc, rtClient.right - rtClient.left, rtClient.bottom - rtClient.top)) {
+        int width  = rtPaint.right - rtPaint.left;
+        int height = rtPaint.bottom - rtPaint.top;
 
-    // 将内存 DC 的内容绘制到窗口客户区
-    BitBlt(hdc, 0, 0, rtClient.right - rtClient.left, rtClient.bottom - rtClient.top, hdcMem, 0, 0, SRCCOPY);
+        // 在后台缓冲区上进行绘制
+        SetDCBrushColor(_hdcBackBuffer, GetRealBackColor());
+        FillRect(_hdcBackBuffer, &rtPaint, reinterpret_cast<HBRUSH>(GetStockObject(DC_BRUSH)));
 
-    // 清理资源
-    SelectObject(hdcMem, hBitmapOld);
-    DeleteObject(hBitmap);
-    DeleteObject(hBrush);
-    DeleteDC(hdcMem);
+        // 将无效区域复制到窗口客户区
+        BitBlt(hdc, rtPaint.left, rtPaint.top, width, height, _hdcBackBuffer, rtPaint.left, rtPaint.top, SRCCOPY);
+        _paintStats.bytesBlitted += uint64_t(width) * uint64_t(height) * _backBufferBytesPerPixel;
+    }
 
+    ++_paintStats.paintCount;
     EndPaint(hwnd, &ps);
     return true;
 }
@@ -442,6 +468,9 @@ void sw::Window::OnDpiChanged(int dpiX, int dpiY)
         return item->UpdateFont(), true;
     });
 
+    // 销毁旧DPI下已不再使用的字体句柄
+    FontCache::Trim();
+
     if (!layoutDisabled) {
         EnableLayout();
     }
@@ -550,12 +579,43 @@ void sw::Window::DrawMenuBar()
     ::DrawMenuBar(Handle);
 }
 
+sw::WindowPaintStats sw::Window::GetPaintStats()
+{
+    return _paintStats;
+}
+
+void sw::Window::ResetPaintStats()
+{
+    _paintStats.paintCount          = 0;
+    _paintStats.bytesBlitted        = 0;
+    _paintStats.bufferReallocations = 0;
+}
+
+void sw::Window::ReleaseBackBuffer()
+{
+    if (_hdcBackBuffer != NULL) {
+        SelectObject(_hdcBackBuffer, _hBackBufferOld);
+        DeleteObject(_hBackBuffer);
+        DeleteDC(_hdcBackBuffer);
+    }
+
+    _hdcBackBuffer           = NULL;
+    _hBackBuffer             = NULL;
+    _hBackBufferOld          = NULL;
+    _backBufferBytesPerPixel = 0;
+    _paintStats.bufferWidth  = 0;
+    _paintStats.bufferHeight = 0;
+}
+
 void sw::Window::SizeToContent()
 {
     if (!IsRootElement()) {
         return; // 只对顶级窗口有效
     }
 
+    // 先处理尚未完成的布局更新，保证各元素的所需尺寸是最新的
+    LayoutScheduler::Flush();
+
     // 该函数需要AutoSize为true，这里先备份其值以做后续恢复
     bool oldAutoSize = AutoSize;
     AutoSize         = true;
@@ -589,3 +649,45 @@ HICON sw::Window::_GetWindowDefaultIcon()
     static HICON hIcon = ExtractIconW(App::Instance, App::ExePath->c_str(), 0);
     return hIcon;
 }
+
+bool sw::Window::_EnsureBackBuffer(HDC hdc, int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    int oldWidth  = _paintStats.bufferWidth;
+    int oldHeight = _paintStats.bufferHeight;
+
+    if (_hdcBackBuffer != NULL && width <= oldWidth && height <= oldHeight) {
+        return true;
+    }
+
+    if (_hdcBackBuffer == NULL) {
+        _hdcBackBuffer = CreateCompatibleDC(hdc);
+        if (_hdcBackBuffer == NULL) return false;
+    }
+
+    // 只增长超出的方向，并额外预留1/4，避免拖动调整窗口大小时每次都重新分配
+    int newWidth  = width > oldWidth ? Utils::Max(width, oldWidth + oldWidth / 4) : oldWidth;
+    int newHeight = height > oldHeight ? Utils::Max(height, oldHeight + oldHeight / 4) : oldHeight;
+
+    HBITMAP hBitmap = CreateCompatibleBitmap(hdc, newWidth, newHeight);
+    if (hBitmap == NULL) {
+        return false;
+    }
+
+    HBITMAP hBitmapOld = reinterpret_cast<HBITMAP>(SelectObject(_hdcBackBuffer, hBitmap));
+    if (_hBackBuffer == NULL) {
+        _hBackBufferOld = hBitmapOld;
+    } else {
+        DeleteObject(_hBackBuffer);
+    }
+
+    _hBackBuffer             = hBitmap;
+    _backBufferBytesPerPixel = (GetDeviceCaps(hdc, BITSPIXEL) * GetDeviceCaps(hdc, PLANES) + 7) / 8;
+    _paintStats.bufferWidth  = newWidth;
+    _paintStats.bufferHeight = newHeight;
+    ++_paintStats.bufferReallocations;
+    return true;
+}
@@ -0,0 +1,218 @@
+#include "WindowPositioner.h"
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+namespace
+{
+#if defined(_WIN32)
+    /**
+     * @brief 使用DeferWindowPos合并提交位置改变的窗口定位器
+     */
+    class _DeferWindowPositioner : public sw::IWindowPositioner
+    {
+    private:
+        /**
+         * @brief 当前批次中的位置改变
+         */
+        struct _Entry {
+            HWND hwnd;
+            HWND hwndParent;
+            sw::PixelRect rect;
+        };
+
+        std::vector<_Entry> _entries;
+
+    public:
+        virtual void BeginBatch() override
+        {
+            this->_entries.clear();
+        }
+
+        virtual void Move(void *handle, void *parentHandle, const sw::PixelRect &rect) override
+        {
+            this->_entries.push_back({reinterpret_cast<HWND>(handle), reinterpret_cast<HWND>(parentHandle), rect});
+        }
+
+        virtual void EndBatch() override
+        {
+            // 提交时窗口会收到WM_SIZE等消息，期间可能开始新的批次，因此先将当前批次取出
+            std::vector<_Entry> entries;
+            entries.swap(this->_entries);
+
+            // DeferWindowPos要求同一批窗口的父窗口相同，因此先按父窗口分组，组内保持原有顺序
+            std::stable_sort(
+                entries.begin(), entries.end(),
+                [](const _Entry &a, const _Entry &b) -> bool {
+                    return a.hwndParent < b.hwndParent;
+                });
+
+            size_t count = entries.size();
+
+            for (size_t i = 0; i < count;) {
+                size_t end = i;
+                while (end < count && entries[end].hwndParent == entries[i].hwndParent) {
+                    ++end;
+                }
+
+                HDWP hdwp = end - i > 1 ? BeginDeferWindowPos(int(end - i)) : NULL;
+
+                for (; i < end; ++i) {
+                    _Entry &entry = entries[i];
+                    if (hdwp != NULL) {
+                        // DeferWindowPos失败时会释放hdwp，此时剩余的窗口逐个调用SetWindowPos
+                        hdwp = DeferWindowPos(hdwp, entry.hwnd, NULL,
+                                              entry.rect.left, entry.rect.top, entry.rect.width, entry.rect.height,
+                                              SWP_NOACTIVATE | SWP_NOZORDER);
+                        if (hdwp != NULL) continue;
+                    }
+                    SetWindowPos(entry.hwnd, NULL,
+                                 entry.rect.left, entry.rect.top, entry.rect.width, entry.rect.height,
+                                 SWP_NOACTIVATE | SWP_NOZORDER);
+                }
+
+                if (hdwp != NULL) {
+                    EndDeferWindowPos(hdwp);
+                }
+            }
+        }
+    };
+#endif
+
+    /**
+     * @brief 当前线程使用的窗口定位器，为nullptr时使用默认定位器
+     */
+    thread_local sw::IWindowPositioner *_currentPositioner = nullptr;
+
+    /**
+     * @brief 当前线程批次的嵌套层数
+     */
+    thread_local int _batchDepth = 0;
+
+    /**
+     * @brief 当前线程批次的序号
+     */
+    thread_local uint64_t _batchId = 0;
+}
+
+bool sw::PixelRect::operator==(const PixelRect &other) const
+{
+    return (this->left == other.left) &&
+           (this->top == other.top) &&
+           (this->width == other.width) &&
+           (this->height == other.height);
+}
+
+bool sw::PixelRect::operator!=(const PixelRect &other) const
+{
+    return !this->operator==(other);
+}
+
+void sw::RecordingWindowPositioner::BeginBatch()
+{
+    if (this->next != nullptr) {
+        this->next->BeginBatch();
+    }
+}
+
+void sw::RecordingWindowPositioner::Move(void *handle, void *parentHandle, const PixelRect &rect)
+{
+    this->records.push_back({handle, parentHandle, rect, this->batchCount});
+
+    if (this->next != nullptr) {
+        this->next->Move(handle, parentHandle, rect);
+    }
+}
+
+void sw::RecordingWindowPositioner::EndBatch()
+{
+    ++this->batchCount;
+
+    if (this->next != nullptr) {
+        this->next->EndBatch();
+    }
+}
+
+int sw::RecordingWindowPositioner::GetMoveCount(int batch) const
+{
+    return (int)std::count_if(
+        this->records.begin(), this->records.end(),
+        [batch](const Record &record) -> bool {
+            return record.batch == batch;
+        });
+}
+
+void sw::RecordingWindowPositioner::Clear()
+{
+    this->records.clear();
+    this->batchCount = 0;
+}
+
+sw::IWindowPositioner *sw::WindowPositioner::GetDefault()
+{
+#if defined(_WIN32)
+    static thread_local _DeferWindowPositioner positioner;
+    return &positioner;
+#else
+    return nullptr;
+#endif
+}
+
+sw::IWindowPositioner *sw::WindowPositioner::GetCurrent()
+{
+    return _currentPositioner != nullptr ? _currentPositioner : GetDefault();
+}
+
+void sw::WindowPositioner::SetCurrent(IWindowPositioner *positioner)
+{
+    _currentPositioner = positioner;
+}
+
+void sw::WindowPositioner::BeginBatch()
+{
+    if (_batchDepth++ == 0) {
+        ++_batchId;
+        IWindowPositioner *positioner = GetCurrent();
+        if (positioner != nullptr) positioner->BeginBatch();
+    }
+}
+
+bool sw::WindowPositioner::EndBatch()
+{
+    if (_batchDepth == 0 || --_batchDepth != 0) {
+        return false;
+    }
+
+    IWindowPositioner *positioner = GetCurrent();
+    if (positioner != nullptr) positioner->EndBatch();
+    return true;
+}
+
+bool sw::WindowPositioner::IsInBatch()
+{
+    return _batchDepth != 0;
+}
+
+int sw::WindowPositioner::GetBatchDepth()
+{
+    return _batchDepth;
+}
+
+uint64_t sw::WindowPositioner::GetBatchId()
+{
+    return _batchId;
+}
+
+void sw::WindowPositioner::Move(void *handle, void *parentHandle, const PixelRect &rect)
+{
+    if (_batchDepth != 0) {
+        IWindowPositioner *positioner = GetCurrent();
+        if (positioner != nullptr) positioner->Move(handle, parentHandle, rect);
+    } else {
+        BeginBatch();
+        Move(handle, parentHandle, rect);
+        EndBatch();
+    }
+}
@@ -0,0 +1,709 @@
+#include "WindowlessElement.h"
+#include "Dip.h"
+#include "LayoutProfiler.h"
+#include "Utils.h"
+#include "WindowlessHost.h"
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+namespace
+{
+    /**
+     * @brief 未注册处理函数时传给OnRoutedEvent的空处理函数
+     */
+    const sw::WindowlessEventHandler _emptyWindowlessEventHandler;
+
+    /**
+     * @brief 判断两个尺寸值是否相同，两者均为NaN时视为相同
+     */
+    bool _IsSameLength(double a, double b)
+    {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+
+    /**
+     * @brief 判断矩形是否包含点，右边与底边不计入矩形
+     */
+    bool _RectContains(const sw::Rect &rect, const sw::Point &point)
+    {
+        return point.x >= rect.left && point.x < rect.left + rect.width &&
+               point.y >= rect.top && point.y < rect.top + rect.height;
+    }
+}
+
+constexpr int sw::WindowlessElement::SpatialIndexThreshold;
+
+sw::WindowlessElement::WindowlessElement()
+    : Margin(
+          this,
+          // get
+          [](WindowlessElement *self) -> sw::Thickness {
+              return self->_margin;
+          },
+          // set
+          [](WindowlessElement *self, const sw::Thickness &value) {
+              if (self->_margin != value) {
+                  self->_margin = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      HorizontalAlignment(
+          this,
+          // get
+          [](WindowlessElement *self) -> sw::HorizontalAlignment {
+              return self->_horizontalAlignment;
+          },
+          // set
+          [](WindowlessElement *self, const sw::HorizontalAlignment &value) {
+              if (self->_horizontalAlignment != value) {
+                  self->_horizontalAlignment = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      VerticalAlignment(
+          this,
+          // get
+          [](WindowlessElement *self) -> sw::VerticalAlignment {
+              return self->_verticalAlignment;
+          },
+          // set
+          [](WindowlessElement *self, const sw::VerticalAlignment &value) {
+              if (self->_verticalAlignment != value) {
+                  self->_verticalAlignment = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      Width(
+          this,
+          // get
+          [](WindowlessElement *self) -> double {
+              return self->_width;
+          },
+          // set
+          [](WindowlessElement *self, const double &value) {
+              if (!_IsSameLength(self->_width, value)) {
+                  self->_width = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      Height(
+          this,
+          // get
+          [](WindowlessElement *self) -> double {
+              return self->_height;
+          },
+          // set
+          [](WindowlessElement *self, const double &value) {
+              if (!_IsSameLength(self->_height, value)) {
+                  self->_height = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      Visible(
+          this,
+          // get
+          [](WindowlessElement *self) -> bool {
+              return self->_visible;
+          },
+          // set
+          [](WindowlessElement *self, const bool &value) {
+              if (self->_visible != value) {
+                  self->_visible = value;
+                  if (self->_parent != nullptr) {
+                      self->_parent->_UpdateLayoutVisibleChildren();
+                      self->_parent->_childIndexValid = false;
+                  }
+                  self->OnVisibleChanged();
+                  self->Redraw();
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      IsHitTestVisible(
+          this,
+          // get
+          [](WindowlessElement *self) -> bool {
+              return self->_hitTestVisible;
+          },
+          // set
+          [](WindowlessElement *self, const bool &value) {
+              self->_hitTestVisible = value;
+          }),
+
+      LayoutTag(
+          this,
+          // get
+          [](WindowlessElement *self) -> uint64_t {
+              return self->_layoutTag;
+          },
+          // set
+          [](WindowlessElement *self, const uint64_t &value) {
+              if (self->_layoutTag != value) {
+                  self->_layoutTag = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      Bounds(
+          this,
+          // get
+          [](WindowlessElement *self) -> sw::Rect {
+              return self->_bounds;
+          }),
+
+      Parent(
+          this,
+          // get
+          [](WindowlessElement *self) -> WindowlessElement * {
+              return self->_parent;
+          }),
+
+      Host(
+          this,
+          // get
+          [](WindowlessElement *self) -> WindowlessHost * {
+              return self->_host;
+          }),
+
+      ChildCount(
+          this,
+          // get
+          [](WindowlessElement *self) -> int {
+              return (int)self->_children.size();
+          })
+{
+}
+
+sw::WindowlessElement::~WindowlessElement()
+{
+    if (this->_parent != nullptr) {
+        this->_parent->RemoveChild(this);
+    }
+
+    for (WindowlessElement *child : this->_children) {
+        child->_parent = nullptr;
+        child->_SetHost(nullptr);
+    }
+    this->_children.clear();
+    this->_layoutVisibleChildren.clear();
+
+    // 作为宿主的内容时需通知宿主，析构期间不再调用派生类的OnHostChanged
+    this->_SetHost(nullptr);
+}
+
+bool sw::WindowlessElement::AddChild(WindowlessElement *element)
+{
+    if (element == nullptr || element->_parent != nullptr) {
+        return false;
+    }
+
+    // 不能添加宿主的内容或当前元素的祖先元素
+    if (element->_host != nullptr) {
+        return false;
+    }
+    for (WindowlessElement *item = this; item != nullptr; item = item->_parent) {
+        if (item == element) return false;
+    }
+
+    this->_children.push_back(element);
+    if (element->_visible) {
+        this->_layoutVisibleChildren.push_back(element);
+    }
+
+    element->_parent       = this;
+    this->_childIndexValid = false;
+    element->_SetHost(this->_host);
+    this->InvalidateMeasure();
+    return true;
+}
+
+bool sw::WindowlessElement::AddChild(WindowlessElement &element)
+{
+    return this->AddChild(&element);
+}
+
+bool sw::WindowlessElement::RemoveChild(WindowlessElement *element)
+{
+    if (element == nullptr) {
+        return false;
+    }
+
+    auto it = std::find(this->_children.begin(), this->_children.end(), element);
+    if (it == this->_children.end()) {
+        return false;
+    }
+
+    element->Redraw();
+    this->_children.erase(it);
+
+    auto itVisible = std::find(this->_layoutVisibleChildren.begin(), this->_layoutVisibleChildren.end(), element);
+    if (itVisible != this->_layoutVisibleChildren.end()) {
+        this->_layoutVisibleChildren.erase(itVisible);
+    }
+
+    element->_parent       = nullptr;
+    this->_childIndexValid = false;
+    element->_SetHost(nullptr);
+    this->InvalidateMeasure();
+    return true;
+}
+
+bool sw::WindowlessElement::RemoveChild(WindowlessElement &element)
+{
+    return this->RemoveChild(&element);
+}
+
+void sw::WindowlessElement::ClearChildren()
+{
+    if (this->_children.empty()) {
+        return;
+    }
+
+    for (WindowlessElement *child : this->_children) {
+        child->_parent = nullptr;
+        child->_SetHost(nullptr);
+    }
+    this->_children.clear();
+    this->_layoutVisibleChildren.clear();
+    this->_childIndexValid = false;
+
+    this->Redraw();
+    this->InvalidateMeasure();
+}
+
+int sw::WindowlessElement::IndexOf(WindowlessElement &element)
+{
+    auto it = std::find(this->_children.begin(), this->_children.end(), &element);
+    return it == this->_children.end() ? -1 : int(it - this->_children.begin());
+}
+
+sw::WindowlessElement &sw::WindowlessElement::operator[](int index) const
+{
+    return *this->_children[index];
+}
+
+void sw::WindowlessElement::AddHandler(RoutedEventType eventType, const WindowlessEventHandler &handler)
+{
+    if (handler) this->_eventTable.GetOrAdd(eventType) += handler;
+}
+
+bool sw::WindowlessElement::RemoveHandler(RoutedEventType eventType, const WindowlessEventHandler &handler)
+{
+    if (handler == nullptr) {
+        return false;
+    }
+    WindowlessEventHandler *eventHandler = this->_eventTable.Find(eventType);
+    return eventHandler != nullptr && eventHandler->Remove(handler);
+}
+
+void sw::WindowlessElement::RemoveAllHandlers(RoutedEventType eventType)
+{
+    // 不移除表项，处理函数可能正在执行
+    WindowlessEventHandler *eventHandler = this->_eventTable.Find(eventType);
+    if (eventHandler != nullptr) *eventHandler = nullptr;
+}
+
+bool sw::WindowlessElement::RaiseRoutedEvent(RoutedEventArgs &eventArgs)
+{
+    // 路由事件参数中的事件源为UIElement，无窗口元素的事件以宿主作为事件源
+    eventArgs.originalSource = this->_host;
+
+    if (eventArgs.source == nullptr) {
+        eventArgs.source = this->_host;
+    }
+
+    // 查找处理函数的方式与UIElement::RaiseRoutedEvent相同，宿主分发的鼠标事件未被处理时由宿主继续向上传递
+    for (WindowlessElement *element = this; element != nullptr; element = element->_parent) {
+        WindowlessEventHandler *handler = element->_eventTable.Find(eventArgs.eventType);
+        if (!element->OnRoutedEvent(eventArgs, handler != nullptr ? *handler : _emptyWindowlessEventHandler)) {
+            if (handler != nullptr && *handler) (*handler)(*element, eventArgs);
+        }
+        if (eventArgs.handled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+sw::WindowlessElement *sw::WindowlessElement::HitTest(const Point &point)
+{
+    // 点不在子树的范围内时无需继续查找
+    if (!this->_visible || !_RectContains(this->_extent, point)) {
+        return nullptr;
+    }
+
+    // 后添加的子元素绘制在上层，因此从后往前查找
+    if (this->_childIndex != nullptr && this->_childIndexValid) {
+        std::vector<int> candidates;
+        this->_childIndex->QueryPoint(point, candidates);
+        for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+            WindowlessElement *result = this->_children[*it]->HitTest(point);
+            if (result != nullptr) return result;
+        }
+    } else {
+        for (auto it = this->_children.rbegin(); it != this->_children.rend(); ++it) {
+            WindowlessElement *result = (*it)->HitTest(point);
+            if (result != nullptr) return result;
+        }
+    }
+
+    if (this->_hitTestVisible && _RectContains(this->_bounds, point)) {
+        return this;
+    }
+    return nullptr;
+}
+
+void sw::WindowlessElement::InvalidateMeasure()
+{
+    for (WindowlessElement *element = this; element != nullptr; element = element->_parent) {
+        element->_measureCache.Clear();
+    }
+    if (this->_host != nullptr) {
+        this->_host->InvalidateMeasure();
+    }
+}
+
+void sw::WindowlessElement::Redraw()
+{
+    if (this->_host != nullptr) {
+        this->_host->_InvalidateContentRect(this->GetPixelBounds());
+    }
+}
+
+void sw::WindowlessElement::Draw(HDC hdc, const RECT &clipRect)
+{
+    if (!this->_visible) {
+        return;
+    }
+
+    // 子树的范围与需要绘制的区域不相交时跳过整个子树
+    RECT intersection;
+    RECT extent = this->_extent;
+    if (!IntersectRect(&intersection, &extent, &clipRect)) {
+        return;
+    }
+
+    RECT rect = this->GetPixelBounds();
+    if (IntersectRect(&intersection, &rect, &clipRect)) {
+        this->OnDraw(hdc, rect);
+    }
+
+    if (this->_childIndex != nullptr && this->_childIndexValid) {
+        // 像素与DIP换算有舍入，查询时向外扩展一个像素
+        RECT queryRect = clipRect;
+        InflateRect(&queryRect, 1, 1);
+
+        std::vector<int> visibleChildren;
+        this->_childIndex->QueryRect(queryRect, visibleChildren);
+        for (int index : visibleChildren) {
+            this->_children[index]->Draw(hdc, clipRect);
+        }
+    } else {
+        for (WindowlessElement *child : this->_children) {
+            child->Draw(hdc, clipRect);
+        }
+    }
+}
+
+uint64_t sw::WindowlessElement::GetLayoutTag()
+{
+    return this->_layoutTag;
+}
+
+int sw::WindowlessElement::GetChildLayoutCount()
+{
+    return (int)this->_layoutVisibleChildren.size();
+}
+
+sw::ILayout &sw::WindowlessElement::GetChildLayoutAt(int index)
+{
+    return *this->_layoutVisibleChildren[index];
+}
+
+sw::Size sw::WindowlessElement::GetDesireSize()
+{
+    return this->_desireSize;
+}
+
+void sw::WindowlessElement::Measure(const Size &availableSize)
+{
+    bool profiling = LayoutProfiler::IsEnabled();
+    if (profiling) {
+        LayoutProfiler::BeginMeasure(this, this->_parent, typeid(*this).name());
+    }
+
+    Size cachedDesireSize;
+    if (this->_measureCache.TryGet(availableSize, cachedDesireSize)) {
+        // 命中的结果不是最近一次实际测量的结果时，子元素由Arrange在安排前重新测量
+        this->_desireSize               = cachedDesireSize;
+        this->_lastMeasureAvailableSize = availableSize;
+        if (profiling) LayoutProfiler::EndMeasure(true);
+        return;
+    }
+
+    this->_MeasureCore(availableSize);
+
+    if (profiling) {
+        LayoutProfiler::EndMeasure(false);
+    }
+}
+
+void sw::WindowlessElement::Arrange(const sw::Rect &finalPosition)
+{
+    bool profiling = LayoutProfiler::IsEnabled();
+    if (profiling) {
+        LayoutProfiler::BeginArrange(this, this->_parent, typeid(*this).name());
+    }
+
+    // 上一次Measure命中了较早的缓存时，子元素的测量结果对应的是其他可用尺寸，需要先按当前尺寸重新测量
+    if (this->_lastMeasureAvailableSize != this->_lastMeasureOverrideSize) {
+        this->_MeasureCore(this->_lastMeasureAvailableSize);
+    }
+
+    Size &desireSize  = this->_desireSize;
+    Thickness &margin = this->_margin;
+
+    sw::Rect rect;
+    rect.width  = desireSize.width - margin.left - margin.right;
+    rect.height = desireSize.height - margin.top - margin.bottom;
+
+    if (!std::isnan(this->_width)) {
+        rect.width = this->_width;
+    } else if (this->_horizontalAlignment == HorizontalAlignment::Stretch) {
+        rect.width = finalPosition.width - margin.left - margin.right;
+    }
+
+    if (!std::isnan(this->_height)) {
+        rect.height = this->_height;
+    } else if (this->_verticalAlignment == VerticalAlignment::Stretch) {
+        rect.height = finalPosition.height - margin.top - margin.bottom;
+    }
+
+    switch (this->_horizontalAlignment) {
+        case HorizontalAlignment::Center:
+        case HorizontalAlignment::Stretch: {
+            rect.left = finalPosition.left + (finalPosition.width - rect.width - margin.left - margin.right) / 2 + margin.left;
+            break;
+        }
+        case HorizontalAlignment::Left: {
+            rect.left = finalPosition.left + margin.left;
+            break;
+        }
+        case HorizontalAlignment::Right: {
+            rect.left = finalPosition.left + finalPosition.width - rect.width - margin.right;
+            break;
+        }
+    }
+
+    switch (this->_verticalAlignment) {
+        case VerticalAlignment::Center:
+        case VerticalAlignment::Stretch: {
+            rect.top = finalPosition.top + (finalPosition.height - rect.height - margin.top - margin.bottom) / 2 + margin.top;
+            break;
+        }
+        case VerticalAlignment::Top: {
+            rect.top = finalPosition.top + margin.top;
+            break;
+        }
+        case VerticalAlignment::Bottom: {
+            rect.top = finalPosition.top + finalPosition.height - rect.height - margin.bottom;
+            break;
+        }
+    }
+
+    // 安排的位置相对于父元素的内容区域，转换为宿主内容区域中的位置
+    Point origin = this->GetParentContentOrigin();
+    rect.left += origin.x;
+    rect.top += origin.y;
+
+    rect.width  = Utils::Max(0.0, rect.width);
+    rect.height = Utils::Max(0.0, rect.height);
+    this->SetBounds(rect);
+
+    Thickness padding    = this->GetContentPadding();
+    this->_contentOrigin = Point(rect.left + padding.left, rect.top + padding.top);
+
+    this->ArrangeOverride(Size(
+        Utils::Max(0.0, rect.width - padding.left - padding.right),
+        Utils::Max(0.0, rect.height - padding.top - padding.bottom)));
+
+    this->_UpdateExtentAndChildIndex();
+
+    if (profiling) {
+        LayoutProfiler::EndArrange();
+    }
+}
+
+sw::Thickness sw::WindowlessElement::GetContentPadding()
+{
+    return Thickness();
+}
+
+sw::Size sw::WindowlessElement::MeasureOverride(const Size &availableSize)
+{
+    return Size();
+}
+
+void sw::WindowlessElement::ArrangeOverride(const Size &finalSize)
+{
+}
+
+void sw::WindowlessElement::OnDraw(HDC hdc, const RECT &rect)
+{
+}
+
+bool sw::WindowlessElement::OnRoutedEvent(RoutedEventArgs &eventArgs, const WindowlessEventHandler &handler)
+{
+    return false;
+}
+
+void sw::WindowlessElement::OnMouseEnter()
+{
+}
+
+void sw::WindowlessElement::OnMouseLeave()
+{
+}
+
+void sw::WindowlessElement::OnHostChanged(WindowlessHost *oldHost)
+{
+}
+
+void sw::WindowlessElement::OnVisibleChanged()
+{
+}
+
+void sw::WindowlessElement::OnHostFontChanged()
+{
+}
+
+sw::Point sw::WindowlessElement::GetParentContentOrigin()
+{
+    return this->_parent == nullptr ? Point() : this->_parent->_contentOrigin;
+}
+
+RECT sw::WindowlessElement::GetPixelBounds()
+{
+    return this->_bounds;
+}
+
+void sw::WindowlessElement::SetBounds(const sw::Rect &bounds)
+{
+    this->_bounds = bounds;
+    this->_extent = bounds;
+}
+
+void sw::WindowlessElement::_SetHost(WindowlessHost *host)
+{
+    if (this->_host == host) {
+        return;
+    }
+
+    WindowlessHost *oldHost = this->_host;
+    if (oldHost != nullptr) {
+        oldHost->_OnElementDetached(*this);
+    }
+
+    // 不同宿主的字体可能不同，测量结果不再可用
+    this->_host = host;
+    this->_measureCache.Clear();
+
+    for (WindowlessElement *child : this->_children) {
+        child->_SetHost(host);
+    }
+    this->OnHostChanged(oldHost);
+}
+
+void sw::WindowlessElement::_UpdateLayoutVisibleChildren()
+{
+    this->_layoutVisibleChildren.clear();
+    for (WindowlessElement *child : this->_children) {
+        if (child->_visible) this->_layoutVisibleChildren.push_back(child);
+    }
+}
+
+void sw::WindowlessElement::_UpdateExtentAndChildIndex()
+{
+    int childCount = (int)this->_children.size();
+
+    double left   = this->_bounds.left;
+    double top    = this->_bounds.top;
+    double right  = left + this->_bounds.width;
+    double bottom = top + this->_bounds.height;
+
+    for (WindowlessElement *child : this->_layoutVisibleChildren) {
+        const sw::Rect &extent = child->_extent;
+        if (extent.width <= 0 || extent.height <= 0) continue;
+        left   = Utils::Min(left, extent.left);
+        top    = Utils::Min(top, extent.top);
+        right  = Utils::Max(right, extent.left + extent.width);
+        bottom = Utils::Max(bottom, extent.top + extent.height);
+    }
+    this->_extent = sw::Rect(left, top, right - left, bottom - top);
+
+    if (childCount < SpatialIndexThreshold) {
+        this->_childIndex.reset();
+        this->_childIndexValid = false;
+        return;
+    }
+
+    if (this->_childIndex == nullptr) {
+        this->_childIndex.reset(new SpatialIndex());
+    }
+
+    // 索引中记录子树的范围，不可见的子元素不参与命中测试与绘制
+    for (int i = 0; i < childCount; ++i) {
+        WindowlessElement *child = this->_children[i];
+        this->_childIndex->Update(i, child->_visible ? child->_extent : sw::Rect());
+    }
+    this->_childIndex->SetCount(childCount);
+    this->_childIndexValid = true;
+}
+
+void sw::WindowlessElement::_NotifyHostFontChanged()
+{
+    this->_measureCache.Clear();
+    this->OnHostFontChanged();
+    for (WindowlessElement *child : this->_children) {
+        child->_NotifyHostFontChanged();
+    }
+}
+
+void sw::WindowlessElement::_MeasureCore(const Size &availableSize)
+{
+    Thickness &margin = this->_margin;
+    Thickness padding = this->GetContentPadding();
+
+    double paddingWidth  = padding.left + padding.right;
+    double paddingHeight = padding.top + padding.bottom;
+
+    Size measureSize(
+        Utils::Max(0.0, availableSize.width - margin.left - margin.right - paddingWidth),
+        Utils::Max(0.0, availableSize.height - margin.top - margin.bottom - paddingHeight));
+
+    // 指定了尺寸时内容按指定的尺寸测量
+    if (!std::isnan(this->_width)) {
+        measureSize.width = Utils::Max(0.0, this->_width - paddingWidth);
+    }
+    if (!std::isnan(this->_height)) {
+        measureSize.height = Utils::Max(0.0, this->_height - paddingHeight);
+    }
+
+    Size desireSize = this->MeasureOverride(measureSize);
+    desireSize.width  = std::isnan(this->_width) ? desireSize.width + paddingWidth : this->_width;
+    desireSize.height = std::isnan(this->_height) ? desireSize.height + paddingHeight : this->_height;
+
+    desireSize.width += margin.left + margin.right;
+    desireSize.height += margin.top + margin.bottom;
+
+    this->_desireSize               = desireSize;
+    this->_lastMeasureAvailableSize = availableSize;
+    this->_lastMeasureOverrideSize  = availableSize;
+    this->_measureCache.Add(availableSize, desireSize);
+}
@@ -0,0 +1,59 @@
+#include "WindowlessGrid.h"
+
+sw::WindowlessGrid::WindowlessGrid()
+{
+    this->_gridLayout.Associate(this);
+}
+
+void sw::WindowlessGrid::AddRow(const GridRow &row)
+{
+    this->_gridLayout.rows.Append(row);
+    this->InvalidateMeasure();
+}
+
+void sw::WindowlessGrid::SetRows(std::initializer_list<GridRow> rows)
+{
+    List<GridRow> rowsList = rows;
+    this->_gridLayout.rows = rowsList;
+    this->InvalidateMeasure();
+}
+
+void sw::WindowlessGrid::AddColumn(const GridColumn &col)
+{
+    this->_gridLayout.columns.Append(col);
+    this->InvalidateMeasure();
+}
+
+void sw::WindowlessGrid::SetColumns(std::initializer_list<GridColumn> cols)
+{
+    List<GridColumn> colsList = cols;
+    this->_gridLayout.columns = colsList;
+    this->InvalidateMeasure();
+}
+
+void sw::WindowlessGrid::ClearRows()
+{
+    this->_gridLayout.rows.Clear();
+    this->InvalidateMeasure();
+}
+
+void sw::WindowlessGrid::ClearColumns()
+{
+    this->_gridLayout.columns.Clear();
+    this->InvalidateMeasure();
+}
+
+sw::GridLayoutTag sw::WindowlessGrid::GetGridLayoutTag(WindowlessElement &element)
+{
+    return element.LayoutTag.Get();
+}
+
+void sw::WindowlessGrid::SetGridLayoutTag(WindowlessElement &element, const GridLayoutTag &tag)
+{
+    element.LayoutTag.Set(tag);
+}
+
+sw::LayoutHost *sw::WindowlessGrid::GetDefaultLayout()
+{
+    return &this->_gridLayout;
+}
@@ -0,0 +1,266 @@
+#include "WindowlessHost.h"
+#include "BrushCache.h"
+#include "Dip.h"
+
+sw::WindowlessHost::WindowlessHost()
+    : Content(
+          // get
+          [this]() -> WindowlessElement * {
+              return this->_content;
+          },
+          // set
+          [this](WindowlessElement *value) {
+              if (this->_content == value) {
+                  return;
+              }
+              if (value != nullptr && (value->_parent != nullptr || value->_host != nullptr)) {
+                  return;
+              }
+              if (this->_content != nullptr) {
+                  this->_content->_SetHost(nullptr);
+              }
+              this->_content = value;
+              if (value != nullptr) {
+                  value->_SetHost(this);
+              }
+              this->InvalidateMeasure();
+              this->Redraw();
+          }),
+
+      MouseOverElement(
+          // get
+          [this]() -> WindowlessElement * {
+              return this->_mouseOverElement;
+          })
+{
+    this->_contentLayout.host = this;
+    this->_contentLayout.Associate(this);
+    this->HorizontalAlignment = HorizontalAlignment::Stretch;
+    this->VerticalAlignment   = VerticalAlignment::Stretch;
+}
+
+sw::WindowlessHost::~WindowlessHost()
+{
+    // 先清空_content，析构时不需要重新布局
+    WindowlessElement *content = this->_content;
+    this->_content = nullptr;
+
+    if (content != nullptr) {
+        content->_SetHost(nullptr);
+    }
+}
+
+sw::WindowlessElement *sw::WindowlessHost::HitTestElement(const Point &point)
+{
+    if (this->_content == nullptr) {
+        return nullptr;
+    }
+    return this->_content->HitTest(Point(
+        point.x - this->GetInternalArrangeOffsetX(),
+        point.y - this->GetInternalArrangeOffsetY()));
+}
+
+sw::LayoutHost *sw::WindowlessHost::GetDefaultLayout()
+{
+    return &this->_contentLayout;
+}
+
+double sw::WindowlessHost::GetScrollExtent(ScrollOrientation orientation)
+{
+    if (this->_content == nullptr || !this->_content->_visible) {
+        return 0;
+    }
+    Size desireSize = this->_content->GetDesireSize();
+    return orientation == ScrollOrientation::Horizontal ? desireSize.width : desireSize.height;
+}
+
+bool sw::WindowlessHost::OnPaint()
+{
+    PAINTSTRUCT ps;
+    HWND hwnd = this->Handle;
+    HDC hdc   = BeginPaint(hwnd, &ps);
+
+    HBRUSH hBrush = BrushCache::Acquire(this->GetRealBackColor());
+    FillRect(hdc, &ps.rcPaint, hBrush);
+    BrushCache::Release(hBrush);
+
+    if (this->_content != nullptr) {
+        int offsetX = Dip::DipToPxX(this->GetInternalArrangeOffsetX());
+        int offsetY = Dip::DipToPxY(this->GetInternalArrangeOffsetY());
+
+        // 将原点移动到内容区域的原点，元素按不含滚动偏移量的坐标绘制
+        int savedDC = SaveDC(hdc);
+        SetViewportOrgEx(hdc, offsetX, offsetY, NULL);
+        SelectObject(hdc, this->GetFontHandle());
+        SetBkMode(hdc, TRANSPARENT);
+
+        RECT clipRect = ps.rcPaint;
+        OffsetRect(&clipRect, -offsetX, -offsetY);
+        this->_content->Draw(hdc, clipRect);
+
+        RestoreDC(hdc, savedDC);
+    }
+
+    EndPaint(hwnd, &ps);
+    return true;
+}
+
+void sw::WindowlessHost::FontChanged(HFONT hfont)
+{
+    this->Panel::FontChanged(hfont);
+
+    if (this->_content != nullptr) {
+        this->_content->_NotifyHostFontChanged();
+        this->InvalidateMeasure();
+        this->Redraw();
+    }
+}
+
+bool sw::WindowlessHost::OnMouseMove(Point mousePosition, MouseKey keyState)
+{
+    this->_SetMouseOverElement(this->HitTestElement(mousePosition));
+
+    bool handled = false;
+    MouseMoveEventArgs args(mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseMove(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseLeave()
+{
+    this->_trackingMouseLeave = false;
+    this->_SetMouseOverElement(nullptr);
+    return this->Panel::OnMouseLeave();
+}
+
+bool sw::WindowlessHost::OnMouseWheel(int wheelDelta, Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseWheelEventArgs args(wheelDelta, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(this->PointFromScreen(mousePosition), args, handled);
+    return handled ? result : this->Panel::OnMouseWheel(wheelDelta, mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseLeftButtonDown(Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseButtonDownEventArgs args(MouseKey::MouseLeft, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseLeftButtonDown(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseLeftButtonUp(Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseButtonUpEventArgs args(MouseKey::MouseLeft, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseLeftButtonUp(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseRightButtonDown(Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseButtonDownEventArgs args(MouseKey::MouseRight, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseRightButtonDown(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseRightButtonUp(Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseButtonUpEventArgs args(MouseKey::MouseRight, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseRightButtonUp(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseMiddleButtonDown(Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseButtonDownEventArgs args(MouseKey::MouseMiddle, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseMiddleButtonDown(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::OnMouseMiddleButtonUp(Point mousePosition, MouseKey keyState)
+{
+    bool handled = false;
+    MouseButtonUpEventArgs args(MouseKey::MouseMiddle, mousePosition, keyState);
+    bool result = this->_RaiseElementEvent(mousePosition, args, handled);
+    return handled ? result : this->Panel::OnMouseMiddleButtonUp(mousePosition, keyState);
+}
+
+bool sw::WindowlessHost::_RaiseElementEvent(const Point &point, RoutedEventArgs &args, bool &handled)
+{
+    WindowlessElement *element = this->HitTestElement(point);
+    handled = element != nullptr && element->RaiseRoutedEvent(args);
+    return args.handledMsg;
+}
+
+void sw::WindowlessHost::_InvalidateContentRect(const RECT &rect)
+{
+    RECT clientRect = rect;
+    OffsetRect(&clientRect,
+               Dip::DipToPxX(this->GetInternalArrangeOffsetX()),
+               Dip::DipToPxY(this->GetInternalArrangeOffsetY()));
+    InvalidateRect(this->Handle, &clientRect, FALSE);
+}
+
+void sw::WindowlessHost::_OnElementDetached(WindowlessElement &element)
+{
+    if (this->_mouseOverElement == &element) {
+        this->_mouseOverElement = nullptr;
+    }
+    if (this->_content == &element) {
+        this->_content = nullptr;
+        this->InvalidateMeasure();
+        this->Redraw();
+    }
+}
+
+void sw::WindowlessHost::_SetMouseOverElement(WindowlessElement *element)
+{
+    if (this->_mouseOverElement == element) {
+        return;
+    }
+
+    WindowlessElement *oldElement = this->_mouseOverElement;
+    this->_mouseOverElement       = element;
+
+    if (oldElement != nullptr) {
+        oldElement->OnMouseLeave();
+    }
+
+    if (element != nullptr) {
+        element->OnMouseEnter();
+
+        // 鼠标离开宿主时需要通知当前元素
+        if (!this->_trackingMouseLeave) {
+            TRACKMOUSEEVENT tme{};
+            tme.cbSize    = sizeof(tme);
+            tme.dwFlags   = TME_LEAVE;
+            tme.hwndTrack = this->Handle;
+            this->_trackingMouseLeave = TrackMouseEvent(&tme) != FALSE;
+        }
+    }
+}
+
+sw::Size sw::WindowlessHost::_ContentLayout::MeasureOverride(const Size &availableSize)
+{
+    WindowlessElement *content = this->host->_content;
+    if (content == nullptr || !content->_visible) {
+        return Size();
+    }
+    content->Measure(availableSize);
+    return content->GetDesireSize();
+}
+
+void sw::WindowlessHost::_ContentLayout::ArrangeOverride(const Size &finalSize)
+{
+    WindowlessElement *content = this->host->_content;
+    if (content != nullptr && content->_visible) {
+        content->Arrange(sw::Rect(0, 0, finalSize.width, finalSize.height));
+    }
+
+    // 无窗口元素没有窗口可以移动，位置改变后由宿主整体重绘
+    InvalidateRect(this->host->Handle, NULL, FALSE);
+}
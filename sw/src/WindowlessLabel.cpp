@@ -0,0 +1,249 @@
+#include "WindowlessLabel.h"
+#include "Dip.h"
+#include "Utils.h"
+#include "WindowlessHost.h"
+
+sw::WindowlessLabel::WindowlessLabel()
+    : Text(
+          this,
+          // get
+          [](WindowlessLabel *self) -> std::wstring {
+              return self->_text;
+          },
+          // set
+          [](WindowlessLabel *self, const std::wstring &value) {
+              if (self->_text != value) {
+                  self->_text         = value;
+                  self->_textSizeFont = NULL;
+                  self->Redraw();
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      TextColor(
+          this,
+          // get
+          [](WindowlessLabel *self) -> Color {
+              return self->_textColor;
+          },
+          // set
+          [](WindowlessLabel *self, const Color &value) {
+              self->_textColor        = value;
+              self->_inheritTextColor = false;
+              self->Redraw();
+          }),
+
+      InheritTextColor(
+          this,
+          // get
+          [](WindowlessLabel *self) -> bool {
+              return self->_inheritTextColor;
+          },
+          // set
+          [](WindowlessLabel *self, const bool &value) {
+              if (self->_inheritTextColor != value) {
+                  self->_inheritTextColor = value;
+                  self->Redraw();
+              }
+          }),
+
+      HorizontalContentAlignment(
+          this,
+          // get
+          [](WindowlessLabel *self) -> sw::HorizontalAlignment {
+              return self->_horizontalContentAlignment;
+          },
+          // set
+          [](WindowlessLabel *self, const sw::HorizontalAlignment &value) {
+              if (self->_horizontalContentAlignment != value) {
+                  self->_horizontalContentAlignment = value;
+                  self->Redraw();
+              }
+          }),
+
+      VerticalContentAlignment(
+          this,
+          // get
+          [](WindowlessLabel *self) -> sw::VerticalAlignment {
+              return self->_verticalContentAlignment;
+          },
+          // set
+          [](WindowlessLabel *self, const sw::VerticalAlignment &value) {
+              if (self->_verticalContentAlignment != value) {
+                  self->_verticalContentAlignment = value;
+                  self->Redraw();
+              }
+          }),
+
+      TextTrimming(
+          this,
+          // get
+          [](WindowlessLabel *self) -> sw::TextTrimming {
+              return self->_textTrimming;
+          },
+          // set
+          [](WindowlessLabel *self, const sw::TextTrimming &value) {
+              if (self->_textTrimming != value) {
+                  self->_textTrimming = value;
+                  self->Redraw();
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      AutoWrap(
+          this,
+          // get
+          [](WindowlessLabel *self) -> bool {
+              return self->_autoWrap;
+          },
+          // set
+          [](WindowlessLabel *self, const bool &value) {
+              if (self->_autoWrap != value) {
+                  self->_autoWrap = value;
+                  self->Redraw();
+                  self->InvalidateMeasure();
+              }
+          })
+{
+}
+
+sw::Size sw::WindowlessLabel::MeasureOverride(const Size &availableSize)
+{
+    WindowlessHost *host = this->Host;
+    if (host == nullptr) {
+        return Size();
+    }
+
+    this->_UpdateTextSize();
+    Size desireSize = this->_textSize;
+
+    if (availableSize.width < desireSize.width) {
+        if (this->_textTrimming != sw::TextTrimming::None) {
+            desireSize.width = availableSize.width;
+        } else if (this->_autoWrap) {
+            HWND hwnd = host->Handle;
+            HDC hdc   = GetDC(hwnd);
+            SelectObject(hdc, host->GetFontHandle());
+
+            RECT rect{0, 0, Utils::Max(0, Dip::DipToPxX(availableSize.width)), 0};
+            DrawTextW(hdc, this->_text.c_str(), (int)this->_text.size(), &rect, DT_CALCRECT | DT_WORDBREAK);
+
+            desireSize.width  = availableSize.width;
+            desireSize.height = Dip::PxToDipY(rect.bottom - rect.top);
+            ReleaseDC(hwnd, hdc);
+        }
+    }
+    return desireSize;
+}
+
+void sw::WindowlessLabel::OnDraw(HDC hdc, const RECT &rect)
+{
+    if (this->_text.empty()) {
+        return;
+    }
+
+    WindowlessHost *host = this->Host;
+    SetTextColor(hdc, this->_inheritTextColor ? host->GetRealTextColor() : this->_textColor);
+
+    UINT format   = this->_GetDrawTextFormat();
+    RECT textRect = rect;
+
+    // 多行文本无法通过DT_VCENTER及DT_BOTTOM对齐，需要先计算文本的高度
+    if (this->_autoWrap && this->_verticalContentAlignment != sw::VerticalAlignment::Top &&
+        this->_verticalContentAlignment != sw::VerticalAlignment::Stretch) {
+        RECT calcRect{0, 0, rect.right - rect.left, 0};
+        DrawTextW(hdc, this->_text.c_str(), (int)this->_text.size(), &calcRect, format | DT_CALCRECT);
+
+        LONG space = (rect.bottom - rect.top) - (calcRect.bottom - calcRect.top);
+        if (space > 0) {
+            textRect.top += this->_verticalContentAlignment == sw::VerticalAlignment::Bottom ? space : space / 2;
+        }
+    }
+
+    DrawTextW(hdc, this->_text.c_str(), (int)this->_text.size(), &textRect, format);
+}
+
+void sw::WindowlessLabel::OnHostChanged(WindowlessHost *oldHost)
+{
+    this->_textSizeFont = NULL;
+}
+
+void sw::WindowlessLabel::OnHostFontChanged()
+{
+    this->_textSizeFont = NULL;
+}
+
+void sw::WindowlessLabel::_UpdateTextSize()
+{
+    WindowlessHost *host = this->Host;
+    HFONT hfont          = host->GetFontHandle();
+
+    // 文本与字体均未改变时无需重新计算
+    if (this->_textSizeFont == hfont) {
+        return;
+    }
+
+    HWND hwnd = host->Handle;
+    HDC hdc   = GetDC(hwnd);
+    SelectObject(hdc, hfont);
+
+    RECT rect{};
+    DrawTextW(hdc, this->_text.c_str(), (int)this->_text.size(), &rect, DT_CALCRECT);
+
+    this->_textSize     = sw::Rect(rect).GetSize();
+    this->_textSizeFont = hfont;
+    ReleaseDC(hwnd, hdc);
+}
+
+UINT sw::WindowlessLabel::_GetDrawTextFormat()
+{
+    UINT format = this->_autoWrap ? DT_WORDBREAK : DT_SINGLELINE;
+
+    switch (this->_horizontalContentAlignment) {
+        case sw::HorizontalAlignment::Center: {
+            format |= DT_CENTER;
+            break;
+        }
+        case sw::HorizontalAlignment::Right: {
+            format |= DT_RIGHT;
+            break;
+        }
+        default: {
+            format |= DT_LEFT;
+            break;
+        }
+    }
+
+    if (!this->_autoWrap) {
+        switch (this->_verticalContentAlignment) {
+            case sw::VerticalAlignment::Center: {
+                format |= DT_VCENTER;
+                break;
+            }
+            case sw::VerticalAlignment::Bottom: {
+                format |= DT_BOTTOM;
+                break;
+            }
+            default: {
+                format |= DT_TOP;
+                break;
+            }
+        }
+    }
+
+    switch (this->_textTrimming) {
+        case sw::TextTrimming::EndEllipsis: {
+            format |= DT_END_ELLIPSIS;
+            break;
+        }
+        case sw::TextTrimming::WordEllipsis: {
+            format |= DT_WORD_ELLIPSIS;
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+
+    return format;
+}
@@ -0,0 +1,129 @@
+#include "WindowlessPanel.h"
+#include "BrushCache.h"
+#include "Dip.h"
+
+sw::WindowlessPanel::WindowlessPanel()
+    : BackColor(
+          this,
+          // get
+          [](WindowlessPanel *self) -> Color {
+              return self->_backColor;
+          },
+          // set
+          [](WindowlessPanel *self, const Color &value) {
+              self->_backColor   = value;
+              self->_transparent = false;
+              self->Redraw();
+          }),
+
+      Transparent(
+          this,
+          // get
+          [](WindowlessPanel *self) -> bool {
+              return self->_transparent;
+          },
+          // set
+          [](WindowlessPanel *self, const bool &value) {
+              if (self->_transparent != value) {
+                  self->_transparent = value;
+                  self->Redraw();
+              }
+          }),
+
+      BorderStyle(
+          this,
+          // get
+          [](WindowlessPanel *self) -> sw::BorderStyle {
+              return self->_borderStyle;
+          },
+          // set
+          [](WindowlessPanel *self, const sw::BorderStyle &value) {
+              if (self->_borderStyle != value) {
+                  self->_borderStyle = value;
+                  self->Redraw();
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      Padding(
+          this,
+          // get
+          [](WindowlessPanel *self) -> Thickness {
+              return self->_padding;
+          },
+          // set
+          [](WindowlessPanel *self, const Thickness &value) {
+              if (self->_padding != value) {
+                  self->_padding = value;
+                  self->InvalidateMeasure();
+              }
+          }),
+
+      Layout(
+          this,
+          // get
+          [](WindowlessPanel *self) -> LayoutHost * {
+              return self->_customLayout;
+          },
+          // set
+          [](WindowlessPanel *self, LayoutHost *const &value) {
+              if (value != nullptr)
+                  value->Associate(self);
+              self->_customLayout = value;
+              self->InvalidateMeasure();
+          })
+{
+    this->_defaultLayout.Associate(this);
+    this->HorizontalAlignment = sw::HorizontalAlignment::Stretch;
+    this->VerticalAlignment   = sw::VerticalAlignment::Stretch;
+}
+
+sw::LayoutHost *sw::WindowlessPanel::GetDefaultLayout()
+{
+    return &this->_defaultLayout;
+}
+
+sw::Thickness sw::WindowlessPanel::GetContentPadding()
+{
+    Thickness result = this->_padding;
+
+    if (this->_borderStyle != sw::BorderStyle::None) {
+        // DrawEdge绘制的边框宽度与系统的三维边框宽度相同
+        double edgeX = Dip::PxToDipX(GetSystemMetrics(SM_CXEDGE));
+        double edgeY = Dip::PxToDipY(GetSystemMetrics(SM_CYEDGE));
+        result.left += edgeX;
+        result.right += edgeX;
+        result.top += edgeY;
+        result.bottom += edgeY;
+    }
+    return result;
+}
+
+sw::Size sw::WindowlessPanel::MeasureOverride(const Size &availableSize)
+{
+    return this->_GetLayout()->MeasureOverride(availableSize);
+}
+
+void sw::WindowlessPanel::ArrangeOverride(const Size &finalSize)
+{
+    this->_GetLayout()->ArrangeOverride(finalSize);
+}
+
+void sw::WindowlessPanel::OnDraw(HDC hdc, const RECT &rect)
+{
+    if (!this->_transparent) {
+        HBRUSH hBrush = BrushCache::Acquire(this->_backColor);
+        FillRect(hdc, &rect, hBrush);
+        BrushCache::Release(hBrush);
+    }
+
+    if (this->_borderStyle != sw::BorderStyle::None) {
+        RECT borderRect = rect;
+        DrawEdge(hdc, &borderRect, (UINT)this->_borderStyle, BF_RECT);
+    }
+}
+
+sw::LayoutHost *sw::WindowlessPanel::_GetLayout()
+{
+    return this->_customLayout != nullptr ? this->_customLayout : this->GetDefaultLayout();
+}
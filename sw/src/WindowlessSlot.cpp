@@ -0,0 +1,99 @@
+#include "WindowlessSlot.h"
+#include "WindowlessHost.h"
+
+sw::WindowlessSlot::WindowlessSlot()
+    : Element(
+          this,
+          // get
+          [](WindowlessSlot *self) -> UIElement * {
+              return self->_element;
+          },
+          // set
+          [](WindowlessSlot *self, UIElement *const &value) {
+              if (self->_element == value) {
+                  return;
+              }
+
+              WindowlessHost *host = self->Host;
+              if (host != nullptr && self->_IsElementHosted()) {
+                  host->RemoveChild(self->_element);
+              }
+
+              self->_element = value;
+
+              if (host != nullptr && value != nullptr) {
+                  value->Visible = self->Visible.Get();
+                  host->AddChild(value);
+              }
+              self->InvalidateMeasure();
+          })
+{
+    // 所放置的元素有自己的窗口，鼠标消息不会经过宿主
+    this->IsHitTestVisible = false;
+}
+
+sw::WindowlessSlot::~WindowlessSlot()
+{
+    WindowlessHost *host = this->Host;
+    if (host != nullptr && this->_IsElementHosted()) {
+        host->RemoveChild(this->_element);
+    }
+}
+
+sw::Size sw::WindowlessSlot::GetDesireSize()
+{
+    return this->_IsElementHosted() ? this->_element->GetDesireSize() : this->WindowlessElement::GetDesireSize();
+}
+
+void sw::WindowlessSlot::Measure(const Size &availableSize)
+{
+    if (this->_IsElementHosted()) {
+        this->_element->Measure(availableSize);
+    } else {
+        this->WindowlessElement::Measure(availableSize);
+    }
+}
+
+void sw::WindowlessSlot::Arrange(const sw::Rect &finalPosition)
+{
+    if (!this->_IsElementHosted()) {
+        this->WindowlessElement::Arrange(finalPosition);
+        return;
+    }
+
+    // 元素的位置相对于宿主的用户区，宿主的滚动偏移量由UIElement::Arrange处理
+    Point origin = this->GetParentContentOrigin();
+    sw::Rect rect(finalPosition.left + origin.x, finalPosition.top + origin.y, finalPosition.width, finalPosition.height);
+
+    this->SetBounds(rect);
+    this->_element->Arrange(rect);
+}
+
+void sw::WindowlessSlot::OnHostChanged(WindowlessHost *oldHost)
+{
+    if (this->_element == nullptr) {
+        return;
+    }
+    if (oldHost != nullptr && this->_element->Parent.Get() == oldHost) {
+        oldHost->RemoveChild(this->_element);
+    }
+
+    WindowlessHost *host = this->Host;
+    if (host != nullptr) {
+        this->_element->Visible = this->Visible.Get();
+        host->AddChild(this->_element);
+    }
+}
+
+void sw::WindowlessSlot::OnVisibleChanged()
+{
+    if (this->_element != nullptr) {
+        this->_element->Visible = this->Visible.Get();
+    }
+}
+
+bool sw::WindowlessSlot::_IsElementHosted()
+{
+    WindowlessHost *host = this->Host;
+    return host != nullptr && this->_element != nullptr && this->_element->Parent.Get() == host;
+}
@@ -0,0 +1,48 @@
+#include "WindowlessSplitter.h"
+#include "Utils.h"
+
+sw::WindowlessSplitter::WindowlessSplitter()
+    : Orientation(
+          this,
+          // get
+          [](WindowlessSplitter *self) -> sw::Orientation {
+              return self->_orientation;
+          },
+          // set
+          [](WindowlessSplitter *self, const sw::Orientation &value) {
+              if (self->_orientation != value) {
+                  self->_orientation = value;
+                  if (value == sw::Orientation::Horizontal) {
+                      self->HorizontalAlignment = sw::HorizontalAlignment::Stretch;
+                      self->VerticalAlignment   = sw::VerticalAlignment::Center;
+                  } else {
+                      self->HorizontalAlignment = sw::HorizontalAlignment::Center;
+                      self->VerticalAlignment   = sw::VerticalAlignment::Stretch;
+                  }
+                  self->Redraw();
+              }
+          })
+{
+    this->HorizontalAlignment = sw::HorizontalAlignment::Stretch;
+    this->VerticalAlignment   = sw::VerticalAlignment::Center;
+}
+
+sw::Size sw::WindowlessSplitter::MeasureOverride(const Size &availableSize)
+{
+    return Size(10, 10);
+}
+
+void sw::WindowlessSplitter::OnDraw(HDC hdc, const RECT &rect)
+{
+    RECT lineRect = rect;
+
+    if (this->_orientation == sw::Orientation::Horizontal) {
+        // 在中间绘制横向分隔条
+        lineRect.top += Utils::Max(0L, (lineRect.bottom - lineRect.top) / 2 - 1);
+        DrawEdge(hdc, &lineRect, EDGE_ETCHED, BF_TOP);
+    } else {
+        // 在中间绘制纵向分隔条
+        lineRect.left += Utils::Max(0L, (lineRect.right - lineRect.left) / 2 - 1);
+        DrawEdge(hdc, &lineRect, EDGE_ETCHED, BF_LEFT);
+    }
+}
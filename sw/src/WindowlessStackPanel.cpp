@@ -0,0 +1,22 @@
+#include "WindowlessStackPanel.h"
+
+sw::WindowlessStackPanel::WindowlessStackPanel()
+    : Orientation(
+          this,
+          // get
+          [](WindowlessStackPanel *self) -> sw::Orientation {
+              return self->_stackLayout.orientation;
+          },
+          // set
+          [](WindowlessStackPanel *self, const sw::Orientation &value) {
+              self->_stackLayout.orientation = value;
+              self->InvalidateMeasure();
+          })
+{
+    this->_stackLayout.Associate(this);
+}
+
+sw::LayoutHost *sw::WindowlessStackPanel::GetDefaultLayout()
+{
+    return &this->_stackLayout;
+}
@@ -1,5 +1,9 @@
 #include "WndBase.h"
+#include "FontCache.h"
+#include "LayoutScheduler.h"
+#include "MsgMonitor.h"
 #include <atomic>
+#include <typeinfo>
 
 namespace
 {
@@ -33,239 +37,262 @@ sw::WndBase::WndBase()
     : _check(_WndBaseMagicNumber),
 
       Handle(
+          this,
           // get
-          [this]() -> HWND {
-              return this->_hwnd;
+          [](WndBase *self) -> HWND {
+              return self->_hwnd;
           }),
 
       Font(
+          this,
           // get
-          [this]() -> sw::Font {
-              return this->_font;
+          [](WndBase *self) -> sw::Font {
+              return self->_font;
           },
           // set
-          [this](const sw::Font &value) {
-              this->_font = value;
-              this->UpdateFont();
+          [](WndBase *self, const sw::Font &value) {
+              self->_font = value;
+              self->UpdateFont();
           }),
 
       FontName(
+          this,
           // get
-          [this]() -> std::wstring {
-              return this->_font.name;
+          [](WndBase *self) -> std::wstring {
+              return self->_font.name;
           },
           // set
-          [this](const std::wstring &value) {
-              if (this->_font.name != value) {
-                  this->_font.name = value;
-                  this->UpdateFont();
+          [](WndBase *self, const std::wstring &value) {
+              if (self->_font.name != value) {
+                  self->_font.name = value;
+                  self->UpdateFont();
               }
           }),
 
       FontSize(
+          this,
           // get
-          [this]() -> double {
-              return this->_font.size;
+          [](WndBase *self) -> double {
+              return self->_font.size;
           },
           // set
-          [this](const double &value) {
-              if (this->_font.size != value) {
-                  this->_font.size = value;
-                  this->UpdateFont();
+          [](WndBase *self, const double &value) {
+              if (self->_font.size != value) {
+                  self->_font.size = value;
+                  self->UpdateFont();
               }
           }),
 
       FontWeight(
+          this,
           // get
-          [this]() -> sw::FontWeight {
-              return this->_font.weight;
+          [](WndBase *self) -> sw::FontWeight {
+              return self->_font.weight;
           },
           // set
-          [this](const sw::FontWeight &value) {
-              if (this->_font.weight != value) {
-                  this->_font.weight = value;
-                  this->UpdateFont();
+          [](WndBase *self, const sw::FontWeight &value) {
+              if (self->_font.weight != value) {
+                  self->_font.weight = value;
+                  self->UpdateFont();
               }
           }),
 
       Rect(
+          this,
           // get
-          [this]() -> sw::Rect {
-              return this->_rect;
+          [](WndBase *self) -> sw::Rect {
+              return self->_rect;
           },
           // set
-          [this](const sw::Rect &value) {
-              if (this->_rect != value) {
+          [](WndBase *self, const sw::Rect &value) {
+              if (self->_rect != value) {
                   int left   = Dip::DipToPxX(value.left);
                   int top    = Dip::DipToPxY(value.top);
                   int width  = Dip::DipToPxX(value.width);
                   int height = Dip::DipToPxY(value.height);
-                  SetWindowPos(this->_hwnd, NULL, left, top, width, height, SWP_NOACTIVATE | SWP_NOZORDER);
+                  SetWindowPos(self->_hwnd, NULL, left, top, width, height, SWP_NOACTIVATE | SWP_NOZORDER);
               }
           }),
 
       Left(
+          this,
           // get
-          [this]() -> double {
-              return this->_rect.left;
+          [](WndBase *self) -> double {
+              return self->_rect.left;
           },
           // set
-          [this](const double &value) {
-              if (this->_rect.left != value) {
+          [](WndBase *self, const double &value) {
+              if (self->_rect.left != value) {
                   int x = Dip::DipToPxX(value);
-                  int y = Dip::DipToPxY(this->_rect.top);
-                  SetWindowPos(this->_hwnd, NULL, x, y, 0, 0, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOSIZE);
+                  int y = Dip::DipToPxY(self->_rect.top);
+                  SetWindowPos(self->_hwnd, NULL, x, y, 0, 0, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOSIZE);
               }
           }),
 
       Top(
+          this,
           // get
-          [this]() -> double {
-              return this->_rect.top;
+          [](WndBase *self) -> double {
+              return self->_rect.top;
           },
           // set
-          [this](const double &value) {
-              if (this->_rect.top != value) {
-                  int x = Dip::DipToPxX(this->_rect.left);
+          [](WndBase *self, const double &value) {
+              if (self->_rect.top != value) {
+                  int x = Dip::DipToPxX(self->_rect.left);
                   int y = Dip::DipToPxY(value);
-                  SetWindowPos(this->_hwnd, NULL, x, y, 0, 0, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOSIZE);
+                  SetWindowPos(self->_hwnd, NULL, x, y, 0, 0, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOSIZE);
               }
           }),
 
       Width(
+          this,
           // get
-          [this]() -> double {
-              return this->_rect.width;
+          [](WndBase *self) -> double {
+              return self->_rect.width;
           },
           // set
-          [this](const double &value) {
-              if (this->_rect.width != value) {
+          [](WndBase *self, const double &value) {
+              if (self->_rect.width != value) {
                   int cx = Dip::DipToPxX(value);
-                  int cy = Dip::DipToPxY(this->_rect.height);
-                  SetWindowPos(this->_hwnd, NULL, 0, 0, cx, cy, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOMOVE);
+                  int cy = Dip::DipToPxY(self->_rect.height);
+                  SetWindowPos(self->_hwnd, NULL, 0, 0, cx, cy, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOMOVE);
               }
           }),
 
       Height(
+          this,
           // get
-          [this]() -> double {
-              return this->_rect.height;
+          [](WndBase *self) -> double {
+              return self->_rect.height;
           },
           // set
-          [this](const double &value) {
-              if (this->_rect.height != value) {
-                  int cx = Dip::DipToPxX(this->_rect.width);
+          [](WndBase *self, const double &value) {
+              if (self->_rect.height != value) {
+                  int cx = Dip::DipToPxX(self->_rect.width);
                   int cy = Dip::DipToPxY(value);
-                  SetWindowPos(this->_hwnd, NULL, 0, 0, cx, cy, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOMOVE);
+                  SetWindowPos(self->_hwnd, NULL, 0, 0, cx, cy, SWP_NOACTIVATE | SWP_NOZORDER | SWP_NOMOVE);
               }
           }),
 
       ClientRect(
+          this,
           // get
-          [this]() -> sw::Rect {
+          [](WndBase *self) -> sw::Rect {
               RECT rect;
-              GetClientRect(this->_hwnd, &rect);
+              GetClientRect(self->_hwnd, &rect);
               return rect;
           }),
 
       ClientWidth(
+          this,
           // get
-          [this]() -> double {
-              return this->ClientRect->width;
+          [](WndBase *self) -> double {
+              return self->ClientRect->width;
           }),
 
       ClientHeight(
+          this,
           // get
-          [this]() -> double {
-              return this->ClientRect->height;
+          [](WndBase *self) -> double {
+              return self->ClientRect->height;
           }),
 
       Enabled(
+          this,
           // get
-          [this]() -> bool {
-              return IsWindowEnabled(this->_hwnd);
+          [](WndBase *self) -> bool {
+              return IsWindowEnabled(self->_hwnd);
           },
           // set
-          [this](const bool &value) {
-              EnableWindow(this->_hwnd, value);
+          [](WndBase *self, const bool &value) {
+              EnableWindow(self->_hwnd, value);
           }),
 
       Visible(
+          this,
           // get
-          [this]() -> bool {
-              return this->GetStyle(WS_VISIBLE);
+          [](WndBase *self) -> bool {
+              return self->GetStyle(WS_VISIBLE);
           },
           // set
-          [this](const bool &value) {
-              ShowWindow(this->_hwnd, value ? SW_SHOW : SW_HIDE);
-              this->VisibleChanged(value);
+          [](WndBase *self, const bool &value) {
+              ShowWindow(self->_hwnd, value ? SW_SHOW : SW_HIDE);
+              self->VisibleChanged(value);
           }),
 
       Text(
+          this,
           // get
-          [this]() -> std::wstring {
-              return this->GetInternalText();
+          [](WndBase *self) -> std::wstring {
+              return self->GetInternalText();
           },
           // set
-          [this](const std::wstring &value) {
-              this->SetInternalText(value);
+          [](WndBase *self, const std::wstring &value) {
+              self->SetInternalText(value);
           }),
 
       Focused(
+          this,
           // get
-          [this]() -> bool {
-              return this->_focused;
+          [](WndBase *self) -> bool {
+              return self->_focused;
           },
           // set
-          [this](const bool &value) {
-              SetFocus(value ? this->_hwnd : NULL);
+          [](WndBase *self, const bool &value) {
+              SetFocus(value ? self->_hwnd : NULL);
           }),
 
       Parent(
+          this,
           // get
-          [this]() -> WndBase * {
-              HWND hwnd = GetParent(this->_hwnd);
+          [](WndBase *self) -> WndBase * {
+              HWND hwnd = GetParent(self->_hwnd);
               return WndBase::GetWndBase(hwnd);
           }),
 
       IsDestroyed(
+          this,
           // get
-          [this]() -> bool {
-              return this->_isDestroyed;
+          [](WndBase *self) -> bool {
+              return self->_isDestroyed;
           }),
 
       AcceptFiles(
+          this,
           // get
-          [this]() -> bool {
-              return this->GetExtendedStyle(WS_EX_ACCEPTFILES);
+          [](WndBase *self) -> bool {
+              return self->GetExtendedStyle(WS_EX_ACCEPTFILES);
           },
           // set
-          [this](const bool &value) {
-              this->SetExtendedStyle(WS_EX_ACCEPTFILES, value);
+          [](WndBase *self, const bool &value) {
+              self->SetExtendedStyle(WS_EX_ACCEPTFILES, value);
           }),
 
       IsControl(
+          this,
           // get
-          [this]() -> bool {
-              return this->_isControl;
+          [](WndBase *self) -> bool {
+              return self->_isControl;
           }),
 
       ClassName(
+          this,
           // get
-          [this]() -> std::wstring {
+          [](WndBase *self) -> std::wstring {
               std::wstring result(256, L'\0');
-              result.resize(GetClassNameW(this->_hwnd, &result[0], (int)result.size()));
+              result.resize(GetClassNameW(self->_hwnd, &result[0], (int)result.size()));
               return result;
           }),
 
       GroupStart(
+          this,
           // get
-          [this]() -> bool {
-              return this->GetStyle(WS_GROUP);
+          [](WndBase *self) -> bool {
+              return self->GetStyle(WS_GROUP);
           },
           // set
-          [this](const bool &value) {
-              this->SetStyle(WS_GROUP, value);
+          [](WndBase *self, const bool &value) {
+              self->SetStyle(WS_GROUP, value);
           })
 {
     this->_font = sw::Font::GetDefaultFont();
@@ -277,7 +304,7 @@ sw::WndBase::~WndBase()
         DestroyWindow(this->_hwnd);
     }
     if (this->_hfont != NULL) {
-        DeleteObject(this->_hfont);
+        FontCache::Release(this->_hfont);
     }
 }
 
@@ -716,6 +743,11 @@ LRESULT sw::WndBase::WndProc(const ProcMsg &refMsg)
             return 0;
         }
 
+        case WM_FlushLayout: {
+            LayoutScheduler::Flush();
+            return 0;
+        }
+
         default: {
             return this->DefaultWndProc(refMsg);
         }
@@ -1058,11 +1090,15 @@ void sw::WndBase::Update()
 
 void sw::WndBase::UpdateFont()
 {
-    if (this->_hfont != NULL) {
-        DeleteObject(this->_hfont);
-    }
-    this->_hfont = this->_font.CreateHandle();
+    // 先获取新句柄再释放旧句柄，字体未改变时可直接复用同一个句柄
+    HFONT hfontOld = this->_hfont;
+
+    this->_hfont = FontCache::Acquire(this->_font);
     this->SendMessageW(WM_SETFONT, (WPARAM)this->_hfont, TRUE);
+
+    if (hfontOld != NULL) {
+        FontCache::Release(hfontOld);
+    }
     this->FontChanged(this->_hfont);
 }
 
@@ -1176,6 +1212,12 @@ void sw::WndBase::Invoke(const SimpleAction &action)
     if (this->CheckAccess())
         action();
     else {
+        if (MsgMonitor::IsEnabled()) {
+            // 记录从发送到开始执行的时间
+            Action<> a = MsgMonitor::MakeQueuedCall(WM_InvokeAction, [&action] { action(); });
+            this->SendMessageW(WM_InvokeAction, false, reinterpret_cast<LPARAM>(&a));
+            return;
+        }
         Action<> &a = const_cast<Action<> &>(action); // safe here
         this->SendMessageW(WM_InvokeAction, false, reinterpret_cast<LPARAM>(&a));
     }
@@ -1186,11 +1228,15 @@ void sw::WndBase::InvokeAsync(const SimpleAction &action)
     if (action == nullptr)
         return;
     else {
-        Action<> *p = new Action<>(action);
-        this->PostMessageW(WM_InvokeAction, true, reinterpret_cast<LPARAM>(p));
+        this->InvokeAsync(action, DispatchPriority::Render);
     }
 }
 
+sw::Dispatcher &sw::WndBase::GetDispatcher() const
+{
+    return *this->_dispatcher;
+}
+
 DWORD sw::WndBase::GetThreadId() const
 {
     return GetWindowThreadProcessId(this->_hwnd, NULL);
@@ -1222,7 +1268,18 @@ LRESULT sw::WndBase::_WndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam
 
     if (pWnd != nullptr) {
         ProcMsg msg{hwnd, uMsg, wParam, lParam};
-        return pWnd->WndProc(msg);
+        if (!MsgMonitor::IsEnabled()) {
+            return pWnd->WndProc(msg);
+        }
+
+        LRESULT result;
+        {
+            MsgMonitor::DispatchScope scope(uMsg, typeid(*pWnd).name(), reinterpret_cast<uint64_t>(hwnd));
+            result = pWnd->WndProc(msg);
+        }
+        // 模态对话框或菜单的消息循环进入空闲状态，此时线程在等待消息而不是卡顿
+        if (uMsg == WM_ENTERIDLE) MsgMonitor::NotifyIdle();
+        return result;
     }
 
     return DefWindowProcW(hwnd, uMsg, wParam, lParam);
@@ -1253,6 +1310,20 @@ void sw::WndBase::_SetWndBase(HWND hwnd, WndBase &wnd)
     SetPropW(hwnd, _WndBasePtrProp, reinterpret_cast<HANDLE>(&wnd));
 }
 
+std::shared_ptr<bool> sw::WndBase::_GetAliveToken()
+{
+    std::shared_ptr<bool> token = std::atomic_load(&this->_aliveToken);
+
+    if (token == nullptr) {
+        std::shared_ptr<bool> created = std::make_shared<bool>(true);
+        // 其他线程已创建令牌时token被更新为已有的令牌
+        if (std::atomic_compare_exchange_strong(&this->_aliveToken, &token, created)) {
+            token = std::move(created);
+        }
+    }
+    return token;
+}
+
 sw::WndBase *sw::WndBase::GetWndBase(HWND hwnd)
 {
     auto p = reinterpret_cast<WndBase *>(GetPropW(hwnd, _WndBasePtrProp));
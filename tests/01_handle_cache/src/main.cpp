@@ -0,0 +1,164 @@
+#include "HandleCache.h"
+#include "Test.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 与BrushCache相同的键与句柄形式，键为COLORREF，句柄为指针大小的整数
+ */
+using TestCache = sw::HandleCache<uint32_t, uintptr_t>;
+
+/**
+ * @brief 记录句柄的创建与销毁
+ */
+struct HandleLog {
+    uintptr_t nextHandle = 1;
+    std::vector<uint32_t> created;
+    std::vector<uintptr_t> destroyed;
+
+    TestCache::FnCreate Create()
+    {
+        return [this](const uint32_t &key) -> uintptr_t {
+            this->created.push_back(key);
+            return key == 0 ? 0 : this->nextHandle++;
+        };
+    }
+
+    TestCache::FnDestroy Destroy()
+    {
+        return [this](uintptr_t handle) {
+            this->destroyed.push_back(handle);
+        };
+    }
+};
+
+/**
+ * @brief 相同的键共享同一个句柄，并分别计入命中与未命中
+ */
+static void TestSharing()
+{
+    HandleLog log;
+    {
+        TestCache cache(log.Create(), log.Destroy(), 4);
+
+        uintptr_t red1  = cache.Acquire(0xff0000);
+        uintptr_t red2  = cache.Acquire(0xff0000);
+        uintptr_t green = cache.Acquire(0x00ff00);
+
+        TEST_CHECK(red1 != 0 && red1 == red2);
+        TEST_CHECK(green != 0 && green != red1);
+        TEST_CHECK(log.created.size() == 2);
+
+        sw::HandleCacheStats stats = cache.GetStats();
+        TEST_CHECK(stats.hits == 1);
+        TEST_CHECK(stats.misses == 2);
+        TEST_CHECK(stats.liveHandles == 2);
+        TEST_CHECK(stats.idleHandles == 0);
+
+        // 仍被引用的句柄不会被销毁
+        TEST_CHECK(cache.Release(red1));
+        TEST_CHECK(cache.GetStats().idleHandles == 0);
+        TEST_CHECK(cache.Release(red2));
+        TEST_CHECK(cache.GetStats().idleHandles == 1);
+        TEST_CHECK(log.destroyed.empty());
+
+        // 多余的Release与不属于缓存的句柄
+        TEST_CHECK(!cache.Release(red1));
+        TEST_CHECK(!cache.Release(12345));
+
+        // 空闲句柄被再次获取时复用
+        TEST_CHECK(cache.Acquire(0xff0000) == red1);
+        TEST_CHECK(cache.GetStats().idleHandles == 0);
+        TEST_CHECK(log.created.size() == 2);
+    }
+
+    // 析构时销毁所有句柄，包括仍被引用的句柄
+    TEST_CHECK(log.destroyed.size() == 2);
+}
+
+/**
+ * @brief 空闲句柄超过上限时销毁最早释放的句柄
+ */
+static void TestLruEviction()
+{
+    HandleLog log;
+    TestCache cache(log.Create(), log.Destroy(), 2);
+
+    uintptr_t a = cache.Acquire(1);
+    uintptr_t b = cache.Acquire(2);
+    uintptr_t c = cache.Acquire(3);
+
+    cache.Release(a);
+    cache.Release(b);
+    TEST_CHECK(log.destroyed.empty());
+
+    // 重新获取b后再释放，b成为最近释放的句柄，a是最早释放的
+    TEST_CHECK(cache.Acquire(2) == b);
+    cache.Release(b);
+    cache.Release(c);
+
+    TEST_CHECK(log.destroyed.size() == 1 && log.destroyed[0] == a);
+
+    sw::HandleCacheStats stats = cache.GetStats();
+    TEST_CHECK(stats.evictions == 1);
+    TEST_CHECK(stats.liveHandles == 2);
+    TEST_CHECK(stats.idleHandles == 2);
+
+    // 被淘汰的键再次获取时重新创建
+    uintptr_t a2 = cache.Acquire(1);
+    TEST_CHECK(a2 != 0 && a2 != a);
+    TEST_CHECK(cache.GetStats().misses == 4);
+
+    // 降低上限时立即销毁多余的空闲句柄，从最早释放的开始
+    cache.SetMaxIdleCount(1);
+    TEST_CHECK(log.destroyed.size() == 2 && log.destroyed[1] == b);
+    TEST_CHECK(cache.GetMaxIdleCount() == 1);
+
+    // Trim销毁所有空闲句柄，不影响仍被引用的句柄
+    cache.Trim();
+    TEST_CHECK(log.destroyed.size() == 3 && log.destroyed[2] == c);
+    TEST_CHECK(cache.GetStats().liveHandles == 1);
+
+    cache.ResetStats();
+    stats = cache.GetStats();
+    TEST_CHECK(stats.hits == 0 && stats.misses == 0 && stats.evictions == 0);
+    TEST_CHECK(stats.liveHandles == 1);
+}
+
+/**
+ * @brief 上限为0时句柄在不被引用后立即销毁
+ */
+static void TestNoIdle()
+{
+    HandleLog log;
+    TestCache cache(log.Create(), log.Destroy(), 0);
+
+    uintptr_t a = cache.Acquire(1);
+    cache.Release(a);
+    TEST_CHECK(log.destroyed.size() == 1 && log.destroyed[0] == a);
+    TEST_CHECK(cache.GetStats().liveHandles == 0);
+}
+
+/**
+ * @brief 创建失败的句柄不会被缓存
+ */
+static void TestCreateFailure()
+{
+    HandleLog log;
+    TestCache cache(log.Create(), log.Destroy(), 4);
+
+    TEST_CHECK(cache.Acquire(0) == 0);
+    TEST_CHECK(cache.Acquire(0) == 0);
+    TEST_CHECK(log.created.size() == 2);
+    TEST_CHECK(cache.GetStats().liveHandles == 0);
+    TEST_CHECK(cache.GetStats().misses == 2);
+}
+
+int main()
+{
+    TestSharing();
+    TestLruEviction();
+    TestNoIdle();
+    TestCreateFailure();
+    return test::Report("handle_cache");
+}
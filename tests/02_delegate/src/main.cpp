@@ -0,0 +1,220 @@
+#include "Delegate.h"
+#include "Test.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 多播调用时，带状态的可调用对象在多次调用之间保持状态
+ */
+static void TestStatefulMulticast()
+{
+    std::vector<int> calls;
+
+    sw::Action<> action;
+    action += [&calls, n = 0]() mutable { calls.push_back(++n); };
+    action += [&calls, n = 100]() mutable { calls.push_back(++n); };
+
+    // 超出内部存储尺寸的可调用对象存储在堆上
+    action += [&calls, n = 1000, text = std::string(64, 'x')]() mutable { calls.push_back(++n + 0 * (int)text.size()); };
+
+    action();
+    action();
+    action();
+
+    std::vector<int> expected = {1, 101, 1001, 2, 102, 1002, 3, 103, 1003};
+    TEST_CHECK(calls == expected);
+}
+
+/**
+ * @brief InvokeAll同样保持状态
+ */
+static void TestStatefulInvokeAll()
+{
+    sw::Func<int> func;
+    func += [n = 0]() mutable { return ++n; };
+    func += [n = 10]() mutable { return ++n; };
+
+    func.InvokeAll();
+    std::vector<int> results = func.InvokeAll();
+    TEST_CHECK(results.size() == 2 && results[0] == 2 && results[1] == 12);
+}
+
+/**
+ * @brief 调用过程中修改委托时，本次调用使用调用开始时的列表
+ */
+static void TestReentrantModification()
+{
+    int first = 0, second = 0, added = 0;
+
+    sw::Action<> action;
+    auto addHandler = [&added]() { ++added; };
+
+    action += [&]() {
+        ++first;
+        action.Clear();
+        action += addHandler;
+    };
+    action += [&second]() { ++second; };
+
+    action();
+    TEST_CHECK(first == 1 && second == 1 && added == 0);
+
+    action();
+    TEST_CHECK(first == 1 && second == 1 && added == 1);
+}
+
+/**
+ * @brief 调用过程中销毁委托不影响本次调用的其余可调用对象
+ */
+static void TestDestroyDuringInvoke()
+{
+    int count = 0;
+
+    std::unique_ptr<sw::Action<>> action(new sw::Action<>);
+    *action += [&]() { ++count; action.reset(); };
+    *action += [&count]() { ++count; };
+
+    (*action)();
+    TEST_CHECK(count == 2 && action == nullptr);
+}
+
+/**
+ * @brief 用于检测可调用对象在调用过程中是否已被销毁
+ */
+struct AliveMarker {
+    int value = 1;
+    AliveMarker() = default;
+    AliveMarker(const AliveMarker &) = default;
+    ~AliveMarker() { value = 0; }
+};
+
+/**
+ * @brief 唯一的可调用对象在调用过程中向委托添加多个可调用对象时，正在执行的对象不会被移动或销毁
+ */
+static void TestReentrantAddFromSingleHandler()
+{
+    int added = 0, checked = 0;
+    sw::Action<> action;
+    auto addHandler = [&added]() { ++added; };
+
+    // 可以存储在委托内部的可调用对象
+    action += [&, self = &action]() {
+        for (int i = 0; i < 4; ++i) {
+            *self += addHandler;
+        }
+        checked += self == &action;
+    };
+    action();
+    TEST_CHECK(checked == 1 && added == 0);
+
+    action();
+    TEST_CHECK(checked == 2 && added == 4);
+
+    // 带析构函数的可调用对象存储在堆上并在调用期间被共享
+    sw::Action<> other;
+    bool alive = false;
+    other += [self = &other, result = &alive, marker = AliveMarker()]() {
+        for (int i = 0; i < 4; ++i) {
+            *self += []() {};
+        }
+        *result = marker.value == 1;
+    };
+    other();
+    TEST_CHECK(alive);
+}
+
+/**
+ * @brief 多个线程同时调用同一个委托时，调用不会修改委托
+ */
+static void TestConcurrentInvoke()
+{
+    std::atomic<int> count{0};
+
+    sw::Action<> action;
+    action += [&count]() { ++count; };
+    action += [&count]() { ++count; };
+
+    auto run = [&action]() {
+        for (int i = 0; i < 10000; ++i) {
+            action();
+        }
+    };
+    std::thread worker(run);
+    run();
+    worker.join();
+
+    TEST_CHECK(count == 40000);
+}
+
+/**
+ * @brief 用于测试成员函数绑定的类型
+ */
+struct Receiver {
+    void OnEvent() {}
+};
+
+/**
+ * @brief 复制与移除不受共享存储的影响
+ */
+static void TestCopyAndRemove()
+{
+    int count = 0;
+    Receiver receiver;
+
+    sw::Action<> action(receiver, &Receiver::OnEvent);
+    action += [&count]() { count += 10; };
+    action();
+    TEST_CHECK(count == 10);
+
+    // 复制的委托拥有各自的可调用对象
+    sw::Action<> copy = action;
+    copy.Remove(receiver, &Receiver::OnEvent);
+    TEST_CHECK(copy != action);
+
+    copy();
+    TEST_CHECK(count == 20);
+
+    // 移动后原委托为空
+    sw::Action<> moved = std::move(action);
+    TEST_CHECK(action == nullptr);
+    moved();
+    TEST_CHECK(count == 30);
+}
+
+/**
+ * @brief 较多的可调用对象在扩容与移除时移动而不是复制，状态随之保留
+ */
+static void TestMoveOnGrowth()
+{
+    std::vector<int> calls;
+    Receiver receiver;
+
+    sw::Action<> action(receiver, &Receiver::OnEvent);
+    for (int i = 1; i <= 8; ++i) {
+        action += [&calls, i, n = 0]() mutable { calls.push_back(i * 10 + ++n); };
+    }
+
+    // 移除第一个可调用对象时其余对象依次前移
+    action();
+    action.Remove(receiver, &Receiver::OnEvent);
+    action();
+
+    TEST_CHECK(calls.size() == 16);
+    TEST_CHECK(calls[0] == 11 && calls[8] == 12 && calls[15] == 82);
+}
+
+int main()
+{
+    TestStatefulMulticast();
+    TestStatefulInvokeAll();
+    TestReentrantModification();
+    TestDestroyDuringInvoke();
+    TestReentrantAddFromSingleHandler();
+    TestConcurrentInvoke();
+    TestCopyAndRemove();
+    TestMoveOnGrowth();
+    return test::Report("delegate");
+}
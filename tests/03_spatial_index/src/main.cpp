@@ -0,0 +1,171 @@
+#include "SpatialIndex.h"
+#include "Test.hpp"
+#include <random>
+#include <vector>
+
+/**
+ * @brief 逐个判断的命中测试，序号最大的项优先
+ */
+static int LinearHitTest(const std::vector<sw::Rect> &rects, const sw::Point &point)
+{
+    for (int i = (int)rects.size() - 1; i >= 0; --i) {
+        const sw::Rect &rect = rects[i];
+        if (rect.width > 0 && rect.height > 0 &&
+            point.x >= rect.left && point.x < rect.left + rect.width &&
+            point.y >= rect.top && point.y < rect.top + rect.height) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 逐个判断的矩形查询
+ */
+static std::vector<int> LinearQueryRect(const std::vector<sw::Rect> &rects, const sw::Rect &query)
+{
+    std::vector<int> result;
+    for (int i = 0; i < (int)rects.size(); ++i) {
+        const sw::Rect &rect = rects[i];
+        if (rect.width > 0 && rect.height > 0 &&
+            rect.left < query.left + query.width && query.left < rect.left + rect.width &&
+            rect.top < query.top + query.height && query.top < rect.top + rect.height) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 对比索引与逐个判断的结果
+ */
+static bool MatchesLinear(const sw::SpatialIndex &index, const std::vector<sw::Rect> &rects)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> pos(-200, 2200);
+    std::uniform_real_distribution<double> size(1, 800);
+    std::vector<int> result;
+
+    for (int i = 0; i < 500; ++i) {
+        sw::Point point(pos(random), pos(random));
+        if (index.HitTest(point) != LinearHitTest(rects, point)) {
+            return false;
+        }
+
+        sw::Rect query(point.x, point.y, size(random), size(random));
+        index.QueryRect(query, result);
+        if (result != LinearQueryRect(rects, query)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 生成随机矩形，包含负坐标与覆盖大量网格的项
+ */
+static std::vector<sw::Rect> MakeRects(int count)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> pos(-100, 2000);
+    std::uniform_real_distribution<double> size(5, 150);
+
+    std::vector<sw::Rect> rects;
+    for (int i = 0; i < count; ++i) {
+        if (i % 50 == 0) {
+            rects.emplace_back(pos(random), pos(random), 1500, 1500);
+        } else {
+            rects.emplace_back(pos(random), pos(random), size(random), size(random));
+        }
+    }
+    return rects;
+}
+
+/**
+ * @brief 基本的命中测试与矩形查询
+ */
+static void TestQueries()
+{
+    std::vector<sw::Rect> rects = MakeRects(400);
+
+    sw::SpatialIndex index(64);
+    for (int i = 0; i < (int)rects.size(); ++i) index.Update(i, rects[i]);
+
+    TEST_CHECK(index.GetCount() == (int)rects.size());
+    TEST_CHECK(MatchesLinear(index, rects));
+
+    // 右边与底边不计入矩形
+    sw::SpatialIndex single;
+    single.Update(0, sw::Rect(10, 10, 20, 20));
+    TEST_CHECK(single.HitTest(sw::Point(10, 10)) == 0);
+    TEST_CHECK(single.HitTest(sw::Point(30, 10)) == -1);
+    TEST_CHECK(single.HitTest(sw::Point(10, 30)) == -1);
+}
+
+/**
+ * @brief 改变网格尺寸后按各项的矩形重新计算覆盖的网格
+ */
+static void TestSetCellSize()
+{
+    std::vector<sw::Rect> rects = MakeRects(400);
+
+    sw::SpatialIndex index(64);
+    for (int i = 0; i < (int)rects.size(); ++i) index.Update(i, rects[i]);
+
+    for (double cellSize : {16.0, 1000.0, 64.0, 7.5}) {
+        index.SetCellSize(cellSize);
+        TEST_CHECK(index.GetCellSize() == cellSize);
+        TEST_CHECK(MatchesLinear(index, rects));
+    }
+
+    // 改变网格尺寸后继续更新与移除
+    for (int i = 0; i < (int)rects.size(); i += 3) {
+        rects[i].left += 37;
+        rects[i].top -= 11;
+        index.Update(i, rects[i]);
+    }
+    for (int i = 1; i < (int)rects.size(); i += 7) {
+        rects[i] = sw::Rect();
+        index.Remove(i);
+    }
+    TEST_CHECK(MatchesLinear(index, rects));
+}
+
+/**
+ * @brief 移动、移除与截断
+ */
+static void TestUpdateAndRemove()
+{
+    std::vector<sw::Rect> rects = MakeRects(200);
+
+    sw::SpatialIndex index(100);
+    for (int i = 0; i < (int)rects.size(); ++i) index.Update(i, rects[i]);
+
+    // 尺寸为0的矩形等同于移除
+    rects[5] = sw::Rect();
+    index.Update(5, sw::Rect(100, 100, 0, 10));
+    TEST_CHECK(!index.Contains(5));
+
+    rects[6] = sw::Rect(1900, 1900, 400, 400);
+    index.Update(6, rects[6]);
+    TEST_CHECK(index.Contains(6));
+    TEST_CHECK(index.GetRect(6) == rects[6]);
+    TEST_CHECK(MatchesLinear(index, rects));
+
+    rects.resize(120);
+    index.SetCount(120);
+    TEST_CHECK(index.GetCount() == 120);
+    TEST_CHECK(MatchesLinear(index, rects));
+
+    index.Clear();
+    TEST_CHECK(index.GetCount() == 0);
+    TEST_CHECK(index.HitTest(rects[0].GetPos()) == -1);
+}
+
+int main()
+{
+    TestQueries();
+    TestSetCellSize();
+    TestUpdateAndRemove();
+    return test::Report("spatial_index");
+}
@@ -0,0 +1,222 @@
+#include "DispatchQueue.h"
+#include "Test.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 不同优先级的回调按优先级执行，同一优先级按添加顺序执行
+ */
+static void TestPriorityOrder()
+{
+    sw::DispatchQueue queue(4);
+    std::vector<int> order;
+
+    TEST_CHECK(queue.Enqueue([&order] { order.push_back(20); }, sw::DispatchPriority::Background));
+    TEST_CHECK(!queue.Enqueue([&order] { order.push_back(10); }, sw::DispatchPriority::Render));
+    queue.Enqueue([&order] { order.push_back(11); }, sw::DispatchPriority::Render);
+    queue.Enqueue([&order] { order.push_back(0); }, sw::DispatchPriority::Input);
+
+    // 超出环形缓冲区容量的回调进入溢出队列，仍按顺序执行
+    for (int i = 12; i < 20; ++i) {
+        queue.Enqueue([&order, i] { order.push_back(i); }, sw::DispatchPriority::Render);
+    }
+
+    // 执行期间加入的高优先级回调先执行
+    queue.Enqueue([&] {
+        order.push_back(1);
+        queue.Enqueue([&order] { order.push_back(2); }, sw::DispatchPriority::Input);
+    },
+                  sw::DispatchPriority::Input);
+
+    TEST_CHECK(queue.Run(1000) == 14);
+    std::vector<int> expected = {0, 1, 2, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    TEST_CHECK(order == expected);
+    TEST_CHECK(!queue.HasPending());
+    TEST_CHECK(!queue.EndRun());
+}
+
+/**
+ * @brief 唤醒标记保证队列非空期间只请求一次唤醒
+ */
+static void TestWake()
+{
+    sw::DispatchQueue queue;
+    int count = 0;
+
+    TEST_CHECK(queue.Enqueue([&count] { ++count; }));
+    TEST_CHECK(!queue.Enqueue([&count] { ++count; }));
+
+    // 低于指定优先级的回调保留在队列中，EndRun要求再次唤醒
+    queue.Enqueue([&count] { count += 100; }, sw::DispatchPriority::Background);
+    queue.Run(1000, sw::DispatchPriority::Render);
+    TEST_CHECK(count == 2);
+    TEST_CHECK(queue.HasPending());
+    TEST_CHECK(!queue.HasPending(sw::DispatchPriority::Render));
+    TEST_CHECK(queue.EndRun());
+
+    queue.Run(1000);
+    TEST_CHECK(count == 102);
+    TEST_CHECK(!queue.EndRun());
+
+    // 唤醒失败后下一次添加重新请求唤醒
+    TEST_CHECK(queue.Enqueue([] {}));
+    queue.CancelWake();
+    TEST_CHECK(queue.Enqueue([] {}));
+    queue.Run(1000);
+    TEST_CHECK(!queue.EndRun());
+}
+
+/**
+ * @brief 预算为0时至少执行一个回调，剩余的回调保留在队列中
+ */
+static void TestBudget()
+{
+    sw::DispatchQueue queue;
+    int count = 0;
+
+    for (int i = 0; i < 3; ++i) queue.Enqueue([&count] { ++count; });
+    TEST_CHECK(queue.Run(0) == 1);
+    TEST_CHECK(count == 1 && queue.HasPending());
+    queue.Run(1000);
+    TEST_CHECK(count == 3);
+}
+
+/**
+ * @brief 回调抛出异常时异常传递给调用方，其余回调保留在队列中
+ */
+static void TestException()
+{
+    sw::DispatchQueue queue;
+    int count = 0;
+
+    queue.Enqueue([] { throw std::string("error"); });
+    queue.Enqueue([&count] { ++count; });
+
+    bool thrown = false;
+    try {
+        queue.Run(1000);
+    } catch (const std::string &) {
+        thrown = true;
+    }
+    TEST_CHECK(thrown && count == 0);
+    queue.Run(1000);
+    TEST_CHECK(count == 1);
+}
+
+/**
+ * @brief 超出内部缓冲区的对象与未执行的回调都会被正确销毁
+ */
+static void TestDestroy()
+{
+    auto token = std::make_shared<int>(0);
+    {
+        sw::DispatchQueue queue(2);
+        std::string large(200, 'x');
+        for (int i = 0; i < 6; ++i) {
+            queue.Enqueue([token, large] { *token += (int)large.size(); });
+        }
+        queue.Run(0);
+        TEST_CHECK(*token == 200);
+        TEST_CHECK(token.use_count() == 6);
+    }
+    TEST_CHECK(token.use_count() == 1);
+}
+
+/**
+ * @brief Clear销毁所有优先级中未执行的回调，包括溢出队列中的回调
+ */
+static void TestClear()
+{
+    auto token = std::make_shared<int>(0);
+    sw::DispatchQueue queue(2);
+
+    for (int i = 0; i < 5; ++i) {
+        queue.Enqueue([token] { ++*token; }, sw::DispatchPriority::Input);
+        queue.Enqueue([token] { ++*token; }, sw::DispatchPriority::Background);
+    }
+    TEST_CHECK(queue.Clear() == 10);
+    TEST_CHECK(token.use_count() == 1);
+    TEST_CHECK(!queue.HasPending());
+
+    // 清空后队列仍可继续使用
+    queue.Enqueue([token] { ++*token; });
+    TEST_CHECK(queue.Run(1000) == 1);
+    TEST_CHECK(*token == 1);
+}
+
+/**
+ * @brief 多个生产者同时添加回调，每个生产者的同一优先级的回调按顺序执行且不丢失
+ */
+static void TestConcurrentOrder(size_t capacity, int producerCount, int perProducer)
+{
+    sw::DispatchQueue queue(capacity);
+    std::vector<int> lastSeq(producerCount * sw::DispatchQueue::PriorityCount, -1);
+    int outOfOrder = 0;
+    int executed   = 0;
+    int total      = producerCount * perProducer;
+
+    std::atomic<int> wakes{0};
+
+    std::thread consumer([&] {
+        while (executed < total) {
+            if (wakes.load() == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            --wakes;
+            for (;;) {
+                queue.Run(0.1);
+                if (queue.HasPending()) continue;
+                if (queue.EndRun()) ++wakes;
+                break;
+            }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < perProducer; ++i) {
+                auto priority = (sw::DispatchPriority)(i % 3 == 0 ? i % 2 * 2 : 1);
+                int slot      = p * sw::DispatchQueue::PriorityCount + (int)priority;
+                bool wake     = queue.Enqueue(
+                    [&, slot, i] {
+                        if (lastSeq[slot] >= i) ++outOfOrder;
+                        lastSeq[slot] = i;
+                        ++executed;
+                    },
+                    priority);
+                if (wake) ++wakes;
+            }
+        });
+    }
+
+    for (std::thread &t : producers) t.join();
+    consumer.join();
+
+    TEST_CHECK(outOfOrder == 0);
+    TEST_CHECK(executed == total);
+    TEST_CHECK(!queue.HasPending());
+}
+
+int main()
+{
+    TestPriorityOrder();
+    TestWake();
+    TestBudget();
+    TestException();
+    TestDestroy();
+    TestClear();
+
+    // 容量很小时大部分回调经过溢出队列，环形缓冲区与溢出队列之间的切换最频繁
+    for (int i = 0; i < 20; ++i) {
+        TestConcurrentOrder(16, 1, 20000);
+        TestConcurrentOrder(16, 4, 5000);
+    }
+    TestConcurrentOrder(sw::DispatchQueue::DefaultCapacity, 8, 20000);
+
+    return test::Report("dispatch_queue");
+}
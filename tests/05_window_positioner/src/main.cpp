@@ -0,0 +1,159 @@
+#include "LayoutNode.h"
+#include "StackLayoutV.h"
+#include "Test.hpp"
+#include "WindowPositioner.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 纵向排列的节点树，根节点拉伸填满可用区域，子节点宽度固定
+ */
+struct StackTree {
+    sw::StackLayoutV layout;
+    sw::LayoutNode root;
+    std::vector<std::unique_ptr<sw::LayoutNode>> children;
+
+    explicit StackTree(int count)
+    {
+        this->root.horizontalAlignment = sw::HorizontalAlignment::Stretch;
+        this->root.verticalAlignment   = sw::VerticalAlignment::Stretch;
+        this->root.SetLayout(&this->layout);
+
+        for (int i = 0; i < count; ++i) {
+            this->children.emplace_back(new sw::LayoutNode(sw::Size(100, 20)));
+            this->children.back()->horizontalAlignment = sw::HorizontalAlignment::Left;
+            this->root.AddChild(this->children.back().get());
+        }
+    }
+};
+
+/**
+ * @brief 在测试期间将当前线程的窗口定位器替换为指定的定位器
+ */
+struct PositionerScope {
+    explicit PositionerScope(sw::IWindowPositioner *positioner)
+    {
+        sw::WindowPositioner::SetCurrent(positioner);
+    }
+
+    ~PositionerScope()
+    {
+        sw::WindowPositioner::SetCurrent(nullptr);
+    }
+};
+
+/**
+ * @brief 每次布局只移动像素位置改变的节点，且所有移动在同一批次中提交
+ */
+static void TestMovesPerPass()
+{
+    StackTree tree(10);
+    sw::RecordingWindowPositioner recorder;
+    PositionerScope scope(&recorder);
+
+    // 首次布局时所有节点都需要移动
+    tree.root.UpdateLayout(sw::Size(400, 300));
+    TEST_CHECK(recorder.batchCount == 1);
+    TEST_CHECK(recorder.GetMoveCount(0) == 11);
+
+    for (const sw::RecordingWindowPositioner::Record &record : recorder.records) {
+        if (record.handle == &tree.root) {
+            TEST_CHECK(record.parentHandle == nullptr);
+        } else {
+            TEST_CHECK(record.parentHandle == &tree.root);
+        }
+    }
+    TEST_CHECK(recorder.records.back().handle == tree.children[9].get());
+    TEST_CHECK(recorder.records.back().rect.top == 180);
+    TEST_CHECK(recorder.records.back().rect.height == 20);
+
+    // 尺寸不变时不移动任何节点
+    tree.root.UpdateLayout(sw::Size(400, 300));
+    TEST_CHECK(recorder.batchCount == 2);
+    TEST_CHECK(recorder.GetMoveCount(1) == 0);
+
+    // 第4个节点变高后，它及其后的节点需要移动，之前的节点与根节点不移动
+    tree.children[3]->size.height = 30;
+    tree.root.UpdateLayout(sw::Size(400, 300));
+    TEST_CHECK(recorder.GetMoveCount(2) == 7);
+    for (const sw::RecordingWindowPositioner::Record &record : recorder.records) {
+        if (record.batch == 2) {
+            TEST_CHECK(record.handle != &tree.root);
+            TEST_CHECK(record.handle != tree.children[2].get());
+        }
+    }
+
+    // 不足半个像素的改变不会改变像素位置
+    tree.children[3]->size.height = 30.2;
+    tree.root.UpdateLayout(sw::Size(400, 300));
+    TEST_CHECK(recorder.GetMoveCount(3) == 0);
+
+    // 可用尺寸改变时只有根节点的像素位置改变
+    tree.root.UpdateLayout(sw::Size(500, 300));
+    TEST_CHECK(recorder.GetMoveCount(4) == 1);
+    TEST_CHECK(recorder.records.back().handle == &tree.root);
+    TEST_CHECK(recorder.records.back().rect.width == 500);
+
+    recorder.Clear();
+    TEST_CHECK(recorder.records.empty() && recorder.batchCount == 0);
+}
+
+/**
+ * @brief 嵌套的批次合并为一批，只有最外层批次结束时才提交
+ */
+static void TestNestedBatches()
+{
+    StackTree first(3);
+    StackTree second(4);
+    sw::RecordingWindowPositioner recorder;
+    PositionerScope scope(&recorder);
+
+    sw::WindowPositioner::BeginBatch();
+    TEST_CHECK(sw::WindowPositioner::IsInBatch());
+    uint64_t batchId = sw::WindowPositioner::GetBatchId();
+
+    first.root.UpdateLayout(sw::Size(200, 200));
+    second.root.UpdateLayout(sw::Size(200, 200));
+
+    TEST_CHECK(sw::WindowPositioner::GetBatchDepth() == 1);
+    TEST_CHECK(sw::WindowPositioner::GetBatchId() == batchId);
+    TEST_CHECK(recorder.batchCount == 0);
+
+    TEST_CHECK(sw::WindowPositioner::EndBatch());
+    TEST_CHECK(!sw::WindowPositioner::IsInBatch());
+    TEST_CHECK(!sw::WindowPositioner::EndBatch());
+
+    TEST_CHECK(recorder.batchCount == 1);
+    TEST_CHECK(recorder.GetMoveCount(0) == 9);
+}
+
+/**
+ * @brief 记录后将调用转发给下一个定位器
+ */
+static void TestForwarding()
+{
+    StackTree tree(5);
+    sw::RecordingWindowPositioner inner;
+    sw::RecordingWindowPositioner outer;
+    outer.next = &inner;
+    PositionerScope scope(&outer);
+
+    tree.root.UpdateLayout(sw::Size(300, 300));
+    tree.children[0]->size.width = 150;
+    tree.root.UpdateLayout(sw::Size(300, 300));
+
+    TEST_CHECK(inner.batchCount == 2 && outer.batchCount == 2);
+    TEST_CHECK(inner.records.size() == outer.records.size());
+    TEST_CHECK(outer.GetMoveCount(1) == 1);
+    TEST_CHECK(inner.records.back().handle == tree.children[0].get());
+    TEST_CHECK(inner.records.back().rect == outer.records.back().rect);
+    TEST_CHECK(inner.records.back().rect.width == 150);
+}
+
+int main()
+{
+    TestMovesPerPass();
+    TestNestedBatches();
+    TestForwarding();
+    return test::Report("window_positioner");
+}
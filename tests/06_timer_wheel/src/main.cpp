@@ -0,0 +1,195 @@
+#include "Test.hpp"
+#include "TimerWheel.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 一次性定时器在到期时间触发一次，之后自动停止
+ */
+static void TestOneShot()
+{
+    sw::TimerWheel wheel;
+    std::vector<uint64_t> fired;
+
+    auto id = wheel.Create([&] { fired.push_back(wheel.GetNow()); });
+    TEST_CHECK(id != 0);
+    TEST_CHECK(!wheel.IsActive(id));
+
+    TEST_CHECK(wheel.Start(id, 10));
+    TEST_CHECK(wheel.IsActive(id));
+    TEST_CHECK(wheel.GetActiveCount() == 1);
+
+    TEST_CHECK(wheel.Advance(9) == 0);
+    TEST_CHECK(fired.empty());
+
+    // 回调中GetNow返回到期时间
+    TEST_CHECK(wheel.Advance(10) == 1);
+    TEST_CHECK(fired.size() == 1 && fired[0] == 10);
+    TEST_CHECK(!wheel.IsActive(id));
+    TEST_CHECK(wheel.GetActiveCount() == 0);
+
+    TEST_CHECK(wheel.Advance(1000) == 0);
+    TEST_CHECK(fired.size() == 1);
+
+    // 到期时间不晚于当前时间时在下一次Advance中触发
+    TEST_CHECK(wheel.Start(id, 500));
+    TEST_CHECK(wheel.Advance(1000) == 1);
+    TEST_CHECK(fired.size() == 2 && fired[1] == 1000);
+}
+
+/**
+ * @brief 周期定时器按周期触发，时钟一次前进很多时仍按顺序触发每个周期
+ */
+static void TestPeriodic()
+{
+    sw::TimerWheel wheel;
+    std::vector<uint64_t> fired;
+
+    auto id = wheel.Create([&] { fired.push_back(wheel.GetNow()); });
+    wheel.Start(id, 5, 10);
+
+    TEST_CHECK(wheel.Advance(100) == 10);
+    TEST_CHECK(fired.size() == 10);
+    for (size_t i = 0; i < fired.size(); ++i) {
+        TEST_CHECK(fired[i] == 5 + 10 * i);
+    }
+    TEST_CHECK(wheel.IsActive(id));
+
+    TEST_CHECK(wheel.Stop(id));
+    TEST_CHECK(!wheel.IsActive(id));
+    TEST_CHECK(wheel.Advance(200) == 0);
+}
+
+/**
+ * @brief 停止或销毁的定时器不会触发，销毁后旧的标识失效
+ */
+static void TestStopAndDestroy()
+{
+    sw::TimerWheel wheel;
+    int count = 0;
+
+    auto a = wheel.Create([&] { ++count; });
+    auto b = wheel.Create([&] { ++count; });
+    wheel.Start(a, 50);
+    wheel.Start(b, 50);
+
+    TEST_CHECK(wheel.Stop(a));
+    TEST_CHECK(wheel.Destroy(b));
+    TEST_CHECK(wheel.GetActiveCount() == 0);
+    TEST_CHECK(wheel.Advance(100) == 0);
+    TEST_CHECK(count == 0);
+
+    // 复用已销毁的定时器的位置时标识不同
+    auto c = wheel.Create([&] { ++count; });
+    TEST_CHECK(c != b);
+    TEST_CHECK(!wheel.Start(b, 150));
+    TEST_CHECK(!wheel.Stop(b));
+    TEST_CHECK(!wheel.Destroy(b));
+    TEST_CHECK(!wheel.IsActive(b));
+
+    TEST_CHECK(wheel.Start(c, 150));
+    TEST_CHECK(wheel.Advance(200) == 1);
+    TEST_CHECK(count == 1);
+}
+
+/**
+ * @brief 容差范围内的定时器合并到同一时刻触发，且不早于到期时间、不晚于到期时间加容差
+ */
+static void TestTolerance()
+{
+    sw::TimerWheel wheel;
+    uint64_t firedA = 0;
+    uint64_t firedB = 0;
+
+    auto a = wheel.Create([&] { firedA = wheel.GetNow(); });
+    auto b = wheel.Create([&] { firedB = wheel.GetNow(); });
+    wheel.Start(a, 100, 0, 7);
+    wheel.Start(b, 103, 0, 7);
+
+    wheel.Advance(200);
+    TEST_CHECK(firedA == firedB);
+    TEST_CHECK(firedA >= 103 && firedA <= 107);
+
+    // 容差为0时准时触发
+    wheel.Start(a, 301);
+    wheel.Advance(400);
+    TEST_CHECK(firedA == 301);
+}
+
+/**
+ * @brief 回调中可以停止、销毁、创建和启动定时器
+ */
+static void TestModifyInCallback()
+{
+    sw::TimerWheel wheel;
+    std::vector<int> order;
+
+    sw::TimerWheel::TimerId a = 0, b = 0, c = 0;
+    b = wheel.Create([&] { order.push_back(2); });
+    c = wheel.Create([&] { order.push_back(3); });
+    a = wheel.Create([&] {
+        order.push_back(1);
+        // 停止同一时刻到期的其他定时器，销毁自身，并创建新的定时器
+        wheel.Stop(b);
+        TEST_CHECK(wheel.Destroy(a));
+        auto d = wheel.Create([&] { order.push_back(4); });
+        wheel.Start(d, wheel.GetNow() + 1);
+        // 启动已到期的定时器时在本次Advance中触发
+        wheel.Start(c, wheel.GetNow());
+    });
+
+    wheel.Start(a, 10);
+    wheel.Start(b, 10);
+
+    wheel.Advance(20);
+    std::vector<int> expected = {1, 3, 4};
+    TEST_CHECK(order == expected);
+    TEST_CHECK(!wheel.IsActive(a));
+    TEST_CHECK(!wheel.Destroy(a));
+    TEST_CHECK(wheel.GetActiveCount() == 0);
+}
+
+/**
+ * @brief 模拟定时器服务：按GetNextExpiry返回的时间唤醒，超出时间轮范围的定时器也准时触发
+ */
+static void TestNextExpiry()
+{
+    sw::TimerWheel wheel(1000);
+    uint64_t next = 0;
+    TEST_CHECK(!wheel.GetNextExpiry(next));
+
+    std::vector<uint64_t> fired;
+    auto near = wheel.Create([&] { fired.push_back(wheel.GetNow()); });
+    auto far  = wheel.Create([&] { fired.push_back(wheel.GetNow()); });
+
+    // 约12天后到期，超出5层时间轮可直接表示的范围
+    uint64_t farDue = 1000 + (uint64_t(3) << 30);
+    wheel.Start(near, 1000 + 70000);
+    wheel.Start(far, farDue);
+
+    int wakes = 0;
+    while (wheel.GetNextExpiry(next)) {
+        TEST_CHECK(next > wheel.GetNow());
+        wheel.Advance(next);
+        ++wakes;
+        if (wakes > 1000) break;
+    }
+
+    TEST_CHECK(fired.size() == 2);
+    TEST_CHECK(fired.size() == 2 && fired[0] == 1000 + 70000 && fired[1] == farDue);
+
+    // 唤醒的次数只与层数有关，而不与时间跨度成正比
+    TEST_CHECK(wakes < 64);
+    TEST_CHECK(wheel.GetActiveCount() == 0);
+}
+
+int main()
+{
+    TestOneShot();
+    TestPeriodic();
+    TestStopAndDestroy();
+    TestTolerance();
+    TestModifyInCallback();
+    TestNextExpiry();
+    return test::Report("timer_wheel");
+}
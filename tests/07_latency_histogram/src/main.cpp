@@ -0,0 +1,146 @@
+#include "LatencyHistogram.h"
+#include "Test.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 桶的范围首尾相接且覆盖所有值，每个值落在包含它的桶中
+ */
+static void TestBuckets()
+{
+    using H = sw::LatencyHistogram;
+
+    TEST_CHECK(H::GetBucketLowerBound(0) == 0);
+    for (int i = 1; i < H::BucketCount; ++i) {
+        TEST_CHECK(H::GetBucketLowerBound(i) == H::GetBucketUpperBound(i - 1) + 1);
+    }
+    TEST_CHECK(H::GetBucketUpperBound(H::BucketCount - 1) == UINT64_MAX);
+
+    std::mt19937_64 random(11);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t v = random() >> (random() % 64);
+        int index  = H::GetBucketIndex(v);
+        TEST_CHECK(index >= 0 && index < H::BucketCount);
+        TEST_CHECK(v >= H::GetBucketLowerBound(index) && v <= H::GetBucketUpperBound(index));
+    }
+    TEST_CHECK(H::GetBucketIndex(UINT64_MAX) == H::BucketCount - 1);
+}
+
+/**
+ * @brief 样本数、总和、最值与平均值是精确的
+ */
+static void TestSummary()
+{
+    sw::LatencyHistogram histogram;
+    TEST_CHECK(histogram.GetCount() == 0);
+    TEST_CHECK(histogram.GetMinimum() == 0 && histogram.GetMaximum() == 0);
+    TEST_CHECK(histogram.GetAverage() == 0);
+    TEST_CHECK(histogram.GetPercentile(50) == 0);
+
+    for (uint64_t v : {300, 100, 200, 1000000}) {
+        histogram.Record(v);
+    }
+    TEST_CHECK(histogram.GetCount() == 4);
+    TEST_CHECK(histogram.GetTotal() == 1000600);
+    TEST_CHECK(histogram.GetMinimum() == 100);
+    TEST_CHECK(histogram.GetMaximum() == 1000000);
+    TEST_CHECK(histogram.GetAverage() == 250150);
+    TEST_CHECK(histogram.GetPercentile(100) == 1000000);
+
+    uint64_t sum = 0;
+    for (int i = 0; i < sw::LatencyHistogram::BucketCount; ++i) {
+        sum += histogram.GetBucketCount(i);
+    }
+    TEST_CHECK(sum == 4);
+    TEST_CHECK(histogram.GetBucketCount(sw::LatencyHistogram::GetBucketIndex(100)) >= 1);
+}
+
+/**
+ * @brief 百分位数不小于精确值，且相对误差不超过一个子桶的宽度
+ */
+static void TestPercentiles()
+{
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> values;
+    sw::LatencyHistogram histogram;
+
+    // 对数分布的样本，跨越从几纳秒到几秒的范围
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t v = (uint64_t)std::exp2((double)(random() % 3200) / 100);
+        values.push_back(v);
+        histogram.Record(v);
+    }
+    std::sort(values.begin(), values.end());
+
+    double limit = 1.0 / sw::LatencyHistogram::SubBucketCount;
+    for (double p : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        uint64_t rank  = std::max<uint64_t>(1, (uint64_t)(p / 100 * values.size() + 0.5));
+        uint64_t exact = values[rank - 1];
+        uint64_t got   = histogram.GetPercentile(p);
+        TEST_CHECK(got >= exact);
+        TEST_CHECK(got <= histogram.GetMaximum());
+        TEST_CHECK((double)(got - exact) <= exact * limit);
+    }
+}
+
+/**
+ * @brief 合并的结果与直接记录所有样本相同，清除后恢复为空
+ */
+static void TestMergeAndClear()
+{
+    sw::LatencyHistogram a, b, all;
+    for (uint64_t v = 1; v <= 5000; v += 7) {
+        ((v & 1) ? a : b).Record(v * 1000);
+        all.Record(v * 1000);
+    }
+
+    a.Merge(b);
+    TEST_CHECK(a.GetCount() == all.GetCount());
+    TEST_CHECK(a.GetTotal() == all.GetTotal());
+    TEST_CHECK(a.GetMinimum() == all.GetMinimum());
+    TEST_CHECK(a.GetMaximum() == all.GetMaximum());
+    for (int i = 0; i < sw::LatencyHistogram::BucketCount; ++i) {
+        TEST_CHECK(a.GetBucketCount(i) == all.GetBucketCount(i));
+    }
+
+    // 合并空的直方图不影响最值
+    a.Merge(sw::LatencyHistogram());
+    TEST_CHECK(a.GetMinimum() == all.GetMinimum());
+
+    a.Clear();
+    TEST_CHECK(a.GetCount() == 0 && a.GetTotal() == 0);
+    TEST_CHECK(a.GetMinimum() == 0 && a.GetMaximum() == 0);
+
+    // 合并到空的直方图
+    a.Merge(all);
+    TEST_CHECK(a.GetMinimum() == all.GetMinimum());
+    TEST_CHECK(a.GetMaximum() == all.GetMaximum());
+}
+
+/**
+ * @brief JSON中包含样本数与非空的桶
+ */
+static void TestJson()
+{
+    sw::LatencyHistogram histogram;
+    histogram.Record(1500);
+    histogram.Record(2500);
+
+    std::wstring json = histogram.ToJson();
+    TEST_CHECK(json.size() > 2 && json.front() == L'{' && json.back() == L'}');
+    TEST_CHECK(json.find(L"\"count\":2") != std::wstring::npos);
+}
+
+int main()
+{
+    TestBuckets();
+    TestSummary();
+    TestPercentiles();
+    TestMergeAndClear();
+    TestJson();
+    return test::Report("latency_histogram");
+}
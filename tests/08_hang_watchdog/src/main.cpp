@@ -0,0 +1,120 @@
+#include "HangWatchdog.h"
+#include "Test.hpp"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 卡顿的阈值（毫秒），测试中的短消息与长消息与其相差数倍，避免受调度延迟影响
+ */
+static constexpr double ThresholdMs = 50;
+
+static void SleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief 回调收到的卡顿记录
+ */
+struct HandlerLog {
+    std::mutex mutex;
+    std::vector<sw::HangReport> reports;
+
+    void Add(const sw::HangReport &report)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->reports.push_back(report);
+    }
+
+    size_t Count()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->reports.size();
+    }
+};
+
+/**
+ * @brief 大量短消息与在嵌套的消息循环中等待消息都不视为卡顿
+ */
+static void TestNoFalseReports()
+{
+    HandlerLog log;
+    sw::HangWatchdog watchdog(ThresholdMs, [&log](const sw::HangReport &report) { log.Add(report); });
+
+    // 大量短消息，总时间远超阈值
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < end) {
+        sw::HangActivity previous = watchdog.Enter({0x0200, "FakeWindow", 1});
+        SleepMs(1);
+        watchdog.Leave(previous);
+    }
+
+    // 处理消息时进入嵌套的消息循环，循环中长时间等待消息，期间处理短消息
+    sw::HangActivity outer = watchdog.Enter({0x0201, "FakeWindow", 1});
+    for (int i = 0; i < 3; ++i) {
+        watchdog.Idle();
+        SleepMs(2 * (int)ThresholdMs);
+        watchdog.Resume();
+        sw::HangActivity inner = watchdog.Enter({0x000F, "FakeWindow", 2});
+        watchdog.Leave(inner);
+    }
+    watchdog.Leave(outer);
+
+    // 空闲状态不视为卡顿
+    SleepMs(2 * (int)ThresholdMs);
+
+    TEST_CHECK(watchdog.GetReports().empty());
+    TEST_CHECK(log.Count() == 0);
+}
+
+/**
+ * @brief 长时间的消息被报告一次，记录中为最内层的工作，结束后记录被标记为已结束
+ */
+static void TestHang()
+{
+    HandlerLog log;
+    sw::HangWatchdog watchdog(ThresholdMs, [&log](const sw::HangReport &report) { log.Add(report); });
+
+    static const char slowClass[] = "SlowWindow";
+    {
+        sw::HangActivity outer = watchdog.Enter({0x0111, "FakeWindow", 1});
+        sw::HangActivity inner = watchdog.Enter({0x0113, slowClass, 3});
+        SleepMs(4 * (int)ThresholdMs);
+
+        // 卡顿尚未结束时已被检测到
+        std::vector<sw::HangReport> reports = watchdog.GetReports();
+        TEST_CHECK(reports.size() == 1);
+        TEST_CHECK(reports.size() == 1 && !reports[0].finished);
+
+        watchdog.Leave(inner);
+        watchdog.Leave(outer);
+    }
+    SleepMs(2 * (int)ThresholdMs);
+
+    std::vector<sw::HangReport> reports = watchdog.GetReports();
+    TEST_CHECK(reports.size() == 1);
+    if (reports.size() == 1) {
+        const sw::HangReport &report = reports[0];
+        TEST_CHECK(report.id == 1);
+        TEST_CHECK(report.finished);
+        TEST_CHECK(report.durationMs >= 3 * ThresholdMs);
+        TEST_CHECK(report.activity.message == 0x0113);
+        TEST_CHECK(report.activity.className == slowClass);
+        TEST_CHECK(report.activity.handle == 3);
+    }
+
+    // 检测到卡顿时与卡顿结束时各调用一次回调
+    TEST_CHECK(log.Count() == 2);
+
+    watchdog.ClearReports();
+    TEST_CHECK(watchdog.GetReports().empty());
+}
+
+int main()
+{
+    TestNoFalseReports();
+    TestHang();
+    return test::Report("hang_watchdog");
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdio>
+
+namespace test
+{
+    /**
+     * @brief 获取当前进程中失败的检查数
+     */
+    inline int &FailureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * @brief 记录一次失败的检查并输出其位置
+     */
+    inline void Fail(const char *file, int line, const char *expr)
+    {
+        std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expr);
+        ++FailureCount();
+    }
+
+    /**
+     * @brief  输出测试结果
+     * @return 作为main函数的返回值，有失败的检查时为非零值
+     */
+    inline int Report(const char *name)
+    {
+        int failures = FailureCount();
+        if (failures == 0) {
+            std::printf("%s: all checks passed\n", name);
+        } else {
+            std::printf("%s: %d check(s) failed\n", name, failures);
+        }
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+/**
+ * @brief 检查表达式是否为true，失败时记录但不中断测试
+ */
+#define TEST_CHECK(expr) \
+    ((expr) ? (void)0 : test::Fail(__FILE__, __LINE__, #expr))